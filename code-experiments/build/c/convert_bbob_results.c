@@ -0,0 +1,33 @@
+/**
+ * Converts data files (.dat, .tdat and .rdat) written by the bbob observer with the observer option
+ * "data_format: bbob-binary" to the text format, which is the same as if the data had been logged in the
+ * default data format "bbob-new2".
+ *
+ * Usage:
+ *
+ *   convert_bbob_results INPUT_FILE_NAME OUTPUT_FILE_NAME
+ *
+ * For example:
+ *
+ *   convert_bbob_results bbobexp_f1_DIM2_i1.dat bbobexp_f1_DIM2_i1.txt
+ */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "coco.h"
+
+int main(int argc, char *argv[]) {
+
+  size_t number_of_runs;
+
+  if (argc != 3) {
+    fprintf(stderr, "Usage: %s INPUT_FILE_NAME OUTPUT_FILE_NAME\n", argv[0]);
+    return 1;
+  }
+
+  coco_set_log_level("warning");
+  number_of_runs = coco_bbob_results_to_text(argv[1], argv[2]);
+  printf("Wrote %lu runs to %s\n", (unsigned long) number_of_runs, argv[2]);
+
+  return 0;
+}
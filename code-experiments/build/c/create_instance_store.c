@@ -0,0 +1,39 @@
+/**
+ * Creates an instance store, that is, a file with the precomputed data (rotation matrices, optimal
+ * solutions, permutations) of all problems of a COCO suite. The file can then be given to the suite with
+ * the suite option "instance_store: FILE_NAME" to avoid recomputing the data in every run.
+ *
+ * Usage:
+ *
+ *   create_instance_store FILE_NAME SUITE_NAME [SUITE_INSTANCE [SUITE_OPTIONS]]
+ *
+ * For example:
+ *
+ *   create_instance_store bbob-largescale.store bbob-largescale "" "dimensions: 320,640"
+ */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "coco.h"
+
+int main(int argc, char *argv[]) {
+
+  const char *suite_instance = "";
+  const char *suite_options = "";
+  size_t number_of_entries;
+
+  if ((argc < 3) || (argc > 5)) {
+    fprintf(stderr, "Usage: %s FILE_NAME SUITE_NAME [SUITE_INSTANCE [SUITE_OPTIONS]]\n", argv[0]);
+    return 1;
+  }
+  if (argc > 3)
+    suite_instance = argv[3];
+  if (argc > 4)
+    suite_options = argv[4];
+
+  coco_set_log_level("warning");
+  number_of_entries = coco_instance_store_create(argv[1], argv[2], suite_instance, suite_options);
+  printf("Wrote %lu entries to %s\n", (unsigned long) number_of_entries, argv[1]);
+
+  return 0;
+}
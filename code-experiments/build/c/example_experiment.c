@@ -272,9 +272,10 @@ void my_random_search(evaluate_function_t evaluate_func,
   for (i = 1; i < max_budget; ++i) {
 
     /* Construct x as a random point between the lower and upper bounds */
+    coco_random_uniform_fill(random_generator, x, dimension);
     for (j = 0; j < dimension; ++j) {
       range = upper_bounds[j] - lower_bounds[j];
-      x[j] = lower_bounds[j] + coco_random_uniform(random_generator) * range;
+      x[j] = lower_bounds[j] + x[j] * range;
       /* Round the variable if integer */
       if (j < number_of_integer_variables)
         x[j] = floor(x[j] + 0.5);
@@ -0,0 +1,37 @@
+/**
+ * Merges the archives of bi-objective solutions from the given archive files (.adat) into one archive per
+ * problem instance, replacing the per-line loop of the archive-update scripts in code-preprocessing. The
+ * merged archives are written to the output folder and the hypervolume values can be written in the format
+ * of the C source files with best values (see coco_archive_merge in coco_archive_merge.c for the options).
+ *
+ * The archives are merged in several threads only if the program is compiled with -DCOCO_THREADS and
+ * linked with the thread library (for example, with -lpthread).
+ *
+ * Usage:
+ *
+ *   merge_archives OUTPUT_FOLDER OPTIONS INPUT_FILE_NAME...
+ *
+ * For example:
+ *
+ *   merge_archives archives-output "number_of_threads: 8 hyp_file: new_best_values_hyp.c" archives-input/bbob-biobj_f*.adat
+ */
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "coco.h"
+
+int main(int argc, char *argv[]) {
+
+  size_t number_of_problems;
+
+  if (argc < 4) {
+    fprintf(stderr, "Usage: %s OUTPUT_FOLDER OPTIONS INPUT_FILE_NAME...\n", argv[0]);
+    return 1;
+  }
+
+  coco_set_log_level("info");
+  number_of_problems = coco_archive_merge((size_t) (argc - 3), (const char **) (argv + 3), argv[1], argv[2]);
+  printf("Merged the archives of %lu problem instances into %s\n", (unsigned long) number_of_problems, argv[1]);
+
+  return 0;
+}
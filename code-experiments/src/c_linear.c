@@ -17,7 +17,6 @@
  */
 typedef struct {
   double *gradient;
-  double *x;
 } linear_constraint_data_t;	
 
 static void c_sum_variables_evaluate(coco_problem_t *self, 
@@ -82,6 +81,7 @@ static void c_linear_single_evaluate(coco_problem_t *self,
                                      double *y) {
 	
   size_t i;
+  double *inner_x;
   
   linear_constraint_data_t *data;
   coco_problem_t *inner_problem;
@@ -91,10 +91,12 @@ static void c_linear_single_evaluate(coco_problem_t *self,
   
   assert(self->number_of_constraints == 1);
 			
+  inner_x = coco_problem_scratch_allocate(self, self->number_of_variables);
   for (i = 0; i < self->number_of_variables; ++i)
-    data->x[i] = (data->gradient[i])*x[i];
+    inner_x[i] = (data->gradient[i])*x[i];
   
-  coco_evaluate_constraint(inner_problem, data->x, y);
+  coco_evaluate_constraint(inner_problem, inner_x, y);
+  coco_problem_scratch_free(self, inner_x, self->number_of_variables);
   
   inner_problem = NULL;
   data = NULL;
@@ -142,7 +144,6 @@ static void c_linear_gradient_free(void *thing) {
 	
   linear_constraint_data_t *data = (linear_constraint_data_t *) thing;
   coco_free_memory(data->gradient);
-  coco_free_memory(data->x);
 }
 
 /**
@@ -176,7 +177,6 @@ static coco_problem_t *c_linear_transform(coco_problem_t *inner_problem,
   coco_problem_t *self;
   data = coco_allocate_memory(sizeof(*data));
   data->gradient = coco_duplicate_vector(gradient, inner_problem->number_of_variables);
-  data->x = coco_allocate_vector(inner_problem->number_of_variables);
   self = coco_problem_transformed_allocate(inner_problem, data, 
       c_linear_gradient_free, "gradient_linear_constraint");
   self->evaluate_constraint = c_linear_single_evaluate;
@@ -248,9 +248,10 @@ static coco_problem_t *c_linear_single_cons_bbob_problem_allocate(const size_t f
     /* Generate a pseudorandom vector with distribution N_i(0, I)
      * and scale it with 'factor1' and 'factor2' (see comments above)
      */
+    coco_random_normal_fill(random_generator, gradient_linear_constraint, dimension);
     for (i = 0; i < dimension; ++i)
       gradient_linear_constraint[i] = factor1 *
-                coco_random_normal(random_generator) * factor2 / sqrt((double)dimension);
+                gradient_linear_constraint[i] * factor2 / sqrt((double)dimension);
 
     problem = c_linear_transform(problem, gradient_linear_constraint);
     coco_free_memory(gradient_linear_constraint);
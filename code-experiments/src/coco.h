@@ -121,6 +121,15 @@ struct coco_random_state_s;
  * See coco_random_state_s for more information on its fields. */
 typedef struct coco_random_state_s coco_random_state_t;
 
+/** @brief Structure containing a COCO random stream. */
+struct coco_random_stream_s;
+
+/**
+ * @brief The COCO random stream type.
+ *
+ * See coco_random_stream_s for more information on its fields. */
+typedef struct coco_random_stream_s coco_random_stream_t;
+
 /***********************************************************************************************************/
 
 /**
@@ -175,6 +184,34 @@ size_t coco_suite_get_dimension_from_dimension_index(const coco_suite_t *suite,
  * @brief Returns the instance number in the suite in position instance_idx (counting from 0).
  */
 size_t coco_suite_get_instance_from_instance_index(const coco_suite_t *suite, const size_t instance_idx);
+
+/**
+ * @brief The type of the solver that is called by coco_suite_run on each problem of the suite.
+ *
+ * The solver may be called from several threads at the same time. It should therefore not change
+ * solver_data and should derive its random numbers from the problem (for example, from a random stream
+ * created with coco_random_stream_new using its suite_dep_index as the stream identifier) so that the
+ * results do not depend on the order in which the problems are solved.
+ */
+typedef void (*coco_solver_function_t)(coco_problem_t *problem, void *solver_data);
+
+/**
+ * @brief Calls the solver on all (observed) problems of the suite using the given number of threads.
+ */
+void coco_suite_run(coco_suite_t *suite,
+                    coco_observer_t *observer,
+                    coco_solver_function_t solver,
+                    void *solver_data,
+                    const size_t number_of_threads);
+
+/**
+ * @brief Writes the instance data of all problems of the suite to an instance store with the given file
+ * name and returns the number of written entries.
+ */
+size_t coco_instance_store_create(const char *file_name,
+                                  const char *suite_name,
+                                  const char *suite_instance,
+                                  const char *suite_options);
 /**@}*/
 
 /**
@@ -287,6 +324,12 @@ coco_problem_t *coco_problem_remove_observer(coco_problem_t *problem, coco_obser
  */
 const char *coco_observer_get_result_folder(const coco_observer_t *observer);
 
+/**
+ * @brief Converts a data file written by the bbob observer in the "bbob-binary" data format to the text
+ * format and returns the number of runs in the file.
+ */
+size_t coco_bbob_results_to_text(const char *input_file_name, const char *output_file_name);
+
 /**@}*/
 
 /***********************************************************************************************************/
@@ -300,6 +343,15 @@ const char *coco_observer_get_result_folder(const coco_observer_t *observer);
  */
 void coco_evaluate_function(coco_problem_t *problem, const double *x, double *y);
 
+/**
+ * @brief Evaluates the problem function in number_of_points points stored one after another in x and saves
+ * the results one after another in y.
+ */
+void coco_evaluate_function_batch(coco_problem_t *problem,
+                                  const size_t number_of_points,
+                                  const double *x,
+                                  double *y);
+
 /**
  * @brief Evaluates the problem constraints in point x and save the result in y.
  */
@@ -315,6 +367,16 @@ void coco_recommend_solution(coco_problem_t *problem, const double *x);
  */
 void coco_problem_free(coco_problem_t *problem);
 
+/**
+ * @brief Returns a clone of the given problem that can be evaluated concurrently with it.
+ */
+coco_problem_t *coco_problem_clone(coco_problem_t *problem);
+
+/**
+ * @brief Adds the evaluations done on the clone to the evaluations of the problem.
+ */
+void coco_problem_merge_evaluations(coco_problem_t *problem, coco_problem_t *clone);
+
 /**
  * @brief Returns the name of the problem.
  */
@@ -432,6 +494,61 @@ double coco_random_uniform(coco_random_state_t *state);
  * @brief Generates an approximately normal random number.
  */
 double coco_random_normal(coco_random_state_t *state);
+
+/**
+ * @brief Stores number_of_values uniform [0, 1) random values in values (the same values as returned by as
+ * many calls of coco_random_uniform).
+ */
+void coco_random_uniform_fill(coco_random_state_t *state, double *values, const size_t number_of_values);
+
+/**
+ * @brief Stores number_of_values approximately normal random values in values (the same values as returned
+ * by as many calls of coco_random_normal).
+ */
+void coco_random_normal_fill(coco_random_state_t *state, double *values, const size_t number_of_values);
+
+/**
+ * @brief Creates and returns a new counter-based random stream with the given seed and stream identifier.
+ *
+ * Streams with the same seed and different identifiers are independent, so that, for example, each problem
+ * or worker of a parallel experiment can use its own stream (identified by the problem index) and get the
+ * same results regardless of the number of threads.
+ */
+coco_random_stream_t *coco_random_stream_new(uint32_t seed, uint64_t stream_id);
+
+/**
+ * @brief Frees all memory associated with the random stream.
+ */
+void coco_random_stream_free(coco_random_stream_t *stream);
+
+/**
+ * @brief Skips the next number_of_values uniform values of the stream (in constant time).
+ */
+void coco_random_stream_skip(coco_random_stream_t *stream, uint64_t number_of_values);
+
+/**
+ * @brief Returns the next uniform [0, 1) random value of the stream.
+ */
+double coco_random_stream_uniform(coco_random_stream_t *stream);
+
+/**
+ * @brief Returns the next normal random value of the stream (computed from two uniform values).
+ */
+double coco_random_stream_normal(coco_random_stream_t *stream);
+
+/**
+ * @brief Stores the next number_of_values uniform [0, 1) random values of the stream in values.
+ */
+void coco_random_stream_uniform_fill(coco_random_stream_t *stream,
+                                     double *values,
+                                     const size_t number_of_values);
+
+/**
+ * @brief Stores the next number_of_values normal random values of the stream in values.
+ */
+void coco_random_stream_normal_fill(coco_random_stream_t *stream,
+                                    double *values,
+                                    const size_t number_of_values);
 /**@}*/
 
 /***********************************************************************************************************/
@@ -519,6 +636,31 @@ coco_archive_t *coco_archive(const char *suite_name,
  */
 int coco_archive_add_solution(coco_archive_t *archive, const double y1, const double y2, const char *text);
 
+/**
+ * @brief Adds number_of_solutions solutions with objectives (y1[i], y2[i]) to the archive at once and returns
+ * the number of them that updated the archive.
+ *
+ * The text of the i-th solution is the string starting at text + text_offsets[i]. The resulting archive is
+ * the same as after adding the solutions one by one with coco_archive_add_solution(), but the solutions are
+ * first sorted and only the non-dominated ones are inserted into the archive.
+ */
+size_t coco_archive_add_solutions(coco_archive_t *archive,
+                                  const size_t number_of_solutions,
+                                  const double *y1,
+                                  const double *y2,
+                                  const char *text,
+                                  const size_t *text_offsets);
+
+/**
+ * @brief Merges the archives of bi-objective solutions from the given archive files (.adat) into one archive
+ * per problem instance, which are written to the output folder (see coco_archive_merge.c for the options).
+ * Returns the number of merged problem instances.
+ */
+size_t coco_archive_merge(const size_t number_of_files,
+                          const char **file_names,
+                          const char *output_folder,
+                          const char *options);
+
 /**
  * @brief Returns the number of (non-dominated) solutions in the archive (computed first, if needed).
  */
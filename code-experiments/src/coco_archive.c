@@ -19,6 +19,7 @@
 struct coco_archive_s {
 
   avl_tree_t *tree;              /**< @brief The AVL tree with non-dominated solutions. */
+  avl_pool_t *node_pool;         /**< @brief The pool holding the nodes of the tree. */
   double *ideal;                 /**< @brief The ideal point. */
   double *nadir;                 /**< @brief The nadir point. */
 
@@ -45,6 +46,27 @@ typedef struct {
   char *text;                /**< @brief The text describing the solution (the whole line of the archive). */
 } coco_archive_avl_item_t;
 
+/**
+ * @brief Allocates a node's item in the AVL tree with the first text_length characters of text as its text
+ * (the normalized objective values are left to the caller).
+ *
+ * The item, its normalized objective values and its text are stored in a single memory block.
+ */
+static coco_archive_avl_item_t* coco_archive_node_item_allocate(const size_t num_obj,
+                                                                const char *text,
+                                                                const size_t text_length) {
+
+  /* Allocate memory to hold the data structure coco_archive_avl_item_t together with its data */
+  coco_archive_avl_item_t *item = (coco_archive_avl_item_t*) coco_allocate_memory(sizeof(*item)
+      + num_obj * sizeof(double) + text_length + 1);
+  item->normalized_y = (double *) (item + 1);
+  item->text = (char *) (item->normalized_y + num_obj);
+
+  memcpy(item->text, text, text_length);
+  item->text[text_length] = '\0';
+  return item;
+}
+
 /**
  * @brief Creates and returns the information on the solution in the form of a node's item in the AVL tree.
  */
@@ -54,13 +76,10 @@ static coco_archive_avl_item_t* coco_archive_node_item_create(const double *y,
                                                               const size_t num_obj,
                                                               const char *text) {
 
-  /* Allocate memory to hold the data structure coco_archive_avl_item_t */
-  coco_archive_avl_item_t *item = (coco_archive_avl_item_t*) coco_allocate_memory(sizeof(*item));
+  coco_archive_avl_item_t *item = coco_archive_node_item_allocate(num_obj, text, strlen(text));
 
   /* Compute the normalized y */
-  item->normalized_y = mo_normalize(y, ideal, nadir, num_obj);
-
-  item->text = coco_strdup(text);
+  mo_normalize_to(y, ideal, nadir, num_obj, item->normalized_y);
   return item;
 }
 
@@ -68,8 +87,6 @@ static coco_archive_avl_item_t* coco_archive_node_item_create(const double *y,
  * @brief Frees the data of the given coco_archive_avl_item_t.
  */
 static void coco_archive_node_item_free(coco_archive_avl_item_t *item, void *userdata) {
-  coco_free_memory(item->normalized_y);
-  coco_free_memory(item->text);
   coco_free_memory(item);
   (void) userdata; /* To silence the compiler */
 }
@@ -98,9 +115,12 @@ static coco_archive_t *coco_archive_allocate(void) {
   /* Allocate memory to hold the data structure coco_archive_t */
   coco_archive_t *archive = (coco_archive_t*) coco_allocate_memory(sizeof(*archive));
 
-  /* Initialize the AVL tree */
+  /* Initialize the AVL tree, its nodes are allocated from the pool */
+  archive->node_pool = avl_pool_construct(sizeof(avl_node_t), 1024);
+  if (archive->node_pool == NULL)
+    coco_error("coco_archive_allocate(): failed to allocate the node pool");
   archive->tree = avl_tree_construct((avl_compare_t) coco_archive_compare_by_last_objective,
-      (avl_free_t) coco_archive_node_item_free);
+      (avl_free_t) coco_archive_node_item_free, &archive->node_pool->allocator);
 
   archive->ideal = NULL;                /* To be allocated in coco_archive() */
   archive->nadir = NULL;                /* To be allocated in coco_archive() */
@@ -173,20 +193,17 @@ coco_archive_t *coco_archive(const char *suite_name,
   return archive;
 }
 
-int coco_archive_add_solution(coco_archive_t *archive, const double y1, const double y2, const char *text) {
+/**
+ * @brief Inserts the item into the archive if none of the existing solutions dominates it or is equal to it
+ * (and removes the solutions dominated by the item). Returns 1 if the archive was updated and 0 otherwise,
+ * in which case the item is freed.
+ */
+static int coco_archive_insert_item(coco_archive_t *archive, coco_archive_avl_item_t *insert_item) {
 
-  coco_archive_avl_item_t* insert_item;
   avl_node_t *node, *next_node;
   int update = 0;
   int dominance;
 
-  double *y = coco_allocate_vector(2);
-  y[0] = y1;
-  y[1] = y2;
-  insert_item = coco_archive_node_item_create(y, archive->ideal, archive->nadir,
-      archive->number_of_objectives, text);
-  coco_free_memory(y);
-
   /* Find the first point that is not worse than the new point (NULL if such point does not exist) */
   node = avl_item_search_right(archive->tree, insert_item, NULL);
 
@@ -233,7 +250,7 @@ int coco_archive_add_solution(coco_archive_t *archive, const double y1, const do
     }
 
     if(avl_item_insert(archive->tree, insert_item) == NULL) {
-      coco_warning("Solution %s did not update the archive", text);
+      coco_warning("Solution %s did not update the archive", insert_item->text);
       update = 0;
     }
 
@@ -243,6 +260,149 @@ int coco_archive_add_solution(coco_archive_t *archive, const double y1, const do
   return update;
 }
 
+int coco_archive_add_solution(coco_archive_t *archive, const double y1, const double y2, const char *text) {
+
+  coco_archive_avl_item_t* insert_item;
+  double y[2];
+
+  y[0] = y1;
+  y[1] = y2;
+  insert_item = coco_archive_node_item_create(y, archive->ideal, archive->nadir,
+      archive->number_of_objectives, text);
+
+  return coco_archive_insert_item(archive, insert_item);
+}
+
+/**
+ * @brief The number of solutions that coco_archive_add_solutions() sorts at once.
+ */
+#define COCO_ARCHIVE_CHUNK_SIZE 4096
+
+/**
+ * @brief A solution given to coco_archive_add_solutions() in the order of the input.
+ */
+typedef struct {
+  double normalized_y[2]; /**< @brief The rounded normalized objective values of the solution. */
+  size_t index;           /**< @brief The index of the solution in the input. */
+} coco_archive_record_t;
+
+/**
+ * @brief Orders the records by increasing first and second objective and then by their index.
+ */
+static int coco_archive_record_compare(const void *a, const void *b) {
+  const coco_archive_record_t *record1 = (const coco_archive_record_t *) a;
+  const coco_archive_record_t *record2 = (const coco_archive_record_t *) b;
+  size_t i;
+
+  for (i = 0; i < 2; i++) {
+    if (record1->normalized_y[i] < record2->normalized_y[i])
+      return -1;
+    if (record1->normalized_y[i] > record2->normalized_y[i])
+      return 1;
+  }
+  if (record1->index < record2->index)
+    return -1;
+  return (record1->index > record2->index) ? 1 : 0;
+}
+
+/**
+ * @brief Returns 1 if a solution in the archive dominates or is equal to the solution with the given normalized
+ * objective values and 0 otherwise.
+ */
+static int coco_archive_is_dominated(coco_archive_t *archive, double *normalized_y) {
+
+  coco_archive_avl_item_t probe_item;
+  avl_node_t *node;
+
+  probe_item.normalized_y = normalized_y;
+  probe_item.text = NULL;
+
+  /* Only the first point that is not worse in the last objective can dominate the given point */
+  node = avl_item_search_right(archive->tree, &probe_item, NULL);
+  if (node == NULL)
+    return 0;
+  return mo_get_dominance(normalized_y, ((coco_archive_avl_item_t*) node->item)->normalized_y,
+      archive->number_of_objectives) < 0;
+}
+
+/**
+ * @brief Adds the solutions to the archive at once (see coco_archive_add_solutions()).
+ *
+ * If text_lengths is not NULL, the text of the i-th solution consists of the text_lengths[i] characters
+ * starting at text + text_offsets[i] (and does not need to be terminated), otherwise it is the string
+ * starting at text + text_offsets[i].
+ */
+static size_t coco_archive_add_text_solutions(coco_archive_t *archive,
+                                              const size_t number_of_solutions,
+                                              const double *y1,
+                                              const double *y2,
+                                              const char *text,
+                                              const size_t *text_offsets,
+                                              const size_t *text_lengths) {
+
+  coco_archive_record_t *records;
+  coco_archive_avl_item_t *insert_item;
+  double y[2];
+  double min_y2 = 0;
+  size_t i, j, chunk_end, number_of_records, number_of_updates = 0;
+
+  if (number_of_solutions == 0)
+    return 0;
+
+  /* The solutions are handled in chunks, so that the solutions inserted from one chunk already filter out
+   * most of the solutions in the following chunks before they need to be sorted */
+  records = (coco_archive_record_t *) coco_allocate_memory(sizeof(*records)
+      * ((number_of_solutions < COCO_ARCHIVE_CHUNK_SIZE) ? number_of_solutions : COCO_ARCHIVE_CHUNK_SIZE));
+  for (chunk_end = 0; chunk_end < number_of_solutions; ) {
+    i = chunk_end;
+    chunk_end = (number_of_solutions - i > COCO_ARCHIVE_CHUNK_SIZE) ? i + COCO_ARCHIVE_CHUNK_SIZE
+        : number_of_solutions;
+
+    /* Keep only the solutions that are not dominated by (or equal to) the solutions already in the archive */
+    number_of_records = 0;
+    for (; i < chunk_end; i++) {
+      y[0] = y1[i];
+      y[1] = y2[i];
+      mo_normalize_to(y, archive->ideal, archive->nadir, archive->number_of_objectives,
+          records[number_of_records].normalized_y);
+      if (!coco_archive_is_dominated(archive, records[number_of_records].normalized_y)) {
+        records[number_of_records].index = i;
+        number_of_records++;
+      }
+    }
+
+    /* Sort the solutions so that each one can only be dominated by (or be equal to) the solutions before it.
+     * Among equal solutions the first one in the input comes first and is kept, as in
+     * coco_archive_add_solution(). */
+    qsort(records, number_of_records, sizeof(*records), coco_archive_record_compare);
+
+    /* Sweep over the sorted solutions and insert only the non-dominated ones into the tree */
+    for (j = 0; j < number_of_records; j++) {
+      if ((j > 0) && !(records[j].normalized_y[1] < min_y2))
+        continue;
+      min_y2 = records[j].normalized_y[1];
+      insert_item = coco_archive_node_item_allocate(archive->number_of_objectives,
+          text + text_offsets[records[j].index], (text_lengths != NULL) ? text_lengths[records[j].index]
+              : strlen(text + text_offsets[records[j].index]));
+      insert_item->normalized_y[0] = records[j].normalized_y[0];
+      insert_item->normalized_y[1] = records[j].normalized_y[1];
+      number_of_updates += (size_t) coco_archive_insert_item(archive, insert_item);
+    }
+  }
+
+  coco_free_memory(records);
+  return number_of_updates;
+}
+
+size_t coco_archive_add_solutions(coco_archive_t *archive,
+                                  const size_t number_of_solutions,
+                                  const double *y1,
+                                  const double *y2,
+                                  const char *text,
+                                  const size_t *text_offsets) {
+  return coco_archive_add_text_solutions(archive, number_of_solutions, y1, y2, text, text_offsets, NULL);
+}
+
 /**
  * @brief Updates the archive fields returned by the getters.
  */
@@ -345,6 +505,7 @@ void coco_archive_free(coco_archive_t *archive) {
   assert(archive != NULL);
 
   avl_tree_destruct(archive->tree);
+  avl_pool_destruct(archive->node_pool);
   coco_free_memory(archive->ideal);
   coco_free_memory(archive->nadir);
   coco_free_memory(archive);
@@ -0,0 +1,897 @@
+/**
+ * @file coco_archive_merge.c
+ * @brief Merging of the archive files of bi-objective solutions in several threads.
+ *
+ * The archive files (.adat) are memory-mapped (or read into memory where mapping is not available) and
+ * split into the parts that hold the solutions of the individual problem instances. The lines are parsed
+ * in place, only the solutions that end up in an archive have their text copied.
+ *
+ * The problem instances are put into a queue ordered by decreasing amount of data and each thread
+ * repeatedly takes the next problem instance from the queue, adds the solutions from all its parts to a
+ * COCO archive at once and writes the resulting archive to the output folder.
+ *
+ * Threads are only used if the code is compiled with COCO_THREADS defined and linked with the thread
+ * library of the platform (for example, -lpthread). Otherwise the archives are merged sequentially.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "coco.h"
+#include "coco_utilities.c"
+#include "coco_string.c"
+#include "coco_archive.c"
+
+/**
+ * @brief The maximal length of a number in an archive file.
+ */
+#define COCO_ARCHIVE_MERGE_MAX_NUMBER_LENGTH 63
+
+/**
+ * @brief An archive file read into memory.
+ */
+typedef struct {
+  char *file_name;            /**< @brief The name of the file. */
+  char *contents;             /**< @brief The contents of the file. */
+  size_t size;                /**< @brief The size of the file in bytes. */
+  int is_mapped;              /**< @brief Whether the contents are memory-mapped. */
+} coco_archive_merge_file_t;
+
+/**
+ * @brief The part of an archive file that holds solutions of one problem instance.
+ */
+typedef struct {
+  const coco_archive_merge_file_t *file; /**< @brief The file. */
+  size_t begin;               /**< @brief The offset of the first line of the part. */
+  size_t end;                 /**< @brief The offset after the last line of the part. */
+} coco_archive_merge_part_t;
+
+/**
+ * @brief A problem instance with the parts of the archive files that hold its solutions.
+ */
+typedef struct {
+  char *name;                 /**< @brief The name of the problem instance (suite_fXX_iXX_dXX). */
+  char *suite_name;           /**< @brief The suite name used in the file names. */
+  size_t function;            /**< @brief The function number. */
+  size_t instance;            /**< @brief The instance number. */
+  size_t dimension;           /**< @brief The dimension. */
+  coco_archive_merge_part_t *parts; /**< @brief The parts holding the solutions. */
+  size_t number_of_parts;     /**< @brief The number of parts. */
+  size_t size;                /**< @brief The total size of the parts in bytes. */
+  double hypervolume;         /**< @brief The hypervolume of the merged archive. */
+  size_t number_of_solutions; /**< @brief The number of solutions in the merged archive. */
+} coco_archive_merge_problem_t;
+
+/**
+ * @brief The data shared by the threads of coco_archive_merge.
+ *
+ * Only the queue and the creation of the archives (which creates suites) are serialized through the mutex,
+ * the threads otherwise work on different problem instances.
+ */
+typedef struct {
+  coco_archive_merge_problem_t **queue; /**< @brief The queue of problem instances. */
+  size_t number_of_problems;  /**< @brief The number of problem instances in the queue. */
+  size_t next_problem;        /**< @brief The position of the next problem instance in the queue. */
+  const char *output_folder;  /**< @brief The folder of the merged archives. */
+  int crop_variables;         /**< @brief Whether to output only the evaluation number and objective values. */
+  double thinning_precision;  /**< @brief The precision of thinning in the normalized objective space (or 0). */
+  int is_parallel;            /**< @brief Whether several threads are used (and the mutex exists). */
+#if defined(HAVE_PTHREAD)
+  pthread_mutex_t mutex;      /**< @brief The mutex. */
+#elif defined(HAVE_WIN_THREADS)
+  CRITICAL_SECTION mutex;     /**< @brief The mutex. */
+#endif
+} coco_archive_merge_t;
+
+/**
+ * @brief The solutions of one problem instance as parsed from the archive files (pointing into the files).
+ */
+typedef struct {
+  double *y1;                 /**< @brief The first objective values. */
+  double *y2;                 /**< @brief The second objective values. */
+  size_t *text_offsets;       /**< @brief The offsets of the lines in the contents of the file. */
+  size_t *text_lengths;       /**< @brief The lengths of the lines. */
+  size_t number_of_solutions; /**< @brief The number of solutions. */
+  size_t capacity;            /**< @brief The number of solutions that fit into the vectors. */
+} coco_archive_merge_solutions_t;
+
+/**
+ * @brief Locks the mutex of the merger.
+ */
+static void coco_archive_merge_lock(coco_archive_merge_t *merger) {
+  if (!merger->is_parallel)
+    return;
+#if defined(HAVE_PTHREAD)
+  pthread_mutex_lock(&merger->mutex);
+#elif defined(HAVE_WIN_THREADS)
+  EnterCriticalSection(&merger->mutex);
+#else
+  (void) merger; /* To silence the compiler */
+#endif
+}
+
+/**
+ * @brief Unlocks the mutex of the merger.
+ */
+static void coco_archive_merge_unlock(coco_archive_merge_t *merger) {
+  if (!merger->is_parallel)
+    return;
+#if defined(HAVE_PTHREAD)
+  pthread_mutex_unlock(&merger->mutex);
+#elif defined(HAVE_WIN_THREADS)
+  LeaveCriticalSection(&merger->mutex);
+#else
+  (void) merger; /* To silence the compiler */
+#endif
+}
+
+/**
+ * @brief Reads the file into memory (memory-maps it where possible).
+ *
+ * @return 1 on success and 0 if the file cannot be read or is empty.
+ */
+static int coco_archive_merge_file_open(coco_archive_merge_file_t *file, const char *file_name) {
+  FILE *stream;
+#if defined(HAVE_MMAP)
+  struct stat file_status;
+  int file_descriptor;
+  void *contents;
+#endif
+
+  file->file_name = coco_strdup(file_name);
+  file->contents = NULL;
+  file->size = 0;
+  file->is_mapped = 0;
+
+#if defined(HAVE_MMAP)
+  file_descriptor = open(file_name, O_RDONLY);
+  if (file_descriptor >= 0) {
+    if ((fstat(file_descriptor, &file_status) == 0) && (file_status.st_size > 0)) {
+      file->size = (size_t) file_status.st_size;
+      contents = mmap(NULL, file->size, PROT_READ, MAP_SHARED, file_descriptor, 0);
+      if (contents != MAP_FAILED) {
+        file->contents = (char *) contents;
+        file->is_mapped = 1;
+      }
+    }
+    close(file_descriptor);
+    if (file->is_mapped)
+      return 1;
+  }
+#endif
+
+  stream = fopen(file_name, "rb");
+  if (stream == NULL)
+    return 0;
+  if ((fseek(stream, 0, SEEK_END) != 0) || (ftell(stream) <= 0)) {
+    fclose(stream);
+    return 0;
+  }
+  file->size = (size_t) ftell(stream);
+  rewind(stream);
+  file->contents = (char *) coco_allocate_memory(file->size);
+  if (fread(file->contents, 1, file->size, stream) != file->size) {
+    coco_free_memory(file->contents);
+    file->contents = NULL;
+    fclose(stream);
+    return 0;
+  }
+  fclose(stream);
+  return 1;
+}
+
+/**
+ * @brief Frees the contents of the file.
+ */
+static void coco_archive_merge_file_close(coco_archive_merge_file_t *file) {
+  if (file->contents != NULL) {
+#if defined(HAVE_MMAP)
+    if (file->is_mapped)
+      munmap(file->contents, file->size);
+    else
+#endif
+      coco_free_memory(file->contents);
+  }
+  coco_free_memory(file->file_name);
+}
+
+/**
+ * @brief Returns the offset after the line starting at the given offset (and the line's length without the
+ * end-of-line character in line_length).
+ */
+static size_t coco_archive_merge_next_line(const char *contents,
+                                           const size_t offset,
+                                           const size_t end,
+                                           size_t *line_length) {
+  const char *line_end = (const char *) memchr(contents + offset, '\n', end - offset);
+  if (line_end == NULL) {
+    *line_length = end - offset;
+    return end;
+  }
+  *line_length = (size_t) (line_end - (contents + offset));
+  return *line_length + offset + 1;
+}
+
+/**
+ * @brief Reads the instance number from a comment line of the form "% ... instance = NUMBER ...".
+ *
+ * @return 1 if the line contains an instance number and 0 otherwise.
+ */
+static int coco_archive_merge_read_instance(const char *line, const size_t line_length, size_t *instance) {
+  char buffer[COCO_PATH_MAX + 1];
+  char *position;
+  unsigned long value;
+  size_t length = (line_length < COCO_PATH_MAX) ? line_length : COCO_PATH_MAX;
+
+  memcpy(buffer, line, length);
+  buffer[length] = '\0';
+  position = strstr(buffer, "instance");
+  if (position == NULL)
+    return 0;
+  position += strlen("instance");
+  while ((*position == ' ') || (*position == '\t'))
+    position++;
+  if ((*position != '=') || (sscanf(position + 1, "%lu", &value) != 1))
+    return 0;
+  *instance = (size_t) value;
+  return 1;
+}
+
+/**
+ * @brief Returns the problem instance with the given values (adds it to the problems if it does not exist yet).
+ */
+static coco_archive_merge_problem_t *coco_archive_merge_get_problem(coco_archive_merge_problem_t **problems,
+                                                                    size_t *number_of_problems,
+                                                                    size_t *capacity,
+                                                                    const char *suite_name,
+                                                                    const size_t function,
+                                                                    const size_t instance,
+                                                                    const size_t dimension) {
+  coco_archive_merge_problem_t *problem;
+  char *name = coco_strdupf("%s_f%02lu_i%02lu_d%02lu", suite_name, (unsigned long) function,
+      (unsigned long) instance, (unsigned long) dimension);
+  size_t i;
+
+  for (i = 0; i < *number_of_problems; i++) {
+    if (strcmp((*problems)[i].name, name) == 0) {
+      coco_free_memory(name);
+      return &(*problems)[i];
+    }
+  }
+
+  if (*number_of_problems == *capacity) {
+    *capacity = (*capacity == 0) ? 16 : 2 * *capacity;
+    problem = (coco_archive_merge_problem_t *) coco_allocate_memory(*capacity * sizeof(*problem));
+    if (*number_of_problems > 0) {
+      memcpy(problem, *problems, *number_of_problems * sizeof(*problem));
+      coco_free_memory(*problems);
+    }
+    *problems = problem;
+  }
+  problem = &(*problems)[(*number_of_problems)++];
+  problem->name = name;
+  problem->suite_name = coco_strdup(suite_name);
+  problem->function = function;
+  problem->instance = instance;
+  problem->dimension = dimension;
+  problem->parts = NULL;
+  problem->number_of_parts = 0;
+  problem->size = 0;
+  problem->hypervolume = 0;
+  problem->number_of_solutions = 0;
+  return problem;
+}
+
+/**
+ * @brief Adds the part of the file to the problem instance.
+ */
+static void coco_archive_merge_add_part(coco_archive_merge_problem_t *problem,
+                                        const coco_archive_merge_file_t *file,
+                                        const size_t begin,
+                                        const size_t end) {
+  coco_archive_merge_part_t *parts;
+
+  parts = (coco_archive_merge_part_t *) coco_allocate_memory((problem->number_of_parts + 1) * sizeof(*parts));
+  if (problem->number_of_parts > 0) {
+    memcpy(parts, problem->parts, problem->number_of_parts * sizeof(*parts));
+    coco_free_memory(problem->parts);
+  }
+  problem->parts = parts;
+  problem->parts[problem->number_of_parts].file = file;
+  problem->parts[problem->number_of_parts].begin = begin;
+  problem->parts[problem->number_of_parts].end = end;
+  problem->number_of_parts++;
+  problem->size += end - begin;
+}
+
+/**
+ * @brief Splits the file into the parts of the problem instances and adds them to the problems.
+ *
+ * The file name needs to be in the form SUITE_fFUNCTION_iINSTANCE_dDIMENSION_*.adat (the file holds the
+ * solutions of one instance) or SUITE_fFUNCTION_dDIMENSION_*.adat (the solutions of each instance follow a
+ * comment line with "instance = INSTANCE").
+ *
+ * @return 1 on success and 0 if the file name is not in the expected form.
+ */
+static int coco_archive_merge_split_file(const coco_archive_merge_file_t *file,
+                                         coco_archive_merge_problem_t **problems,
+                                         size_t *number_of_problems,
+                                         size_t *capacity) {
+  char suite_name[COCO_PATH_MAX + 1];
+  const char *base_name, *separator;
+  unsigned long function, instance = 0, dimension;
+  size_t offset, next_offset, line_length, part_begin = 0, part_instance = 0;
+  int in_part = 0;
+  coco_archive_merge_problem_t *problem;
+
+  base_name = file->file_name;
+  for (separator = file->file_name; *separator != '\0'; separator++) {
+    if ((*separator == '/') || (*separator == '\\'))
+      base_name = separator + 1;
+  }
+  separator = strchr(base_name, '_');
+  if ((separator == NULL) || (separator == base_name) || ((size_t) (separator - base_name) > COCO_PATH_MAX))
+    return 0;
+  memcpy(suite_name, base_name, (size_t) (separator - base_name));
+  suite_name[separator - base_name] = '\0';
+
+  if (sscanf(separator + 1, "f%lu_d%lu", &function, &dimension) == 2) {
+    /* The file holds several instances */
+    for (offset = 0; offset < file->size; offset = next_offset) {
+      next_offset = coco_archive_merge_next_line(file->contents, offset, file->size, &line_length);
+      if ((file->contents[offset] == '%')
+          && coco_archive_merge_read_instance(file->contents + offset, line_length, &part_instance)) {
+        if (in_part) {
+          problem = coco_archive_merge_get_problem(problems, number_of_problems, capacity, suite_name,
+              (size_t) function, (size_t) instance, (size_t) dimension);
+          coco_archive_merge_add_part(problem, file, part_begin, offset);
+        }
+        instance = (unsigned long) part_instance;
+        part_begin = next_offset;
+        in_part = 1;
+      }
+    }
+    if (!in_part) {
+      coco_warning("coco_archive_merge(): file %s does not contain an 'instance' string", file->file_name);
+      return 1;
+    }
+    problem = coco_archive_merge_get_problem(problems, number_of_problems, capacity, suite_name,
+        (size_t) function, (size_t) instance, (size_t) dimension);
+    coco_archive_merge_add_part(problem, file, part_begin, file->size);
+  } else if (sscanf(separator + 1, "f%lu_i%lu_d%lu", &function, &instance, &dimension) == 3) {
+    problem = coco_archive_merge_get_problem(problems, number_of_problems, capacity, suite_name,
+        (size_t) function, (size_t) instance, (size_t) dimension);
+    coco_archive_merge_add_part(problem, file, 0, file->size);
+  } else {
+    return 0;
+  }
+  return 1;
+}
+
+/**
+ * @brief Parses the number in the given characters.
+ *
+ * @return 1 on success and 0 if the characters do not form a number.
+ */
+static int coco_archive_merge_parse_number(const char *characters, const size_t length, double *number) {
+  char buffer[COCO_ARCHIVE_MERGE_MAX_NUMBER_LENGTH + 1];
+  char *end;
+
+  if ((length == 0) || (length > COCO_ARCHIVE_MERGE_MAX_NUMBER_LENGTH))
+    return 0;
+  memcpy(buffer, characters, length);
+  buffer[length] = '\0';
+  *number = strtod(buffer, &end);
+  return (*end == '\0');
+}
+
+/**
+ * @brief Returns the position of the next token in the line and its length in token_length (0 if there are no
+ * more tokens).
+ */
+static const char *coco_archive_merge_next_token(const char *position,
+                                                 const char *line_end,
+                                                 size_t *token_length) {
+  const char *token;
+
+  while ((position < line_end) && ((*position == ' ') || (*position == '\t') || (*position == '\r')))
+    position++;
+  token = position;
+  while ((position < line_end) && (*position != ' ') && (*position != '\t') && (*position != '\r'))
+    position++;
+  *token_length = (size_t) (position - token);
+  return token;
+}
+
+/**
+ * @brief Appends the solutions in the part of a file to the given solutions.
+ *
+ * Empty lines and comments are skipped, lines that do not contain the objective values in the second and
+ * third column are skipped with a warning.
+ */
+static void coco_archive_merge_parse_part(const coco_archive_merge_part_t *part,
+                                          coco_archive_merge_solutions_t *solutions) {
+  const char *contents = part->file->contents;
+  const char *line, *line_end, *token;
+  size_t offset, next_offset, line_length, token_length, capacity;
+  double y[2];
+  size_t *offsets, *lengths;
+  double *y1, *y2;
+  int i, is_valid;
+
+  for (offset = part->begin; offset < part->end; offset = next_offset) {
+    next_offset = coco_archive_merge_next_line(contents, offset, part->end, &line_length);
+    line = contents + offset;
+    line_end = line + line_length;
+
+    /* Skip the evaluation number and read the objective values */
+    token = coco_archive_merge_next_token(line, line_end, &token_length);
+    if ((token_length == 0) || (*token == '%'))
+      continue;
+    is_valid = 1;
+    for (i = 0; (i < 2) && is_valid; i++) {
+      token = coco_archive_merge_next_token(token + token_length, line_end, &token_length);
+      is_valid = coco_archive_merge_parse_number(token, token_length, &y[i]);
+    }
+    if (!is_valid) {
+      coco_warning("coco_archive_merge(): problem in file %s at offset %lu, skipping line",
+          part->file->file_name, (unsigned long) offset);
+      continue;
+    }
+
+    if (solutions->number_of_solutions == solutions->capacity) {
+      capacity = (solutions->capacity == 0) ? 1024 : 2 * solutions->capacity;
+      y1 = coco_allocate_vector(capacity);
+      y2 = coco_allocate_vector(capacity);
+      offsets = coco_allocate_vector_size_t(capacity);
+      lengths = coco_allocate_vector_size_t(capacity);
+      if (solutions->capacity > 0) {
+        memcpy(y1, solutions->y1, solutions->number_of_solutions * sizeof(double));
+        memcpy(y2, solutions->y2, solutions->number_of_solutions * sizeof(double));
+        memcpy(offsets, solutions->text_offsets, solutions->number_of_solutions * sizeof(size_t));
+        memcpy(lengths, solutions->text_lengths, solutions->number_of_solutions * sizeof(size_t));
+        coco_free_memory(solutions->y1);
+        coco_free_memory(solutions->y2);
+        coco_free_memory(solutions->text_offsets);
+        coco_free_memory(solutions->text_lengths);
+      }
+      solutions->y1 = y1;
+      solutions->y2 = y2;
+      solutions->text_offsets = offsets;
+      solutions->text_lengths = lengths;
+      solutions->capacity = capacity;
+    }
+    solutions->y1[solutions->number_of_solutions] = y[0];
+    solutions->y2[solutions->number_of_solutions] = y[1];
+    solutions->text_offsets[solutions->number_of_solutions] = offset;
+    /* The text includes the end-of-line character (if any) */
+    solutions->text_lengths[solutions->number_of_solutions] = next_offset - offset;
+    solutions->number_of_solutions++;
+  }
+}
+
+/**
+ * @brief Rounds the objective values of the solutions to the given precision in the normalized objective
+ * space of the archive.
+ */
+static void coco_archive_merge_thin(const coco_archive_t *archive,
+                                    coco_archive_merge_solutions_t *solutions,
+                                    const double precision) {
+  double range[2];
+  size_t i;
+
+  range[0] = archive->nadir[0] - archive->ideal[0];
+  range[1] = archive->nadir[1] - archive->ideal[1];
+  for (i = 0; i < solutions->number_of_solutions; i++) {
+    solutions->y1[i] = archive->ideal[0]
+        + coco_double_round((solutions->y1[i] - archive->ideal[0]) / range[0] / precision) * precision * range[0];
+    solutions->y2[i] = archive->ideal[1]
+        + coco_double_round((solutions->y2[i] - archive->ideal[1]) / range[1] / precision) * precision * range[1];
+  }
+}
+
+/**
+ * @brief Writes the solutions of the archive to the output file of the problem instance (the output is
+ * appended to an existing file).
+ */
+static void coco_archive_merge_write(coco_archive_merge_t *merger,
+                                     coco_archive_merge_problem_t *problem,
+                                     coco_archive_t *archive) {
+  char file_name[COCO_PATH_MAX + 1] = "";
+  char *base_name;
+  const char *text, *token;
+  size_t text_length, token_length;
+  FILE *file;
+  int i;
+
+  base_name = coco_strdupf("%s_nondominated.adat", problem->name);
+  coco_join_path(file_name, sizeof(file_name), merger->output_folder, base_name, NULL);
+  coco_free_memory(base_name);
+
+  file = fopen(file_name, "a");
+  if (file == NULL) {
+    coco_error("coco_archive_merge(): failed to open file %s", file_name);
+    return; /* Never reached */
+  }
+  fprintf(file, "%% instance = %lu\n%%\n", (unsigned long) problem->instance);
+  while (strcmp(text = coco_archive_get_next_solution_text(archive), "") != 0) {
+    text_length = strlen(text);
+    if (merger->crop_variables) {
+      /* Output only the evaluation number and the objective values */
+      token = coco_archive_merge_next_token(text, text + text_length, &token_length);
+      for (i = 0; i < 3; i++) {
+        if (i > 0)
+          fputc('\t', file);
+        fprintf(file, "%.*s", (int) token_length, token);
+        token = coco_archive_merge_next_token(token + token_length, text + text_length, &token_length);
+      }
+      fputc('\n', file);
+    } else {
+      fputs(text, file);
+      if ((text_length == 0) || (text[text_length - 1] != '\n'))
+        fputc('\n', file);
+    }
+  }
+  fclose(file);
+}
+
+/**
+ * @brief Merges the archives of the problem instances from the queue of the merger until the queue is empty.
+ */
+static void coco_archive_merge_work(coco_archive_merge_t *merger) {
+  coco_archive_merge_problem_t *problem;
+  coco_archive_merge_solutions_t solutions;
+  coco_archive_t *archive;
+  const char *suite_name;
+  size_t i;
+
+  solutions.y1 = NULL;
+  solutions.y2 = NULL;
+  solutions.text_offsets = NULL;
+  solutions.text_lengths = NULL;
+  solutions.capacity = 0;
+
+  while (1) {
+    coco_archive_merge_lock(merger);
+    if (merger->next_problem >= merger->number_of_problems) {
+      coco_archive_merge_unlock(merger);
+      break;
+    }
+    problem = merger->queue[merger->next_problem++];
+    /* The archives of the bbob-biobj-ext suite are named as those of the bbob-biobj suite */
+    suite_name = problem->suite_name;
+    if ((strcmp(suite_name, "bbob-biobj") == 0) && (problem->function >= 56) && (problem->function <= 92))
+      suite_name = "bbob-biobj-ext";
+    archive = coco_archive(suite_name, problem->function, problem->dimension, problem->instance);
+    coco_archive_merge_unlock(merger);
+
+    /* Parts are added one by one so that all solutions point into the same file */
+    for (i = 0; i < problem->number_of_parts; i++) {
+      solutions.number_of_solutions = 0;
+      coco_archive_merge_parse_part(&problem->parts[i], &solutions);
+      if (merger->thinning_precision > 0)
+        coco_archive_merge_thin(archive, &solutions, merger->thinning_precision);
+      coco_archive_add_text_solutions(archive, solutions.number_of_solutions, solutions.y1, solutions.y2,
+          problem->parts[i].file->contents, solutions.text_offsets, solutions.text_lengths);
+    }
+
+    problem->hypervolume = coco_archive_get_hypervolume(archive);
+    problem->number_of_solutions = coco_archive_get_number_of_solutions(archive);
+    coco_archive_merge_write(merger, problem, archive);
+    coco_archive_free(archive);
+  }
+
+  if (solutions.capacity > 0) {
+    coco_free_memory(solutions.y1);
+    coco_free_memory(solutions.y2);
+    coco_free_memory(solutions.text_offsets);
+    coco_free_memory(solutions.text_lengths);
+  }
+}
+
+#if defined(HAVE_PTHREAD)
+/**
+ * @brief The function run by each thread.
+ */
+static void *coco_archive_merge_thread(void *merger) {
+  coco_archive_merge_work((coco_archive_merge_t *) merger);
+  return NULL;
+}
+#elif defined(HAVE_WIN_THREADS)
+/**
+ * @brief The function run by each thread.
+ */
+static DWORD WINAPI coco_archive_merge_thread(LPVOID merger) {
+  coco_archive_merge_work((coco_archive_merge_t *) merger);
+  return 0;
+}
+#endif
+
+/**
+ * @brief Orders the problem instances by decreasing size (and otherwise by name).
+ */
+static int coco_archive_merge_compare_by_size(const void *a, const void *b) {
+  const coco_archive_merge_problem_t *problem1 = *(const coco_archive_merge_problem_t * const *) a;
+  const coco_archive_merge_problem_t *problem2 = *(const coco_archive_merge_problem_t * const *) b;
+
+  if (problem1->size != problem2->size)
+    return (problem1->size > problem2->size) ? -1 : 1;
+  return strcmp(problem1->name, problem2->name);
+}
+
+/**
+ * @brief A problem instance name and its best known hypervolume value.
+ */
+typedef struct {
+  char *name;                 /**< @brief The name of the problem instance. */
+  double value;               /**< @brief The best known hypervolume value. */
+} coco_archive_merge_best_value_t;
+
+/**
+ * @brief Orders the best values by name.
+ */
+static int coco_archive_merge_compare_best_values(const void *a, const void *b) {
+  return strcmp(((const coco_archive_merge_best_value_t *) a)->name,
+      ((const coco_archive_merge_best_value_t *) b)->name);
+}
+
+/**
+ * @brief Reads the best hypervolume values from a file formatted as the C source files with best values
+ * (the values are read from the line after the first line starting with "static" until the line starting
+ * with "};").
+ *
+ * @return The best values (the caller is responsible for freeing them) or NULL if the file cannot be read.
+ */
+static coco_archive_merge_best_value_t *coco_archive_merge_read_best_values(const char *file_name,
+                                                                            size_t *number_of_values) {
+  coco_archive_merge_best_value_t *values = NULL, *new_values;
+  char line[COCO_PATH_MAX + 1], name[COCO_PATH_MAX + 1];
+  size_t capacity = 0;
+  double value;
+  int read = 0;
+  FILE *file;
+
+  *number_of_values = 0;
+  file = fopen(file_name, "r");
+  if (file == NULL)
+    return NULL;
+  while (fgets(line, sizeof(line), file) != NULL) {
+    if (!read) {
+      read = (strncmp(line, "static", 6) == 0);
+      continue;
+    }
+    if (strncmp(line, "};", 2) == 0)
+      break;
+    if ((strchr(line, '"') == NULL) || (sscanf(strchr(line, '"') + 1, "%s %lf", name, &value) != 2))
+      continue;
+    if (*number_of_values == capacity) {
+      capacity = (capacity == 0) ? 1024 : 2 * capacity;
+      new_values = (coco_archive_merge_best_value_t *) coco_allocate_memory(capacity * sizeof(*new_values));
+      if (*number_of_values > 0) {
+        memcpy(new_values, values, *number_of_values * sizeof(*new_values));
+        coco_free_memory(values);
+      }
+      values = new_values;
+    }
+    values[*number_of_values].name = coco_strdup(name);
+    values[*number_of_values].value = value;
+    (*number_of_values)++;
+  }
+  fclose(file);
+  return values;
+}
+
+/**
+ * @brief Appends the best hypervolume values (the old ones updated with the new ones) to the file in the format
+ * of the C source files with best values.
+ *
+ * A new value replaces the old one if it is larger or if the old value equals 1 (which marks unknown values).
+ */
+static void coco_archive_merge_write_best_values(const char *file_name,
+                                                 const char *old_file_name,
+                                                 coco_archive_merge_problem_t *problems,
+                                                 const size_t number_of_problems) {
+  coco_archive_merge_best_value_t *old_values = NULL, *values, *old_value;
+  size_t number_of_old_values = 0, number_of_values, i;
+  char time_string[30];
+  time_t now;
+  FILE *file;
+
+  if ((old_file_name != NULL) && (strlen(old_file_name) > 0)) {
+    old_values = coco_archive_merge_read_best_values(old_file_name, &number_of_old_values);
+    if (old_values == NULL)
+      coco_warning("coco_archive_merge(): cannot read best values from %s, continuing nevertheless",
+          old_file_name);
+    else
+      qsort(old_values, number_of_old_values, sizeof(*old_values), coco_archive_merge_compare_best_values);
+  }
+
+  values = (coco_archive_merge_best_value_t *) coco_allocate_memory((number_of_old_values + number_of_problems + 1)
+      * sizeof(*values));
+  number_of_values = 0;
+  for (i = 0; i < number_of_old_values; i++)
+    values[number_of_values++] = old_values[i];
+  for (i = 0; i < number_of_problems; i++) {
+    values[number_of_values].name = problems[i].name;
+    values[number_of_values].value = problems[i].hypervolume;
+    old_value = NULL;
+    if (number_of_old_values > 0)
+      old_value = (coco_archive_merge_best_value_t *) bsearch(&values[number_of_values], old_values,
+          number_of_old_values, sizeof(*old_values), coco_archive_merge_compare_best_values);
+    if (old_value == NULL) {
+      number_of_values++;
+      continue;
+    }
+    /* Update the old value (in the copy) */
+    if (problems[i].hypervolume > old_value->value)
+      coco_info("%s HV improved by %.15f", problems[i].name, problems[i].hypervolume - old_value->value);
+    if ((fabs(old_value->value - 1) < 1e-8) || (problems[i].hypervolume > old_value->value))
+      values[old_value - old_values].value = problems[i].hypervolume;
+  }
+  qsort(values, number_of_values, sizeof(*values), coco_archive_merge_compare_best_values);
+
+  file = fopen(file_name, "a");
+  if (file == NULL) {
+    coco_error("coco_archive_merge(): failed to open file %s", file_name);
+    return; /* Never reached */
+  }
+  now = time(NULL);
+  strftime(time_string, sizeof(time_string), "%d.%m.%Y %H:%M:%S", gmtime(&now));
+  fprintf(file, "/* Best values on %s */\n", time_string);
+  for (i = 0; i < number_of_values; i++)
+    fprintf(file, "  \"%s %.15f\",\n", values[i].name, values[i].value);
+  fclose(file);
+
+  for (i = 0; i < number_of_old_values; i++)
+    coco_free_memory(old_values[i].name);
+  if (old_values != NULL)
+    coco_free_memory(old_values);
+  coco_free_memory(values);
+}
+
+/**
+ * The archive files are split into the parts of the problem instances (see the file name requirements
+ * below) and the solutions of each problem instance are merged into an archive, which always contains the
+ * two extreme solutions and all non-dominated solutions. The archive of each problem instance is appended
+ * to the file SUITE_fFUNCTION_iINSTANCE_dDIMENSION_nondominated.adat in the output folder.
+ *
+ * The names of the archive files need to be in one of the following forms:
+ * - SUITE_fFUNCTION_iINSTANCE_dDIMENSION_*.adat: the file holds the solutions of one instance (all comment
+ * lines are ignored)
+ * - SUITE_fFUNCTION_dDIMENSION_*.adat: the solutions of each instance follow a comment line containing
+ * "instance = INSTANCE"
+ *
+ * Possible options:
+ *
+ * - "number_of_threads: VALUE" determines the number of threads merging the archives (only used if the
+ * code has been compiled with COCO_THREADS). The default value is 1.
+ *
+ * - "crop_variables: VALUE" determines whether the variables are omitted from the output (1) or not (0).
+ * The default value is 0.
+ *
+ * - "thinning_precision: VALUE" determines the precision in the normalized objective space to which the
+ * objective values are rounded before they are added to the archive (the output keeps the original text).
+ * The default value is 0 (no thinning).
+ *
+ * - "hyp_file: PATH" determines the file to which the hypervolume values of the merged archives are
+ * appended in the format of the C source files with best values. No file is written by default.
+ *
+ * - "best_values_file: PATH" determines the C source file with the best hypervolume values that are
+ * updated with the hypervolume values of the merged archives and written to the hyp_file. By default,
+ * only the values of the merged archives are written.
+ *
+ * @param number_of_files The number of archive files.
+ * @param file_names The names of the archive files.
+ * @param output_folder The folder of the merged archives (created if it does not exist).
+ * @param options The options.
+ *
+ * @return The number of merged problem instances.
+ */
+size_t coco_archive_merge(const size_t number_of_files,
+                          const char **file_names,
+                          const char *output_folder,
+                          const char *options) {
+  coco_archive_merge_t merger;
+  coco_archive_merge_file_t *files;
+  coco_archive_merge_problem_t *problems = NULL;
+  size_t number_of_problems = 0, capacity = 0, number_of_threads = 1, i;
+  char hyp_file_name[COCO_PATH_MAX + 1] = "", best_values_file_name[COCO_PATH_MAX + 1] = "";
+#if defined(HAVE_PTHREAD)
+  pthread_t *threads;
+#elif defined(HAVE_WIN_THREADS)
+  HANDLE *threads;
+#endif
+
+  merger.crop_variables = 0;
+  merger.thinning_precision = 0;
+  if (coco_options_read_size_t(options, "number_of_threads", &number_of_threads) != 0) {
+    if (number_of_threads == 0)
+      number_of_threads = 1;
+  }
+  coco_options_read_int(options, "crop_variables", &merger.crop_variables);
+  coco_options_read_double(options, "thinning_precision", &merger.thinning_precision);
+  coco_options_read_string(options, "hyp_file", hyp_file_name);
+  coco_options_read_string(options, "best_values_file", best_values_file_name);
+
+  /* Read the files and split them into the parts of the problem instances */
+  files = (coco_archive_merge_file_t *) coco_allocate_memory((number_of_files + 1) * sizeof(*files));
+  for (i = 0; i < number_of_files; i++) {
+    if (!coco_archive_merge_file_open(&files[i], file_names[i])) {
+      coco_warning("coco_archive_merge(): skipping file %s, which cannot be read or is empty", file_names[i]);
+      continue;
+    }
+    if (!coco_archive_merge_split_file(&files[i], &problems, &number_of_problems, &capacity))
+      coco_warning("coco_archive_merge(): skipping file %s, whose name is not in the expected format "
+          "SUITE_fFUNCTION_dDIMENSION_*.* or SUITE_fFUNCTION_iINSTANCE_dDIMENSION_*.*", file_names[i]);
+  }
+  coco_info("coco_archive_merge(): read %lu files with %lu problem instances", (unsigned long) number_of_files,
+      (unsigned long) number_of_problems);
+
+  /* Merge the archives, the largest ones first */
+  coco_create_directory(output_folder);
+  merger.queue = (coco_archive_merge_problem_t **) coco_allocate_memory((number_of_problems + 1)
+      * sizeof(*merger.queue));
+  for (i = 0; i < number_of_problems; i++)
+    merger.queue[i] = &problems[i];
+  qsort(merger.queue, number_of_problems, sizeof(*merger.queue), coco_archive_merge_compare_by_size);
+  merger.number_of_problems = number_of_problems;
+  merger.next_problem = 0;
+  merger.output_folder = output_folder;
+  merger.is_parallel = 0;
+
+  if (number_of_threads <= 1) {
+    coco_archive_merge_work(&merger);
+  } else {
+#if defined(HAVE_PTHREAD)
+    pthread_mutex_init(&merger.mutex, NULL);
+    merger.is_parallel = 1;
+    threads = (pthread_t *) coco_allocate_memory(number_of_threads * sizeof(pthread_t));
+    for (i = 0; i < number_of_threads; i++) {
+      if (pthread_create(&threads[i], NULL, coco_archive_merge_thread, &merger) != 0)
+        coco_error("coco_archive_merge(): failed to create thread %lu", (unsigned long) i);
+    }
+    for (i = 0; i < number_of_threads; i++)
+      pthread_join(threads[i], NULL);
+    coco_free_memory(threads);
+    pthread_mutex_destroy(&merger.mutex);
+#elif defined(HAVE_WIN_THREADS)
+    InitializeCriticalSection(&merger.mutex);
+    merger.is_parallel = 1;
+    threads = (HANDLE *) coco_allocate_memory(number_of_threads * sizeof(HANDLE));
+    for (i = 0; i < number_of_threads; i++) {
+      threads[i] = CreateThread(NULL, 0, coco_archive_merge_thread, &merger, 0, NULL);
+      if (threads[i] == NULL)
+        coco_error("coco_archive_merge(): failed to create thread %lu", (unsigned long) i);
+    }
+    for (i = 0; i < number_of_threads; i++) {
+      WaitForSingleObject(threads[i], INFINITE);
+      CloseHandle(threads[i]);
+    }
+    coco_free_memory(threads);
+    DeleteCriticalSection(&merger.mutex);
+#else
+    coco_info("coco_archive_merge(): compiled without COCO_THREADS, merging the archives sequentially");
+    coco_archive_merge_work(&merger);
+#endif
+  }
+
+  for (i = 0; i < number_of_problems; i++)
+    coco_info("%s: %.15f", problems[i].name, problems[i].hypervolume);
+  if (strlen(hyp_file_name) > 0)
+    coco_archive_merge_write_best_values(hyp_file_name, best_values_file_name, problems, number_of_problems);
+
+  for (i = 0; i < number_of_problems; i++) {
+    coco_free_memory(problems[i].name);
+    coco_free_memory(problems[i].suite_name);
+    coco_free_memory(problems[i].parts);
+  }
+  if (problems != NULL)
+    coco_free_memory(problems);
+  coco_free_memory(merger.queue);
+  for (i = 0; i < number_of_files; i++)
+    coco_archive_merge_file_close(&files[i]);
+  coco_free_memory(files);
+  return number_of_problems;
+}
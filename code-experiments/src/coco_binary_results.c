@@ -0,0 +1,608 @@
+/**
+ * @file coco_binary_results.c
+ * @brief Implementation of the binary format of the data files of the bbob logger ("bbob-binary").
+ *
+ * In the "bbob-binary" data format, the .dat, .tdat and .rdat files contain the same information as in the
+ * text format "bbob-new2", but the values are stored in binary form (without rounding) and by column, so
+ * that they can be read without parsing. A file consists of a file header followed by blocks of rows. Each
+ * logged run (the runs that are separated by a header line in the text format) starts with a new block.
+ * The rows of a run are written in blocks of at most COCO_BINARY_RESULTS_ROWS_PER_BLOCK rows while it is
+ * logged, so that the memory used by the logger is bounded and the rows of an interrupted run are kept up
+ * to the last written block. Blocks that continue the run of the previous block are marked with
+ * COCO_BINARY_RESULTS_CONTINUATION.
+ *
+ * All numbers are stored in little-endian byte order, integers as unsigned 64-bit values and reals as
+ * IEEE 754 doubles. The file header consists of the magic string "COCOBDAT" and the version of the format
+ * (COCO_BINARY_RESULTS_VERSION, 64-bit). Each block consists of the fields of coco_binary_results_header_t
+ * (16 64-bit values, see coco_binary_results_header_field_t), where the offsets are the positions of the
+ * columns relative to the start of the block, followed by the columns:
+ * - the numbers of function evaluations (number_of_rows integers),
+ * - the numbers of constraint evaluations (number_of_rows integers),
+ * - the function values (number_of_rows doubles),
+ * - the best function values (number_of_rows doubles),
+ * - whether the row contains constraint values (number_of_rows bytes),
+ * - the single-digit constraint values (number_of_rows * number_of_constraints bytes, padded to a multiple
+ * of 8 bytes together with the previous column) and
+ * - the values of the variables (number_of_rows * number_of_logged_variables doubles).
+ *
+ * Version 1 of the format had no continuation blocks (the flags were always 0) and is still read.
+ *
+ * coco_binary_results_to_text converts a file back to the text format, giving exactly the same text as
+ * written by the logger in the text format.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+#include "coco.h"
+#include "coco_utilities.c"
+#include "coco_writer.c"
+
+/** @brief The magic string at the start of a file in the "bbob-binary" format. */
+#define COCO_BINARY_RESULTS_MAGIC "COCOBDAT"
+
+/** @brief The version of the "bbob-binary" format. */
+#define COCO_BINARY_RESULTS_VERSION 2
+
+/** @brief The maximal number of rows of a block written by the logger. */
+#define COCO_BINARY_RESULTS_ROWS_PER_BLOCK 256
+
+/** @brief The flag of a block that continues the run of the previous block (no header line in the text). */
+#define COCO_BINARY_RESULTS_CONTINUATION 1
+
+/**
+ * @brief The fields of the header of a block (in the order in which they are stored).
+ */
+typedef enum {
+  COCO_BINARY_RESULTS_BLOCK_SIZE,         /**< @brief The size of the block in bytes. */
+  COCO_BINARY_RESULTS_NUMBER_OF_ROWS,     /**< @brief The number of rows. */
+  COCO_BINARY_RESULTS_NUMBER_OF_VARIABLES,/**< @brief The number of variables of the problem. */
+  COCO_BINARY_RESULTS_NUMBER_OF_INTEGER_VARIABLES, /**< @brief The number of integer variables. */
+  COCO_BINARY_RESULTS_NUMBER_OF_LOGGED_VARIABLES,  /**< @brief The number of variables in each row. */
+  COCO_BINARY_RESULTS_NUMBER_OF_CONSTRAINTS,       /**< @brief The number of constraints. */
+  COCO_BINARY_RESULTS_LOG_DISCRETE_AS_INT,         /**< @brief Whether integer variables are logged as int. */
+  COCO_BINARY_RESULTS_OPTIMAL_VALUE,      /**< @brief The optimal function value (a double). */
+  COCO_BINARY_RESULTS_OFFSET_F_EVALUATIONS,        /**< @brief The offset of the function evaluations. */
+  COCO_BINARY_RESULTS_OFFSET_G_EVALUATIONS,        /**< @brief The offset of the constraint evaluations. */
+  COCO_BINARY_RESULTS_OFFSET_FVALUES,     /**< @brief The offset of the function values. */
+  COCO_BINARY_RESULTS_OFFSET_BEST_FVALUES,/**< @brief The offset of the best function values. */
+  COCO_BINARY_RESULTS_OFFSET_HAS_CONSTRAINTS,      /**< @brief The offset of the constraint flags. */
+  COCO_BINARY_RESULTS_OFFSET_CONSTRAINTS, /**< @brief The offset of the constraint values. */
+  COCO_BINARY_RESULTS_OFFSET_X,           /**< @brief The offset of the variables. */
+  COCO_BINARY_RESULTS_FLAGS,              /**< @brief The flags (COCO_BINARY_RESULTS_CONTINUATION or 0). */
+  COCO_BINARY_RESULTS_HEADER_FIELDS       /**< @brief The number of fields. */
+} coco_binary_results_header_field_t;
+
+/**
+ * @brief The rows of one block of a logged run, stored by column.
+ *
+ * A block that is being logged has the name of the file to which its rows are appended. When the block is
+ * full, its rows are written and it continues with the next rows of the run.
+ */
+typedef struct {
+  char *file_name;                   /**< @brief The file of the rows (NULL if the block was read). */
+  int is_continuation;               /**< @brief Whether the rows continue the run of an earlier block. */
+  size_t number_of_rows;             /**< @brief The number of rows. */
+  size_t capacity;                   /**< @brief The number of rows for which memory is allocated. */
+  size_t number_of_variables;        /**< @brief The number of variables of the problem. */
+  size_t number_of_integer_variables;/**< @brief The number of integer variables of the problem. */
+  size_t number_of_logged_variables; /**< @brief The number of variables in each row. */
+  size_t number_of_constraints;      /**< @brief The number of constraints. */
+  int log_discrete_as_int;           /**< @brief Whether integer variables are logged as int. */
+  double optimal_value;              /**< @brief The optimal function value. */
+  size_t *f_evaluations;             /**< @brief The numbers of function evaluations. */
+  size_t *g_evaluations;             /**< @brief The numbers of constraint evaluations. */
+  double *fvalues;                   /**< @brief The function values. */
+  double *best_fvalues;              /**< @brief The best function values. */
+  unsigned char *has_constraints;    /**< @brief Whether the rows contain constraint values. */
+  unsigned char *constraints;        /**< @brief The single-digit constraint values. */
+  double *x;                         /**< @brief The values of the variables. */
+} coco_binary_results_block_t;
+
+/**
+ * @brief Allocates an empty block for a run whose rows are appended to the file with the given name (NULL if
+ * the rows are not written).
+ *
+ * The variables are logged (as in the text format) only if there are less than 22 non-integer variables.
+ */
+static coco_binary_results_block_t *coco_binary_results_block_allocate(const char *file_name,
+                                                                      const size_t number_of_variables,
+                                                                      const size_t number_of_integer_variables,
+                                                                      const size_t number_of_constraints,
+                                                                      const int log_discrete_as_int,
+                                                                      const double optimal_value) {
+  coco_binary_results_block_t *block;
+
+  block = (coco_binary_results_block_t *) coco_allocate_memory(sizeof(*block));
+  block->file_name = (file_name != NULL) ? coco_strdup(file_name) : NULL;
+  block->is_continuation = 0;
+  block->number_of_rows = 0;
+  block->capacity = 0;
+  block->number_of_variables = number_of_variables;
+  block->number_of_integer_variables = number_of_integer_variables;
+  block->number_of_logged_variables =
+      ((number_of_variables - number_of_integer_variables) < 22) ? number_of_variables : 0;
+  block->number_of_constraints = number_of_constraints;
+  block->log_discrete_as_int = log_discrete_as_int;
+  block->optimal_value = optimal_value;
+  block->f_evaluations = NULL;
+  block->g_evaluations = NULL;
+  block->fvalues = NULL;
+  block->best_fvalues = NULL;
+  block->has_constraints = NULL;
+  block->constraints = NULL;
+  block->x = NULL;
+  return block;
+}
+
+/**
+ * @brief Frees the block.
+ */
+static void coco_binary_results_block_free(coco_binary_results_block_t *block) {
+  if (block == NULL)
+    return;
+  if (block->file_name != NULL)
+    coco_free_memory(block->file_name);
+  if (block->capacity > 0) {
+    coco_free_memory(block->f_evaluations);
+    coco_free_memory(block->g_evaluations);
+    coco_free_memory(block->fvalues);
+    coco_free_memory(block->best_fvalues);
+    coco_free_memory(block->has_constraints);
+    if (block->constraints != NULL)
+      coco_free_memory(block->constraints);
+    if (block->x != NULL)
+      coco_free_memory(block->x);
+  }
+  coco_free_memory(block);
+}
+
+/**
+ * @brief Returns a copy of the memory with the given new size (the old memory is freed).
+ */
+static void *coco_binary_results_reallocate(void *data, const size_t old_size, const size_t new_size) {
+  void *new_data = coco_allocate_memory(new_size);
+  if (old_size > 0) {
+    memcpy(new_data, data, old_size);
+    coco_free_memory(data);
+  }
+  return new_data;
+}
+
+/**
+ * @brief Sets the capacity of the block (in rows) to the given number, which must be larger than the
+ * current capacity.
+ */
+static void coco_binary_results_block_reserve(coco_binary_results_block_t *block, const size_t capacity) {
+  const size_t m = block->number_of_constraints;
+  const size_t n = block->number_of_logged_variables;
+  const size_t old = block->capacity;
+
+  assert(capacity > old);
+  block->f_evaluations = (size_t *) coco_binary_results_reallocate(block->f_evaluations,
+      old * sizeof(size_t), capacity * sizeof(size_t));
+  block->g_evaluations = (size_t *) coco_binary_results_reallocate(block->g_evaluations,
+      old * sizeof(size_t), capacity * sizeof(size_t));
+  block->fvalues = (double *) coco_binary_results_reallocate(block->fvalues,
+      old * sizeof(double), capacity * sizeof(double));
+  block->best_fvalues = (double *) coco_binary_results_reallocate(block->best_fvalues,
+      old * sizeof(double), capacity * sizeof(double));
+  block->has_constraints = (unsigned char *) coco_binary_results_reallocate(block->has_constraints,
+      old, capacity);
+  if (m > 0)
+    block->constraints = (unsigned char *) coco_binary_results_reallocate(block->constraints,
+        old * m, capacity * m);
+  if (n > 0)
+    block->x = (double *) coco_binary_results_reallocate(block->x,
+        old * n * sizeof(double), capacity * n * sizeof(double));
+  block->capacity = capacity;
+}
+
+static void coco_binary_results_block_flush(coco_binary_results_block_t *block);
+
+/**
+ * @brief Appends a row to the block.
+ *
+ * The arguments are the same as those of logger_bbob_write_data. If constraint_digits is NULL, the row
+ * contains the best function value instead of the constraint values (as the last line of a .tdat file).
+ * The rows are written to the file once there are COCO_BINARY_RESULTS_ROWS_PER_BLOCK of them.
+ */
+static void coco_binary_results_block_append(coco_binary_results_block_t *block,
+                                             const size_t number_of_f_evaluations,
+                                             const size_t number_of_cons_evaluations,
+                                             const double fvalue,
+                                             const double best_fvalue,
+                                             const double *x,
+                                             const unsigned char *constraint_digits) {
+  const size_t row = block->number_of_rows;
+  const size_t m = block->number_of_constraints;
+  const size_t n = block->number_of_logged_variables;
+
+  if (row == block->capacity)
+    coco_binary_results_block_reserve(block, (block->capacity == 0) ? 16 : 2 * block->capacity);
+  block->f_evaluations[row] = number_of_f_evaluations;
+  block->g_evaluations[row] = number_of_cons_evaluations;
+  block->fvalues[row] = fvalue;
+  block->best_fvalues[row] = best_fvalue;
+  block->has_constraints[row] = (unsigned char) ((constraint_digits != NULL) && (m > 0));
+  if (m > 0) {
+    if (constraint_digits != NULL)
+      memcpy(block->constraints + row * m, constraint_digits, m);
+    else
+      memset(block->constraints + row * m, 0, m);
+  }
+  if (n > 0)
+    memcpy(block->x + row * n, x, n * sizeof(double));
+  block->number_of_rows++;
+  if ((block->file_name != NULL) && (block->number_of_rows == COCO_BINARY_RESULTS_ROWS_PER_BLOCK))
+    coco_binary_results_block_flush(block);
+}
+
+/**
+ * @brief Stores the value as an unsigned 64-bit little-endian integer at the given position.
+ */
+static void coco_binary_results_put_integer(unsigned char *position, size_t value) {
+  size_t i;
+  for (i = 0; i < 8; i++) {
+    position[i] = (unsigned char) (value & 0xFF);
+    /* Two shifts, as shifting by the full width of size_t (if it has 32 bits) is undefined */
+    value = (value >> 4) >> 4;
+  }
+}
+
+/**
+ * @brief Returns the unsigned 64-bit little-endian integer at the given position.
+ *
+ * Calls coco_error if the value does not fit into size_t.
+ */
+static size_t coco_binary_results_get_integer(const unsigned char *position) {
+  size_t value = 0, i;
+  for (i = 8; i > 0; i--) {
+    if (((value << 4) << 4) >> 8 != value)
+      coco_error("coco_binary_results_get_integer(): the value does not fit into size_t");
+    value = ((value << 4) << 4) | position[i - 1];
+  }
+  return value;
+}
+
+/**
+ * @brief Stores the double in little-endian byte order at the given position.
+ */
+static void coco_binary_results_put_double(unsigned char *position, const double value) {
+  uint64_t bits;
+  size_t i;
+
+  assert(sizeof(double) == sizeof(uint64_t));
+  memcpy(&bits, &value, sizeof(double));
+  for (i = 0; i < 8; i++) {
+    position[i] = (unsigned char) (bits & 0xFF);
+    bits >>= 8;
+  }
+}
+
+/**
+ * @brief Returns the double stored in little-endian byte order at the given position.
+ */
+static double coco_binary_results_get_double(const unsigned char *position) {
+  uint64_t bits = 0;
+  double value;
+  size_t i;
+
+  for (i = 8; i > 0; i--)
+    bits = (bits << 8) | position[i - 1];
+  memcpy(&value, &bits, sizeof(double));
+  return value;
+}
+
+/**
+ * @brief Returns the size of the block in bytes and computes the offsets of its columns.
+ */
+static size_t coco_binary_results_block_layout(const size_t number_of_rows,
+                                               const size_t number_of_constraints,
+                                               const size_t number_of_logged_variables,
+                                               size_t *offsets) {
+  size_t position = 8 * COCO_BINARY_RESULTS_HEADER_FIELDS;
+
+  offsets[COCO_BINARY_RESULTS_OFFSET_F_EVALUATIONS] = position;
+  position += 8 * number_of_rows;
+  offsets[COCO_BINARY_RESULTS_OFFSET_G_EVALUATIONS] = position;
+  position += 8 * number_of_rows;
+  offsets[COCO_BINARY_RESULTS_OFFSET_FVALUES] = position;
+  position += 8 * number_of_rows;
+  offsets[COCO_BINARY_RESULTS_OFFSET_BEST_FVALUES] = position;
+  position += 8 * number_of_rows;
+  offsets[COCO_BINARY_RESULTS_OFFSET_HAS_CONSTRAINTS] = position;
+  position += number_of_rows;
+  offsets[COCO_BINARY_RESULTS_OFFSET_CONSTRAINTS] = position;
+  position += number_of_rows * number_of_constraints;
+  position = (position + 7) / 8 * 8;
+  offsets[COCO_BINARY_RESULTS_OFFSET_X] = position;
+  position += 8 * number_of_rows * number_of_logged_variables;
+  return position;
+}
+
+/**
+ * @brief Appends the block to the file with the given name (the file header is written if the file is new).
+ */
+static void coco_binary_results_block_write(const coco_binary_results_block_t *block, const char *file_name) {
+  const size_t m = block->number_of_constraints;
+  const size_t n = block->number_of_logged_variables;
+  size_t offsets[COCO_BINARY_RESULTS_HEADER_FIELDS] = { 0 };
+  unsigned char file_header[16];
+  unsigned char *data, *position;
+  size_t size, i;
+  FILE *file;
+
+  size = coco_binary_results_block_layout(block->number_of_rows, m, n, offsets);
+  data = (unsigned char *) coco_allocate_memory(size);
+  memset(data, 0, size);
+
+  offsets[COCO_BINARY_RESULTS_BLOCK_SIZE] = size;
+  offsets[COCO_BINARY_RESULTS_NUMBER_OF_ROWS] = block->number_of_rows;
+  offsets[COCO_BINARY_RESULTS_NUMBER_OF_VARIABLES] = block->number_of_variables;
+  offsets[COCO_BINARY_RESULTS_NUMBER_OF_INTEGER_VARIABLES] = block->number_of_integer_variables;
+  offsets[COCO_BINARY_RESULTS_NUMBER_OF_LOGGED_VARIABLES] = n;
+  offsets[COCO_BINARY_RESULTS_NUMBER_OF_CONSTRAINTS] = m;
+  offsets[COCO_BINARY_RESULTS_LOG_DISCRETE_AS_INT] = (size_t) block->log_discrete_as_int;
+  offsets[COCO_BINARY_RESULTS_FLAGS] = block->is_continuation ? COCO_BINARY_RESULTS_CONTINUATION : 0;
+  for (i = 0; i < COCO_BINARY_RESULTS_HEADER_FIELDS; i++) {
+    if (i == COCO_BINARY_RESULTS_OPTIMAL_VALUE)
+      coco_binary_results_put_double(data + 8 * i, block->optimal_value);
+    else
+      coco_binary_results_put_integer(data + 8 * i, offsets[i]);
+  }
+
+  for (i = 0; i < block->number_of_rows; i++) {
+    coco_binary_results_put_integer(data + offsets[COCO_BINARY_RESULTS_OFFSET_F_EVALUATIONS] + 8 * i,
+        block->f_evaluations[i]);
+    coco_binary_results_put_integer(data + offsets[COCO_BINARY_RESULTS_OFFSET_G_EVALUATIONS] + 8 * i,
+        block->g_evaluations[i]);
+    coco_binary_results_put_double(data + offsets[COCO_BINARY_RESULTS_OFFSET_FVALUES] + 8 * i,
+        block->fvalues[i]);
+    coco_binary_results_put_double(data + offsets[COCO_BINARY_RESULTS_OFFSET_BEST_FVALUES] + 8 * i,
+        block->best_fvalues[i]);
+  }
+  if (block->number_of_rows > 0) {
+    memcpy(data + offsets[COCO_BINARY_RESULTS_OFFSET_HAS_CONSTRAINTS], block->has_constraints,
+        block->number_of_rows);
+    if (m > 0)
+      memcpy(data + offsets[COCO_BINARY_RESULTS_OFFSET_CONSTRAINTS], block->constraints,
+          block->number_of_rows * m);
+  }
+  position = data + offsets[COCO_BINARY_RESULTS_OFFSET_X];
+  for (i = 0; i < block->number_of_rows * n; i++)
+    coco_binary_results_put_double(position + 8 * i, block->x[i]);
+
+  file = fopen(file_name, "ab");
+  if (file == NULL) {
+    coco_error("coco_binary_results_block_write(): failed to open file %s", file_name);
+    return; /* Never reached */
+  }
+  fseek(file, 0, SEEK_END);
+  if (ftell(file) == 0) {
+    memcpy(file_header, COCO_BINARY_RESULTS_MAGIC, 8);
+    coco_binary_results_put_integer(file_header + 8, COCO_BINARY_RESULTS_VERSION);
+    fwrite(file_header, 1, 16, file);
+  }
+  if (fwrite(data, 1, size, file) != size)
+    coco_error("coco_binary_results_block_write(): failed to write to file %s", file_name);
+  fclose(file);
+  coco_free_memory(data);
+}
+
+/**
+ * @brief Appends the rows of the block to its file and empties the block, which then continues the run.
+ */
+static void coco_binary_results_block_flush(coco_binary_results_block_t *block) {
+  assert(block->file_name != NULL);
+  coco_binary_results_block_write(block, block->file_name);
+  block->number_of_rows = 0;
+  block->is_continuation = 1;
+}
+
+/**
+ * @brief Appends the remaining rows of the block to its file and frees the block.
+ *
+ * A run without rows is written as an empty block, so that its header line is kept.
+ */
+static void coco_binary_results_block_close(coco_binary_results_block_t *block) {
+  if ((block->number_of_rows > 0) || !block->is_continuation)
+    coco_binary_results_block_flush(block);
+  coco_binary_results_block_free(block);
+}
+
+/**
+ * @brief Reads the block at the given position of the contents of a file.
+ *
+ * @return The block or NULL (after a warning) if the data is not a valid block.
+ */
+static coco_binary_results_block_t *coco_binary_results_block_read(const unsigned char *data,
+                                                                   const size_t size) {
+  coco_binary_results_block_t *block;
+  size_t header[COCO_BINARY_RESULTS_HEADER_FIELDS], offsets[COCO_BINARY_RESULTS_HEADER_FIELDS];
+  size_t i, m, n, rows;
+
+  if (size < 8 * COCO_BINARY_RESULTS_HEADER_FIELDS) {
+    coco_warning("coco_binary_results_block_read(): truncated block");
+    return NULL;
+  }
+  for (i = 0; i < COCO_BINARY_RESULTS_HEADER_FIELDS; i++) {
+    if (i != COCO_BINARY_RESULTS_OPTIMAL_VALUE)
+      header[i] = coco_binary_results_get_integer(data + 8 * i);
+  }
+  rows = header[COCO_BINARY_RESULTS_NUMBER_OF_ROWS];
+  m = header[COCO_BINARY_RESULTS_NUMBER_OF_CONSTRAINTS];
+  n = header[COCO_BINARY_RESULTS_NUMBER_OF_LOGGED_VARIABLES];
+  /* Checks the sizes before computing the layout to avoid overflows */
+  if ((rows > size) || (m > size) || (n > size) || (header[COCO_BINARY_RESULTS_BLOCK_SIZE] > size)
+      || (header[COCO_BINARY_RESULTS_NUMBER_OF_VARIABLES] < n)
+      || (header[COCO_BINARY_RESULTS_FLAGS] > COCO_BINARY_RESULTS_CONTINUATION)
+      || (coco_binary_results_block_layout(rows, m, n, offsets) != header[COCO_BINARY_RESULTS_BLOCK_SIZE])) {
+    coco_warning("coco_binary_results_block_read(): invalid block header");
+    return NULL;
+  }
+  for (i = COCO_BINARY_RESULTS_OFFSET_F_EVALUATIONS; i <= COCO_BINARY_RESULTS_OFFSET_X; i++) {
+    if (offsets[i] != header[i]) {
+      coco_warning("coco_binary_results_block_read(): invalid block header");
+      return NULL;
+    }
+  }
+
+  block = coco_binary_results_block_allocate(NULL, header[COCO_BINARY_RESULTS_NUMBER_OF_VARIABLES],
+      header[COCO_BINARY_RESULTS_NUMBER_OF_INTEGER_VARIABLES], m,
+      (int) header[COCO_BINARY_RESULTS_LOG_DISCRETE_AS_INT],
+      coco_binary_results_get_double(data + 8 * COCO_BINARY_RESULTS_OPTIMAL_VALUE));
+  block->number_of_logged_variables = n;
+  block->is_continuation = (header[COCO_BINARY_RESULTS_FLAGS] == COCO_BINARY_RESULTS_CONTINUATION);
+  if (rows == 0)
+    return block;
+
+  coco_binary_results_block_reserve(block, rows);
+  for (i = 0; i < rows; i++) {
+    block->f_evaluations[i] = coco_binary_results_get_integer(data
+        + offsets[COCO_BINARY_RESULTS_OFFSET_F_EVALUATIONS] + 8 * i);
+    block->g_evaluations[i] = coco_binary_results_get_integer(data
+        + offsets[COCO_BINARY_RESULTS_OFFSET_G_EVALUATIONS] + 8 * i);
+    block->fvalues[i] = coco_binary_results_get_double(data + offsets[COCO_BINARY_RESULTS_OFFSET_FVALUES] + 8 * i);
+    block->best_fvalues[i] = coco_binary_results_get_double(data
+        + offsets[COCO_BINARY_RESULTS_OFFSET_BEST_FVALUES] + 8 * i);
+  }
+  memcpy(block->has_constraints, data + offsets[COCO_BINARY_RESULTS_OFFSET_HAS_CONSTRAINTS], rows);
+  if (m > 0)
+    memcpy(block->constraints, data + offsets[COCO_BINARY_RESULTS_OFFSET_CONSTRAINTS], rows * m);
+  for (i = 0; i < rows * n; i++)
+    block->x[i] = coco_binary_results_get_double(data + offsets[COCO_BINARY_RESULTS_OFFSET_X] + 8 * i);
+  block->number_of_rows = rows;
+  return block;
+}
+
+/**
+ * @brief Writes the block in the text format "bbob-new2" (including the header line of the run, unless the
+ * block continues the run of the previous block).
+ *
+ * The header line is given as a format with the optimal value as its only argument.
+ */
+static void coco_binary_results_block_write_text(const coco_binary_results_block_t *block,
+                                                 const char *header_format,
+                                                 coco_writer_t *writer) {
+  const size_t m = block->number_of_constraints;
+  const size_t n = block->number_of_logged_variables;
+  char *header;
+  size_t row, i;
+
+  if (!block->is_continuation) {
+    header = coco_strdupf(header_format, block->optimal_value);
+    coco_writer_write_string(writer, header);
+    coco_free_memory(header);
+  }
+  for (row = 0; row < block->number_of_rows; row++) {
+    coco_writer_write_unsigned_long(writer, (unsigned long) block->f_evaluations[row]);
+    coco_writer_write_char(writer, ' ');
+    coco_writer_write_unsigned_long(writer, (unsigned long) block->g_evaluations[row]);
+    coco_writer_write_char(writer, ' ');
+    coco_writer_write_exponential(writer, block->best_fvalues[row] - block->optimal_value, 10, 9);
+    coco_writer_write_char(writer, ' ');
+    coco_writer_write_exponential(writer, block->fvalues[row], 10, 9);
+    coco_writer_write_char(writer, ' ');
+    if (block->has_constraints[row]) {
+      for (i = 0; i < m; i++)
+        coco_writer_write_int(writer, (int) block->constraints[row * m + i]);
+    } else {
+      coco_writer_write_exponential(writer, block->best_fvalues[row], 10, 9);
+    }
+    for (i = 0; i < n; i++) {
+      coco_writer_write_char(writer, ' ');
+      if ((i < block->number_of_integer_variables) && block->log_discrete_as_int)
+        coco_writer_write_int(writer, coco_double_to_int(block->x[row * n + i]));
+      else
+        coco_writer_write_exponential(writer, block->x[row * n + i], 5, 4);
+    }
+    coco_writer_end_line(writer);
+  }
+}
+
+/**
+ * @brief Reads the whole file into memory and returns its contents (and size) or NULL if it cannot be read.
+ */
+static unsigned char *coco_binary_results_read_file(const char *file_name, size_t *size) {
+  unsigned char *contents;
+  FILE *file;
+  long length;
+
+  file = fopen(file_name, "rb");
+  if (file == NULL)
+    return NULL;
+  if ((fseek(file, 0, SEEK_END) != 0) || ((length = ftell(file)) < 0)) {
+    fclose(file);
+    return NULL;
+  }
+  rewind(file);
+  *size = (size_t) length;
+  contents = (unsigned char *) coco_allocate_memory(*size + 1);
+  if (fread(contents, 1, *size, file) != *size) {
+    coco_free_memory(contents);
+    fclose(file);
+    return NULL;
+  }
+  fclose(file);
+  return contents;
+}
+
+/**
+ * @brief Converts the file in the "bbob-binary" format to the text format "bbob-new2".
+ *
+ * The header line of each run is given as a format with the optimal value as its only argument. Calls
+ * coco_error if the input file cannot be read or is not a valid file in the "bbob-binary" format.
+ *
+ * @return The number of runs in the file (the blocks that do not continue a run).
+ */
+static size_t coco_binary_results_convert(const char *input_file_name,
+                                          const char *output_file_name,
+                                          const char *header_format) {
+  coco_binary_results_block_t *block;
+  coco_writer_t *writer;
+  unsigned char *contents;
+  FILE *output_file;
+  size_t size, position, number_of_blocks = 0, number_of_runs = 0;
+
+  contents = coco_binary_results_read_file(input_file_name, &size);
+  if (contents == NULL) {
+    coco_error("coco_binary_results_convert(): failed to read file %s", input_file_name);
+    return 0; /* Never reached */
+  }
+  if ((size < 16) || (memcmp(contents, COCO_BINARY_RESULTS_MAGIC, 8) != 0)
+      || (coco_binary_results_get_integer(contents + 8) < 1)
+      || (coco_binary_results_get_integer(contents + 8) > COCO_BINARY_RESULTS_VERSION)) {
+    coco_free_memory(contents);
+    coco_error("coco_binary_results_convert(): %s is not a file in the bbob-binary format (version 1 to %d)",
+        input_file_name, COCO_BINARY_RESULTS_VERSION);
+    return 0; /* Never reached */
+  }
+
+  output_file = fopen(output_file_name, "w");
+  if (output_file == NULL) {
+    coco_free_memory(contents);
+    coco_error("coco_binary_results_convert(): failed to open file %s", output_file_name);
+    return 0; /* Never reached */
+  }
+  writer = coco_writer(output_file, COCO_WRITER_FLUSH_END, 0, 0, NULL);
+  for (position = 16; position < size; position += coco_binary_results_get_integer(contents + position)) {
+    block = coco_binary_results_block_read(contents + position, size - position);
+    if (block == NULL) {
+      coco_writer_close(writer);
+      coco_free_memory(contents);
+      coco_error("coco_binary_results_convert(): invalid block %lu in file %s", (unsigned long) number_of_blocks,
+          input_file_name);
+      return 0; /* Never reached */
+    }
+    coco_binary_results_block_write_text(block, header_format, writer);
+    if (!block->is_continuation)
+      number_of_runs++;
+    coco_binary_results_block_free(block);
+    number_of_blocks++;
+  }
+  coco_writer_close(writer);
+  coco_free_memory(contents);
+  return number_of_runs;
+}
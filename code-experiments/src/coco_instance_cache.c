@@ -0,0 +1,391 @@
+/**
+ * @file coco_instance_cache.c
+ * @brief Implementation of a cache for the instance data (rotation matrices, optima and permutations)
+ * that is shared among the problems of all suites.
+ *
+ * The instance data of a problem is computed by deterministic generators from a seed and a dimension
+ * (and possibly some additional parameters). Since different functions of a suite often use the same
+ * seeds and since the same problem is often constructed several times, the results of the generators are
+ * kept in a cache with the key (generator, seed, dimension, parameter1, parameter2).
+ *
+ * The cache is only used while at least one suite exists (see coco_instance_cache_open and
+ * coco_instance_cache_close) and is emptied when the last suite is freed. The size of the cached data is
+ * bounded by COCO_INSTANCE_CACHE_MAX_SIZE bytes; when the bound is exceeded, the least recently used
+ * entries are removed.
+ *
+ * Entries are handed out by coco_instance_cache_acquire with a reference count and must be given back with
+ * coco_instance_cache_release. Entries that are in use are never removed, so that their data can be read
+ * without holding the lock of the cache, which is only needed if the code is compiled with COCO_THREADS.
+ *
+ * Data that is not in the cache is looked up in the instance store (see coco_instance_store.c), if one has
+ * been opened with coco_instance_cache_open_store. The contents of the cache can be written to an instance
+ * store with coco_instance_cache_write_store.
+ */
+
+#include "coco_platform.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "coco.h"
+#include "coco_utilities.c"
+#include "coco_instance_store.c"
+
+#ifndef COCO_INSTANCE_CACHE_MAX_SIZE
+/** @brief The maximal size (in bytes) of the data kept in the instance cache. */
+#define COCO_INSTANCE_CACHE_MAX_SIZE (64 * 1024 * 1024)
+#endif
+
+/**
+ * @brief An entry of the instance cache.
+ */
+typedef struct coco_instance_cache_entry_s {
+  const char *generator;  /**< @brief The name of the generator (compared by content). */
+  long seed;              /**< @brief The seed. */
+  size_t dimension;       /**< @brief The dimension. */
+  size_t parameter1;      /**< @brief The first additional parameter of the generator. */
+  size_t parameter2;      /**< @brief The second additional parameter of the generator. */
+  void *data;             /**< @brief The data computed by the generator. */
+  size_t size;            /**< @brief The size of the data in bytes. */
+  size_t references;      /**< @brief The number of users of the data. */
+  struct coco_instance_cache_entry_s *next; /**< @brief The next (less recently used) entry. */
+} coco_instance_cache_entry_t;
+
+/**
+ * @brief The instance cache.
+ */
+typedef struct {
+  coco_instance_cache_entry_t *first; /**< @brief The most recently used entry. */
+  size_t size;                        /**< @brief The size of all cached data in bytes. */
+  size_t number_of_users;             /**< @brief The number of suites that use the cache. */
+  int is_recording;                   /**< @brief Whether all data is kept (to write an instance store). */
+  coco_instance_store_t *store;       /**< @brief The instance store (can be NULL). */
+} coco_instance_cache_t;
+
+/** @brief The instance cache shared by all suites. */
+static coco_instance_cache_t coco_instance_cache = { NULL, 0, 0, 0, NULL };
+
+#if defined(HAVE_PTHREAD)
+/** @brief The lock of the instance cache. */
+static pthread_mutex_t coco_instance_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+#elif defined(HAVE_WIN_THREADS)
+/** @brief The lock of the instance cache. */
+static SRWLOCK coco_instance_cache_mutex = SRWLOCK_INIT;
+#endif
+
+/**
+ * @brief Locks the instance cache.
+ */
+static void coco_instance_cache_lock(void) {
+#if defined(HAVE_PTHREAD)
+  pthread_mutex_lock(&coco_instance_cache_mutex);
+#elif defined(HAVE_WIN_THREADS)
+  AcquireSRWLockExclusive(&coco_instance_cache_mutex);
+#endif
+}
+
+/**
+ * @brief Unlocks the instance cache.
+ */
+static void coco_instance_cache_unlock(void) {
+#if defined(HAVE_PTHREAD)
+  pthread_mutex_unlock(&coco_instance_cache_mutex);
+#elif defined(HAVE_WIN_THREADS)
+  ReleaseSRWLockExclusive(&coco_instance_cache_mutex);
+#endif
+}
+
+/**
+ * @brief Frees the entry and its data.
+ */
+static void coco_instance_cache_entry_free(coco_instance_cache_entry_t *entry) {
+  coco_free_memory(entry->data);
+  coco_free_memory(entry);
+}
+
+/**
+ * @brief Removes the least recently used entries that are not in use until the size of the cached data
+ * is at most max_size. Must be called while holding the lock.
+ */
+static void coco_instance_cache_shrink(const size_t max_size) {
+  coco_instance_cache_entry_t *entry, *previous, *last, *last_previous;
+
+  if (coco_instance_cache.is_recording && (max_size > 0))
+    return;
+  while (coco_instance_cache.size > max_size) {
+    /* Find the last entry that is not in use */
+    last = NULL;
+    last_previous = NULL;
+    previous = NULL;
+    for (entry = coco_instance_cache.first; entry != NULL; entry = entry->next) {
+      if (entry->references == 0) {
+        last = entry;
+        last_previous = previous;
+      }
+      previous = entry;
+    }
+    if (last == NULL)
+      return;
+
+    if (last_previous == NULL)
+      coco_instance_cache.first = last->next;
+    else
+      last_previous->next = last->next;
+    coco_instance_cache.size -= last->size;
+    coco_instance_cache_entry_free(last);
+  }
+}
+
+/**
+ * @brief Starts using the instance cache (called when a suite is allocated).
+ */
+static void coco_instance_cache_open(void) {
+  coco_instance_cache_lock();
+  coco_instance_cache.number_of_users++;
+  coco_instance_cache_unlock();
+}
+
+/**
+ * @brief Stops using the instance cache (called when a suite is freed). The cache is emptied and the
+ * instance store is closed when the cache has no more users.
+ */
+static void coco_instance_cache_close(void) {
+  coco_instance_cache_lock();
+  assert(coco_instance_cache.number_of_users > 0);
+  coco_instance_cache.number_of_users--;
+  if (coco_instance_cache.number_of_users == 0) {
+    coco_instance_cache_shrink(0);
+    coco_instance_store_close(coco_instance_cache.store);
+    coco_instance_cache.store = NULL;
+  }
+  coco_instance_cache_unlock();
+}
+
+/**
+ * @brief Opens the instance store with the given file name, in which the data not found in the cache is
+ * looked up until the cache has no more users. Only one store can be opened at a time.
+ */
+static void coco_instance_cache_open_store(const char *file_name) {
+  coco_instance_cache_lock();
+  if (coco_instance_cache.store == NULL) {
+    coco_instance_cache.store = coco_instance_store_open(file_name);
+  } else if (strcmp(coco_instance_cache.store->file_name, file_name) != 0) {
+    coco_warning("coco_instance_cache_open_store(): instance store '%s' ignored, since '%s' is already used",
+        file_name, coco_instance_cache.store->file_name);
+  }
+  coco_instance_cache_unlock();
+}
+
+/**
+ * @brief Returns the data cached for the given key (and increases its reference count) or NULL if no data
+ * is cached for the key.
+ *
+ * The size is the number of bytes that the caller is going to read from the data. Data of a different size
+ * in the instance store is not used.
+ *
+ * The returned data must not be changed and must be given back with coco_instance_cache_release.
+ */
+static const void *coco_instance_cache_acquire(const char *generator,
+                                               const long seed,
+                                               const size_t dimension,
+                                               const size_t parameter1,
+                                               const size_t parameter2,
+                                               const size_t size) {
+  coco_instance_cache_entry_t *entry, *previous = NULL;
+  const void *data = NULL;
+
+  coco_instance_cache_lock();
+  for (entry = coco_instance_cache.first; entry != NULL; previous = entry, entry = entry->next) {
+    if ((entry->seed == seed) && (entry->dimension == dimension) && (entry->parameter1 == parameter1)
+        && (entry->parameter2 == parameter2) && (strcmp(entry->generator, generator) == 0)) {
+      /* Move the entry to the front of the list */
+      if (previous != NULL) {
+        previous->next = entry->next;
+        entry->next = coco_instance_cache.first;
+        coco_instance_cache.first = entry;
+      }
+      assert(entry->size == size);
+      entry->references++;
+      data = entry->data;
+      break;
+    }
+  }
+  /* The data in the store stays valid as long as the cache has users, so it needs no reference count. While
+   * recording, the data is computed again, so that it is added to the cache. */
+  if ((data == NULL) && (coco_instance_cache.store != NULL) && !coco_instance_cache.is_recording)
+    data = coco_instance_store_find(coco_instance_cache.store, generator, seed, dimension, parameter1, parameter2,
+        size);
+  coco_instance_cache_unlock();
+  return data;
+}
+
+/**
+ * @brief Gives back data obtained with coco_instance_cache_acquire.
+ */
+static void coco_instance_cache_release(const void *data) {
+  coco_instance_cache_entry_t *entry;
+
+  coco_instance_cache_lock();
+  for (entry = coco_instance_cache.first; entry != NULL; entry = entry->next) {
+    if (entry->data == data) {
+      assert(entry->references > 0);
+      entry->references--;
+      break;
+    }
+  }
+  assert((entry != NULL) || coco_instance_store_contains(coco_instance_cache.store, data));
+  coco_instance_cache_shrink(COCO_INSTANCE_CACHE_MAX_SIZE);
+  coco_instance_cache_unlock();
+}
+
+/**
+ * @brief Adds the data computed by the generator for the given key to the cache.
+ *
+ * The cache takes over the data, which must have been allocated with coco_allocate_memory. The data is
+ * freed right away if the cache is not used by any suite, if it is too large or if data for the same key
+ * has already been added in the meantime.
+ *
+ * The generator must be a string literal, since it is not copied.
+ */
+static void coco_instance_cache_insert(const char *generator,
+                                       const long seed,
+                                       const size_t dimension,
+                                       const size_t parameter1,
+                                       const size_t parameter2,
+                                       void *data,
+                                       const size_t size) {
+  coco_instance_cache_entry_t *entry;
+
+  coco_instance_cache_lock();
+  if ((coco_instance_cache.number_of_users == 0) || (size > COCO_INSTANCE_CACHE_MAX_SIZE)) {
+    coco_instance_cache_unlock();
+    coco_free_memory(data);
+    return;
+  }
+  for (entry = coco_instance_cache.first; entry != NULL; entry = entry->next) {
+    if ((entry->seed == seed) && (entry->dimension == dimension) && (entry->parameter1 == parameter1)
+        && (entry->parameter2 == parameter2) && (strcmp(entry->generator, generator) == 0)) {
+      coco_instance_cache_unlock();
+      coco_free_memory(data);
+      return;
+    }
+  }
+
+  entry = (coco_instance_cache_entry_t *) coco_allocate_memory(sizeof(*entry));
+  entry->generator = generator;
+  entry->seed = seed;
+  entry->dimension = dimension;
+  entry->parameter1 = parameter1;
+  entry->parameter2 = parameter2;
+  entry->data = data;
+  entry->size = size;
+  entry->references = 0;
+  entry->next = coco_instance_cache.first;
+  coco_instance_cache.first = entry;
+  coco_instance_cache.size += size;
+  coco_instance_cache_shrink(COCO_INSTANCE_CACHE_MAX_SIZE);
+  coco_instance_cache_unlock();
+}
+
+/**
+ * @brief Starts or stops recording, during which all data added to the cache is kept regardless of
+ * COCO_INSTANCE_CACHE_MAX_SIZE and the instance store is not used.
+ */
+static void coco_instance_cache_set_recording(const int is_recording) {
+  coco_instance_cache_lock();
+  coco_instance_cache.is_recording = is_recording;
+  if (!is_recording)
+    coco_instance_cache_shrink(COCO_INSTANCE_CACHE_MAX_SIZE);
+  coco_instance_cache_unlock();
+}
+
+/**
+ * @brief Writes the contents of the cache to an instance store with the given file name.
+ *
+ * @return The number of written entries.
+ */
+static size_t coco_instance_cache_write_store(const char *file_name) {
+  coco_instance_store_header_t header;
+  coco_instance_store_entry_t *index;
+  coco_instance_cache_entry_t *entry;
+  const coco_instance_cache_entry_t **data;
+  const char zeros[COCO_INSTANCE_STORE_ALIGNMENT] = { 0 };
+  size_t number_of_entries, offset, i;
+  FILE *file;
+
+  coco_instance_cache_lock();
+  number_of_entries = 0;
+  for (entry = coco_instance_cache.first; entry != NULL; entry = entry->next) {
+    if (strlen(entry->generator) < COCO_INSTANCE_STORE_GENERATOR_LENGTH)
+      number_of_entries++;
+  }
+
+  /* Sort the index by the keys and find the data of each entry */
+  index = (coco_instance_store_entry_t *) coco_allocate_memory((number_of_entries + 1) * sizeof(*index));
+  i = 0;
+  for (entry = coco_instance_cache.first; entry != NULL; entry = entry->next) {
+    if (strlen(entry->generator) >= COCO_INSTANCE_STORE_GENERATOR_LENGTH)
+      continue;
+    coco_instance_store_entry_set_key(&index[i], entry->generator, entry->seed, entry->dimension,
+        entry->parameter1, entry->parameter2);
+    index[i].size = entry->size;
+    index[i].checksum = coco_instance_store_checksum(entry->data, entry->size);
+    i++;
+  }
+  qsort(index, number_of_entries, sizeof(*index), coco_instance_store_entry_compare);
+  data = (const coco_instance_cache_entry_t **) coco_allocate_memory((number_of_entries + 1) * sizeof(*data));
+  for (entry = coco_instance_cache.first; entry != NULL; entry = entry->next) {
+    coco_instance_store_entry_t key;
+    const coco_instance_store_entry_t *found;
+    if (strlen(entry->generator) >= COCO_INSTANCE_STORE_GENERATOR_LENGTH)
+      continue;
+    coco_instance_store_entry_set_key(&key, entry->generator, entry->seed, entry->dimension,
+        entry->parameter1, entry->parameter2);
+    found = (const coco_instance_store_entry_t *) bsearch(&key, index, number_of_entries, sizeof(key),
+        coco_instance_store_entry_compare);
+    assert(found != NULL);
+    data[found - index] = entry;
+  }
+
+  /* Compute the positions of the data */
+  offset = sizeof(header) + number_of_entries * sizeof(*index);
+  for (i = 0; i < number_of_entries; i++) {
+    offset = (offset + COCO_INSTANCE_STORE_ALIGNMENT - 1) / COCO_INSTANCE_STORE_ALIGNMENT
+        * COCO_INSTANCE_STORE_ALIGNMENT;
+    index[i].offset = offset;
+    offset += index[i].size;
+  }
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, COCO_INSTANCE_STORE_MAGIC, 8);
+  header.version = COCO_INSTANCE_STORE_VERSION;
+  header.byte_order = COCO_INSTANCE_STORE_BYTE_ORDER;
+  header.type_sizes = coco_instance_store_type_sizes();
+  header.number_of_entries = number_of_entries;
+  header.index_checksum = coco_instance_store_checksum(index, number_of_entries * sizeof(*index));
+
+  file = fopen(file_name, "wb");
+  if (file == NULL) {
+    coco_instance_cache_unlock();
+    coco_error("coco_instance_cache_write_store(): failed to open file '%s'", file_name);
+    return 0; /* Never reached */
+  }
+  fwrite(&header, sizeof(header), 1, file);
+  fwrite(index, sizeof(*index), number_of_entries, file);
+  offset = sizeof(header) + number_of_entries * sizeof(*index);
+  for (i = 0; i < number_of_entries; i++) {
+    fwrite(zeros, 1, index[i].offset - offset, file);
+    fwrite(data[i]->data, 1, data[i]->size, file);
+    offset = index[i].offset + index[i].size;
+  }
+  if (fclose(file) != 0) {
+    coco_instance_cache_unlock();
+    coco_error("coco_instance_cache_write_store(): failed to write file '%s'", file_name);
+    return 0; /* Never reached */
+  }
+  coco_instance_cache_unlock();
+
+  coco_free_memory(index);
+  coco_free_memory((void *) data);
+  return number_of_entries;
+}
@@ -0,0 +1,328 @@
+/**
+ * @file coco_instance_store.c
+ * @brief Implementation of reading precomputed instance data from a file.
+ *
+ * An instance store is a binary file that contains the data computed by the generators of the instance
+ * cache (see coco_instance_cache.c) for some suite, dimensions and instances. It is created with
+ * coco_instance_store_create (or the create_instance_store program) and used by giving the suite option
+ * "instance_store: FILE_NAME" to coco_suite. Where possible, the file is memory-mapped read-only, so that
+ * several processes on the same machine share its pages; otherwise it is read into memory.
+ *
+ * The file consists of
+ * - a header (coco_instance_store_header_t),
+ * - an index of entries (coco_instance_store_entry_t) sorted by their keys and
+ * - the data of the entries, each starting at a multiple of COCO_INSTANCE_STORE_ALIGNMENT bytes.
+ *
+ * The header contains the version of the format, a byte order mark and the sizes of the basic types, so
+ * that files written on an incompatible platform are rejected, as well as a checksum of the index. Each
+ * entry contains a checksum of its data, which is verified when the data is used for the first time.
+ */
+
+#include "coco_platform.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "coco.h"
+#include "coco_utilities.c"
+
+/** @brief The magic string at the start of an instance store. */
+#define COCO_INSTANCE_STORE_MAGIC "COCOINST"
+
+/** @brief The version of the file format of instance stores. */
+#define COCO_INSTANCE_STORE_VERSION 1
+
+/** @brief The byte order mark of instance stores. */
+#define COCO_INSTANCE_STORE_BYTE_ORDER 0x01020304
+
+/** @brief The maximal length of a generator name (including the terminating zero). */
+#define COCO_INSTANCE_STORE_GENERATOR_LENGTH 64
+
+/** @brief The alignment of the data of the entries (in bytes). */
+#define COCO_INSTANCE_STORE_ALIGNMENT 64
+
+/**
+ * @brief The header of an instance store.
+ */
+typedef struct {
+  char magic[8];                /**< @brief COCO_INSTANCE_STORE_MAGIC (without terminating zero). */
+  size_t version;               /**< @brief COCO_INSTANCE_STORE_VERSION. */
+  size_t byte_order;            /**< @brief COCO_INSTANCE_STORE_BYTE_ORDER. */
+  size_t type_sizes;            /**< @brief The sizes of size_t, long and double (one byte each). */
+  size_t number_of_entries;     /**< @brief The number of entries in the index. */
+  size_t index_checksum;        /**< @brief The checksum of the index. */
+} coco_instance_store_header_t;
+
+/**
+ * @brief An entry of the index of an instance store.
+ */
+typedef struct {
+  char generator[COCO_INSTANCE_STORE_GENERATOR_LENGTH]; /**< @brief The name of the generator. */
+  long seed;                    /**< @brief The seed. */
+  size_t dimension;             /**< @brief The dimension. */
+  size_t parameter1;            /**< @brief The first additional parameter of the generator. */
+  size_t parameter2;            /**< @brief The second additional parameter of the generator. */
+  size_t offset;                /**< @brief The position of the data in the file (in bytes). */
+  size_t size;                  /**< @brief The size of the data (in bytes). */
+  size_t checksum;              /**< @brief The checksum of the data. */
+} coco_instance_store_entry_t;
+
+/**
+ * @brief An opened instance store.
+ */
+typedef struct {
+  char *file_name;                          /**< @brief The name of the file. */
+  char *contents;                           /**< @brief The contents of the file. */
+  size_t size;                              /**< @brief The size of the file. */
+  int is_mapped;                            /**< @brief Whether the contents are memory-mapped. */
+  const coco_instance_store_entry_t *index; /**< @brief The index of entries. */
+  size_t number_of_entries;                 /**< @brief The number of entries. */
+  char *verified;                           /**< @brief Whether the checksums of the entries were verified. */
+} coco_instance_store_t;
+
+/**
+ * @brief Returns the sizes of the basic types as stored in the header.
+ */
+static size_t coco_instance_store_type_sizes(void) {
+  return sizeof(size_t) | (sizeof(long) << 8) | (sizeof(double) << 16);
+}
+
+/**
+ * @brief Computes the checksum (the FNV-1a hash in size_t arithmetic) of the given data.
+ */
+static size_t coco_instance_store_checksum(const void *data, const size_t size) {
+  const unsigned char *bytes = (const unsigned char *) data;
+  size_t hash = 2166136261UL;
+  size_t i;
+
+  for (i = 0; i < size; i++) {
+    hash ^= bytes[i];
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+/**
+ * @brief Compares the keys of two entries (used for sorting and searching the index).
+ */
+static int coco_instance_store_entry_compare(const void *a, const void *b) {
+  const coco_instance_store_entry_t *entry1 = (const coco_instance_store_entry_t *) a;
+  const coco_instance_store_entry_t *entry2 = (const coco_instance_store_entry_t *) b;
+  int result = strcmp(entry1->generator, entry2->generator);
+
+  if (result != 0)
+    return result;
+  if (entry1->seed != entry2->seed)
+    return (entry1->seed < entry2->seed) ? -1 : 1;
+  if (entry1->dimension != entry2->dimension)
+    return (entry1->dimension < entry2->dimension) ? -1 : 1;
+  if (entry1->parameter1 != entry2->parameter1)
+    return (entry1->parameter1 < entry2->parameter1) ? -1 : 1;
+  if (entry1->parameter2 != entry2->parameter2)
+    return (entry1->parameter2 < entry2->parameter2) ? -1 : 1;
+  return 0;
+}
+
+/**
+ * @brief Sets the key of the entry.
+ */
+static void coco_instance_store_entry_set_key(coco_instance_store_entry_t *entry,
+                                              const char *generator,
+                                              const long seed,
+                                              const size_t dimension,
+                                              const size_t parameter1,
+                                              const size_t parameter2) {
+  /* Also clears the padding, so that the index can be checksummed */
+  memset(entry, 0, sizeof(*entry));
+  assert(strlen(generator) < COCO_INSTANCE_STORE_GENERATOR_LENGTH);
+  strncpy(entry->generator, generator, COCO_INSTANCE_STORE_GENERATOR_LENGTH - 1);
+  entry->seed = seed;
+  entry->dimension = dimension;
+  entry->parameter1 = parameter1;
+  entry->parameter2 = parameter2;
+}
+
+/**
+ * @brief Reads the contents of the file into the store (memory-mapped if possible).
+ *
+ * @return 1 on success and 0 otherwise.
+ */
+static int coco_instance_store_read_file(coco_instance_store_t *store) {
+  FILE *file;
+#if defined(HAVE_MMAP)
+  struct stat file_status;
+  int file_descriptor;
+  void *contents;
+
+  file_descriptor = open(store->file_name, O_RDONLY);
+  if (file_descriptor >= 0) {
+    if ((fstat(file_descriptor, &file_status) == 0) && (file_status.st_size > 0)) {
+      store->size = (size_t) file_status.st_size;
+      contents = mmap(NULL, store->size, PROT_READ, MAP_SHARED, file_descriptor, 0);
+      if (contents != MAP_FAILED) {
+        store->contents = (char *) contents;
+        store->is_mapped = 1;
+      }
+    }
+    close(file_descriptor);
+    if (store->is_mapped)
+      return 1;
+  }
+#endif
+
+  file = fopen(store->file_name, "rb");
+  if (file == NULL)
+    return 0;
+  if ((fseek(file, 0, SEEK_END) != 0) || (ftell(file) <= 0)) {
+    fclose(file);
+    return 0;
+  }
+  store->size = (size_t) ftell(file);
+  rewind(file);
+  store->contents = (char *) coco_allocate_memory(store->size);
+  if (fread(store->contents, 1, store->size, file) != store->size) {
+    fclose(file);
+    return 0;
+  }
+  fclose(file);
+  return 1;
+}
+
+/**
+ * @brief Closes the instance store.
+ */
+static void coco_instance_store_close(coco_instance_store_t *store) {
+  if (store == NULL)
+    return;
+  if (store->contents != NULL) {
+#if defined(HAVE_MMAP)
+    if (store->is_mapped)
+      munmap(store->contents, store->size);
+    else
+#endif
+      coco_free_memory(store->contents);
+  }
+  if (store->verified != NULL)
+    coco_free_memory(store->verified);
+  coco_free_memory(store->file_name);
+  coco_free_memory(store);
+}
+
+/**
+ * @brief Opens the instance store with the given file name and checks its header and index.
+ *
+ * @return The opened store or NULL (with a warning) if the file cannot be read or is not a valid
+ * instance store.
+ */
+static coco_instance_store_t *coco_instance_store_open(const char *file_name) {
+  coco_instance_store_t *store;
+  const coco_instance_store_header_t *header;
+  size_t i;
+
+  store = (coco_instance_store_t *) coco_allocate_memory(sizeof(*store));
+  store->file_name = coco_strdup(file_name);
+  store->contents = NULL;
+  store->size = 0;
+  store->is_mapped = 0;
+  store->index = NULL;
+  store->number_of_entries = 0;
+  store->verified = NULL;
+
+  if (!coco_instance_store_read_file(store)) {
+    coco_warning("coco_instance_store_open(): could not read file '%s'", file_name);
+    coco_instance_store_close(store);
+    return NULL;
+  }
+
+  header = (const coco_instance_store_header_t *) store->contents;
+  if ((store->size < sizeof(*header)) || (memcmp(header->magic, COCO_INSTANCE_STORE_MAGIC, 8) != 0)
+      || (header->version != COCO_INSTANCE_STORE_VERSION)
+      || (header->byte_order != COCO_INSTANCE_STORE_BYTE_ORDER)
+      || (header->type_sizes != coco_instance_store_type_sizes())
+      || (header->number_of_entries > (store->size - sizeof(*header)) / sizeof(coco_instance_store_entry_t))) {
+    coco_warning("coco_instance_store_open(): '%s' is not an instance store of this version and platform",
+        file_name);
+    coco_instance_store_close(store);
+    return NULL;
+  }
+
+  store->number_of_entries = header->number_of_entries;
+  store->index = (const coco_instance_store_entry_t *) (store->contents + sizeof(*header));
+  if (coco_instance_store_checksum(store->index, store->number_of_entries * sizeof(*store->index))
+      != header->index_checksum) {
+    coco_warning("coco_instance_store_open(): the index of '%s' is corrupted", file_name);
+    coco_instance_store_close(store);
+    return NULL;
+  }
+  for (i = 0; i < store->number_of_entries; i++) {
+    if ((store->index[i].offset > store->size) || (store->index[i].size > store->size - store->index[i].offset)) {
+      coco_warning("coco_instance_store_open(): the index of '%s' is corrupted", file_name);
+      coco_instance_store_close(store);
+      return NULL;
+    }
+  }
+
+  store->verified = coco_allocate_string(store->number_of_entries + 1);
+  memset(store->verified, 0, store->number_of_entries + 1);
+  coco_debug("coco_instance_store_open(): opened '%s' with %lu entries", file_name,
+      (unsigned long) store->number_of_entries);
+  return store;
+}
+
+/**
+ * @brief Returns the data stored for the given key or NULL if the store has no (valid) data for the key.
+ *
+ * The data is only valid if it has the given size in bytes, which the caller is going to read. Data of a
+ * different size has been recorded by a build with a different data layout and is treated like corrupted
+ * data.
+ */
+static const void *coco_instance_store_find(coco_instance_store_t *store,
+                                            const char *generator,
+                                            const long seed,
+                                            const size_t dimension,
+                                            const size_t parameter1,
+                                            const size_t parameter2,
+                                            const size_t size) {
+  coco_instance_store_entry_t key;
+  const coco_instance_store_entry_t *entry;
+  size_t i;
+
+  if (strlen(generator) >= COCO_INSTANCE_STORE_GENERATOR_LENGTH)
+    return NULL;
+  coco_instance_store_entry_set_key(&key, generator, seed, dimension, parameter1, parameter2);
+  entry = (const coco_instance_store_entry_t *) bsearch(&key, store->index, store->number_of_entries,
+      sizeof(key), coco_instance_store_entry_compare);
+  if (entry == NULL)
+    return NULL;
+
+  /* The checksum is verified only once (verified is 1 for valid and 2 for corrupted data) */
+  i = (size_t) (entry - store->index);
+  if (entry->size != size) {
+    if (store->verified[i] != 2) {
+      coco_warning("coco_instance_store_find(): the data of %s (seed %ld, dimension %lu) in '%s' has %lu bytes "
+          "instead of %lu", generator, seed, (unsigned long) dimension, store->file_name,
+          (unsigned long) entry->size, (unsigned long) size);
+      store->verified[i] = 2;
+    }
+    return NULL;
+  }
+  if (store->verified[i] == 0) {
+    store->verified[i] = 1;
+    if (coco_instance_store_checksum(store->contents + entry->offset, entry->size) != entry->checksum) {
+      coco_warning("coco_instance_store_find(): the data of %s (seed %ld, dimension %lu) in '%s' is corrupted",
+          generator, seed, (unsigned long) dimension, store->file_name);
+      store->verified[i] = 2;
+    }
+  }
+  return (store->verified[i] == 1) ? store->contents + entry->offset : NULL;
+}
+
+/**
+ * @brief Returns 1 if the data belongs to the store and 0 otherwise.
+ */
+static int coco_instance_store_contains(const coco_instance_store_t *store, const void *data) {
+  const char *pointer = (const char *) data;
+  return (store != NULL) && (pointer >= store->contents) && (pointer < store->contents + store->size);
+}
@@ -28,6 +28,13 @@ typedef void (*coco_data_free_function_t)(void *data);
  */
 typedef void (*coco_problem_free_function_t)(coco_problem_t *problem);
 
+/**
+ * @brief The problem clone function type.
+ *
+ * This is a template for functions that clone the problem structure (see coco_problem_clone).
+ */
+typedef coco_problem_t *(*coco_problem_clone_function_t)(const coco_problem_t *problem);
+
 /**
  * @brief The evaluate function type.
  *
@@ -36,6 +43,18 @@ typedef void (*coco_problem_free_function_t)(coco_problem_t *problem);
  */
 typedef void (*coco_evaluate_function_t)(coco_problem_t *problem, const double *x, double *y);
 
+/**
+ * @brief The batch evaluate function type.
+ *
+ * This is a template for functions that evaluate the problem function in number_of_points points at once.
+ * The points are stored one after another in x (number_of_points * number_of_variables values) and the
+ * results are stored one after another in y (number_of_points * number_of_objectives values).
+ */
+typedef void (*coco_evaluate_batch_function_t)(coco_problem_t *problem,
+                                               const size_t number_of_points,
+                                               const double *x,
+                                               double *y);
+
 /**
  * @brief The recommend solutions function type.
  *
@@ -124,8 +143,12 @@ struct coco_problem_s {
   coco_evaluate_function_t evaluate_function;         /**< @brief  The function for evaluating the problem. */
   coco_evaluate_function_t evaluate_constraint;       /**< @brief  The function for evaluating the constraints. */
   coco_evaluate_function_t evaluate_gradient;         /**< @brief  The function for evaluating the constraints. */
+  coco_evaluate_batch_function_t evaluate_function_batch; /**< @brief  The function for evaluating the problem
+                                                      in a batch of points. */
   coco_recommend_function_t recommend_solution;       /**< @brief  The function for recommending a solution. */
   coco_problem_free_function_t problem_free_function; /**< @brief  The function for freeing this problem. */
+  coco_problem_clone_function_t problem_clone_function; /**< @brief  The function for cloning this problem
+                                                      (NULL if the problem cannot be cloned). */
 
   size_t number_of_variables;          /**< @brief Number of variables expected by the function, i.e.
                                        problem dimension */
@@ -164,11 +187,27 @@ struct coco_problem_s {
   size_t suite_dep_function;           /**< @brief Suite-depending function */
   size_t suite_dep_instance;           /**< @brief Suite-depending instance */
 
+  double *scratch;                     /**< @brief Scratch memory for the temporary vectors needed in evaluations
+                                       @see coco_problem_scratch_allocate */
+  size_t scratch_size;                 /**< @brief Size of the scratch memory (number of doubles). */
+  size_t scratch_used;                 /**< @brief Number of doubles of the scratch memory currently in use. */
+  size_t scratch_required;             /**< @brief Size the scratch memory needs to grow to once it is released. */
+
+  size_t reference_count;              /**< @brief Number of references to the problem (the problem itself and
+                                       its clones), the problem is freed when it drops to zero. */
+  coco_problem_t *clone_origin;        /**< @brief The problem this problem was cloned from (NULL if the problem
+                                       is not a clone) @see coco_problem_clone */
+
   void *data;                          /**< @brief Pointer to a data instance @see coco_problem_transformed_data_t */
   
   void *versatile_data;                /* Wassim: *< @brief pointer to eventual additional data that need to be accessed all along the transforamtions*/
 };
 
+/**
+ * @brief The type of the background thread that writes the output of the loggers (see coco_io_thread.c).
+ */
+typedef struct coco_io_thread_s coco_io_thread_t;
+
 /**
  * @brief The COCO observer structure.
  *
@@ -195,6 +234,8 @@ struct coco_observer_s {
   int precision_g;           /**< @brief Output precision for constraint values. */
   int log_discrete_as_int;   /**< @brief Whether to output discrete variables in int or double format. */
   void *data;                /**< @brief Void pointer that can be used to point to data specific to an observer. */
+  coco_io_thread_t *io_thread;
+                             /**< @brief The thread writing the output of the loggers (NULL if they write it). */
 
   coco_data_free_function_t data_free_function;             /**< @brief  The function for freeing this observer. */
   coco_logger_allocate_function_t logger_allocate_function; /**< @brief  The function for allocating the logger. */
@@ -228,6 +269,9 @@ struct coco_suite_s {
   long current_function_idx;       /**< @brief The function index of the currently tackled problem. */
   long current_instance_idx;       /**< @brief The instance index of the currently tackled problem. */
 
+  int compiled;                    /**< @brief Whether the linear transformations of the problems are fused. */
+  int fast_kernels;                /**< @brief Whether the raw functions use their fast variants. */
+
   void *data;                      /**< @brief Void pointer that can be used to point to data specific to a suite. */
 
   coco_data_free_function_t data_free_function; /**< @brief The function for freeing this suite. */
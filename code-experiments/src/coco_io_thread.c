@@ -0,0 +1,366 @@
+/**
+ * @file coco_io_thread.c
+ * @brief Implementation of a background thread that writes the output of the loggers.
+ *
+ * If an observer is constructed with the option "async_io: 1", the writers of its loggers (see
+ * coco_writer.c) do not write to their files themselves. Instead, they pass their buffered text to the
+ * I/O thread of the observer as jobs, which the thread performs in the order in which they were submitted.
+ * The evaluations therefore only format their output into memory and do not wait for the file system.
+ *
+ * The jobs are kept in a queue of fixed size, so the memory used by the queued output is bounded. If the
+ * queue is full (the file system cannot keep up with the loggers), the submitting thread waits until the
+ * I/O thread has performed a job (backpressure).
+ *
+ * The thread is shared by the observer and all writers that use it (they keep a reference to it), so it
+ * is only stopped once the observer and all writers are freed. Closing a writer waits until all its output
+ * has been written, and freeing the observer waits until the queue is empty.
+ *
+ * The I/O thread is opt-in (the default of "async_io" is 0) and only available if the code is compiled with
+ * COCO_THREADS defined (see coco_platform.h), as done by the makefiles in code-experiments/build/c.
+ * Otherwise coco_io_thread returns NULL and the writers write directly to their files.
+ */
+
+#include <stdio.h>
+
+#include "coco.h"
+#include "coco_internal.h"
+#include "coco_utilities.c"
+
+/**
+ * @brief The actions performed by the I/O thread.
+ */
+typedef enum {
+  COCO_IO_WRITE, /**< @brief Write the data to the file. */
+  COCO_IO_FLUSH, /**< @brief Write the data to the file and flush it. */
+  COCO_IO_CLOSE  /**< @brief Write the data to the file and close it. */
+} coco_io_action_t;
+
+/**
+ * @brief A job of the I/O thread.
+ */
+typedef struct {
+  FILE *file;              /**< @brief The file. */
+  char *data;              /**< @brief The data to be written (owned by the job, can be NULL). */
+  size_t length;           /**< @brief The length of the data. */
+  coco_io_action_t action; /**< @brief The action. */
+} coco_io_job_t;
+
+/**
+ * @brief The I/O thread type.
+ *
+ * The queue is a ring buffer of jobs. A job stays in the queue until it has been performed, so that the
+ * number of jobs that are queued or being performed never exceeds the size of the queue.
+ */
+struct coco_io_thread_s {
+  coco_io_job_t *jobs;             /**< @brief The queue of jobs. */
+  size_t queue_size;               /**< @brief The maximal number of jobs in the queue. */
+  size_t first_job;                /**< @brief The position of the first job in the queue. */
+  size_t number_of_jobs;           /**< @brief The number of jobs in the queue. */
+  size_t number_of_submitted_jobs; /**< @brief The number of jobs submitted so far. */
+  size_t number_of_completed_jobs; /**< @brief The number of jobs performed so far. */
+  size_t number_of_waits;          /**< @brief The number of times a job had to wait for a full queue. */
+  size_t number_of_references;     /**< @brief The number of users of the thread (observer and writers). */
+  int has_failed;                  /**< @brief Whether writing to a file has failed. */
+  int is_stopping;                 /**< @brief Whether the thread should stop once the queue is empty. */
+#if defined(HAVE_PTHREAD)
+  pthread_t thread;                /**< @brief The thread. */
+  pthread_mutex_t mutex;           /**< @brief The mutex protecting the queue. */
+  pthread_cond_t job_submitted;    /**< @brief Signaled when a job is submitted or the thread should stop. */
+  pthread_cond_t job_completed;    /**< @brief Signaled when a job is performed. */
+#elif defined(HAVE_WIN_THREADS)
+  HANDLE thread;                   /**< @brief The thread. */
+  CRITICAL_SECTION mutex;          /**< @brief The mutex protecting the queue. */
+  CONDITION_VARIABLE job_submitted;/**< @brief Signaled when a job is submitted or the thread should stop. */
+  CONDITION_VARIABLE job_completed;/**< @brief Signaled when a job is performed. */
+#endif
+};
+
+/**
+ * @brief Locks the queue.
+ */
+static void coco_io_thread_lock(coco_io_thread_t *io_thread) {
+#if defined(HAVE_PTHREAD)
+  pthread_mutex_lock(&io_thread->mutex);
+#elif defined(HAVE_WIN_THREADS)
+  EnterCriticalSection(&io_thread->mutex);
+#else
+  (void) io_thread; /* To silence the compiler */
+#endif
+}
+
+/**
+ * @brief Unlocks the queue.
+ */
+static void coco_io_thread_unlock(coco_io_thread_t *io_thread) {
+#if defined(HAVE_PTHREAD)
+  pthread_mutex_unlock(&io_thread->mutex);
+#elif defined(HAVE_WIN_THREADS)
+  LeaveCriticalSection(&io_thread->mutex);
+#else
+  (void) io_thread; /* To silence the compiler */
+#endif
+}
+
+/**
+ * @brief Waits (with the queue locked) until a job is performed.
+ */
+static void coco_io_thread_wait_for_completion(coco_io_thread_t *io_thread) {
+#if defined(HAVE_PTHREAD)
+  pthread_cond_wait(&io_thread->job_completed, &io_thread->mutex);
+#elif defined(HAVE_WIN_THREADS)
+  SleepConditionVariableCS(&io_thread->job_completed, &io_thread->mutex, INFINITE);
+#else
+  (void) io_thread; /* To silence the compiler */
+#endif
+}
+
+/**
+ * @brief Wakes up the I/O thread.
+ */
+static void coco_io_thread_signal_submission(coco_io_thread_t *io_thread) {
+#if defined(HAVE_PTHREAD)
+  pthread_cond_signal(&io_thread->job_submitted);
+#elif defined(HAVE_WIN_THREADS)
+  WakeConditionVariable(&io_thread->job_submitted);
+#else
+  (void) io_thread; /* To silence the compiler */
+#endif
+}
+
+#if defined(HAVE_PTHREAD) || defined(HAVE_WIN_THREADS)
+/**
+ * @brief Wakes up all threads waiting for a job to be performed.
+ */
+static void coco_io_thread_signal_completion(coco_io_thread_t *io_thread) {
+#if defined(HAVE_PTHREAD)
+  pthread_cond_broadcast(&io_thread->job_completed);
+#else
+  WakeAllConditionVariable(&io_thread->job_completed);
+#endif
+}
+
+/**
+ * @brief Waits (with the queue locked) until a job is submitted or the thread should stop.
+ */
+static void coco_io_thread_wait_for_submission(coco_io_thread_t *io_thread) {
+#if defined(HAVE_PTHREAD)
+  pthread_cond_wait(&io_thread->job_submitted, &io_thread->mutex);
+#else
+  SleepConditionVariableCS(&io_thread->job_submitted, &io_thread->mutex, INFINITE);
+#endif
+}
+
+/**
+ * @brief Performs the job and returns 0 if it failed and 1 otherwise.
+ */
+static int coco_io_thread_perform(coco_io_job_t *job) {
+  int result = 1;
+
+  if ((job->length > 0) && (fwrite(job->data, 1, job->length, job->file) != job->length))
+    result = 0;
+  if (job->action == COCO_IO_FLUSH)
+    result = (fflush(job->file) == 0) && result;
+  else if (job->action == COCO_IO_CLOSE)
+    result = (fclose(job->file) == 0) && result;
+  if (job->data != NULL)
+    coco_free_memory(job->data);
+  return result;
+}
+
+/**
+ * @brief Performs the jobs in the queue until the thread should stop and the queue is empty.
+ *
+ * The job is removed from the queue only after it has been performed.
+ */
+static void coco_io_thread_work(coco_io_thread_t *io_thread) {
+  coco_io_job_t job;
+  int result;
+
+  coco_io_thread_lock(io_thread);
+  while (1) {
+    while ((io_thread->number_of_jobs == 0) && !io_thread->is_stopping)
+      coco_io_thread_wait_for_submission(io_thread);
+    if (io_thread->number_of_jobs == 0)
+      break;
+    job = io_thread->jobs[io_thread->first_job];
+    coco_io_thread_unlock(io_thread);
+
+    result = coco_io_thread_perform(&job);
+
+    coco_io_thread_lock(io_thread);
+    if (!result)
+      io_thread->has_failed = 1;
+    io_thread->first_job = (io_thread->first_job + 1) % io_thread->queue_size;
+    io_thread->number_of_jobs--;
+    io_thread->number_of_completed_jobs++;
+    coco_io_thread_signal_completion(io_thread);
+  }
+  coco_io_thread_unlock(io_thread);
+}
+
+#if defined(HAVE_PTHREAD)
+/**
+ * @brief The function run by the I/O thread.
+ */
+static void *coco_io_thread_run(void *io_thread) {
+  coco_io_thread_work((coco_io_thread_t *) io_thread);
+  return NULL;
+}
+#else
+/**
+ * @brief The function run by the I/O thread.
+ */
+static DWORD WINAPI coco_io_thread_run(LPVOID io_thread) {
+  coco_io_thread_work((coco_io_thread_t *) io_thread);
+  return 0;
+}
+#endif
+#endif
+
+/**
+ * @brief Starts an I/O thread with a queue of the given size (with one reference held by the caller).
+ *
+ * @return The I/O thread or NULL (after a warning) if the code has been compiled without COCO_THREADS.
+ */
+static coco_io_thread_t *coco_io_thread(const size_t queue_size) {
+#if defined(HAVE_PTHREAD) || defined(HAVE_WIN_THREADS)
+  coco_io_thread_t *io_thread;
+
+  io_thread = (coco_io_thread_t *) coco_allocate_memory(sizeof(*io_thread));
+  io_thread->queue_size = (queue_size > 0) ? queue_size : 1;
+  io_thread->jobs = (coco_io_job_t *) coco_allocate_memory(io_thread->queue_size * sizeof(coco_io_job_t));
+  io_thread->first_job = 0;
+  io_thread->number_of_jobs = 0;
+  io_thread->number_of_submitted_jobs = 0;
+  io_thread->number_of_completed_jobs = 0;
+  io_thread->number_of_waits = 0;
+  io_thread->number_of_references = 1;
+  io_thread->has_failed = 0;
+  io_thread->is_stopping = 0;
+#if defined(HAVE_PTHREAD)
+  pthread_mutex_init(&io_thread->mutex, NULL);
+  pthread_cond_init(&io_thread->job_submitted, NULL);
+  pthread_cond_init(&io_thread->job_completed, NULL);
+  if (pthread_create(&io_thread->thread, NULL, coco_io_thread_run, io_thread) != 0)
+    coco_error("coco_io_thread(): failed to create thread");
+#else
+  InitializeCriticalSection(&io_thread->mutex);
+  InitializeConditionVariable(&io_thread->job_submitted);
+  InitializeConditionVariable(&io_thread->job_completed);
+  io_thread->thread = CreateThread(NULL, 0, coco_io_thread_run, io_thread, 0, NULL);
+  if (io_thread->thread == NULL)
+    coco_error("coco_io_thread(): failed to create thread");
+#endif
+  return io_thread;
+#else
+  (void) queue_size; /* To silence the compiler */
+  coco_warning("coco_io_thread(): compiled without COCO_THREADS, the output is written synchronously");
+  return NULL;
+#endif
+}
+
+/**
+ * @brief Adds a reference to the I/O thread.
+ */
+static void coco_io_thread_retain(coco_io_thread_t *io_thread) {
+  coco_io_thread_lock(io_thread);
+  io_thread->number_of_references++;
+  coco_io_thread_unlock(io_thread);
+}
+
+/**
+ * @brief Submits a job (the I/O thread takes over the data) and returns its sequence number.
+ *
+ * Waits while the queue is full.
+ */
+static size_t coco_io_thread_submit(coco_io_thread_t *io_thread,
+                                    FILE *file,
+                                    char *data,
+                                    const size_t length,
+                                    const coco_io_action_t action) {
+  coco_io_job_t *job;
+  size_t sequence_number;
+
+  coco_io_thread_lock(io_thread);
+  if (io_thread->number_of_jobs == io_thread->queue_size)
+    io_thread->number_of_waits++;
+  while (io_thread->number_of_jobs == io_thread->queue_size)
+    coco_io_thread_wait_for_completion(io_thread);
+  job = &io_thread->jobs[(io_thread->first_job + io_thread->number_of_jobs) % io_thread->queue_size];
+  job->file = file;
+  job->data = data;
+  job->length = length;
+  job->action = action;
+  io_thread->number_of_jobs++;
+  sequence_number = ++io_thread->number_of_submitted_jobs;
+  coco_io_thread_signal_submission(io_thread);
+  coco_io_thread_unlock(io_thread);
+  return sequence_number;
+}
+
+/**
+ * @brief Waits until the job with the given sequence number (and all jobs before it) has been performed.
+ *
+ * Calls coco_error if writing to a file has failed.
+ */
+static void coco_io_thread_wait(coco_io_thread_t *io_thread, const size_t sequence_number) {
+  int has_failed;
+
+  coco_io_thread_lock(io_thread);
+  while (io_thread->number_of_completed_jobs < sequence_number)
+    coco_io_thread_wait_for_completion(io_thread);
+  has_failed = io_thread->has_failed;
+  coco_io_thread_unlock(io_thread);
+  if (has_failed)
+    coco_error("coco_io_thread_wait(): failed to write the output of a logger");
+}
+
+/**
+ * @brief Waits until all submitted jobs have been performed.
+ */
+static void coco_io_thread_drain(coco_io_thread_t *io_thread) {
+  size_t sequence_number;
+
+  coco_io_thread_lock(io_thread);
+  sequence_number = io_thread->number_of_submitted_jobs;
+  coco_io_thread_unlock(io_thread);
+  coco_io_thread_wait(io_thread, sequence_number);
+}
+
+/**
+ * @brief Removes a reference to the I/O thread. The last reference performs the remaining jobs, stops the
+ * thread and frees it.
+ */
+static void coco_io_thread_release(coco_io_thread_t *io_thread) {
+  int is_last;
+
+  if (io_thread == NULL)
+    return;
+  coco_io_thread_lock(io_thread);
+  is_last = (--io_thread->number_of_references == 0);
+  if (is_last) {
+    io_thread->is_stopping = 1;
+    coco_io_thread_signal_submission(io_thread);
+  }
+  coco_io_thread_unlock(io_thread);
+  if (!is_last)
+    return;
+
+#if defined(HAVE_PTHREAD)
+  pthread_join(io_thread->thread, NULL);
+  pthread_cond_destroy(&io_thread->job_completed);
+  pthread_cond_destroy(&io_thread->job_submitted);
+  pthread_mutex_destroy(&io_thread->mutex);
+#elif defined(HAVE_WIN_THREADS)
+  WaitForSingleObject(io_thread->thread, INFINITE);
+  CloseHandle(io_thread->thread);
+  DeleteCriticalSection(&io_thread->mutex);
+#endif
+  if (io_thread->number_of_waits > 0)
+    coco_debug("coco_io_thread_release(): the queue was full %lu times",
+        (unsigned long) io_thread->number_of_waits);
+  if (io_thread->has_failed)
+    coco_warning("coco_io_thread_release(): failed to write the output of a logger");
+  coco_free_memory(io_thread->jobs);
+  coco_free_memory(io_thread);
+}
@@ -9,6 +9,8 @@
 #include <float.h>
 #include <math.h>
 
+#include "coco_io_thread.c"
+
 /**
  * @brief The type for triggers based on target values.
  *
@@ -314,6 +316,7 @@ static coco_observer_t *coco_observer_allocate(const char *result_folder,
   observer->precision_g = precision_g;
   observer->log_discrete_as_int = log_discrete_as_int;
   observer->data = NULL;
+  observer->io_thread = NULL;
   observer->data_free_function = NULL;
   observer->logger_allocate_function = NULL;
   observer->logger_free_function = NULL;
@@ -345,6 +348,13 @@ void coco_observer_free(coco_observer_t *observer) {
       observer->data = NULL;
     }
 
+    if (observer->io_thread != NULL) {
+      /* The loggers that are still open keep the thread running until they are freed */
+      coco_io_thread_drain(observer->io_thread);
+      coco_io_thread_release(observer->io_thread);
+      observer->io_thread = NULL;
+    }
+
     observer->logger_allocate_function = NULL;
     observer->logger_free_function = NULL;
 
@@ -397,6 +407,15 @@ void coco_observer_free(coco_observer_t *observer) {
  * of digits to be printed after the decimal point. The default value is 3.
  * - "log_discrete_as_int: VALUE" determines whether the values of integer variables (in mixed-integer problems)
  * are logged as integers (1) or not (0 - in this case they are logged as doubles). The default value is 0.
+ * - "async_io: VALUE" determines whether the output of the loggers is written by a background thread (1) or
+ * directly by the loggers during the evaluations (0). Asynchronous output is opt-in: the default value is 0.
+ * The background thread is only available if the code has been compiled with COCO_THREADS defined, which the
+ * makefiles of the C build do (and link with the thread library). The Python, Java and Matlab builds are
+ * compiled without COCO_THREADS, so there the option only gives a warning and the output is written
+ * synchronously.
+ * - "async_io_queue_size: VALUE" defines the maximal number of pieces of output (each of at most 64kB) that
+ * wait to be written by the background thread. When the queue is full, the evaluations wait until the thread
+ * catches up. The default value is 256.
  *
  * @return The constructed observer object or NULL if observer_name equals NULL, "" or "no_observer".
  */
@@ -405,7 +424,8 @@ coco_observer_t *coco_observer(const char *observer_name, const char *observer_o
   coco_observer_t *observer;
   char *path, *result_folder, *algorithm_name, *algorithm_info;
   const char *outer_folder_name = "exdata";
-  int precision_x, precision_f, precision_g, log_discrete_as_int;
+  int precision_x, precision_f, precision_g, log_discrete_as_int, async_io;
+  size_t async_io_queue_size;
 
   size_t number_target_triggers;
   size_t number_evaluation_triggers;
@@ -418,7 +438,7 @@ coco_observer_t *coco_observer(const char *observer_name, const char *observer_o
    * IMPORTANT: This list should be up-to-date with the code and the documentation */
   const char *known_keys[] = { "result_folder", "algorithm_name", "algorithm_info",
       "number_target_triggers", "target_precision", "number_evaluation_triggers", "base_evaluation_triggers",
-      "precision_x", "precision_f", "precision_g", "log_discrete_as_int" };
+      "precision_x", "precision_f", "precision_g", "log_discrete_as_int", "async_io", "async_io_queue_size" };
   additional_option_keys = NULL; /* To be set by the chosen observer */
 
   if (0 == strcmp(observer_name, "no_observer")) {
@@ -498,9 +518,23 @@ coco_observer_t *coco_observer(const char *observer_name, const char *observer_o
       log_discrete_as_int = 0;
   }
 
+  async_io = 0;
+  if (coco_options_read_int(observer_options, "async_io", &async_io) != 0) {
+    if ((async_io < 0) || (async_io > 1))
+      async_io = 0;
+  }
+
+  async_io_queue_size = 256;
+  if (coco_options_read_size_t(observer_options, "async_io_queue_size", &async_io_queue_size) != 0) {
+    if (async_io_queue_size == 0)
+      async_io_queue_size = 256;
+  }
+
   observer = coco_observer_allocate(path, observer_name, algorithm_name, algorithm_info,
       number_target_triggers, target_precision, number_evaluation_triggers, base_evaluation_triggers,
       precision_x, precision_f, precision_g, log_discrete_as_int);
+  if (async_io)
+    observer->io_thread = coco_io_thread(async_io_queue_size);
 
   coco_free_memory(path);
   coco_free_memory(result_folder);
@@ -573,6 +607,8 @@ coco_observer_t *coco_observer(const char *observer_name, const char *observer_o
  */
 coco_problem_t *coco_problem_add_observer(coco_problem_t *problem, coco_observer_t *observer) {
 
+  coco_problem_t *problem_observed;
+
   if (problem == NULL)
 	  return NULL;
 
@@ -583,7 +619,10 @@ coco_problem_t *coco_problem_add_observer(coco_problem_t *problem, coco_observer
   }
 
   assert(observer->logger_allocate_function);
-  return observer->logger_allocate_function(observer, problem);
+  problem_observed = observer->logger_allocate_function(observer, problem);
+  /* The loggers write their output sequentially, which is why observed problems cannot be cloned */
+  problem_observed->problem_clone_function = NULL;
+  return problem_observed;
 }
 
 /**
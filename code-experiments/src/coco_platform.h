@@ -84,6 +84,26 @@ int mkdir(const char *pathname, mode_t mode);
 #define S_IRWXU 0700
 #endif
 
+/* Definitions needed for running experiments in several threads (see coco_runner.c). Threads are only used
+ * if COCO_THREADS is defined, otherwise the problems are solved sequentially. */
+#if defined(COCO_THREADS)
+#if defined(_WIN32) || defined(_WIN64) || defined(__MINGW64__) || defined(__CYGWIN__)
+#define HAVE_WIN_THREADS 1
+#else
+#include <pthread.h>
+#define HAVE_PTHREAD 1
+#endif
+#endif
+
+/* Definitions needed for memory-mapping instance stores (see coco_instance_store.c). On other platforms
+ * the stores are read into memory. */
+#if defined(HAVE_STAT)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define HAVE_MMAP 1
+#endif
+
 /* To silence the Visual Studio compiler (C4996 warnings in the python build). */
 #ifdef _MSC_VER
 #pragma warning(disable:4996)
@@ -16,51 +16,90 @@
  */
 /**@{*/
 /**
- * Evaluates the problem function, increases the number of evaluations and updates the best observed value
- * and the best observed evaluation number.
+ * @brief Returns a vector of the given size from the scratch memory of the problem.
  *
- * @note Both x and y must point to correctly sized allocated memory regions.
+ * The scratch memory holds the temporary vectors that would otherwise be allocated and freed in every
+ * evaluation. It works like a stack, so the vectors must be freed with coco_problem_scratch_free in the
+ * reverse order of their allocation. A request that does not fit is served from the heap and the scratch
+ * memory is enlarged the next time it is not in use, so that after the first few evaluations no more
+ * memory is allocated.
+ */
+static double *coco_problem_scratch_allocate(coco_problem_t *problem, const size_t size) {
+  double *vector;
+
+  if (problem->scratch_used + size > problem->scratch_required)
+    problem->scratch_required = problem->scratch_used + size;
+
+  if ((problem->scratch_used == 0) && (problem->scratch_required > problem->scratch_size)) {
+    if (problem->scratch != NULL)
+      coco_free_memory(problem->scratch);
+    problem->scratch = coco_allocate_vector(problem->scratch_required);
+    problem->scratch_size = problem->scratch_required;
+  }
+
+  if (problem->scratch_used + size > problem->scratch_size)
+    return coco_allocate_vector(size);
+
+  vector = problem->scratch + problem->scratch_used;
+  problem->scratch_used += size;
+  return vector;
+}
+
+/**
+ * @brief Frees a vector of the given size obtained with coco_problem_scratch_allocate.
+ */
+static void coco_problem_scratch_free(coco_problem_t *problem, double *vector, const size_t size) {
+  if ((problem->scratch != NULL) && (size <= problem->scratch_used)
+      && (vector == problem->scratch + (problem->scratch_used - size))) {
+    problem->scratch_used -= size;
+  } else {
+    coco_free_memory(vector);
+  }
+}
+
+/**
+ * @brief Handles decision vectors with INFINITY or NAN values, which are not evaluated.
  *
- * @param problem The given COCO problem.
- * @param x The decision vector.
- * @param y The objective vector that is the result of the evaluation (in single-objective problems only the
- * first vector item is being set).
+ * The objective vector is set to INFINITY if the decision vector contains any INFINITY values and to NAN
+ * if it contains any NAN values.
+ *
+ * @return 1 if the decision vector contains any INFINITY or NAN values and 0 otherwise.
  */
-void coco_evaluate_function(coco_problem_t *problem, const double *x, double *y) {
-  /* implements a safer version of problem->evaluate(problem, x, y) */
+static int coco_evaluate_function_non_finite(coco_problem_t *problem, const double *x, double *y) {
   size_t i, j;
-  int is_feasible;
-  double *z;
-  
-  assert(problem != NULL);
-  assert(problem->evaluate_function != NULL);
-  
+
   /* Set objective vector to INFINITY if the decision vector contains any INFINITY values */
   for (i = 0; i < coco_problem_get_dimension(problem); i++) {
     if (coco_is_inf(x[i])) {
       for (j = 0; j < coco_problem_get_number_of_objectives(problem); j++) {
         y[j] = fabs(x[i]);
       }
-      return;
+      return 1;
     }
   }
-  
+
   /* Set objective vector to NAN if the decision vector contains any NAN values */
   if (coco_vector_contains_nan(x, coco_problem_get_dimension(problem))) {
     coco_vector_set_to_nan(y, coco_problem_get_number_of_objectives(problem));
-    return;
+    return 1;
   }
+  return 0;
+}
 
-  problem->evaluate_function(problem, x, y);
-  problem->evaluations++; /* each derived class has its own counter, only the most outer will be visible */
+/**
+ * @brief Updates the best observed value and the best observed evaluation number after the evaluation of
+ * x resulted in y.
+ */
+static void coco_problem_update_best_observed(coco_problem_t *problem, const double *x, const double *y) {
+  int is_feasible;
+  double *z;
 
-  /* A little bit of bookkeeping */
   if (y[0] < problem->best_observed_fvalue[0]) {
     is_feasible = 1;
     if (coco_problem_get_number_of_constraints(problem) > 0) {
-      z = coco_allocate_vector(coco_problem_get_number_of_constraints(problem));
+      z = coco_problem_scratch_allocate(problem, problem->number_of_constraints);
       is_feasible = coco_is_feasible(problem, x, z);
-      coco_free_memory(z);
+      coco_problem_scratch_free(problem, z, problem->number_of_constraints);
     }
     if (is_feasible) {
       problem->best_observed_fvalue[0] = y[0];
@@ -69,6 +108,126 @@ void coco_evaluate_function(coco_problem_t *problem, const double *x, double *y)
   }
 }
 
+/**
+ * Evaluates the problem function, increases the number of evaluations and updates the best observed value
+ * and the best observed evaluation number.
+ *
+ * @note Both x and y must point to correctly sized allocated memory regions.
+ *
+ * @param problem The given COCO problem.
+ * @param x The decision vector.
+ * @param y The objective vector that is the result of the evaluation (in single-objective problems only the
+ * first vector item is being set).
+ */
+void coco_evaluate_function(coco_problem_t *problem, const double *x, double *y) {
+  /* implements a safer version of problem->evaluate(problem, x, y) */
+  assert(problem != NULL);
+  assert(problem->evaluate_function != NULL);
+  
+  if (coco_evaluate_function_non_finite(problem, x, y))
+    return;
+
+  problem->evaluate_function(problem, x, y);
+  problem->evaluations++; /* each derived class has its own counter, only the most outer will be visible */
+
+  /* A little bit of bookkeeping */
+  coco_problem_update_best_observed(problem, x, y);
+}
+
+/**
+ * Evaluates the problem function in a batch of points. The result (including the number of evaluations,
+ * the best observed value and the output of any loggers) is the same as if coco_evaluate_function was
+ * called on each of the points in turn, but the transformations and loggers that implement the
+ * evaluate_function_batch method process the whole batch in one go.
+ *
+ * @note x must point to a memory region of number_of_points * dimension values and y to a memory region
+ * of number_of_points * number_of_objectives values.
+ *
+ * @param problem The given COCO problem.
+ * @param number_of_points The number of points in the batch.
+ * @param x The decision vectors stored one after another.
+ * @param y The objective vectors that are the result of the evaluation stored one after another.
+ */
+void coco_evaluate_function_batch(coco_problem_t *problem,
+                                  const size_t number_of_points,
+                                  const double *x,
+                                  double *y) {
+  size_t k, first, last;
+  size_t dimension, number_of_objectives;
+
+  assert(problem != NULL);
+  assert(problem->evaluate_function != NULL);
+  dimension = coco_problem_get_dimension(problem);
+  number_of_objectives = coco_problem_get_number_of_objectives(problem);
+
+  if (problem->evaluate_function_batch == NULL) {
+    for (k = 0; k < number_of_points; k++)
+      coco_evaluate_function(problem, x + k * dimension, y + k * number_of_objectives);
+    return;
+  }
+
+  /* Points with INFINITY or NAN values are skipped, the others are evaluated in runs of consecutive points */
+  first = 0;
+  while (first < number_of_points) {
+    if (coco_evaluate_function_non_finite(problem, x + first * dimension, y + first * number_of_objectives)) {
+      first++;
+      continue;
+    }
+    last = first + 1;
+    while ((last < number_of_points) && coco_vector_isfinite(x + last * dimension, dimension))
+      last++;
+
+    problem->evaluate_function_batch(problem, last - first, x + first * dimension,
+        y + first * number_of_objectives);
+
+    for (k = first; k < last; k++) {
+      problem->evaluations++;
+      coco_problem_update_best_observed(problem, x + k * dimension, y + k * number_of_objectives);
+    }
+    first = last;
+  }
+}
+
+/**
+ * @brief Evaluates the problem function in each point of the batch separately.
+ *
+ * This is the default evaluate_function_batch method used by problems without a native batch evaluation.
+ */
+static void coco_problem_evaluate_function_batch_loop(coco_problem_t *problem,
+                                                      const size_t number_of_points,
+                                                      const double *x,
+                                                      double *y) {
+  size_t k;
+  for (k = 0; k < number_of_points; k++)
+    problem->evaluate_function(problem, x + k * problem->number_of_variables,
+        y + k * problem->number_of_objectives);
+}
+
+/**
+ * @brief Asserts that no feasible point in the batch has a function value lower than the optimal one.
+ *
+ * Used by the batch evaluations of transformations, which perform the same sanity check for a single point.
+ */
+static void coco_problem_batch_assert_best_value(coco_problem_t *problem,
+                                                 const size_t number_of_points,
+                                                 const double *x,
+                                                 const double *y) {
+  size_t k;
+  double *cons_values;
+  int is_feasible;
+
+  for (k = 0; k < number_of_points; k++) {
+    if (problem->number_of_constraints > 0) {
+      cons_values = coco_problem_scratch_allocate(problem, problem->number_of_constraints);
+      is_feasible = coco_is_feasible(problem, x + k * problem->number_of_variables, cons_values);
+      coco_problem_scratch_free(problem, cons_values, problem->number_of_constraints);
+      if (is_feasible)
+        assert(y[k * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
+    }
+    else assert(y[k * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
+  }
+}
+
 /**
  * Evaluates the problem constraint.
  * 
@@ -145,6 +304,8 @@ void coco_recommend_solution(coco_problem_t *problem, const double *x) {
 
 /***********************************************************************************************************/
 
+static coco_problem_t *coco_problem_basic_clone(const coco_problem_t *problem);
+
 /**
  * @brief Allocates a new coco_problem_t for the given number of variables, number of objectives and
  * number of constraints.
@@ -160,8 +321,10 @@ static coco_problem_t *coco_problem_allocate(const size_t number_of_variables,
   problem->evaluate_function = NULL;
   problem->evaluate_constraint = NULL;
   problem->evaluate_gradient = NULL;
+  problem->evaluate_function_batch = coco_problem_evaluate_function_batch_loop;
   problem->recommend_solution = NULL;
   problem->problem_free_function = NULL;
+  problem->problem_clone_function = coco_problem_basic_clone;
   problem->number_of_variables = number_of_variables;
   problem->number_of_objectives = number_of_objectives;
   problem->number_of_constraints = number_of_constraints;
@@ -191,6 +354,12 @@ static coco_problem_t *coco_problem_allocate(const size_t number_of_variables,
   problem->suite_dep_index = 0;
   problem->suite_dep_function = 0;
   problem->suite_dep_instance = 0;
+  problem->scratch_size = number_of_variables + number_of_constraints;
+  problem->scratch = (problem->scratch_size > 0) ? coco_allocate_vector(problem->scratch_size) : NULL;
+  problem->scratch_used = 0;
+  problem->scratch_required = problem->scratch_size;
+  problem->reference_count = 1;
+  problem->clone_origin = NULL;
   problem->data = NULL;
   problem->versatile_data = NULL; /* Wassim: added to be able to pass data from one transformation to another*/
   return problem;
@@ -207,8 +376,10 @@ static coco_problem_t *coco_problem_duplicate(const coco_problem_t *other) {
 
   problem->evaluate_function = other->evaluate_function;
   problem->evaluate_constraint = other->evaluate_constraint;
+  problem->evaluate_function_batch = other->evaluate_function_batch;
   problem->recommend_solution = other->recommend_solution;
   problem->problem_free_function = other->problem_free_function;
+  problem->problem_clone_function = other->problem_clone_function;
   
   problem->versatile_data = other->versatile_data; /* Wassim: make the pointers the same*/
 
@@ -284,7 +455,14 @@ static coco_problem_t *coco_problem_allocate_from_scalars(const char *problem_na
 }
 
 void coco_problem_free(coco_problem_t *problem) {
+  coco_problem_t *clone_origin;
+
   assert(problem != NULL);
+  if (problem->reference_count > 1) {
+    /* The problem is still used by its clones and is freed together with the last one of them */
+    problem->reference_count--;
+    return;
+  }
   if (problem->problem_free_function != NULL) {
     problem->problem_free_function(problem);
   } else {
@@ -309,6 +487,8 @@ void coco_problem_free(coco_problem_t *problem) {
       coco_free_memory(problem->data);
     if (problem->initial_solution != NULL)
       coco_free_memory(problem->initial_solution);
+    if (problem->scratch != NULL)
+      coco_free_memory(problem->scratch);
     problem->smallest_values_of_interest = NULL;
     problem->largest_values_of_interest = NULL;
     problem->best_parameter = NULL;
@@ -317,8 +497,119 @@ void coco_problem_free(coco_problem_t *problem) {
     problem->suite = NULL;
     problem->data = NULL;
     problem->initial_solution = NULL;
+    problem->scratch = NULL;
+    clone_origin = problem->clone_origin;
     coco_free_memory(problem);
+    if (clone_origin != NULL)
+      coco_problem_free(clone_origin);
+  }
+}
+
+/**
+ * @brief Creates a duplicate of the problem to be used as its clone.
+ *
+ * Besides the fields copied by coco_problem_duplicate, the clone also takes over the gradient evaluation
+ * function, while its counters and best observed value are reset.
+ */
+static coco_problem_t *coco_problem_clone_duplicate(const coco_problem_t *problem) {
+  coco_problem_t *clone = coco_problem_duplicate(problem);
+
+  clone->evaluate_gradient = problem->evaluate_gradient;
+  clone->evaluations = 0;
+  clone->evaluations_constraints = 0;
+  clone->best_observed_fvalue[0] = DBL_MAX;
+  clone->best_observed_evaluation[0] = 0;
+  return clone;
+}
+
+/**
+ * @brief Returns a clone of the problem using its clone function.
+ */
+static coco_problem_t *coco_problem_clone_inner(const coco_problem_t *problem) {
+  if (problem->problem_clone_function == NULL) {
+    coco_error("coco_problem_clone(): problem %s cannot be cloned", problem->problem_id);
+    return NULL; /* Never reached */
   }
+  return problem->problem_clone_function(problem);
+}
+
+/**
+ * @brief Frees the clone of a basic problem leaving the data it shares with the original problem intact.
+ */
+static void coco_problem_basic_clone_free(coco_problem_t *problem) {
+  problem->data = NULL;
+  problem->problem_free_function = NULL;
+  coco_problem_free(problem);
+}
+
+/**
+ * @brief Clones a basic problem, whose data is not changed by the evaluations and can be shared.
+ */
+static coco_problem_t *coco_problem_basic_clone(const coco_problem_t *problem) {
+  coco_problem_t *clone = coco_problem_clone_duplicate(problem);
+
+  clone->data = problem->data;
+  clone->problem_free_function = coco_problem_basic_clone_free;
+  return clone;
+}
+
+/**
+ * Clones a problem so that the clone and the problem can be evaluated concurrently (in different threads).
+ * The clone shares all the data that is not changed by the evaluations (rotation matrices, optimal
+ * solutions, ...) with the problem, while it gets its own scratch memory and counters.
+ *
+ * Clones must be created and freed in the same thread as the problem. The problem can be freed before its
+ * clones, in which case the shared data is freed together with the last clone. The evaluations done on
+ * the clone can be added to those of the problem with coco_problem_merge_evaluations.
+ *
+ * @note Observed problems cannot be cloned, since the loggers write their output sequentially.
+ *
+ * @param problem The given COCO problem (or a clone of it).
+ *
+ * @return The clone of the problem.
+ */
+coco_problem_t *coco_problem_clone(coco_problem_t *problem) {
+  coco_problem_t *origin, *clone;
+
+  assert(problem != NULL);
+  origin = (problem->clone_origin != NULL) ? problem->clone_origin : problem;
+  clone = coco_problem_clone_inner(origin);
+  clone->clone_origin = origin;
+  origin->reference_count++;
+  return clone;
+}
+
+/**
+ * Adds the number of evaluations of the clone to those of the problem and updates the best observed value
+ * of the problem if the clone has found a better one (its evaluation number counts the evaluations of the
+ * problem first). The counters of the clone are then reset, so that the evaluations are merged only once.
+ *
+ * @param problem The given COCO problem.
+ * @param clone A clone of the problem obtained with coco_problem_clone.
+ */
+void coco_problem_merge_evaluations(coco_problem_t *problem, coco_problem_t *clone) {
+  coco_problem_t *origin;
+
+  assert(problem != NULL);
+  assert(clone != NULL);
+  origin = (problem->clone_origin != NULL) ? problem->clone_origin : problem;
+  if ((clone == problem) || (clone->clone_origin != origin)) {
+    coco_error("coco_problem_merge_evaluations(): %s is not a clone of %s", clone->problem_id,
+        problem->problem_id);
+    return; /* Never reached */
+  }
+
+  if ((clone->evaluations > 0) && (clone->best_observed_fvalue[0] < problem->best_observed_fvalue[0])) {
+    problem->best_observed_fvalue[0] = clone->best_observed_fvalue[0];
+    problem->best_observed_evaluation[0] = problem->evaluations + clone->best_observed_evaluation[0];
+  }
+  problem->evaluations += clone->evaluations;
+  problem->evaluations_constraints += clone->evaluations_constraints;
+
+  clone->evaluations = 0;
+  clone->evaluations_constraints = 0;
+  clone->best_observed_fvalue[0] = DBL_MAX;
+  clone->best_observed_evaluation[0] = 0;
 }
 
 /***********************************************************************************************************/
@@ -680,6 +971,29 @@ static void coco_problem_transformed_evaluate_function(coco_problem_t *problem,
   coco_evaluate_function(data->inner_problem, x, y);
 }
 
+/**
+ * @brief Calls the coco_evaluate_function_batch function on the inner problem.
+ *
+ * Transformations that replace evaluate_function without providing their own batch evaluation are
+ * evaluated point by point.
+ */
+static void coco_problem_transformed_evaluate_function_batch(coco_problem_t *problem,
+                                                             const size_t number_of_points,
+                                                             const double *x,
+                                                             double *y) {
+  coco_problem_transformed_data_t *data;
+  assert(problem != NULL);
+  assert(problem->data != NULL);
+  data = (coco_problem_transformed_data_t *) problem->data;
+  assert(data->inner_problem != NULL);
+
+  if (problem->evaluate_function != coco_problem_transformed_evaluate_function) {
+    coco_problem_evaluate_function_batch_loop(problem, number_of_points, x, y);
+    return;
+  }
+  coco_evaluate_function_batch(data->inner_problem, number_of_points, x, y);
+}
+
 /**
  * @brief Calls the coco_evaluate_constraint function on the inner problem.
  */
@@ -759,6 +1073,48 @@ static void coco_problem_transformed_free(coco_problem_t *problem) {
   coco_problem_transformed_free_data(problem);
 }
 
+/**
+ * @brief Frees the clone of a transformed problem leaving the data it shares with the original intact.
+ */
+static void coco_problem_transformed_clone_free(coco_problem_t *problem) {
+  coco_problem_transformed_data_t *data;
+
+  assert(problem != NULL);
+  assert(problem->data != NULL);
+  data = (coco_problem_transformed_data_t *) problem->data;
+  data->data = NULL;
+  data->data_free_function = NULL;
+  coco_problem_transformed_free(problem);
+}
+
+/**
+ * @brief Clones the transformed problem together with its inner problem.
+ *
+ * The data of the transformation is shared with the original problem, which is why only the transformations
+ * that do not change their data during evaluations may use this clone function.
+ */
+static coco_problem_t *coco_problem_transformed_clone(const coco_problem_t *problem) {
+  coco_problem_transformed_data_t *data, *clone_data;
+  coco_problem_t *clone;
+
+  assert(problem != NULL);
+  assert(problem->data != NULL);
+  data = (coco_problem_transformed_data_t *) problem->data;
+
+  clone_data = (coco_problem_transformed_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  clone_data->inner_problem = coco_problem_clone_inner(data->inner_problem);
+  clone_data->data = data->data;
+  clone_data->data_free_function = NULL;
+
+  clone = coco_problem_clone_duplicate(problem);
+  clone->data = clone_data;
+  clone->problem_free_function = coco_problem_transformed_clone_free;
+  /* The versatile data is passed through the layers and belongs to the (cloned) inner problem */
+  if (problem->versatile_data == data->inner_problem->versatile_data)
+    clone->versatile_data = clone_data->inner_problem->versatile_data;
+  return clone;
+}
+
 /**
  * @brief Allocates a transformed problem that wraps the inner_problem.
  *
@@ -782,8 +1138,10 @@ static coco_problem_t *coco_problem_transformed_allocate(coco_problem_t *inner_p
   inner_copy->evaluate_function = coco_problem_transformed_evaluate_function;
   inner_copy->evaluate_constraint = coco_problem_transformed_evaluate_constraint;
   inner_copy->evaluate_gradient = bbob_problem_transformed_evaluate_gradient;
+  inner_copy->evaluate_function_batch = coco_problem_transformed_evaluate_function_batch;
   inner_copy->recommend_solution = coco_problem_transformed_recommend_solution;
   inner_copy->problem_free_function = coco_problem_transformed_free;
+  inner_copy->problem_clone_function = coco_problem_transformed_clone;
   inner_copy->data = problem;
 
   coco_problem_set_name(inner_copy, "%s(%s)", name_prefix, old_name);
@@ -823,14 +1181,51 @@ static void coco_problem_stacked_evaluate_function(coco_problem_t *problem, cons
    * than the minimum's.
    */
   if (problem->number_of_constraints > 0) {
-    cons_values = coco_allocate_vector(problem->number_of_constraints);
+    cons_values = coco_problem_scratch_allocate(problem, problem->number_of_constraints);
     is_feasible = coco_is_feasible(problem, x, cons_values);
-    coco_free_memory(cons_values);   
+    coco_problem_scratch_free(problem, cons_values, problem->number_of_constraints);
     if (is_feasible)
       assert(y[0] + 1e-13 >= problem->best_value[0]);
   }
 }
 
+/**
+ * @brief Calls the coco_evaluate_function_batch function on the underlying problems.
+ */
+static void coco_problem_stacked_evaluate_function_batch(coco_problem_t *problem,
+                                                         const size_t number_of_points,
+                                                         const double *x,
+                                                         double *y) {
+  coco_problem_stacked_data_t* data = (coco_problem_stacked_data_t *) problem->data;
+
+  const size_t number_of_objectives_problem1 = coco_problem_get_number_of_objectives(data->problem1);
+  const size_t number_of_objectives_problem2 = coco_problem_get_number_of_objectives(data->problem2);
+  const size_t number_of_objectives = coco_problem_get_number_of_objectives(problem);
+  double *y1, *y2;
+  size_t i, k;
+
+  assert(number_of_objectives == number_of_objectives_problem1 + number_of_objectives_problem2);
+
+  /* The objective values of both problems are stored one after another and then interleaved */
+  y1 = coco_problem_scratch_allocate(problem, number_of_points * number_of_objectives);
+  y2 = y1 + number_of_points * number_of_objectives_problem1;
+  if (number_of_objectives_problem1 > 0)
+    coco_evaluate_function_batch(data->problem1, number_of_points, x, y1);
+  if (number_of_objectives_problem2 > 0)
+    coco_evaluate_function_batch(data->problem2, number_of_points, x, y2);
+
+  for (k = 0; k < number_of_points; k++) {
+    for (i = 0; i < number_of_objectives_problem1; i++)
+      y[k * number_of_objectives + i] = y1[k * number_of_objectives_problem1 + i];
+    for (i = 0; i < number_of_objectives_problem2; i++)
+      y[k * number_of_objectives + number_of_objectives_problem1 + i] = y2[k * number_of_objectives_problem2 + i];
+  }
+  coco_problem_scratch_free(problem, y1, number_of_points * number_of_objectives);
+
+  if (problem->number_of_constraints > 0)
+    coco_problem_batch_assert_best_value(problem, number_of_points, x, y);
+}
+
 /**
  * @brief Calls the coco_evaluate_constraint function on the underlying problems.
  */
@@ -875,6 +1270,51 @@ static void coco_problem_stacked_free(coco_problem_t *problem) {
   coco_problem_free(problem);
 }
 
+/**
+ * @brief Clones the stacked problem together with the two underlying problems.
+ */
+static coco_problem_t *coco_problem_stacked_clone(const coco_problem_t *problem) {
+  coco_problem_stacked_data_t *data, *clone_data;
+  coco_problem_t *clone;
+
+  assert(problem != NULL);
+  assert(problem->data != NULL);
+  data = (coco_problem_stacked_data_t *) problem->data;
+
+  clone_data = (coco_problem_stacked_data_t *) coco_allocate_memory(sizeof(*clone_data));
+  clone_data->problem1 = coco_problem_clone_inner(data->problem1);
+  clone_data->problem2 = coco_problem_clone_inner(data->problem2);
+
+  clone = coco_problem_clone_duplicate(problem);
+  clone->data = clone_data;
+  return clone;
+}
+
+/**
+ * @brief Updates the nadir values of the stacked problem with the objective values of its two components at
+ * the optima of the single-objective problems that the given problem consists of (the given problem can
+ * itself be a stacked problem, in which case its components are searched recursively).
+ */
+static void coco_problem_stacked_update_nadir(coco_problem_t *problem,
+                                              coco_problem_t *problem1,
+                                              coco_problem_t *problem2,
+                                              const coco_problem_t *component,
+                                              double *y) {
+  coco_problem_stacked_data_t *data;
+  size_t i;
+
+  if (component->problem_free_function == coco_problem_stacked_free) {
+    data = (coco_problem_stacked_data_t *) component->data;
+    coco_problem_stacked_update_nadir(problem, problem1, problem2, data->problem1, y);
+    coco_problem_stacked_update_nadir(problem, problem1, problem2, data->problem2, y);
+  } else if ((component->number_of_objectives == 1) && (component->best_parameter != NULL)) {
+    coco_evaluate_function(problem1, component->best_parameter, y);
+    coco_evaluate_function(problem2, component->best_parameter, y + problem1->number_of_objectives);
+    for (i = 0; i < problem->number_of_objectives; i++)
+      problem->nadir_value[i] = coco_double_max(problem->nadir_value[i], y[i]);
+  }
+}
+
 /**
  * @brief Allocates a problem constructed by stacking two COCO problems.
  * 
@@ -884,6 +1324,10 @@ static void coco_problem_stacked_free(coco_problem_t *problem) {
  *
  * @note Regions of interest in the decision space must either agree or at least one of them must be NULL.
  * @note Best parameter becomes somewhat meaningless, but the nadir value make sense now.
+ * @note Stacking a problem that is itself stacked results in a problem with more than two objectives (for
+ * example, three single-objective problems give a problem with three objectives). The ideal point then
+ * consists of the best values of the components and the nadir point is estimated by the largest objective
+ * values at the optima of all underlying single-objective problems.
  */
 static coco_problem_t *coco_problem_stacked_allocate(coco_problem_t *problem1, 
                                                      coco_problem_t *problem2,
@@ -891,10 +1335,12 @@ static coco_problem_t *coco_problem_stacked_allocate(coco_problem_t *problem1,
                                                      const double *largest_values_of_interest) {
 
   size_t number_of_variables, number_of_objectives, number_of_constraints;
-  size_t i;
+  size_t i, j;
   char *s;
+  double *y;
   coco_problem_stacked_data_t *data;
   coco_problem_t *problem; /* the new coco problem */
+  const coco_problem_t *component;
 
   assert(problem1);
   assert(problem2);
@@ -916,6 +1362,7 @@ static coco_problem_t *coco_problem_stacked_allocate(coco_problem_t *problem1,
   coco_free_memory(s);
 
   problem->evaluate_function = coco_problem_stacked_evaluate_function;
+  problem->evaluate_function_batch = coco_problem_stacked_evaluate_function_batch;
   if (number_of_constraints > 0)
     problem->evaluate_constraint = coco_problem_stacked_evaluate_constraint;
 
@@ -946,10 +1393,25 @@ static coco_problem_t *coco_problem_stacked_allocate(coco_problem_t *problem1,
     /* Compute the ideal and nadir values */
     assert(problem->nadir_value);
     
-    problem->best_value[0] = problem1->best_value[0];
-    problem->best_value[1] = problem2->best_value[0];
-    coco_evaluate_function(problem1, problem2->best_parameter, &problem->nadir_value[0]);
-    coco_evaluate_function(problem2, problem1->best_parameter, &problem->nadir_value[1]);
+    if (number_of_objectives == 2) {
+      problem->best_value[0] = problem1->best_value[0];
+      problem->best_value[1] = problem2->best_value[0];
+      coco_evaluate_function(problem1, problem2->best_parameter, &problem->nadir_value[0]);
+      coco_evaluate_function(problem2, problem1->best_parameter, &problem->nadir_value[1]);
+    } else {
+      /* Start from the nadir values of multi-objective components and the best values otherwise */
+      for (i = 0; i < number_of_objectives; i++) {
+        component = (i < problem1->number_of_objectives) ? problem1 : problem2;
+        j = (i < problem1->number_of_objectives) ? i : i - problem1->number_of_objectives;
+        problem->best_value[i] = component->best_value[j];
+        problem->nadir_value[i] = (component->nadir_value != NULL) ? component->nadir_value[j]
+            : component->best_value[j];
+      }
+      y = coco_allocate_vector(number_of_objectives);
+      coco_problem_stacked_update_nadir(problem, problem1, problem2, problem1, y);
+      coco_problem_stacked_update_nadir(problem, problem1, problem2, problem2, y);
+      coco_free_memory(y);
+    }
     
   }
 
@@ -960,6 +1422,7 @@ static coco_problem_t *coco_problem_stacked_allocate(coco_problem_t *problem1,
 
   problem->data = data;
   problem->problem_free_function = coco_problem_stacked_free;
+  problem->problem_clone_function = coco_problem_stacked_clone;
 
   return problem;
 }
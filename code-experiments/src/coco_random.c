@@ -7,6 +7,7 @@
  */
 
 #include <math.h>
+#include <string.h>
 
 #include "coco.h"
 #include <stdio.h>
@@ -16,6 +17,9 @@
 #define COCO_SHORT_LAG 273
 #define COCO_LONG_LAG 607
 
+/** @brief The number of uniform values generated at once by coco_random_normal_fill. */
+#define COCO_RANDOM_FILL_BLOCK_SIZE 240
+
 /**
  * @brief A structure containing the state of the COCO random generator.
  */
@@ -24,26 +28,33 @@ struct coco_random_state_s {
   size_t index;
 };
 
+/**
+ * @brief Computes x[i] = (x[i] + y[i]) mod 1 for i = 0, ..., n - 1, where all values are in [0, 1).
+ *
+ * The sum is in [0, 2), so subtracting its integer part gives the same result as subtracting 1 when the sum
+ * is at least 1, but without a (badly predictable) branch, which also lets the compiler vectorize the loop.
+ */
+static void coco_random_add_mod_one(double *x, const double *y, const size_t n) {
+  size_t i;
+  for (i = 0; i < n; ++i) {
+    const double t = x[i] + y[i];
+    x[i] = t - (double) (int) t;
+  }
+}
+
 /**
  * @brief A lagged Fibonacci random number generator.
  *
  * This generator is nice because it is reasonably small and directly generates double values. The chosen
  * lags (607 and 273) lead to a generator with a period in excess of 2^607-1.
+ *
+ * The first COCO_SHORT_LAG values only depend on values that have not been updated yet and the remaining
+ * ones on values that are at least COCO_SHORT_LAG positions before them, so both parts can be computed as
+ * element-wise sums.
  */
 static void coco_random_generate(coco_random_state_t *state) {
-  size_t i;
-  for (i = 0; i < COCO_SHORT_LAG; ++i) {
-    double t = state->x[i] + state->x[i + (COCO_LONG_LAG - COCO_SHORT_LAG)];
-    if (t >= 1.0)
-      t -= 1.0;
-    state->x[i] = t;
-  }
-  for (i = COCO_SHORT_LAG; i < COCO_LONG_LAG; ++i) {
-    double t = state->x[i] + state->x[i - COCO_SHORT_LAG];
-    if (t >= 1.0)
-      t -= 1.0;
-    state->x[i] = t;
-  }
+  coco_random_add_mod_one(state->x, state->x + (COCO_LONG_LAG - COCO_SHORT_LAG), COCO_SHORT_LAG);
+  coco_random_add_mod_one(state->x + COCO_SHORT_LAG, state->x, COCO_LONG_LAG - COCO_SHORT_LAG);
   state->index = 0;
 }
 
@@ -97,6 +108,193 @@ double coco_random_normal(coco_random_state_t *state) {
   return normal;
 }
 
+/**
+ * The values are copied from the state of the generator in blocks, so the result is the same as of
+ * number_of_values calls of coco_random_uniform.
+ */
+void coco_random_uniform_fill(coco_random_state_t *state, double *values, const size_t number_of_values) {
+  size_t i = 0, count;
+  while (i < number_of_values) {
+    if (state->index >= COCO_LONG_LAG)
+      coco_random_generate(state);
+    count = COCO_LONG_LAG - state->index;
+    if (count > number_of_values - i)
+      count = number_of_values - i;
+    memcpy(values + i, state->x + state->index, count * sizeof(double));
+    state->index += count;
+    i += count;
+  }
+}
+
+/**
+ * The uniform values are generated in blocks, so the result is the same as of number_of_values calls of
+ * coco_random_normal.
+ */
+void coco_random_normal_fill(coco_random_state_t *state, double *values, const size_t number_of_values) {
+#ifdef COCO_NORMAL_POLAR
+  const size_t uniforms_per_value = 2;
+#else
+  const size_t uniforms_per_value = 12;
+#endif
+  double uniform[COCO_RANDOM_FILL_BLOCK_SIZE];
+  const size_t block_size = COCO_RANDOM_FILL_BLOCK_SIZE / uniforms_per_value;
+  size_t i, k, count;
+
+  for (i = 0; i < number_of_values; i += count) {
+    count = (number_of_values - i < block_size) ? number_of_values - i : block_size;
+    coco_random_uniform_fill(state, uniform, count * uniforms_per_value);
+    for (k = 0; k < count; ++k) {
+#ifdef COCO_NORMAL_POLAR
+      values[i + k] = sqrt(-2 * log(uniform[2 * k])) * cos(2 * coco_pi * uniform[2 * k + 1]);
+#else
+      size_t j;
+      values[i + k] = 0.0;
+      for (j = 0; j < 12; ++j)
+        values[i + k] += uniform[12 * k + j];
+      values[i + k] -= 6.0;
+#endif
+    }
+  }
+}
+
+/**
+ * @brief A structure containing the state of a COCO random stream.
+ *
+ * A random stream is a counter-based generator (Philox4x32-10, see J. K. Salmon et al., "Parallel random
+ * numbers: as easy as 1, 2, 3", SC 2011): the value at some position of the stream is a bijective
+ * scrambling of the position and the stream identifier under a key derived from the seed. Streams with
+ * different identifiers are therefore independent, and any position can be reached in constant time.
+ */
+struct coco_random_stream_s {
+  uint32_t key[2];          /**< @brief The key (derived from the seed). */
+  uint32_t stream_id[2];    /**< @brief The stream identifier (lower and upper 32 bits). */
+  uint64_t position;        /**< @brief The position of the next value in the stream. */
+  uint64_t cached_block;    /**< @brief The block of the cached values. */
+  int has_cached_block;     /**< @brief Whether cached_values are valid. */
+  double cached_values[2];  /**< @brief The two values of cached_block. */
+};
+
+/**
+ * @brief Computes the Philox4x32-10 function of the given counter and key.
+ */
+static void coco_random_philox(const uint32_t *counter, const uint32_t *key, uint32_t *result) {
+  uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+  uint32_t k0 = key[0], k1 = key[1];
+  uint64_t product0, product1;
+  int round;
+
+  for (round = 0; round < 10; round++) {
+    product0 = (uint64_t) 0xD2511F53UL * c0;
+    product1 = (uint64_t) 0xCD9E8D57UL * c2;
+    c0 = (uint32_t) (product1 >> 32) ^ c1 ^ k0;
+    c2 = (uint32_t) (product0 >> 32) ^ c3 ^ k1;
+    c1 = (uint32_t) product1;
+    c3 = (uint32_t) product0;
+    k0 = (uint32_t) (k0 + 0x9E3779B9UL);
+    k1 = (uint32_t) (k1 + 0xBB67AE85UL);
+  }
+  result[0] = c0;
+  result[1] = c1;
+  result[2] = c2;
+  result[3] = c3;
+}
+
+/**
+ * @brief Computes the two uniform [0, 1) values (with 53 random bits each) of the given block of the stream.
+ */
+static void coco_random_stream_compute_block(const coco_random_stream_t *stream,
+                                             const uint64_t block,
+                                             double *values) {
+  uint32_t counter[4], result[4];
+
+  counter[0] = (uint32_t) block;
+  counter[1] = (uint32_t) (block >> 32);
+  counter[2] = stream->stream_id[0];
+  counter[3] = stream->stream_id[1];
+  coco_random_philox(counter, stream->key, result);
+  values[0] = ((double) (result[0] >> 5) * 67108864.0 + (double) (result[1] >> 6)) / 9007199254740992.0;
+  values[1] = ((double) (result[2] >> 5) * 67108864.0 + (double) (result[3] >> 6)) / 9007199254740992.0;
+}
+
+coco_random_stream_t *coco_random_stream_new(uint32_t seed, uint64_t stream_id) {
+  coco_random_stream_t *stream = (coco_random_stream_t *) coco_allocate_memory(sizeof(*stream));
+  stream->key[0] = seed;
+  stream->key[1] = 0x434F434FUL; /* "COCO" */
+  stream->stream_id[0] = (uint32_t) stream_id;
+  stream->stream_id[1] = (uint32_t) (stream_id >> 32);
+  stream->position = 0;
+  stream->cached_block = 0;
+  stream->has_cached_block = 0;
+  return stream;
+}
+
+void coco_random_stream_free(coco_random_stream_t *stream) {
+  coco_free_memory(stream);
+}
+
+void coco_random_stream_skip(coco_random_stream_t *stream, uint64_t number_of_values) {
+  stream->position += number_of_values;
+}
+
+double coco_random_stream_uniform(coco_random_stream_t *stream) {
+  const uint64_t block = stream->position >> 1;
+  if (!stream->has_cached_block || stream->cached_block != block) {
+    coco_random_stream_compute_block(stream, block, stream->cached_values);
+    stream->cached_block = block;
+    stream->has_cached_block = 1;
+  }
+  return stream->cached_values[stream->position++ & 1];
+}
+
+/**
+ * Uses the Box-Muller transformation of two uniform values (like coco_random_normal with COCO_NORMAL_POLAR).
+ */
+double coco_random_stream_normal(coco_random_stream_t *stream) {
+  const double u1 = coco_random_stream_uniform(stream);
+  const double u2 = coco_random_stream_uniform(stream);
+  /* 1 - u1 is in (0, 1], so that its logarithm is finite */
+  return sqrt(-2 * log(1.0 - u1)) * cos(2 * coco_pi * u2);
+}
+
+/**
+ * The blocks of the stream are independent of each other and computed directly into values, so the
+ * compiler can interleave (or vectorize) their computation. The result is the same as of number_of_values
+ * calls of coco_random_stream_uniform.
+ */
+void coco_random_stream_uniform_fill(coco_random_stream_t *stream,
+                                     double *values,
+                                     const size_t number_of_values) {
+  size_t i = 0;
+
+  if ((number_of_values > 0) && (stream->position & 1))
+    values[i++] = coco_random_stream_uniform(stream);
+  for (; i + 1 < number_of_values; i += 2) {
+    coco_random_stream_compute_block(stream, stream->position >> 1, values + i);
+    stream->position += 2;
+  }
+  if (i < number_of_values)
+    values[i] = coco_random_stream_uniform(stream);
+}
+
+/**
+ * The result is the same as of number_of_values calls of coco_random_stream_normal.
+ */
+void coco_random_stream_normal_fill(coco_random_stream_t *stream,
+                                    double *values,
+                                    const size_t number_of_values) {
+  double uniform[COCO_RANDOM_FILL_BLOCK_SIZE];
+  const size_t block_size = COCO_RANDOM_FILL_BLOCK_SIZE / 2;
+  size_t i, k, count;
+
+  for (i = 0; i < number_of_values; i += count) {
+    count = (number_of_values - i < block_size) ? number_of_values - i : block_size;
+    coco_random_stream_uniform_fill(stream, uniform, 2 * count);
+    for (k = 0; k < count; ++k)
+      values[i + k] = sqrt(-2 * log(1.0 - uniform[2 * k])) * cos(2 * coco_pi * uniform[2 * k + 1]);
+  }
+}
+
 /* Be hygienic (for amalgamation) and undef lags. */
 #undef COCO_SHORT_LAG
 #undef COCO_LONG_LAG
+#undef COCO_RANDOM_FILL_BLOCK_SIZE
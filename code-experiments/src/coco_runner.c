@@ -0,0 +1,325 @@
+/**
+ * @file coco_runner.c
+ * @brief Implementation of running a solver on all problems of a suite in several threads.
+ *
+ * The problems are put into a queue ordered by decreasing dimension (so that the longest runs start
+ * first) and each thread repeatedly takes the next problem from the queue until the queue is empty.
+ *
+ * Threads are only used if the code is compiled with COCO_THREADS defined and linked with the thread
+ * library of the platform (for example, -lpthread). Otherwise the problems are solved sequentially.
+ * Problems wrapped by an observer other than the bbob one are also solved sequentially (see
+ * coco_suite_run).
+ */
+
+#include "coco.h"
+#include "coco_internal.h"
+#include "coco_utilities.c"
+#include "coco_problem.c"
+#include "coco_observer.c"
+
+/**
+ * @brief The data shared by the threads of coco_suite_run.
+ *
+ * All accesses to the suite, the observer and the queue are serialized through the mutex.
+ */
+typedef struct {
+  coco_suite_t *suite;                /**< @brief The suite. */
+  coco_observer_t *observer;          /**< @brief The observer (can be NULL). */
+  coco_solver_function_t solver;      /**< @brief The solver. */
+  void *solver_data;                  /**< @brief The data passed to the solver. */
+  size_t *problem_indices;            /**< @brief The queue of problem indices. */
+  size_t number_of_problems;          /**< @brief The number of problems in the queue. */
+  size_t next_problem;                /**< @brief The position of the next problem in the queue. */
+  int is_parallel;                    /**< @brief Whether several threads are used (and the mutex exists). */
+#if defined(HAVE_PTHREAD)
+  pthread_mutex_t mutex;              /**< @brief The mutex. */
+#elif defined(HAVE_WIN_THREADS)
+  CRITICAL_SECTION mutex;             /**< @brief The mutex. */
+#endif
+} coco_runner_t;
+
+/**
+ * @brief Data type of the transformation that guards the first evaluation of an observed problem.
+ */
+typedef struct {
+  coco_runner_t *runner;
+} coco_runner_guard_data_t;
+
+/**
+ * @brief Locks the mutex of the runner.
+ */
+static void coco_runner_lock(coco_runner_t *runner) {
+  if (!runner->is_parallel)
+    return;
+#if defined(HAVE_PTHREAD)
+  pthread_mutex_lock(&runner->mutex);
+#elif defined(HAVE_WIN_THREADS)
+  EnterCriticalSection(&runner->mutex);
+#else
+  (void) runner; /* To silence the compiler */
+#endif
+}
+
+/**
+ * @brief Unlocks the mutex of the runner.
+ */
+static void coco_runner_unlock(coco_runner_t *runner) {
+  if (!runner->is_parallel)
+    return;
+#if defined(HAVE_PTHREAD)
+  pthread_mutex_unlock(&runner->mutex);
+#elif defined(HAVE_WIN_THREADS)
+  LeaveCriticalSection(&runner->mutex);
+#else
+  (void) runner; /* To silence the compiler */
+#endif
+}
+
+/**
+ * @brief Dispatches all evaluations of the guarded problem directly to the inner problem.
+ */
+static void coco_runner_guard_release(coco_problem_t *problem) {
+  problem->evaluate_function = coco_problem_transformed_evaluate_function;
+  problem->evaluate_function_batch = coco_problem_transformed_evaluate_function_batch;
+}
+
+/**
+ * @brief Evaluates the function while holding the mutex of the runner.
+ */
+static void coco_runner_guard_evaluate_function(coco_problem_t *problem, const double *x, double *y) {
+  coco_runner_guard_data_t *data = (coco_runner_guard_data_t *) coco_problem_transformed_get_data(problem);
+  coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  coco_runner_lock(data->runner);
+  coco_evaluate_function(inner_problem, x, y);
+  coco_runner_unlock(data->runner);
+  coco_runner_guard_release(problem);
+}
+
+/**
+ * @brief Evaluates the function in a batch of points while holding the mutex of the runner.
+ */
+static void coco_runner_guard_evaluate_function_batch(coco_problem_t *problem,
+                                                      const size_t number_of_points,
+                                                      const double *x,
+                                                      double *y) {
+  coco_runner_guard_data_t *data = (coco_runner_guard_data_t *) coco_problem_transformed_get_data(problem);
+  coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  coco_runner_lock(data->runner);
+  coco_evaluate_function_batch(inner_problem, number_of_points, x, y);
+  coco_runner_unlock(data->runner);
+  coco_runner_guard_release(problem);
+}
+
+/**
+ * @brief Wraps the observed problem so that its first function evaluation holds the mutex of the runner.
+ *
+ * Loggers (for example, the bbob logger) open their files and update the data of the observer on the
+ * first evaluation of the problem. The following evaluations only touch the data of the problem and its
+ * logger and are therefore not guarded.
+ */
+static coco_problem_t *coco_runner_guard(coco_runner_t *runner, coco_problem_t *inner_problem) {
+  coco_runner_guard_data_t *data;
+  coco_problem_t *problem;
+
+  data = (coco_runner_guard_data_t *) coco_allocate_memory(sizeof(*data));
+  data->runner = runner;
+
+  problem = coco_problem_transformed_allocate(inner_problem, data, NULL, "coco_runner_guard");
+  /* The guard is invisible to the solver */
+  coco_problem_set_name(problem, "%s", inner_problem->problem_name);
+  coco_problem_set_id(problem, "%s", inner_problem->problem_id);
+  problem->evaluate_function = coco_runner_guard_evaluate_function;
+  problem->evaluate_function_batch = coco_runner_guard_evaluate_function_batch;
+  return problem;
+}
+
+/**
+ * @brief Returns the indices of all problems of the suite that are not filtered out, ordered by
+ * decreasing dimension and otherwise in the order of coco_suite_get_next_problem.
+ */
+static size_t *coco_runner_get_problem_indices(const coco_suite_t *suite, size_t *number_of_problems) {
+  size_t *problem_indices;
+  size_t *dimension_used;
+  size_t i, function_idx, dimension_idx, instance_idx;
+  long largest_dimension_idx;
+
+  problem_indices = coco_allocate_vector_size_t(coco_suite_get_number_of_problems(suite));
+  dimension_used = coco_allocate_vector_size_t(suite->number_of_dimensions);
+  for (dimension_idx = 0; dimension_idx < suite->number_of_dimensions; dimension_idx++)
+    dimension_used[dimension_idx] = 0;
+
+  *number_of_problems = 0;
+  for (i = 0; i < suite->number_of_dimensions; i++) {
+    /* Find the largest dimension that has not been used yet */
+    largest_dimension_idx = -1;
+    for (dimension_idx = 0; dimension_idx < suite->number_of_dimensions; dimension_idx++) {
+      if (dimension_used[dimension_idx] || (suite->dimensions[dimension_idx] == 0))
+        continue;
+      if ((largest_dimension_idx < 0)
+          || (suite->dimensions[dimension_idx] > suite->dimensions[largest_dimension_idx]))
+        largest_dimension_idx = (long) dimension_idx;
+    }
+    if (largest_dimension_idx < 0)
+      break;
+    dimension_idx = (size_t) largest_dimension_idx;
+    dimension_used[dimension_idx] = 1;
+
+    for (function_idx = 0; function_idx < suite->number_of_functions; function_idx++) {
+      if (suite->functions[function_idx] == 0)
+        continue;
+      for (instance_idx = 0; instance_idx < suite->number_of_instances; instance_idx++) {
+        if (suite->instances[instance_idx] == 0)
+          continue;
+        problem_indices[(*number_of_problems)++] = coco_suite_encode_problem_index(suite, function_idx,
+            dimension_idx, instance_idx);
+      }
+    }
+  }
+
+  coco_free_memory(dimension_used);
+  return problem_indices;
+}
+
+/**
+ * @brief Solves the problems from the queue of the runner until the queue is empty.
+ */
+static void coco_runner_work(coco_runner_t *runner) {
+  coco_problem_t *problem;
+  size_t problem_index;
+
+  while (1) {
+    coco_runner_lock(runner);
+    if (runner->next_problem >= runner->number_of_problems) {
+      coco_runner_unlock(runner);
+      return;
+    }
+    problem_index = runner->problem_indices[runner->next_problem++];
+    problem = coco_suite_get_problem(runner->suite, problem_index);
+    if (runner->observer != NULL) {
+      problem = coco_problem_add_observer(problem, runner->observer);
+      problem = coco_runner_guard(runner, problem);
+    }
+    coco_runner_unlock(runner);
+
+    runner->solver(problem, runner->solver_data);
+
+    coco_runner_lock(runner);
+    coco_debug("coco_suite_run(): solved problem %s", coco_problem_get_id(problem));
+    coco_problem_free(problem);
+    coco_runner_unlock(runner);
+  }
+}
+
+#if defined(HAVE_PTHREAD)
+/**
+ * @brief The function run by each thread.
+ */
+static void *coco_runner_thread(void *runner) {
+  coco_runner_work((coco_runner_t *) runner);
+  return NULL;
+}
+#elif defined(HAVE_WIN_THREADS)
+/**
+ * @brief The function run by each thread.
+ */
+static DWORD WINAPI coco_runner_thread(LPVOID runner) {
+  coco_runner_work((coco_runner_t *) runner);
+  return 0;
+}
+#endif
+
+/**
+ * Each problem of the suite (that was not filtered out by the suite options) is created, wrapped by the
+ * observer and passed to the solver exactly once. The problems are solved in order of decreasing
+ * dimension by number_of_threads threads that take the next problem as soon as they are done with the
+ * previous one.
+ *
+ * The suite and the observer are only accessed by one thread at a time, while the solvers run in parallel.
+ * Only the loggers of the bbob observers ("bbob", "bbob-largescale" and "bbob-constrained") write the data
+ * of each problem into files that no other open logger uses. With these observers (or without an
+ * observer), if a solver uses only the problem it is given, the data logged for each problem is the same
+ * as in a sequential run, although the data of different problems might be grouped differently into the
+ * output files. The loggers of the other observers ("bbob-biobj", "toy", "rw", ...) share their output
+ * files, so with these observers the problems are always solved in the calling thread.
+ *
+ * If the code has been compiled without COCO_THREADS, the problems are solved sequentially (in the
+ * same order).
+ *
+ * @param suite The suite.
+ * @param observer The observer used to wrap the problems. If NULL, the problems are not observed.
+ * @param solver The solver called on each problem.
+ * @param solver_data The data passed to the solver.
+ * @param number_of_threads The number of threads (0 and 1 mean that the problems are solved in the
+ * calling thread, which is also the case for observers other than the bbob ones).
+ */
+void coco_suite_run(coco_suite_t *suite,
+                    coco_observer_t *observer,
+                    coco_solver_function_t solver,
+                    void *solver_data,
+                    const size_t number_of_threads) {
+  coco_runner_t runner;
+#if defined(HAVE_PTHREAD)
+  pthread_t *threads;
+#elif defined(HAVE_WIN_THREADS)
+  HANDLE *threads;
+#endif
+  size_t i;
+
+  assert(suite != NULL);
+  assert(solver != NULL);
+
+  runner.suite = suite;
+  runner.observer = observer;
+  runner.solver = solver;
+  runner.solver_data = solver_data;
+  runner.problem_indices = coco_runner_get_problem_indices(suite, &runner.number_of_problems);
+  runner.next_problem = 0;
+  runner.is_parallel = 0;
+
+  /* Only the loggers of the bbob observer never share their files */
+  if ((number_of_threads <= 1) || ((observer != NULL) && (observer->logger_allocate_function != logger_bbob))) {
+    if (number_of_threads > 1)
+      coco_info("coco_suite_run(): the loggers of observer %s share their files, solving the problems "
+          "sequentially", observer->observer_name);
+    coco_runner_work(&runner);
+    coco_free_memory(runner.problem_indices);
+    return;
+  }
+
+#if defined(HAVE_PTHREAD)
+  pthread_mutex_init(&runner.mutex, NULL);
+  runner.is_parallel = 1;
+  threads = (pthread_t *) coco_allocate_memory(number_of_threads * sizeof(pthread_t));
+  for (i = 0; i < number_of_threads; i++) {
+    if (pthread_create(&threads[i], NULL, coco_runner_thread, &runner) != 0)
+      coco_error("coco_suite_run(): failed to create thread %lu", (unsigned long) i);
+  }
+  for (i = 0; i < number_of_threads; i++)
+    pthread_join(threads[i], NULL);
+  coco_free_memory(threads);
+  pthread_mutex_destroy(&runner.mutex);
+#elif defined(HAVE_WIN_THREADS)
+  InitializeCriticalSection(&runner.mutex);
+  runner.is_parallel = 1;
+  threads = (HANDLE *) coco_allocate_memory(number_of_threads * sizeof(HANDLE));
+  for (i = 0; i < number_of_threads; i++) {
+    threads[i] = CreateThread(NULL, 0, coco_runner_thread, &runner, 0, NULL);
+    if (threads[i] == NULL)
+      coco_error("coco_suite_run(): failed to create thread %lu", (unsigned long) i);
+  }
+  for (i = 0; i < number_of_threads; i++) {
+    WaitForSingleObject(threads[i], INFINITE);
+    CloseHandle(threads[i]);
+  }
+  coco_free_memory(threads);
+  DeleteCriticalSection(&runner.mutex);
+#else
+  coco_info("coco_suite_run(): compiled without COCO_THREADS, solving the problems sequentially");
+  (void) i; /* To silence the compiler */
+  coco_runner_work(&runner);
+#endif
+
+  coco_free_memory(runner.problem_indices);
+}
@@ -86,6 +86,9 @@ void *coco_allocate_memory(const size_t size) {
   data = malloc(size);
   if (data == NULL)
     coco_error("coco_allocate_memory() failed.");
+#if defined(COCO_COUNT_ALLOCATIONS)
+  coco_allocate_memory_counter++;
+#endif
   return data;
 }
 
@@ -14,6 +14,7 @@
 #include "coco.h"
 #include "coco_internal.h"
 #include "coco_utilities.c"
+#include "coco_instance_cache.c"
 
 #include "suite_bbob.c"
 #include "suite_bbob_mixint.c"
@@ -22,6 +23,8 @@
 #include "suite_toy.c"
 #include "suite_largescale.c"
 #include "suite_cons_bbob.c"
+#include "transform_vars_fused.c"
+#include "f_fast_kernels.c"
 
 /** @brief The maximum number of different instances in a suite. */
 #define COCO_MAX_INSTANCES 1000
@@ -128,6 +131,11 @@ static coco_problem_t *coco_suite_get_problem_from_indices(coco_suite_t *suite,
     return NULL;
   }
 
+  if (suite->compiled)
+    problem = transform_vars_fused(problem);
+  if (suite->fast_kernels)
+    f_fast_kernels(problem);
+
   coco_problem_set_suite(problem, suite);
 
   return problem;
@@ -245,10 +253,17 @@ static coco_suite_t *coco_suite_allocate(const char *suite_name,
   suite->current_instance_idx = -1;
   suite->current_problem = NULL;
 
+  /* The instance data of the problems is cached while the suite exists */
+  coco_instance_cache_open();
+
   /* To be set in coco_suite_set_instance() */
   suite->number_of_instances = 0;
   suite->instances = NULL;
 
+  /* To be set in coco_suite() if needed */
+  suite->compiled = 0;
+  suite->fast_kernels = 0;
+
   /* To be set in particular suites if needed */
   suite->data = NULL;
   suite->data_free_function = NULL;
@@ -417,6 +432,8 @@ void coco_suite_free(coco_suite_t *suite) {
 
     coco_free_memory(suite);
     suite = NULL;
+
+    coco_instance_cache_close();
   }
 }
 
@@ -627,7 +644,17 @@ static int coco_suite_is_next_dimension_found(coco_suite_t *suite) {
  * - "function_indices: VALUES", where VALUES is a list or a range of function indices (starting from 1) to keep
  * in the suite, and
  * - "instance_indices: VALUES", where VALUES is a list or a range of instance indices (starting from 1) to keep
- * in the suite.
+ * in the suite, and
+ * - "compiled: 1", which fuses adjacent linear transformations of the problems into single affine
+ * transformations (see transform_vars_fused.c) for faster evaluation, and
+ * - "fast_kernels: 1", which evaluates the raw functions with reordered floating-point operations (see
+ * f_fast_kernels.c). The function values are not bit-for-bit identical to the default ones, but their
+ * relative error is below 1e-12, and
+ * - "instance_store: FILE_NAME", which reads the precomputed instance data (rotation matrices, optima and
+ * permutations) from the given instance store (see coco_instance_store_create) instead of computing it, and
+ * - "biobj_instance_file: FILE_NAME", which keeps the instances of the bi-objective suites that are not
+ * among the predefined ones (instances above 15) in the given file, so that the search for suitable instances
+ * of the underlying single-objective problems is done only once (see suite_biobj_set_instance_file).
  *
  * @return The constructed suite object.
  */
@@ -645,7 +672,8 @@ coco_suite_t *coco_suite(const char *suite_name, const char *suite_instance, con
   coco_option_keys_t *known_option_keys, *given_option_keys, *redundant_option_keys;
 
   /* Sets the valid keys for suite options and suite instance */
-  const char *known_keys_o[] = { "dimensions", "dimension_indices", "function_indices", "instance_indices" };
+  const char *known_keys_o[] = { "dimensions", "dimension_indices", "function_indices", "instance_indices",
+      "compiled", "fast_kernels", "instance_store", "biobj_instance_file" };
   const char *known_keys_i[] = { "year", "instances" };
 
   /* Initialize the suite */
@@ -757,6 +785,21 @@ coco_suite_t *coco_suite(const char *suite_name, const char *suite_instance, con
     }
     coco_free_memory(option_string);
 
+    if (coco_options_read_int(suite_options, "compiled", &(suite->compiled)) == 0)
+      suite->compiled = 0;
+    if (coco_options_read_int(suite_options, "fast_kernels", &(suite->fast_kernels)) == 0)
+      suite->fast_kernels = 0;
+
+    option_string = coco_allocate_string(COCO_PATH_MAX + 1);
+    if (coco_options_read_string(suite_options, "instance_store", option_string) > 0)
+      coco_instance_cache_open_store(option_string);
+    coco_free_memory(option_string);
+
+    option_string = coco_allocate_string(COCO_PATH_MAX + 1);
+    if (coco_options_read_string(suite_options, "biobj_instance_file", option_string) > 0)
+      suite_biobj_set_instance_file(suite, option_string);
+    coco_free_memory(option_string);
+
     /* Check for redundant option keys for suite options */
     known_option_keys = coco_option_keys_allocate(sizeof(known_keys_o) / sizeof(char *), known_keys_o);
     given_option_keys = coco_option_keys(suite_options);
@@ -923,3 +966,41 @@ void coco_suite_decode_problem_index(const coco_suite_t *suite,
   *dimension_idx = problem_index / (suite->number_of_instances * suite->number_of_functions);
 
 }
+
+/**
+ * All problems of the suite (after applying the suite instance and suite options) are constructed, while
+ * the instance cache (see coco_instance_cache.c) keeps all the data computed by the generators, which is
+ * then written to the file. The file can be given to coco_suite with the suite option
+ * "instance_store: FILE_NAME", so that the data is read from the file instead of being computed.
+ *
+ * The instance store can only be used on platforms with the same byte order and sizes of the basic types.
+ *
+ * @param file_name The name of the instance store file (an existing file is overwritten).
+ * @param suite_name The name of the suite (see coco_suite).
+ * @param suite_instance The suite instance (see coco_suite).
+ * @param suite_options The suite options (see coco_suite), for example, to choose the dimensions.
+ *
+ * @return The number of entries written to the instance store.
+ */
+size_t coco_instance_store_create(const char *file_name,
+                                  const char *suite_name,
+                                  const char *suite_instance,
+                                  const char *suite_options) {
+  coco_suite_t *suite;
+  size_t number_of_problems = 0, number_of_entries;
+
+  suite = coco_suite(suite_name, suite_instance, suite_options);
+  if (suite == NULL)
+    coco_error("coco_instance_store_create(): failed to construct suite '%s'", suite_name);
+
+  coco_instance_cache_set_recording(1);
+  while (coco_suite_get_next_problem(suite, NULL) != NULL)
+    number_of_problems++;
+  number_of_entries = coco_instance_cache_write_store(file_name);
+  coco_instance_cache_set_recording(0);
+  coco_suite_free(suite);
+
+  coco_info("coco_instance_store_create(): wrote %lu entries for %lu problems to '%s'",
+      (unsigned long) number_of_entries, (unsigned long) number_of_problems, file_name);
+  return number_of_entries;
+}
@@ -33,6 +33,18 @@ static const double chosen_precision = 1e-9;
  */
 static coco_log_level_type_e coco_log_level = COCO_INFO;
 
+#if defined(COCO_COUNT_ALLOCATIONS)
+/**
+ * @brief Counts the calls to coco_allocate_memory (used by the unit tests to check that no memory is
+ * allocated on the evaluation hot path).
+ *
+ * The counter is not synchronized, while memory is allocated from several threads when the code is compiled
+ * with COCO_THREADS. It is therefore only compiled into builds that define COCO_COUNT_ALLOCATIONS (the unit
+ * tests), where it is read while a single thread allocates memory.
+ */
+static size_t coco_allocate_memory_counter = 0;
+#endif
+
 /**
  * @param log_level Denotes the level of information given to the user through the standard output and
  * error streams. Can take on the values:
@@ -1122,6 +1134,48 @@ static double coco_vector_norm(const double *x, size_t dimension) {
   return sqrt(ssum);
 }
 
+/**
+ * @brief Returns the sum of the squares of the entries of x.
+ *
+ * The sum is computed in four independent partial sums, which allows the compiler to vectorize the loop.
+ * The result can therefore differ in the last bits from the sum computed in a single loop.
+ */
+static double coco_vector_sum_of_squares(const double *x, const size_t dimension) {
+
+  size_t i;
+  double ssum[4] = { 0.0, 0.0, 0.0, 0.0 };
+
+  for (i = 0; i + 4 <= dimension; i += 4) {
+    ssum[0] += x[i] * x[i];
+    ssum[1] += x[i + 1] * x[i + 1];
+    ssum[2] += x[i + 2] * x[i + 2];
+    ssum[3] += x[i + 3] * x[i + 3];
+  }
+  for (; i < dimension; ++i)
+    ssum[i % 4] += x[i] * x[i];
+
+  return (ssum[0] + ssum[1]) + (ssum[2] + ssum[3]);
+}
+
+/**
+ * @brief Allocates a vector of size dimension with the coefficients base^(scale * i / (dimension - 1)).
+ *
+ * These coefficients are used to condition the variables of many problems. Since they depend only on the
+ * dimension, they are computed once when the problem is constructed instead of in every evaluation. The
+ * exponents are computed in the same way as in the original evaluation loops, so that the values are
+ * exactly the same.
+ */
+static double *coco_allocate_conditioning_coefficients(const double base,
+                                                       const double scale,
+                                                       const size_t dimension) {
+  size_t i;
+  double *coefficients = coco_allocate_vector(dimension);
+
+  for (i = 0; i < dimension; ++i)
+    coefficients[i] = pow(base, scale * (double) (long) i / ((double) (long) dimension - 1.0));
+  return coefficients;
+}
+
 /**
  * @brief Checks if a given matrix M is orthogonal by (partially) computing M * M^T.
  * If M is a square matrix and M * M^T is close enough to the identity matrix
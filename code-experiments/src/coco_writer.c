@@ -0,0 +1,605 @@
+/**
+ * @file coco_writer.c
+ * @brief Implementation of a buffered writer of text files with a configurable flush policy.
+ *
+ * The loggers write many short lines, which used to be written with one fprintf per column and flushed
+ * after every line. The writer collects the text in its own buffer, formats numbers without going through
+ * stdio and flushes the file according to its flush policy:
+ * - COCO_WRITER_FLUSH_LINE flushes after every line (so that impatient users can see the progress),
+ * - COCO_WRITER_FLUSH_LINES flushes after every flush_lines lines,
+ * - COCO_WRITER_FLUSH_INTERVAL flushes after a line if at least flush_interval seconds passed since the
+ * last flush and
+ * - COCO_WRITER_FLUSH_END flushes only when the writer is closed (at the end of the problem).
+ *
+ * The formatted numbers are byte-identical to the output of the corresponding printf formats.
+ *
+ * A writer can be given an I/O thread (see coco_io_thread.c), to which it then passes its text instead of
+ * writing it to the file. The flushes are performed by the I/O thread as well, while closing the writer
+ * waits until all of its text has been written.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <time.h>
+#include <stdarg.h>
+#include <assert.h>
+
+#include "coco.h"
+#include "coco_utilities.c"
+#include "coco_string.c"
+#include "coco_io_thread.c"
+
+/** @brief The size of the buffer of a writer (in bytes). */
+#define COCO_WRITER_BUFFER_SIZE 65536
+
+/**
+ * @brief The flush policies of a writer.
+ */
+typedef enum {
+  COCO_WRITER_FLUSH_LINE,     /**< @brief Flush after every line. */
+  COCO_WRITER_FLUSH_LINES,    /**< @brief Flush after every flush_lines lines. */
+  COCO_WRITER_FLUSH_INTERVAL, /**< @brief Flush after a line once flush_interval seconds have passed. */
+  COCO_WRITER_FLUSH_END       /**< @brief Flush only when closing the writer. */
+} coco_writer_flush_policy_t;
+
+/**
+ * @brief The writer type.
+ */
+typedef struct {
+  FILE *file;                             /**< @brief The file (owned by the writer). */
+  char *buffer;                           /**< @brief The text not yet passed to the file. */
+  size_t length;                          /**< @brief The length of the text in the buffer. */
+  coco_writer_flush_policy_t flush_policy;/**< @brief The flush policy. */
+  size_t flush_lines;                     /**< @brief The number of lines between flushes. */
+  double flush_interval;                  /**< @brief The minimal number of seconds between flushes. */
+  size_t lines_since_flush;               /**< @brief The number of lines written since the last flush. */
+  time_t last_flush_time;                 /**< @brief The time of the last flush. */
+  coco_io_thread_t *io_thread;            /**< @brief The I/O thread (NULL if the writer writes the file). */
+} coco_writer_t;
+
+/** @brief The powers of ten that are exactly representable as doubles. */
+static const double coco_writer_powers_of_ten[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+    1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+/**
+ * @brief Writes the decimal representation of value to buffer (without a terminating zero) and returns its
+ * length.
+ */
+static size_t coco_format_unsigned_long(char *buffer, unsigned long value) {
+  char digits[24];
+  size_t length = 0, i;
+
+  do {
+    digits[length++] = (char) ('0' + value % 10);
+    value /= 10;
+  } while (value > 0);
+  for (i = 0; i < length; i++)
+    buffer[i] = digits[length - 1 - i];
+  return length;
+}
+
+/**
+ * @brief Writes value to buffer as printf("%d") would (without a terminating zero) and returns the length.
+ */
+static size_t coco_format_int(char *buffer, const int value) {
+  if (value < 0) {
+    buffer[0] = '-';
+    return 1 + coco_format_unsigned_long(buffer + 1, 0UL - (unsigned long) value);
+  }
+  return coco_format_unsigned_long(buffer, (unsigned long) value);
+}
+
+/**
+ * @brief Returns value * 10^shift for |shift| <= 44 (with at most two rounding errors) or -1 otherwise.
+ */
+static double coco_format_scale(const double value, const int shift) {
+  if (shift >= 0 && shift <= 22)
+    return value * coco_writer_powers_of_ten[shift];
+  else if (shift < 0 && shift >= -22)
+    return value / coco_writer_powers_of_ten[-shift];
+  else if (shift > 22 && shift <= 44)
+    return value * coco_writer_powers_of_ten[22] * coco_writer_powers_of_ten[shift - 22];
+  else if (shift < -22 && shift >= -44)
+    return value / coco_writer_powers_of_ten[22] / coco_writer_powers_of_ten[-shift - 22];
+  return -1;
+}
+
+/**
+ * @brief Writes value to buffer as sprintf(buffer, "%+*.*e", width, precision, value) would and returns the
+ * length of the result.
+ *
+ * The digits are computed by scaling the value with a power of ten, which is exact up to a few units in the
+ * last place. If the scaled value is too close to the middle between two integers to decide the rounding
+ * (or the value is zero, infinite, NaN or out of range), sprintf is used instead, so that the result is
+ * always the same as with sprintf. The buffer must be able to hold at least width + 32 characters.
+ */
+static size_t coco_format_exponential(char *buffer, const double value, const int width, const int precision) {
+  double absolute, scaled, digits, fraction, high;
+  unsigned long low_digits, high_digits;
+  int exponent, i, attempt;
+  size_t length = 0;
+
+  absolute = fabs(value);
+  if ((precision < 1) || (precision > 9) || !(absolute >= 1e-300) || !(absolute <= 1e300))
+    return (size_t) sprintf(buffer, "%+*.*e", width, precision, value);
+
+  /* Find the exponent such that 10^precision <= scaled < 10^(precision + 1) */
+  exponent = (int) floor(log10(absolute));
+  scaled = coco_format_scale(absolute, precision - exponent);
+  for (attempt = 0; attempt < 2; attempt++) {
+    if (scaled >= coco_writer_powers_of_ten[precision + 1])
+      exponent++;
+    else if ((scaled >= 0) && (scaled < coco_writer_powers_of_ten[precision]))
+      exponent--;
+    else
+      break;
+    scaled = coco_format_scale(absolute, precision - exponent);
+  }
+  digits = floor(scaled);
+  fraction = scaled - digits;
+  if ((scaled < 0) || (fabs(fraction - 0.5) < 1e-4))
+    return (size_t) sprintf(buffer, "%+*.*e", width, precision, value);
+  if (fraction > 0.5)
+    digits += 1;
+  if (digits >= coco_writer_powers_of_ten[precision + 1]) {
+    digits = coco_writer_powers_of_ten[precision];
+    exponent++;
+  }
+
+  /* The digits are split into two parts that fit into unsigned long */
+  high = floor(digits / 1e5);
+  high_digits = (unsigned long) high;
+  low_digits = (unsigned long) (digits - high * 1e5);
+
+  buffer[length++] = (value < 0) ? '-' : '+';
+  for (i = precision; i >= 0; i--) {
+    unsigned long digit;
+    if (precision - i < 5) {
+      digit = low_digits % 10;
+      low_digits /= 10;
+    } else {
+      digit = high_digits % 10;
+      high_digits /= 10;
+    }
+    /* The position of digit i (0 is the digit before the decimal point) */
+    buffer[length + (size_t) i + (i > 0 ? 1 : 0)] = (char) ('0' + digit);
+  }
+  buffer[length + 1] = '.';
+  length += (size_t) precision + 2;
+
+  buffer[length++] = 'e';
+  buffer[length++] = (exponent < 0) ? '-' : '+';
+  if (exponent < 0)
+    exponent = -exponent;
+  if (exponent < 10)
+    buffer[length++] = '0';
+  length += coco_format_unsigned_long(buffer + length, (unsigned long) exponent);
+
+  /* Right-justify the result in the given width */
+  if (length < (size_t) width) {
+    memmove(buffer + (size_t) width - length, buffer, length);
+    memset(buffer, ' ', (size_t) width - length);
+    length = (size_t) width;
+  }
+  buffer[length] = '\0';
+  return length;
+}
+
+/**
+ * @brief Reads the options "flush_policy", "flush_lines" and "flush_interval" of an observer (see
+ * observer_bbob) and returns the flush policy, which is default_policy if the option is not given.
+ *
+ * The default number of lines is 100 and the default interval 10 seconds.
+ */
+static coco_writer_flush_policy_t coco_writer_read_flush_options(const char *options,
+                                                                 const char *observer_name,
+                                                                 const coco_writer_flush_policy_t default_policy,
+                                                                 size_t *flush_lines,
+                                                                 double *flush_interval) {
+  const char *policy_names[] = { "line", "lines", "interval", "end" };
+  coco_writer_flush_policy_t flush_policy = default_policy;
+  char string_value[COCO_PATH_MAX + 1];
+  size_t i;
+
+  if (coco_options_read_string(options, "flush_policy", string_value) > 0) {
+    for (i = 0; i < sizeof(policy_names) / sizeof(char *); i++) {
+      if (strcmp(string_value, policy_names[i]) == 0)
+        break;
+    }
+    if (i < sizeof(policy_names) / sizeof(char *))
+      flush_policy = (coco_writer_flush_policy_t) i;
+    else
+      coco_warning("observer_%s(): unknown flush_policy '%s', using '%s'", observer_name, string_value,
+          policy_names[default_policy]);
+  }
+
+  *flush_lines = 100;
+  if (coco_options_read_size_t(options, "flush_lines", flush_lines) != 0) {
+    if (*flush_lines == 0)
+      *flush_lines = 100;
+  }
+
+  *flush_interval = 10;
+  if (coco_options_read_double(options, "flush_interval", flush_interval) != 0) {
+    if (*flush_interval < 0)
+      *flush_interval = 10;
+  }
+  return flush_policy;
+}
+
+/**
+ * @brief Creates a writer for the given (opened) file, which is closed together with the writer.
+ *
+ * If io_thread is not NULL, the text is written by the I/O thread.
+ */
+static coco_writer_t *coco_writer(FILE *file,
+                                  const coco_writer_flush_policy_t flush_policy,
+                                  const size_t flush_lines,
+                                  const double flush_interval,
+                                  coco_io_thread_t *io_thread) {
+  coco_writer_t *writer = (coco_writer_t *) coco_allocate_memory(sizeof(*writer));
+  writer->file = file;
+  writer->buffer = coco_allocate_string(COCO_WRITER_BUFFER_SIZE);
+  writer->length = 0;
+  writer->flush_policy = flush_policy;
+  writer->flush_lines = (flush_lines > 0) ? flush_lines : 1;
+  writer->flush_interval = flush_interval;
+  writer->lines_since_flush = 0;
+  writer->last_flush_time = time(NULL);
+  writer->io_thread = io_thread;
+  if (io_thread != NULL)
+    coco_io_thread_retain(io_thread);
+  return writer;
+}
+
+/**
+ * @brief Passes a copy of the buffered text to the I/O thread together with the given action and returns
+ * the sequence number of the job.
+ */
+static size_t coco_writer_submit(coco_writer_t *writer, const coco_io_action_t action) {
+  char *data = NULL;
+
+  if (writer->length > 0) {
+    data = (char *) coco_allocate_memory(writer->length);
+    memcpy(data, writer->buffer, writer->length);
+  }
+  return coco_io_thread_submit(writer->io_thread, writer->file, data, writer->length, action);
+}
+
+/**
+ * @brief Passes the buffered text to the file (without flushing the file).
+ */
+static void coco_writer_empty_buffer(coco_writer_t *writer) {
+  if (writer->length > 0) {
+    if (writer->io_thread != NULL)
+      coco_writer_submit(writer, COCO_IO_WRITE);
+    else
+      fwrite(writer->buffer, 1, writer->length, writer->file);
+    writer->length = 0;
+  }
+}
+
+/**
+ * @brief Makes sure that the buffer has room for the given number of characters (at most
+ * COCO_WRITER_BUFFER_SIZE).
+ */
+static void coco_writer_reserve(coco_writer_t *writer, const size_t length) {
+  assert(length <= COCO_WRITER_BUFFER_SIZE);
+  if (writer->length + length > COCO_WRITER_BUFFER_SIZE)
+    coco_writer_empty_buffer(writer);
+}
+
+/**
+ * @brief Writes the buffered text to the file and flushes it.
+ */
+static void coco_writer_flush(coco_writer_t *writer) {
+  if (writer->io_thread != NULL) {
+    coco_writer_submit(writer, COCO_IO_FLUSH);
+    writer->length = 0;
+  } else {
+    coco_writer_empty_buffer(writer);
+    fflush(writer->file);
+  }
+  writer->lines_since_flush = 0;
+  writer->last_flush_time = time(NULL);
+}
+
+/**
+ * @brief Writes the string.
+ */
+static void coco_writer_write_string(coco_writer_t *writer, const char *string) {
+  size_t length = strlen(string);
+
+  if (length > COCO_WRITER_BUFFER_SIZE) {
+    coco_writer_empty_buffer(writer);
+    if (writer->io_thread != NULL)
+      coco_io_thread_submit(writer->io_thread, writer->file, coco_strdup(string), length, COCO_IO_WRITE);
+    else
+      fwrite(string, 1, length, writer->file);
+    return;
+  }
+  coco_writer_reserve(writer, length);
+  memcpy(writer->buffer + writer->length, string, length);
+  writer->length += length;
+}
+
+/**
+ * @brief Writes the character.
+ */
+static void coco_writer_write_char(coco_writer_t *writer, const char character) {
+  coco_writer_reserve(writer, 1);
+  writer->buffer[writer->length++] = character;
+}
+
+/**
+ * @brief Writes the value as printf("%lu") would.
+ */
+static void coco_writer_write_unsigned_long(coco_writer_t *writer, const unsigned long value) {
+  coco_writer_reserve(writer, 24);
+  writer->length += coco_format_unsigned_long(writer->buffer + writer->length, value);
+}
+
+/**
+ * @brief Writes the value as printf("%d") would.
+ */
+static void coco_writer_write_int(coco_writer_t *writer, const int value) {
+  coco_writer_reserve(writer, 24);
+  writer->length += coco_format_int(writer->buffer + writer->length, value);
+}
+
+/**
+ * @brief Writes the value as printf("%+*.*e", width, precision, value) would (width must be below 64).
+ */
+static void coco_writer_write_exponential(coco_writer_t *writer,
+                                          const double value,
+                                          const int width,
+                                          const int precision) {
+  assert((width >= 0) && (width < 64) && (precision >= 0) && (precision < 64));
+  coco_writer_reserve(writer, 160);
+  writer->length += coco_format_exponential(writer->buffer + writer->length, value, width, precision);
+}
+
+/**
+ * @brief Writes the text of the given length.
+ */
+static void coco_writer_write_text(coco_writer_t *writer, const char *text, size_t length) {
+  size_t chunk;
+
+  while (length > 0) {
+    chunk = (length < COCO_WRITER_BUFFER_SIZE) ? length : COCO_WRITER_BUFFER_SIZE;
+    coco_writer_reserve(writer, chunk);
+    memcpy(writer->buffer + writer->length, text, chunk);
+    writer->length += chunk;
+    text += chunk;
+    length -= chunk;
+  }
+}
+
+/**
+ * @brief Writes one conversion of a printf format (given by its flags, width, precision, length modifier and
+ * conversion character, where width and precision are negative if absent) with the next argument.
+ *
+ * Integers and exponential formats without flags other than '+' are formatted directly into the buffer,
+ * everything else with sprintf into room in the buffer that is reserved for the longest possible result of
+ * the conversion. Calls coco_error if the result could be longer than COCO_WRITER_BUFFER_SIZE.
+ */
+static void coco_writer_write_conversion(coco_writer_t *writer,
+                                         const char *flags,
+                                         const int width,
+                                         const int precision,
+                                         const int is_long,
+                                         const char conversion,
+                                         va_list *args) {
+  char spec[40], *position;
+  const char *string;
+  double value;
+  size_t bound, length = 0;
+
+  /* The printf format of the conversion */
+  spec[length++] = '%';
+  memcpy(spec + length, flags, strlen(flags));
+  length += strlen(flags);
+  if (width >= 0)
+    length += coco_format_int(spec + length, width);
+  if (precision >= 0) {
+    spec[length++] = '.';
+    length += coco_format_int(spec + length, precision);
+  }
+  if (is_long)
+    spec[length++] = 'l';
+  spec[length++] = conversion;
+  spec[length] = '\0';
+
+  bound = (size_t) ((width > 0) ? width : 0) + (size_t) ((precision > 0) ? precision : 0) + 32;
+  switch (conversion) {
+    case 'd':
+    case 'i':
+    case 'u':
+    case 'c':
+      if (bound > COCO_WRITER_BUFFER_SIZE)
+        break;
+      coco_writer_reserve(writer, bound);
+      position = writer->buffer + writer->length;
+      if ((width < 0) && (precision < 0) && (*flags == '\0') && (conversion != 'c')) {
+        if (conversion == 'u')
+          writer->length += coco_format_unsigned_long(position,
+              is_long ? va_arg(*args, unsigned long) : (unsigned long) va_arg(*args, unsigned int));
+        else if (is_long)
+          writer->length += (size_t) sprintf(position, "%ld", va_arg(*args, long));
+        else
+          writer->length += coco_format_int(position, va_arg(*args, int));
+      } else if (conversion == 'u') {
+        writer->length += (size_t) (is_long ? sprintf(position, spec, va_arg(*args, unsigned long))
+            : sprintf(position, spec, va_arg(*args, unsigned int)));
+      } else {
+        writer->length += (size_t) (is_long ? sprintf(position, spec, va_arg(*args, long))
+            : sprintf(position, spec, va_arg(*args, int)));
+      }
+      return;
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'f':
+      /* %f writes all digits before the decimal point (up to 309 for the largest doubles) */
+      if (conversion == 'f')
+        bound += DBL_MAX_10_EXP + 1;
+      if (bound > COCO_WRITER_BUFFER_SIZE)
+        break;
+      value = va_arg(*args, double);
+      coco_writer_reserve(writer, bound);
+      position = writer->buffer + writer->length;
+      if ((conversion == 'e') && ((*flags == '\0') || (strcmp(flags, "+") == 0))) {
+        length = coco_format_exponential(position, value, 0, (precision >= 0) ? precision : 6);
+        /* coco_format_exponential always writes the sign */
+        if ((*flags == '\0') && (position[0] == '+'))
+          memmove(position, position + 1, length--);
+        if ((width > 0) && ((size_t) width > length)) {
+          memmove(position + (size_t) width - length, position, length);
+          memset(position, ' ', (size_t) width - length);
+          length = (size_t) width;
+        }
+        writer->length += length;
+      } else {
+        writer->length += (size_t) sprintf(position, spec, value);
+      }
+      return;
+    case 's':
+      string = va_arg(*args, const char *);
+      if ((width < 0) && (precision < 0)) {
+        coco_writer_write_text(writer, string, strlen(string));
+        return;
+      }
+      length = strlen(string);
+      if ((precision >= 0) && ((size_t) precision < length))
+        length = (size_t) precision;
+      bound = ((width > 0) && ((size_t) width > length)) ? (size_t) width + 1 : length + 1;
+      if (bound > COCO_WRITER_BUFFER_SIZE)
+        break;
+      coco_writer_reserve(writer, bound);
+      writer->length += (size_t) sprintf(writer->buffer + writer->length, spec, string);
+      return;
+    default:
+      coco_error("coco_writer_write_formatted(): unsupported conversion '%s'", spec);
+      return; /* Never reached */
+  }
+  coco_error("coco_writer_write_formatted(): the conversion '%s' is too long", spec);
+}
+
+/**
+ * @brief Writes the arguments formatted as by printf.
+ *
+ * The format is parsed here and each conversion is written straight into the buffer (see
+ * coco_writer_write_conversion), so that the length of the result is only bounded by
+ * COCO_WRITER_BUFFER_SIZE for each conversion. The supported conversions are d, i, u, c, e, E, f, g, G, s and
+ * %, with the flags -+ #0, a width and a precision (also given as *) and the length modifier l.
+ */
+static void coco_writer_write_formatted(coco_writer_t *writer, const char *format, ...) {
+  va_list args;
+  char flags[8];
+  size_t number_of_flags;
+  int width, precision, is_long;
+  const char *text;
+
+  va_start(args, format);
+  while (*format != '\0') {
+    text = format;
+    while ((*format != '\0') && (*format != '%'))
+      format++;
+    coco_writer_write_text(writer, text, (size_t) (format - text));
+    if (*format == '\0')
+      break;
+    format++;
+    if (*format == '%') {
+      coco_writer_write_char(writer, '%');
+      format++;
+      continue;
+    }
+    number_of_flags = 0;
+    while ((*format != '\0') && (strchr("-+ #0", *format) != NULL)) {
+      if (number_of_flags < sizeof(flags) - 1)
+        flags[number_of_flags++] = *format;
+      format++;
+    }
+    flags[number_of_flags] = '\0';
+    width = -1;
+    if (*format == '*') {
+      width = va_arg(args, int);
+      if (width < 0) {
+        /* A negative width is taken as the flag - followed by a positive width */
+        if (number_of_flags < sizeof(flags) - 1) {
+          flags[number_of_flags++] = '-';
+          flags[number_of_flags] = '\0';
+        }
+        width = -width;
+      }
+      format++;
+    } else if ((*format >= '0') && (*format <= '9')) {
+      for (width = 0; (*format >= '0') && (*format <= '9'); format++)
+        width = 10 * width + (*format - '0');
+    }
+    precision = -1;
+    if (*format == '.') {
+      format++;
+      if (*format == '*') {
+        precision = va_arg(args, int);
+        format++;
+      } else {
+        for (precision = 0; (*format >= '0') && (*format <= '9'); format++)
+          precision = 10 * precision + (*format - '0');
+      }
+    }
+    is_long = (*format == 'l');
+    if (is_long)
+      format++;
+    if (*format == '\0')
+      coco_error("coco_writer_write_formatted(): incomplete conversion at the end of the format");
+    coco_writer_write_conversion(writer, flags, width, precision, is_long, *format, &args);
+    format++;
+  }
+  va_end(args);
+}
+
+/**
+ * @brief Ends the current line and flushes the file if required by the flush policy.
+ */
+static void coco_writer_end_line(coco_writer_t *writer) {
+  coco_writer_write_char(writer, '\n');
+  writer->lines_since_flush++;
+  switch (writer->flush_policy) {
+    case COCO_WRITER_FLUSH_LINE:
+      coco_writer_flush(writer);
+      break;
+    case COCO_WRITER_FLUSH_LINES:
+      if (writer->lines_since_flush >= writer->flush_lines)
+        coco_writer_flush(writer);
+      break;
+    case COCO_WRITER_FLUSH_INTERVAL:
+      if (difftime(time(NULL), writer->last_flush_time) >= writer->flush_interval)
+        coco_writer_flush(writer);
+      break;
+    case COCO_WRITER_FLUSH_END:
+      break;
+  }
+}
+
+/**
+ * @brief Flushes and closes the file and frees the writer.
+ *
+ * With an I/O thread, waits until the file has been closed.
+ */
+static void coco_writer_close(coco_writer_t *writer) {
+  if (writer == NULL)
+    return;
+  if (writer->io_thread != NULL) {
+    coco_io_thread_wait(writer->io_thread, coco_writer_submit(writer, COCO_IO_CLOSE));
+    coco_io_thread_release(writer->io_thread);
+  } else {
+    coco_writer_empty_buffer(writer);
+    fclose(writer->file);
+  }
+  coco_free_memory(writer->buffer);
+  coco_free_memory(writer);
+}
@@ -16,6 +16,7 @@
 #include "transform_vars_shift.c"
 #include "transform_vars_permutation.c"
 #include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_vars_conditioning.c"
 #include "transform_obj_norm_by_dim.c"
 
@@ -197,13 +198,9 @@ static coco_problem_t *f_attractive_sector_permblockdiag_bbob_problem_allocate(c
   problem = transform_obj_power(problem, 0.9);
   problem = transform_obj_shift(problem, fopt);
 
-  problem = transform_vars_permutation(problem, P22, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
-  problem = transform_vars_permutation(problem, P21, dimension);
+  problem = transform_vars_permblockdiag(problem, B1_copy, P21, P22, dimension, block_sizes1, nb_blocks1);
   problem = transform_vars_conditioning(problem, condition);
-  problem = transform_vars_permutation(problem, P12, dimension);
-  problem = transform_vars_blockrotation(problem, B2_copy, dimension, block_sizes2, nb_blocks2);
-  problem = transform_vars_permutation(problem, P11, dimension);
+  problem = transform_vars_permblockdiag(problem, B2_copy, P11, P12, dimension, block_sizes2, nb_blocks2);
   problem = transform_vars_shift(problem, xopt, 0);
   
   coco_problem_set_id(problem, problem_id_template, function, instance, dimension);
@@ -43,6 +43,25 @@ static void f_bent_cigar_evaluate(coco_problem_t *problem, const double *x, doub
   
 }
 
+/**
+ * @brief Implements the bent cigar function with reordered floating-point operations (see f_fast_kernels.c).
+ */
+static double f_bent_cigar_raw_fast(const double *x, const size_t number_of_variables) {
+
+  static const double condition = 1.0e6;
+
+  return x[0] * x[0] + condition * coco_vector_sum_of_squares(x + 1, number_of_variables - 1);
+}
+
+/**
+ * @brief Uses the fast raw function to evaluate the COCO problem (see f_fast_kernels.c).
+ */
+static void f_bent_cigar_evaluate_fast(coco_problem_t *problem, const double *x, double *y) {
+  assert(problem->number_of_objectives == 1);
+  y[0] = f_bent_cigar_raw_fast(x, problem->number_of_variables);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Evaluates the gradient of the bent cigar function.
  */
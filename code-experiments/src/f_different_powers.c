@@ -14,6 +14,7 @@
 #include "transform_vars_shift.c"
 #include "transform_vars_permutation.c"
 #include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_obj_norm_by_dim.c"
 
 /**
@@ -46,6 +47,31 @@ static void f_different_powers_evaluate(coco_problem_t *problem, const double *x
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Implements the different powers function with reordered floating-point operations (see
+ * f_fast_kernels.c).
+ */
+static double f_different_powers_raw_fast(const double *x, const size_t number_of_variables) {
+
+  size_t i;
+  double sum = 0.0;
+  const double step = 4.0 / ((double) (long) number_of_variables - 1.0);
+
+  for (i = 0; i < number_of_variables; ++i)
+    sum += pow(fabs(x[i]), 2.0 + step * (double) (long) i);
+
+  return sqrt(sum);
+}
+
+/**
+ * @brief Uses the fast raw function to evaluate the COCO problem (see f_fast_kernels.c).
+ */
+static void f_different_powers_evaluate_fast(coco_problem_t *problem, const double *x, double *y) {
+  assert(problem->number_of_objectives == 1);
+  y[0] = f_different_powers_raw_fast(x, problem->number_of_variables);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Implements the sign function.
  */
@@ -235,9 +261,7 @@ static coco_problem_t *f_different_powers_permblockdiag_bbob_problem_allocate(co
   coco_compute_truncated_uniform_swap_permutation(P2, rseed + 3000000, dimension, nb_swaps, swap_range);
 
   problem = f_different_powers_allocate(dimension);
-  problem = transform_vars_permutation(problem, P2, dimension);
-  problem = transform_vars_blockrotation(problem, B_copy, dimension, block_sizes, nb_blocks);
-  problem = transform_vars_permutation(problem, P1, dimension);
+  problem = transform_vars_permblockdiag(problem, B_copy, P1, P2, dimension, block_sizes, nb_blocks);
   problem = transform_vars_shift(problem, xopt, 0);
 
   problem = transform_obj_norm_by_dim(problem);
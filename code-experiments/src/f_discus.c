@@ -42,6 +42,25 @@ static void f_discus_evaluate(coco_problem_t *problem, const double *x, double *
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Implements the discus function with reordered floating-point operations (see f_fast_kernels.c).
+ */
+static double f_discus_raw_fast(const double *x, const size_t number_of_variables) {
+
+  static const double condition = 1.0e6;
+
+  return condition * x[0] * x[0] + coco_vector_sum_of_squares(x + 1, number_of_variables - 1);
+}
+
+/**
+ * @brief Uses the fast raw function to evaluate the COCO problem (see f_fast_kernels.c).
+ */
+static void f_discus_evaluate_fast(coco_problem_t *problem, const double *x, double *y) {
+  assert(problem->number_of_objectives == 1);
+  y[0] = f_discus_raw_fast(x, problem->number_of_variables);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Evaluates the gradient of the discus function.
  */
@@ -13,6 +13,7 @@
 #include "transform_obj_shift.c"
 #include "transform_vars_permutation.c"
 #include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_obj_norm_by_dim.c"
 
 /**
@@ -128,9 +129,7 @@ static coco_problem_t *f_discus_generalized_permblockdiag_bbob_problem_allocate(
 
   problem = f_discus_generalized_allocate(dimension, proportion_short_axes_denom);
   problem = transform_vars_oscillate(problem);
-  problem = transform_vars_permutation(problem, P2, dimension);
-  problem = transform_vars_blockrotation(problem, B_copy, dimension, block_sizes, nb_blocks);
-  problem = transform_vars_permutation(problem, P1, dimension);
+  problem = transform_vars_permblockdiag(problem, B_copy, P1, P2, dimension, block_sizes, nb_blocks);
   problem = transform_vars_shift(problem, xopt, 0);
 
   problem = transform_obj_norm_by_dim(problem);
@@ -15,14 +15,16 @@
 #include "transform_obj_shift.c"
 #include "transform_vars_permutation.c"
 #include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_obj_norm_by_dim.c"
 
 /**
  * @brief Implements the ellipsoid function without connections to any COCO structures.
+ *
+ * The coefficients condition^(i / (n - 1)) are given in the vector coefficients.
  */
-static double f_ellipsoid_raw(const double *x, const size_t number_of_variables) {
+static double f_ellipsoid_raw(const double *x, const size_t number_of_variables, const double *coefficients) {
 
-  static const double condition = 1.0e6;
   size_t i = 0;
   double result;
     
@@ -31,8 +33,7 @@ static double f_ellipsoid_raw(const double *x, const size_t number_of_variables)
 
   result = x[i] * x[i];
   for (i = 1; i < number_of_variables; ++i) {
-    const double exponent = 1.0 * (double) (long) i / ((double) (long) number_of_variables - 1.0);
-    result += pow(condition, exponent) * x[i] * x[i];
+    result += coefficients[i] * x[i] * x[i];
   }
 
   return result;
@@ -43,7 +44,36 @@ static double f_ellipsoid_raw(const double *x, const size_t number_of_variables)
  */
 static void f_ellipsoid_evaluate(coco_problem_t *problem, const double *x, double *y) {
   assert(problem->number_of_objectives == 1);
-  y[0] = f_ellipsoid_raw(x, problem->number_of_variables);
+  y[0] = f_ellipsoid_raw(x, problem->number_of_variables, (const double *) problem->data);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+}
+
+/**
+ * @brief Implements the ellipsoid function with reordered floating-point operations (see f_fast_kernels.c).
+ */
+static double f_ellipsoid_raw_fast(const double *x, const size_t number_of_variables, const double *coefficients) {
+
+  size_t i;
+  double result[4] = { 0.0, 0.0, 0.0, 0.0 };
+
+  for (i = 1; i + 4 <= number_of_variables; i += 4) {
+    result[0] += coefficients[i] * x[i] * x[i];
+    result[1] += coefficients[i + 1] * x[i + 1] * x[i + 1];
+    result[2] += coefficients[i + 2] * x[i + 2] * x[i + 2];
+    result[3] += coefficients[i + 3] * x[i + 3] * x[i + 3];
+  }
+  for (; i < number_of_variables; ++i)
+    result[i % 4] += coefficients[i] * x[i] * x[i];
+
+  return x[0] * x[0] + ((result[0] + result[1]) + (result[2] + result[3]));
+}
+
+/**
+ * @brief Uses the fast raw function to evaluate the COCO problem (see f_fast_kernels.c).
+ */
+static void f_ellipsoid_evaluate_fast(coco_problem_t *problem, const double *x, double *y) {
+  assert(problem->number_of_objectives == 1);
+  y[0] = f_ellipsoid_raw_fast(x, problem->number_of_variables, (const double *) problem->data);
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
@@ -54,24 +84,26 @@ static void f_ellipsoid_evaluate_gradient(coco_problem_t *problem,
                                           const double *x, 
                                           double *y) {
 
-  static const double condition = 1.0e6;
-  double exponent;
+  const double *coefficients = (const double *) problem->data;
   size_t i = 0;
   
   for (i = 0; i < problem->number_of_variables; ++i) {
-    exponent = 1.0 * (double) (long) i / ((double) (long) problem->number_of_variables - 1.0);
-    y[i] = 2.0*pow(condition, exponent) * x[i];
+    y[i] = 2.0*coefficients[i] * x[i];
   }
  
 }
 
 /**
  * @brief Allocates the basic ellipsoid problem.
+ *
+ * The data of the problem is the vector of the coefficients condition^(i / (n - 1)).
  */
 static coco_problem_t *f_ellipsoid_allocate(const size_t number_of_variables) {
 
+  static const double condition = 1.0e6;
   coco_problem_t *problem = coco_problem_allocate_from_scalars("ellipsoid function",
       f_ellipsoid_evaluate, NULL, number_of_variables, -5.0, 5.0, 0.0);
+  problem->data = coco_allocate_conditioning_coefficients(condition, 1.0, number_of_variables);
   problem->evaluate_gradient = f_ellipsoid_evaluate_gradient;
   coco_problem_set_id(problem, "%s_d%02lu", "ellipsoid", number_of_variables);
 
@@ -194,9 +226,7 @@ static coco_problem_t *f_ellipsoid_permblockdiag_bbob_problem_allocate(const siz
 
   problem = f_ellipsoid_allocate(dimension);
   problem = transform_vars_oscillate(problem);
-  problem = transform_vars_permutation(problem, P2, dimension);
-  problem = transform_vars_blockrotation(problem, B_copy, dimension, block_sizes, nb_blocks);
-  problem = transform_vars_permutation(problem, P1, dimension);
+  problem = transform_vars_permblockdiag(problem, B_copy, P1, P2, dimension, block_sizes, nb_blocks);
   problem = transform_vars_shift(problem, xopt, 0);
 
   
@@ -0,0 +1,79 @@
+/**
+ * @file f_fast_kernels.c
+ * @brief Implementation of switching problems to the fast variants of their raw functions.
+ *
+ * Some raw functions have a fast variant (f_*_raw_fast) that computes the same function with reordered
+ * floating-point operations: independent partial sums that the compiler can vectorize, fewer calls to
+ * pow, exp and log, and no separate check for NaN values (NaN values propagate through the computation).
+ * The fast variants are therefore not bit-for-bit identical to the default (strict) ones.
+ *
+ * The results of the fast variants differ from the strict ones by a relative error of at most 1e-12 in
+ * all dimensions of the bbob and bbob-largescale suites (checked in test_coco_suite.c), which is well below
+ * the precision of 1e-9 required by the regression test of the suites. Functions that are close to their
+ * optimal value can have a larger relative error, but their absolute error is then below 1e-12 as well.
+ * The optimal values of the problems are computed with the strict variants.
+ */
+
+#include <assert.h>
+
+#include "coco.h"
+#include "coco_problem.c"
+#include "f_bent_cigar.c"
+#include "f_different_powers.c"
+#include "f_discus.c"
+#include "f_ellipsoid.c"
+#include "f_katsuura.c"
+#include "f_rastrigin.c"
+#include "f_schaffers.c"
+#include "f_sphere.c"
+#include "f_weierstrass.c"
+
+/**
+ * @brief Returns the fast variant of the given evaluate function or NULL if it has none.
+ */
+static coco_evaluate_function_t f_fast_kernels_get(const coco_evaluate_function_t evaluate_function) {
+  if (evaluate_function == f_bent_cigar_evaluate)
+    return f_bent_cigar_evaluate_fast;
+  else if (evaluate_function == f_different_powers_evaluate)
+    return f_different_powers_evaluate_fast;
+  else if (evaluate_function == f_discus_evaluate)
+    return f_discus_evaluate_fast;
+  else if (evaluate_function == f_ellipsoid_evaluate)
+    return f_ellipsoid_evaluate_fast;
+  else if (evaluate_function == f_katsuura_evaluate)
+    return f_katsuura_evaluate_fast;
+  else if (evaluate_function == f_rastrigin_evaluate)
+    return f_rastrigin_evaluate_fast;
+  else if (evaluate_function == f_schaffers_evaluate)
+    return f_schaffers_evaluate_fast;
+  else if (evaluate_function == f_sphere_evaluate)
+    return f_sphere_evaluate_fast;
+  else if (evaluate_function == f_weierstrass_evaluate)
+    return f_weierstrass_evaluate_fast;
+  return NULL;
+}
+
+/**
+ * @brief Switches the innermost problem(s) of the given problem to the fast variants of their raw functions
+ * and returns the number of switched problems.
+ *
+ * The chain of transformations is walked down to the innermost problem. Stacked problems are handled by
+ * switching each of the underlying problems. Problems without a fast variant are left unchanged.
+ */
+static size_t f_fast_kernels(coco_problem_t *problem) {
+  coco_evaluate_function_t fast_evaluate_function;
+
+  while (problem->problem_free_function == coco_problem_transformed_free)
+    problem = coco_problem_transformed_get_inner_problem(problem);
+
+  if (problem->problem_free_function == coco_problem_stacked_free) {
+    coco_problem_stacked_data_t *data = (coco_problem_stacked_data_t *) problem->data;
+    return f_fast_kernels(data->problem1) + f_fast_kernels(data->problem2);
+  }
+
+  fast_evaluate_function = f_fast_kernels_get(problem->evaluate_function);
+  if (fast_evaluate_function == NULL)
+    return 0;
+  problem->evaluate_function = fast_evaluate_function;
+  return 1;
+}
@@ -56,10 +56,14 @@ static int f_gallagher_compare_doubles(const void *a, const void *b) {
 
 /**
  * @brief Implements the Gallagher function without connections to any COCO structures.
+ *
+ * The vector tmx of size number_of_variables is used as temporary storage.
  */
-static double f_gallagher_raw(const double *x, const size_t number_of_variables, f_gallagher_data_t *data) {
+static double f_gallagher_raw(const double *x,
+                              const size_t number_of_variables,
+                              const f_gallagher_data_t *data,
+                              double *tmx) {
   size_t i, j; /* Loop over dim */
-  double *tmx;
   double a = 0.1;
   double tmp2, f = 0., f_add, tmp, f_pen = 0., f_true = 0.;
   double fac;
@@ -80,7 +84,6 @@ static double f_gallagher_raw(const double *x, const size_t number_of_variables,
   f_add = f_pen;
   /* Transformation in search space */
   /* TODO: this should rather be done in f_gallagher */
-  tmx = coco_allocate_vector(number_of_variables);
   for (i = 0; i < number_of_variables; i++) {
     tmx[i] = 0;
     for (j = 0; j < number_of_variables; ++j) {
@@ -111,7 +114,6 @@ static double f_gallagher_raw(const double *x, const size_t number_of_variables,
   f_true *= f_true;
   f_true += f_add;
   result = f_true;
-  coco_free_memory(tmx);
   return result;
 }
 
@@ -119,8 +121,12 @@ static double f_gallagher_raw(const double *x, const size_t number_of_variables,
  * @brief Uses the raw function to evaluate the COCO problem.
  */
 static void f_gallagher_evaluate(coco_problem_t *problem, const double *x, double *y) {
+  double *tmx;
+
   assert(problem->number_of_objectives == 1);
-  y[0] = f_gallagher_raw(x, problem->number_of_variables, (f_gallagher_data_t *) problem->data);
+  tmx = coco_problem_scratch_allocate(problem, problem->number_of_variables);
+  y[0] = f_gallagher_raw(x, problem->number_of_variables, (f_gallagher_data_t *) problem->data, tmx);
+  coco_problem_scratch_free(problem, tmx, problem->number_of_variables);
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
@@ -142,6 +148,9 @@ static void f_gallagher_free(coco_problem_t *problem) {
 /**
  * @brief Creates the BBOB Gallagher problem.
  *
+ * The scales and local optima of the peaks (which take O(number_of_peaks * dimension^2) operations) are
+ * kept in the instance cache and can therefore be stored in an instance store.
+ *
  * @note There is no separate basic allocate function.
  */
 static coco_problem_t *f_gallagher_bbob_problem_allocate(const size_t function,
@@ -173,6 +182,8 @@ static coco_problem_t *f_gallagher_bbob_problem_allocate(const size_t function,
   /* Random permutation */
   f_gallagher_permutation_t *rperm;
   double *random_numbers;
+  const double *cached;
+  double *copy;
 
   data = (f_gallagher_data_t *) coco_allocate_memory(sizeof(*data));
   /* Allocate temporary storage and space for the rotation matrices */
@@ -196,59 +207,86 @@ static coco_problem_t *f_gallagher_bbob_problem_allocate(const size_t function,
   data->rseed = rseed;
   bbob2009_compute_rotation(data->rotation, rseed, dimension);
 
-  /* Initialize all the data of the inner problem */
-  random_numbers = coco_allocate_vector(number_of_peaks * dimension); /* This is large enough for all cases below */
-  bbob2009_unif(random_numbers, number_of_peaks - 1, data->rseed);
-  rperm = (f_gallagher_permutation_t *) coco_allocate_memory(sizeof(*rperm) * (number_of_peaks - 1));
-  for (i = 0; i < number_of_peaks - 1; ++i) {
-    rperm[i].value = random_numbers[i];
-    rperm[i].index = i;
-  }
-  qsort(rperm, number_of_peaks - 1, sizeof(*rperm), f_gallagher_compare_doubles);
-
-  /* Random permutation */
-  arrCondition = coco_allocate_vector(number_of_peaks);
-  arrCondition[0] = maxcondition1;
   data->peak_values = coco_allocate_vector(number_of_peaks);
   data->peak_values[0] = 10;
   for (i = 1; i < number_of_peaks; ++i) {
-    arrCondition[i] = pow(maxcondition, (double) (rperm[i - 1].index) / ((double) (number_of_peaks - 2)));
     data->peak_values[i] = (double) (i - 1) / (double) (number_of_peaks - 2) * (fitvalues[1] - fitvalues[0])
         + fitvalues[0];
   }
-  coco_free_memory(rperm);
-
-  rperm = (f_gallagher_permutation_t *) coco_allocate_memory(sizeof(*rperm) * dimension);
-  for (i = 0; i < number_of_peaks; ++i) {
-    bbob2009_unif(random_numbers, dimension, data->rseed + (long) (1000 * i));
-    for (j = 0; j < dimension; ++j) {
-      rperm[j].value = random_numbers[j];
-      rperm[j].index = j;
+
+  /* The scales, the local optima and the global optimum are stored one after another in the instance cache */
+  cached = (const double *) coco_instance_cache_acquire("f_gallagher_bbob_problem_allocate", rseed, dimension,
+      number_of_peaks, 0, (2 * number_of_peaks + 1) * dimension * sizeof(double));
+  if (cached != NULL) {
+    for (i = 0; i < number_of_peaks; ++i)
+      memcpy(data->arr_scales[i], cached + i * dimension, dimension * sizeof(double));
+    for (i = 0; i < dimension; ++i)
+      memcpy(data->x_local[i], cached + number_of_peaks * dimension + i * number_of_peaks,
+          number_of_peaks * sizeof(double));
+    memcpy(data->xopt, cached + 2 * number_of_peaks * dimension, dimension * sizeof(double));
+    coco_instance_cache_release(cached);
+  } else {
+    /* Initialize all the data of the inner problem */
+    random_numbers = coco_allocate_vector(number_of_peaks * dimension); /* This is large enough for all cases below */
+    bbob2009_unif(random_numbers, number_of_peaks - 1, data->rseed);
+    rperm = (f_gallagher_permutation_t *) coco_allocate_memory(sizeof(*rperm) * (number_of_peaks - 1));
+    for (i = 0; i < number_of_peaks - 1; ++i) {
+      rperm[i].value = random_numbers[i];
+      rperm[i].index = i;
     }
-    qsort(rperm, dimension, sizeof(*rperm), f_gallagher_compare_doubles);
-    for (j = 0; j < dimension; ++j) {
-      data->arr_scales[i][j] = pow(arrCondition[i],                             /* Lambda^alpha_i from the doc */
-          ((double) rperm[j].index) / ((double) (dimension - 1)) - 0.5);
+    qsort(rperm, number_of_peaks - 1, sizeof(*rperm), f_gallagher_compare_doubles);
+
+    /* Random permutation */
+    arrCondition = coco_allocate_vector(number_of_peaks);
+    arrCondition[0] = maxcondition1;
+    for (i = 1; i < number_of_peaks; ++i) {
+      arrCondition[i] = pow(maxcondition, (double) (rperm[i - 1].index) / ((double) (number_of_peaks - 2)));
     }
-  }
-  coco_free_memory(rperm);
-
-  bbob2009_unif(random_numbers, dimension * number_of_peaks, data->rseed);
-  for (i = 0; i < dimension; ++i) {
-    data->xopt[i] = 0.8 * (b * random_numbers[i] - c);
-    problem->best_parameter[i] = 0.8 * (b * random_numbers[i] - c);
-    for (j = 0; j < number_of_peaks; ++j) {
-      data->x_local[i][j] = 0.;
-      for (k = 0; k < dimension; ++k) {
-        data->x_local[i][j] += data->rotation[i][k] * (b * random_numbers[j * dimension + k] - c);
+    coco_free_memory(rperm);
+
+    rperm = (f_gallagher_permutation_t *) coco_allocate_memory(sizeof(*rperm) * dimension);
+    for (i = 0; i < number_of_peaks; ++i) {
+      bbob2009_unif(random_numbers, dimension, data->rseed + (long) (1000 * i));
+      for (j = 0; j < dimension; ++j) {
+        rperm[j].value = random_numbers[j];
+        rperm[j].index = j;
       }
-      if (j == 0) {
-        data->x_local[i][j] *= 0.8;
+      qsort(rperm, dimension, sizeof(*rperm), f_gallagher_compare_doubles);
+      for (j = 0; j < dimension; ++j) {
+        data->arr_scales[i][j] = pow(arrCondition[i],                             /* Lambda^alpha_i from the doc */
+            ((double) rperm[j].index) / ((double) (dimension - 1)) - 0.5);
       }
     }
+    coco_free_memory(rperm);
+
+    bbob2009_unif(random_numbers, dimension * number_of_peaks, data->rseed);
+    for (i = 0; i < dimension; ++i) {
+      data->xopt[i] = 0.8 * (b * random_numbers[i] - c);
+      for (j = 0; j < number_of_peaks; ++j) {
+        data->x_local[i][j] = 0.;
+        for (k = 0; k < dimension; ++k) {
+          data->x_local[i][j] += data->rotation[i][k] * (b * random_numbers[j * dimension + k] - c);
+        }
+        if (j == 0) {
+          data->x_local[i][j] *= 0.8;
+        }
+      }
+    }
+    coco_free_memory(arrCondition);
+    coco_free_memory(random_numbers);
+
+    copy = coco_allocate_vector((2 * number_of_peaks + 1) * dimension);
+    for (i = 0; i < number_of_peaks; ++i)
+      memcpy(copy + i * dimension, data->arr_scales[i], dimension * sizeof(double));
+    for (i = 0; i < dimension; ++i)
+      memcpy(copy + number_of_peaks * dimension + i * number_of_peaks, data->x_local[i],
+          number_of_peaks * sizeof(double));
+    memcpy(copy + 2 * number_of_peaks * dimension, data->xopt, dimension * sizeof(double));
+    coco_instance_cache_insert("f_gallagher_bbob_problem_allocate", rseed, dimension, number_of_peaks, 0, copy,
+        (2 * number_of_peaks + 1) * dimension * sizeof(double));
   }
-  coco_free_memory(arrCondition);
-  coco_free_memory(random_numbers);
+  for (i = 0; i < dimension; ++i)
+    problem->best_parameter[i] = data->xopt[i];
 
   problem->data = data;
 
@@ -310,19 +348,65 @@ static coco_problem_t *f_gallagher_sub_problem_allocate(const size_t number_of_v
 
 
 
+/**
+ * @brief Frees the versatile_data of a clone of the basic gallagher problem.
+ *
+ * The block-rotation fields are shared with the original problem and are not freed.
+ */
+static void f_gallagher_versatile_data_clone_free(coco_problem_t *problem) {
+  size_t i;
+  f_gallagher_versatile_data_t *versatile_data = (f_gallagher_versatile_data_t *) problem->versatile_data;
+
+  for (i = 0; i < versatile_data->number_of_peaks; i++) {
+    coco_problem_free(versatile_data->sub_problems[i]);
+  }
+  coco_free_memory(versatile_data->sub_problems);
+  coco_free_memory(versatile_data->rotated_x);
+  coco_free_memory(versatile_data);
+  problem->versatile_data = NULL;
+  problem->problem_free_function = NULL;
+  coco_problem_free(problem);
+}
+
+/**
+ * @brief Clones the basic gallagher problem, giving the clone its own versatile_data with clones of the
+ * sub-problems (which are used in every evaluation).
+ */
+static coco_problem_t *f_gallagher_versatile_data_clone(const coco_problem_t *problem) {
+  size_t i;
+  f_gallagher_versatile_data_t *versatile_data, *clone_versatile_data;
+  coco_problem_t *clone = coco_problem_clone_duplicate(problem);
+
+  versatile_data = (f_gallagher_versatile_data_t *) problem->versatile_data;
+  clone_versatile_data = (f_gallagher_versatile_data_t *) coco_allocate_memory(sizeof(*clone_versatile_data));
+  *clone_versatile_data = *versatile_data;
+  clone_versatile_data->sub_problems = (coco_problem_t **) coco_allocate_memory(versatile_data->number_of_peaks
+      * sizeof(coco_problem_t *));
+  for (i = 0; i < versatile_data->number_of_peaks; i++) {
+    clone_versatile_data->sub_problems[i] = coco_problem_clone_inner(versatile_data->sub_problems[i]);
+  }
+  clone_versatile_data->rotated_x = coco_allocate_vector(problem->number_of_variables);
+  clone->versatile_data = clone_versatile_data;
+  clone->problem_free_function = f_gallagher_versatile_data_clone_free;
+  return clone;
+}
+
 /**
  * @brief Implements the gallagher function without connections to any COCO structures.
  * Wassim: core to not conflict with raw for now
+ *
+ * The vector x_local of size number_of_variables is used as temporary storage.
  */
-static double f_gallagher_core(const double *x, size_t number_of_variables, f_gallagher_versatile_data_t *versatile_data) {
+static double f_gallagher_core(const double *x,
+                               size_t number_of_variables,
+                               f_gallagher_versatile_data_t *versatile_data,
+                               double *x_local) {
 
   coco_problem_t *problem_i;
   double result = 0;
   double y, w_i;
   size_t i,j;
   double maxf;
-  double *x_local;
-  x_local = coco_allocate_vector(number_of_variables);
 
 
   for (i = 0; i < versatile_data->number_of_peaks; i++) {
@@ -342,7 +426,6 @@ static double f_gallagher_core(const double *x, size_t number_of_variables, f_ga
     }
   }
   result = 10.0 - maxf;
-  coco_free_memory(x_local);
   return result;
 }
 
@@ -350,9 +433,13 @@ static double f_gallagher_core(const double *x, size_t number_of_variables, f_ga
  * @brief Uses the core function to evaluate the COCO problem.
  */
 static void f_gallagher_evaluate_core(coco_problem_t *problem, const double *x, double *y) {
+  double *x_local;
 
   assert(problem->number_of_objectives == 1);
-  y[0] = f_gallagher_core(x, problem->number_of_variables, ((f_gallagher_versatile_data_t *) problem->versatile_data));
+  x_local = coco_problem_scratch_allocate(problem, problem->number_of_variables);
+  y[0] = f_gallagher_core(x, problem->number_of_variables, ((f_gallagher_versatile_data_t *) problem->versatile_data),
+      x_local);
+  coco_problem_scratch_free(problem, x_local, problem->number_of_variables);
   if (! (y[0] + 1e-13 >= problem->best_value[0])) {
     printf("\n x[0]= %f: %f < %f\n", x[0], y[0] + 1e-13, problem->best_value[0]);
   }
@@ -379,6 +466,7 @@ static coco_problem_t *f_gallagher_problem_allocate(const size_t number_of_varia
   versatile_data->block_size_map = coco_allocate_vector_size_t(number_of_variables);
   versatile_data->first_non_zero_map = coco_allocate_vector_size_t(number_of_variables);
   versatile_data->block_sizes = coco_allocate_vector_size_t(number_of_variables);
+  problem->problem_clone_function = f_gallagher_versatile_data_clone;
 
   coco_problem_set_id(problem, "%s_d%04lu", "gallagher", number_of_variables);
   problem->best_value[0] = 0;
@@ -388,6 +476,13 @@ static coco_problem_t *f_gallagher_problem_allocate(const size_t number_of_varia
   return problem;
 }
 
+/**
+ * @brief Creates the large-scale Gallagher problem.
+ *
+ * Only the rotations of the blocks are taken from the instance cache (see coco_compute_blockrotation). The
+ * local optima are rotated by blocks and the scales are permutations, which take
+ * O(number_of_peaks * dimension * block size) operations and are therefore not cached.
+ */
 static coco_problem_t *f_gallagher_permblockdiag_bbob_problem_allocate(const size_t function,
                                                                        const size_t dimension,
                                                                        const size_t instance,
@@ -16,6 +16,7 @@
 #include "transform_vars_shift.c"
 #include "transform_obj_penalize.c"
 #include "transform_obj_norm_by_dim.c"
+#include "transform_vars_permblockdiag.c"
 
 /**
  * @brief Implements the Katsuura function without connections to any COCO structures.
@@ -58,6 +59,44 @@ static void f_katsuura_evaluate(coco_problem_t *problem, const double *x, double
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Implements the Katsuura function with reordered floating-point operations (see f_fast_kernels.c).
+ *
+ * The powers of two are computed by doubling and the product of the powers is computed as the exponential
+ * of a sum of logarithms, so that exp and log are called instead of one pow per variable.
+ */
+static double f_katsuura_raw_fast(const double *x, const size_t number_of_variables) {
+
+  size_t i, j;
+  double tmp, power, inverse_power;
+  double sum_of_logs = 0.0;
+  const double exponent = 10. / pow((double) number_of_variables, 1.2);
+
+  for (i = 0; i < number_of_variables; ++i) {
+    tmp = 0;
+    power = 1.0;
+    inverse_power = 1.0;
+    for (j = 1; j < 33; ++j) {
+      power *= 2.0;
+      inverse_power *= 0.5;
+      tmp += fabs(power * x[i] - coco_double_round(power * x[i])) * inverse_power;
+    }
+    sum_of_logs += log(1.0 + ((double) (long) i + 1) * tmp);
+  }
+
+  return 10. / ((double) number_of_variables) / ((double) number_of_variables)
+      * (-1. + exp(exponent * sum_of_logs));
+}
+
+/**
+ * @brief Uses the fast raw function to evaluate the COCO problem (see f_fast_kernels.c).
+ */
+static void f_katsuura_evaluate_fast(coco_problem_t *problem, const double *x, double *y) {
+  assert(problem->number_of_objectives == 1);
+  y[0] = f_katsuura_raw_fast(x, problem->number_of_variables);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Allocates the basic Katsuura problem.
  */
@@ -184,13 +223,9 @@ static coco_problem_t *f_katsuura_permblockdiag_bbob_problem_allocate(const size
   coco_compute_truncated_uniform_swap_permutation(P22, rseed + 6000000, dimension, nb_swaps2, swap_range2);
 
   problem = f_katsuura_allocate(dimension);
-  problem = transform_vars_permutation(problem, P22, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes2, nb_blocks2);
-  problem = transform_vars_permutation(problem, P21, dimension);
+  problem = transform_vars_permblockdiag(problem, B1_copy, P21, P22, dimension, block_sizes2, nb_blocks2);
   problem = transform_vars_conditioning(problem, 100.0);
-  problem = transform_vars_permutation(problem, P12, dimension);
-  problem = transform_vars_blockrotation(problem, B2_copy, dimension, block_sizes1, nb_blocks1);
-  problem = transform_vars_permutation(problem, P11, dimension);
+  problem = transform_vars_permblockdiag(problem, B2_copy, P11, P12, dimension, block_sizes1, nb_blocks1);
   problem = transform_vars_shift(problem, xopt, 0);
 
   /*problem = transform_obj_norm_by_dim(problem);*/ /* Wassim: does not seem to be needed*/
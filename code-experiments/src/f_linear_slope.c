@@ -15,12 +15,14 @@
 
 /**
  * @brief Implements the linear slope function without connections to any COCO structures.
+ *
+ * The slopes s_i = sign(best_parameter[i]) * sqrt(alpha)^(i / (n - 1)) are given in the vector slopes.
  */
 static double f_linear_slope_raw(const double *x,
                                  const size_t number_of_variables,
-                                 const double *best_parameter) {
+                                 const double *best_parameter,
+                                 const double *slopes) {
 
-  static const double alpha = 100.0;
   size_t i;
   double result = 0.0;
   
@@ -28,15 +30,8 @@ static double f_linear_slope_raw(const double *x,
     return NAN;
     
   for (i = 0; i < number_of_variables; ++i) {
-    double base, exponent, si;
+    const double si = slopes[i];
 
-    base = sqrt(alpha);
-    exponent = (double) (long) i / ((double) (long) number_of_variables - 1);
-    if (best_parameter[i] > 0.0) {
-      si = pow(base, exponent);
-    } else {
-      si = -pow(base, exponent);
-    }
     /* boundary handling */
     if (x[i] * best_parameter[i] < 25.0) {
       result += 5.0 * fabs(si) - si * x[i];
@@ -53,7 +48,8 @@ static double f_linear_slope_raw(const double *x,
  */
 static void f_linear_slope_evaluate(coco_problem_t *problem, const double *x, double *y) {
   assert(problem->number_of_objectives == 1);
-  y[0] = f_linear_slope_raw(x, problem->number_of_variables, problem->best_parameter);
+  y[0] = f_linear_slope_raw(x, problem->number_of_variables, problem->best_parameter,
+      (const double *) problem->data);
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
@@ -64,28 +60,25 @@ static void f_linear_slope_evaluate_gradient(coco_problem_t *problem,
                                              const double *x, 
                                              double *y) {
 
-  static const double alpha = 100.0;
-  double base, exponent, si;
+  const double *slopes = (const double *) problem->data;
   size_t i;
 
   (void)x; /* silence (C89) compiliers */
   for (i = 0; i < problem->number_of_variables; ++i) {
-    base = sqrt(alpha);
-    exponent = (double) (long) i / ((double) (long) problem->number_of_variables - 1);
-    if (problem->best_parameter[i] > 0.0) {
-      si = pow(base, exponent);
-    } else {
-      si = -pow(base, exponent);
-    }
-    y[i] = -si;
+    y[i] = -slopes[i];
   }
 }
 
 /**
  * @brief Allocates the basic linear slope problem.
+ *
+ * The data of the problem is the vector of the slopes, which depend only on the dimension and on the signs
+ * of the optimal solution.
  */
 static coco_problem_t *f_linear_slope_allocate(const size_t number_of_variables, const double *best_parameter) {
 
+  static const double alpha = 100.0;
+  double *slopes;
   size_t i;
   /* best_parameter will be overwritten below */
   coco_problem_t *problem = coco_problem_allocate_from_scalars("linear slope function",
@@ -101,6 +94,12 @@ static coco_problem_t *f_linear_slope_allocate(const size_t number_of_variables,
       problem->best_parameter[i] = problem->largest_values_of_interest[i];
     }
   }
+  slopes = coco_allocate_conditioning_coefficients(sqrt(alpha), 1.0, number_of_variables);
+  for (i = 0; i < number_of_variables; ++i) {
+    if (!(problem->best_parameter[i] > 0.0))
+      slopes[i] = -slopes[i];
+  }
+  problem->data = slopes;
   f_linear_slope_evaluate(problem, problem->best_parameter, problem->best_value);
   
   return problem;
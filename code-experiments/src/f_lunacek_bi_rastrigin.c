@@ -14,33 +14,38 @@
 #include "transform_vars_x_hat_generic.c"
 #include "transform_obj_norm_by_dim.c"
 #include "transform_obj_scale.c"
+#include "transform_vars_permblockdiag.c"
 
 /**
  * @brief Data type for the Lunacek bi-Rastrigin problem.
  */
 typedef struct {
-  double *x_hat, *z;
   double *xopt, fopt;
   double **rot1, **rot2;
+  double *conditioning; /**< @brief The coefficients sqrt(100)^(i / (n - 1)) of the affine transformation. */
   long rseed;
   coco_problem_free_function_t old_free_problem;
 } f_lunacek_bi_rastrigin_data_t;
 
 /**
  * @brief Implements the Lunacek bi-Rastrigin function without connections to any COCO structures.
+ *
+ * The vectors x_hat, z and tmpvect of size number_of_variables are used as temporary storage.
  */
 static double f_lunacek_bi_rastrigin_raw(const double *x,
                                          const size_t number_of_variables,
-                                         f_lunacek_bi_rastrigin_data_t *data) {
+                                         const f_lunacek_bi_rastrigin_data_t *data,
+                                         double *x_hat,
+                                         double *z,
+                                         double *tmpvect) {
   double result;
-  static const double condition = 100.;
   size_t i, j;
   double penalty = 0.0;
   static const double mu0 = 2.5;
   static const double d = 1.;
   const double s = 1. - 0.5 / (sqrt((double) (number_of_variables + 20)) - 4.1);
   const double mu1 = -sqrt((mu0 * mu0 - d) / s);
-  double *tmpvect, sum1 = 0., sum2 = 0., sum3 = 0.;
+  double sum1 = 0., sum2 = 0., sum3 = 0.;
 
   assert(number_of_variables > 1);
 
@@ -56,37 +61,34 @@ static double f_lunacek_bi_rastrigin_raw(const double *x,
 
   /* x_hat */
   for (i = 0; i < number_of_variables; ++i) {
-    data->x_hat[i] = 2. * x[i];
+    x_hat[i] = 2. * x[i];
     if (data->xopt[i] < 0.) {
-      data->x_hat[i] *= -1.;
+      x_hat[i] *= -1.;
     }
   }
 
-  tmpvect = coco_allocate_vector(number_of_variables);
   /* affine transformation */
   for (i = 0; i < number_of_variables; ++i) {
-    double c1;
+    const double c1 = data->conditioning[i];
     tmpvect[i] = 0.0;
-    c1 = pow(sqrt(condition), ((double) i) / (double) (number_of_variables - 1));
     for (j = 0; j < number_of_variables; ++j) {
-      tmpvect[i] += c1 * data->rot2[i][j] * (data->x_hat[j] - mu0);
+      tmpvect[i] += c1 * data->rot2[i][j] * (x_hat[j] - mu0);
     }
   }
   for (i = 0; i < number_of_variables; ++i) {
-    data->z[i] = 0;
+    z[i] = 0;
     for (j = 0; j < number_of_variables; ++j) {
-      data->z[i] += data->rot1[i][j] * tmpvect[j];
+      z[i] += data->rot1[i][j] * tmpvect[j];
     }
   }
   /* Computation core */
   for (i = 0; i < number_of_variables; ++i) {
-    sum1 += (data->x_hat[i] - mu0) * (data->x_hat[i] - mu0);
-    sum2 += (data->x_hat[i] - mu1) * (data->x_hat[i] - mu1);
-    sum3 += cos(2 * coco_pi * data->z[i]);
+    sum1 += (x_hat[i] - mu0) * (x_hat[i] - mu0);
+    sum2 += (x_hat[i] - mu1) * (x_hat[i] - mu1);
+    sum3 += cos(2 * coco_pi * z[i]);
   }
   result = coco_double_min(sum1, d * (double) number_of_variables + s * sum2)
       + 10. * ((double) number_of_variables - sum3) + 1e4 * penalty;
-  coco_free_memory(tmpvect);
 
   return result;
 }
@@ -95,8 +97,14 @@ static double f_lunacek_bi_rastrigin_raw(const double *x,
  * @brief Uses the raw function to evaluate the COCO problem.
  */
 static void f_lunacek_bi_rastrigin_evaluate(coco_problem_t *problem, const double *x, double *y) {
+  const size_t n = problem->number_of_variables;
+  double *x_hat;
+
   assert(problem->number_of_objectives == 1);
-  y[0] = f_lunacek_bi_rastrigin_raw(x, problem->number_of_variables, (f_lunacek_bi_rastrigin_data_t *) problem->data);
+  x_hat = coco_problem_scratch_allocate(problem, 3 * n);
+  y[0] = f_lunacek_bi_rastrigin_raw(x, n, (f_lunacek_bi_rastrigin_data_t *) problem->data,
+      x_hat, x_hat + n, x_hat + 2 * n);
+  coco_problem_scratch_free(problem, x_hat, 3 * n);
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
@@ -106,11 +114,10 @@ static void f_lunacek_bi_rastrigin_evaluate(coco_problem_t *problem, const doubl
 static void f_lunacek_bi_rastrigin_free(coco_problem_t *problem) {
   f_lunacek_bi_rastrigin_data_t *data;
   data = (f_lunacek_bi_rastrigin_data_t *) problem->data;
-  coco_free_memory(data->x_hat);
-  coco_free_memory(data->z);
   coco_free_memory(data->xopt);
   bbob2009_free_matrix(data->rot1, problem->number_of_variables);
   bbob2009_free_matrix(data->rot2, problem->number_of_variables);
+  coco_free_memory(data->conditioning);
 
   /* Let the generic free problem code deal with all of the
    * coco_problem_t fields.
@@ -136,14 +143,13 @@ static coco_problem_t *f_lunacek_bi_rastrigin_bbob_problem_allocate(const size_t
       f_lunacek_bi_rastrigin_evaluate, f_lunacek_bi_rastrigin_free, dimension, -5.0, 5.0, 0.0);
 
   const double mu0 = 2.5;
+  const double condition = 100.;
 
   double fopt, *tmpvect;
   size_t i;
 
   data = (f_lunacek_bi_rastrigin_data_t *) coco_allocate_memory(sizeof(*data));
-  /* Allocate temporary storage and space for the rotation matrices */
-  data->x_hat = coco_allocate_vector(dimension);
-  data->z = coco_allocate_vector(dimension);
+  /* Allocate space for the rotation matrices */
   data->xopt = coco_allocate_vector(dimension);
   data->rot1 = bbob2009_allocate_matrix(dimension, dimension);
   data->rot2 = bbob2009_allocate_matrix(dimension, dimension);
@@ -153,6 +159,7 @@ static coco_problem_t *f_lunacek_bi_rastrigin_bbob_problem_allocate(const size_t
   bbob2009_compute_xopt(data->xopt, rseed, dimension);
   bbob2009_compute_rotation(data->rot1, rseed + 1000000, dimension);
   bbob2009_compute_rotation(data->rot2, rseed, dimension);
+  data->conditioning = coco_allocate_conditioning_coefficients(sqrt(condition), 1.0, dimension);
 
   problem->data = data;
 
@@ -207,6 +214,29 @@ static void f_lunacek_bi_rastrigin_versatile_data_free(coco_problem_t *problem)
 }
 
 
+/**
+ * @brief Clones the basic lunacek_bi_rastrigin problem, giving the clone its own versatile_data with clones
+ * of the sub-problems and its own x_hat (both are used in every evaluation).
+ */
+static coco_problem_t *f_lunacek_bi_rastrigin_versatile_data_clone(const coco_problem_t *problem) {
+
+  f_lunacek_bi_rastrigin_versatile_data_t *versatile_data, *clone_versatile_data;
+  coco_problem_t *clone = coco_problem_clone_duplicate(problem);
+
+  versatile_data = (f_lunacek_bi_rastrigin_versatile_data_t *) problem->versatile_data;
+  clone_versatile_data = (f_lunacek_bi_rastrigin_versatile_data_t *) coco_allocate_memory(sizeof(*clone_versatile_data));
+  clone_versatile_data->x_hat = coco_allocate_vector(problem->number_of_variables);
+  clone_versatile_data->sub_problem_mu0 = NULL;
+  clone_versatile_data->sub_problem_mu1 = NULL;
+  if (versatile_data->sub_problem_mu0 != NULL)
+    clone_versatile_data->sub_problem_mu0 = coco_problem_clone_inner(versatile_data->sub_problem_mu0);
+  if (versatile_data->sub_problem_mu1 != NULL)
+    clone_versatile_data->sub_problem_mu1 = coco_problem_clone_inner(versatile_data->sub_problem_mu1);
+  clone->versatile_data = clone_versatile_data;
+  return clone;
+}
+
+
 /**
  * @brief Uses the core function to evaluate the sub problem.
  */
@@ -282,6 +312,7 @@ static coco_problem_t *f_lunacek_bi_rastrigin_problem_allocate(const size_t numb
 
   problem->versatile_data = (f_lunacek_bi_rastrigin_versatile_data_t *) coco_allocate_memory(sizeof(f_lunacek_bi_rastrigin_versatile_data_t));
   ((f_lunacek_bi_rastrigin_versatile_data_t *) problem->versatile_data)->x_hat = coco_allocate_vector(number_of_variables); /* Manh: Allocate x_hat in versatile_data */
+  problem->problem_clone_function = f_lunacek_bi_rastrigin_versatile_data_clone;
   coco_problem_set_id(problem, "%s_d%04lu", "lunacek_bi_rastrigin", number_of_variables);
   /* Compute the best solution later once the sub-problems are well defined */
   *(problem->best_value) = 0;  /* Manh: set default value to avoid assert() in transformation later*/
@@ -378,14 +409,10 @@ static coco_problem_t *f_lunacek_bi_rastrigin_permblockdiag_bbob_problem_allocat
   *sub_problem_tmp = transform_obj_shift(*sub_problem_tmp, d * (double) dimension);
 
   /* transformations on main problem */
-  problem = transform_vars_permutation(problem, P22, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
-  problem = transform_vars_permutation(problem, P21, dimension);
+  problem = transform_vars_permblockdiag(problem, B1_copy, P21, P22, dimension, block_sizes1, nb_blocks1);
   problem = transform_vars_conditioning(problem, condition);
 
-  problem = transform_vars_permutation(problem, P12, dimension);
-  problem = transform_vars_blockrotation(problem, B2_copy, dimension, block_sizes2, nb_blocks2);
-  problem = transform_vars_permutation(problem, P11, dimension);
+  problem = transform_vars_permblockdiag(problem, B2_copy, P11, P12, dimension, block_sizes2, nb_blocks2);
   problem = transform_vars_shift(problem, mu0_vector, 0);
   problem = transform_vars_x_hat_generic(problem, sign_vector);
 
@@ -19,6 +19,7 @@
 #include "transform_vars_affine.c"
 #include "transform_vars_permutation.c"
 #include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_obj_norm_by_dim.c"
 
 /**
@@ -53,6 +54,32 @@ static void f_rastrigin_evaluate(coco_problem_t *problem, const double *x, doubl
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Implements the Rastrigin function with reordered floating-point operations (see f_fast_kernels.c).
+ */
+static double f_rastrigin_raw_fast(const double *x, const size_t number_of_variables) {
+
+  size_t i;
+  double sum1 = 0.0, sum2;
+
+  for (i = 0; i < number_of_variables; ++i)
+    sum1 += cos(coco_two_pi * x[i]);
+  sum2 = coco_vector_sum_of_squares(x, number_of_variables);
+  if (coco_is_inf(sum2)) /* cos(inf) -> nan */
+    return sum2;
+
+  return 10.0 * ((double) (long) number_of_variables - sum1) + sum2;
+}
+
+/**
+ * @brief Uses the fast raw function to evaluate the COCO problem (see f_fast_kernels.c).
+ */
+static void f_rastrigin_evaluate_fast(coco_problem_t *problem, const double *x, double *y) {
+  assert(problem->number_of_objectives == 1);
+  y[0] = f_rastrigin_raw_fast(x, problem->number_of_variables);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Evaluates the gradient of the raw Rastrigin function.
  */
@@ -225,18 +252,12 @@ static coco_problem_t *f_rastrigin_permblockdiag_bbob_problem_allocate(const siz
   coco_compute_truncated_uniform_swap_permutation(P22, rseed + 6000000, dimension, nb_swaps2, swap_range2);
   
   problem = f_rastrigin_allocate(dimension);
-  problem = transform_vars_permutation(problem, P12, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
-  problem = transform_vars_permutation(problem, P11, dimension);
+  problem = transform_vars_permblockdiag(problem, B1_copy, P11, P12, dimension, block_sizes1, nb_blocks1);
   problem = transform_vars_conditioning(problem, 10.0);
-  problem = transform_vars_permutation(problem, P22, dimension);
-  problem = transform_vars_blockrotation(problem, B2_copy, dimension, block_sizes2, nb_blocks2);
-  problem = transform_vars_permutation(problem, P21, dimension);
+  problem = transform_vars_permblockdiag(problem, B2_copy, P21, P22, dimension, block_sizes2, nb_blocks2);
   problem = transform_vars_asymmetric(problem, 0.2);
   problem = transform_vars_oscillate(problem);
-  problem = transform_vars_permutation(problem, P12, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
-  problem = transform_vars_permutation(problem, P11, dimension);
+  problem = transform_vars_permblockdiag(problem, B1_copy, P11, P12, dimension, block_sizes1, nb_blocks1);
   problem = transform_vars_shift(problem, xopt, 0);
 
   problem = transform_obj_norm_by_dim(problem);
@@ -18,6 +18,7 @@
 #include "transform_obj_penalize.c"
 #include "transform_vars_permutation.c"
 #include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_obj_norm_by_dim.c"
 
 /**
@@ -56,6 +57,46 @@ static void f_schaffers_evaluate(coco_problem_t *problem, const double *x, doubl
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Implements the Schaffer's F7 function with reordered floating-point operations (see
+ * f_fast_kernels.c).
+ *
+ * Computes pow(tmp, 0.1) and the square of each variable only once and replaces the remaining calls to pow
+ * by square roots and multiplications.
+ */
+static double f_schaffers_raw_fast(const double *x, const size_t number_of_variables) {
+
+  size_t i;
+  double result, square, next_square;
+
+  assert(number_of_variables > 1);
+
+  result = 0.0;
+  square = x[0] * x[0];
+  for (i = 0; i < number_of_variables - 1; ++i) {
+    double tmp, sine;
+    next_square = x[i + 1] * x[i + 1];
+    tmp = square + next_square;
+    sine = sin(50.0 * pow(tmp, 0.1));
+    if (coco_is_inf(tmp) && coco_is_nan(sine)) /* sin(inf) -> nan */
+      return tmp;
+    result += sqrt(sqrt(tmp)) * (1.0 + sine * sine);
+    square = next_square;
+  }
+  result /= (double) (long) number_of_variables - 1.0;
+
+  return result * result;
+}
+
+/**
+ * @brief Uses the fast raw function to evaluate the COCO problem (see f_fast_kernels.c).
+ */
+static void f_schaffers_evaluate_fast(coco_problem_t *problem, const double *x, double *y) {
+  assert(problem->number_of_objectives == 1);
+  y[0] = f_schaffers_raw_fast(x, problem->number_of_variables);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Allocates the basic Schaffer's F7 problem.
  */
@@ -182,14 +223,10 @@ static coco_problem_t *f_schaffers_permblockdiag_bbob_problem_allocate(const siz
     
     problem = f_schaffers_allocate(dimension);
     problem = transform_vars_conditioning(problem, conditioning);
-    problem = transform_vars_permutation(problem, P21, dimension);
-    problem = transform_vars_blockrotation(problem, B2_copy, dimension, block_sizes2, nb_blocks2);
-    problem = transform_vars_permutation(problem, P11, dimension);
+    problem = transform_vars_permblockdiag(problem, B2_copy, P11, P21, dimension, block_sizes2, nb_blocks2);
     
     problem = transform_vars_asymmetric(problem, 0.5);
-    problem = transform_vars_permutation(problem, P22, dimension);
-    problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
-    problem = transform_vars_permutation(problem, P12, dimension);
+    problem = transform_vars_permblockdiag(problem, B1_copy, P12, P22, dimension, block_sizes1, nb_blocks1);
     
     problem = transform_vars_shift(problem, xopt, 0);
     /*problem = transform_obj_norm_by_dim(problem);*/ /* Wassim: there is already a normalization by dimension*/
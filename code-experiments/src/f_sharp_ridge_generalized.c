@@ -15,6 +15,7 @@
 #include "transform_vars_conditioning.c"
 #include "transform_vars_permutation.c"
 #include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_obj_norm_by_dim.c"
 
 /**
@@ -147,13 +148,9 @@ static coco_problem_t *f_sharp_ridge_generalized_permblockdiag_bbob_problem_allo
   
   
   problem = f_sharp_ridge_generalized_allocate(dimension, proportion_of_linear_dims);
-  problem = transform_vars_permutation(problem, P21, dimension);/* LIFO */
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
-  problem = transform_vars_permutation(problem, P11, dimension);
+  problem = transform_vars_permblockdiag(problem, B1_copy, P11, P21, dimension, block_sizes1, nb_blocks1); /* LIFO */
   problem = transform_vars_conditioning(problem, 10.0);
-  problem = transform_vars_permutation(problem, P22, dimension);/*Consider replacing P11 and 22 by a single permutation P3*/
-  problem = transform_vars_blockrotation(problem, B2_copy, dimension, block_sizes2, nb_blocks2);
-  problem = transform_vars_permutation(problem, P12, dimension);
+  problem = transform_vars_permblockdiag(problem, B2_copy, P12, P22, dimension, block_sizes2, nb_blocks2); /*Consider replacing P11 and 22 by a single permutation P3*/
   problem = transform_vars_shift(problem, xopt, 0);
 
   problem = transform_obj_norm_by_dim(problem);
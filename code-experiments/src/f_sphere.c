@@ -41,6 +41,22 @@ static void f_sphere_evaluate(coco_problem_t *problem, const double *x, double *
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Implements the sphere function with reordered floating-point operations (see f_fast_kernels.c).
+ */
+static double f_sphere_raw_fast(const double *x, const size_t number_of_variables) {
+  return coco_vector_sum_of_squares(x, number_of_variables);
+}
+
+/**
+ * @brief Uses the fast raw function to evaluate the COCO problem (see f_fast_kernels.c).
+ */
+static void f_sphere_evaluate_fast(coco_problem_t *problem, const double *x, double *y) {
+  assert(problem->number_of_objectives == 1);
+  y[0] = f_sphere_raw_fast(x, problem->number_of_variables);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Evaluates the gradient of the sphere function.
  */
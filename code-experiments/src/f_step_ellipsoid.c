@@ -21,6 +21,7 @@
 #include "transform_vars_shift.c"
 #include "transform_vars_permutation.c"
 #include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_vars_round_step.c"
 #include "transform_obj_norm_by_dim.c"
 
@@ -29,17 +30,23 @@
  * @brief Data type for the step ellipsoid problem.
  */
 typedef struct {
-  double *x, *xx;
   double *xopt, fopt;
   double **rot1, **rot2;
+  double *scaling;      /**< @brief The coefficients sqrt(10^(i / (n - 1))) of the first transformation. */
+  double *conditioning; /**< @brief The coefficients 100^(i / (n - 1)) of the ellipsoid. */
 } f_step_ellipsoid_data_t;
 
 /**
  * @brief Implements the step ellipsoid function without connections to any COCO structures.
+ *
+ * The vectors z and zz of size number_of_variables are used as temporary storage.
  */
-static double f_step_ellipsoid_raw(const double *x, const size_t number_of_variables, f_step_ellipsoid_data_t *data) {
+static double f_step_ellipsoid_raw(const double *x,
+                                   const size_t number_of_variables,
+                                   const f_step_ellipsoid_data_t *data,
+                                   double *z,
+                                   double *zz) {
   
-  static const double condition = 100;
   static const double alpha = 10.0;
   size_t i, j;
   double penalty = 0.0, x1;
@@ -58,36 +65,32 @@ static double f_step_ellipsoid_raw(const double *x, const size_t number_of_varia
   }
   
   for (i = 0; i < number_of_variables; ++i) {
-    double c1;
-    data->x[i] = 0.0;
-    c1 = sqrt(pow(condition / 10., (double) i / (double) (number_of_variables - 1)));
+    const double c1 = data->scaling[i];
+    z[i] = 0.0;
     for (j = 0; j < number_of_variables; ++j) {
-      data->x[i] += c1 * data->rot2[i][j] * (x[j] - data->xopt[j]);
+      z[i] += c1 * data->rot2[i][j] * (x[j] - data->xopt[j]);
     }
   }
-  x1 = data->x[0];
+  x1 = z[0];
   
   for (i = 0; i < number_of_variables; ++i) {
-    if (fabs(data->x[i]) > 0.5) /* TODO: Documentation: no fabs() in documentation */
-      data->x[i] = coco_double_round(data->x[i]);
+    if (fabs(z[i]) > 0.5) /* TODO: Documentation: no fabs() in documentation */
+      z[i] = coco_double_round(z[i]);
     else
-      data->x[i] = coco_double_round(alpha * data->x[i]) / alpha;
+      z[i] = coco_double_round(alpha * z[i]) / alpha;
   }
   
   for (i = 0; i < number_of_variables; ++i) {
-    data->xx[i] = 0.0;
+    zz[i] = 0.0;
     for (j = 0; j < number_of_variables; ++j) {
-      data->xx[i] += data->rot1[i][j] * data->x[j];
+      zz[i] += data->rot1[i][j] * z[j];
     }
   }
   
   /* Computation core */
   result = 0.0;
   for (i = 0; i < number_of_variables; ++i) {
-    double exponent;
-    exponent = (double) (long) i / ((double) (long) number_of_variables - 1.0);
-    result += pow(condition, exponent) * data->xx[i] * data->xx[i];
-    ;
+    result += data->conditioning[i] * zz[i] * zz[i];
   }
   result = 0.1 * coco_double_max(fabs(x1) * 1.0e-4, result) + penalty + data->fopt;
   
@@ -98,8 +101,13 @@ static double f_step_ellipsoid_raw(const double *x, const size_t number_of_varia
  * @brief Uses the raw function to evaluate the COCO problem.
  */
 static void f_step_ellipsoid_evaluate(coco_problem_t *problem, const double *x, double *y) {
+  double *z;
+
   assert(problem->number_of_objectives == 1);
-  y[0] = f_step_ellipsoid_raw(x, problem->number_of_variables, (f_step_ellipsoid_data_t *) problem->data);
+  z = coco_problem_scratch_allocate(problem, 2 * problem->number_of_variables);
+  y[0] = f_step_ellipsoid_raw(x, problem->number_of_variables, (f_step_ellipsoid_data_t *) problem->data,
+      z, z + problem->number_of_variables);
+  coco_problem_scratch_free(problem, z, 2 * problem->number_of_variables);
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
@@ -109,11 +117,11 @@ static void f_step_ellipsoid_evaluate(coco_problem_t *problem, const double *x,
 static void f_step_ellipsoid_free(coco_problem_t *problem) {
   f_step_ellipsoid_data_t *data;
   data = (f_step_ellipsoid_data_t *) problem->data;
-  coco_free_memory(data->x);
-  coco_free_memory(data->xx);
   coco_free_memory(data->xopt);
   bbob2009_free_matrix(data->rot1, problem->number_of_variables);
   bbob2009_free_matrix(data->rot2, problem->number_of_variables);
+  coco_free_memory(data->scaling);
+  coco_free_memory(data->conditioning);
   /* Let the generic free problem code deal with all of the coco_problem_t fields */
   problem->problem_free_function = NULL;
   coco_problem_free(problem);
@@ -131,15 +139,14 @@ static coco_problem_t *f_step_ellipsoid_bbob_problem_allocate(const size_t funct
                                                               const char *problem_id_template,
                                                               const char *problem_name_template) {
   
+  static const double condition = 100;
   f_step_ellipsoid_data_t *data;
   size_t i;
   coco_problem_t *problem = coco_problem_allocate_from_scalars("step ellipsoid function",
                                                                f_step_ellipsoid_evaluate, f_step_ellipsoid_free, dimension, -5.0, 5.0, 0);
   
   data = (f_step_ellipsoid_data_t *) coco_allocate_memory(sizeof(*data));
-  /* Allocate temporary storage and space for the rotation matrices */
-  data->x = coco_allocate_vector(dimension);
-  data->xx = coco_allocate_vector(dimension);
+  /* Allocate space for the rotation matrices */
   data->xopt = coco_allocate_vector(dimension);
   data->rot1 = bbob2009_allocate_matrix(dimension, dimension);
   data->rot2 = bbob2009_allocate_matrix(dimension, dimension);
@@ -148,6 +155,10 @@ static coco_problem_t *f_step_ellipsoid_bbob_problem_allocate(const size_t funct
   bbob2009_compute_xopt(data->xopt, rseed, dimension);
   bbob2009_compute_rotation(data->rot1, rseed + 1000000, dimension);
   bbob2009_compute_rotation(data->rot2, rseed, dimension);
+  data->scaling = coco_allocate_conditioning_coefficients(condition / 10., 1.0, dimension);
+  for (i = 0; i < dimension; ++i)
+    data->scaling[i] = sqrt(data->scaling[i]);
+  data->conditioning = coco_allocate_conditioning_coefficients(condition, 1.0, dimension);
   
   problem->data = data;
   
@@ -175,18 +186,17 @@ static coco_problem_t *f_step_ellipsoid_bbob_problem_allocate(const size_t funct
 
 /**
  * @brief Implements the step ellipsoid function without connections to any COCO structures.
+ *
+ * The coefficients 100^(i / (n - 1)) are given in the vector conditioning.
  */
-static double f_step_ellipsoid_core(const double *x, const size_t number_of_variables, f_step_ellipsoid_versatile_data_t *f_step_ellipsoid_versatile_data) {
+static double f_step_ellipsoid_core(const double *x, const size_t number_of_variables, f_step_ellipsoid_versatile_data_t *f_step_ellipsoid_versatile_data, const double *conditioning) {
   
-  static const double condition = 100;
   size_t i;
   double result;
   result = 0.0;
   
   for (i = 0; i < number_of_variables; ++i) {
-    double exponent;
-    exponent = (double) (long) i / ((double) (long) number_of_variables - 1.0);
-    result += pow(condition, exponent) * x[i] * x[i];
+    result += conditioning[i] * x[i] * x[i];
   }
   result = 0.1 * coco_double_max(f_step_ellipsoid_versatile_data->zhat_1 * 1.0e-4, result);
   return result;
@@ -198,7 +208,8 @@ static double f_step_ellipsoid_core(const double *x, const size_t number_of_vari
  */
 static void f_step_ellipsoid_permblock_evaluate(coco_problem_t *problem, const double *x, double *y) {
   assert(problem->number_of_objectives == 1);
-  y[0] = f_step_ellipsoid_core(x, problem->number_of_variables, (f_step_ellipsoid_versatile_data_t *) problem->versatile_data);
+  y[0] = f_step_ellipsoid_core(x, problem->number_of_variables, (f_step_ellipsoid_versatile_data_t *) problem->versatile_data,
+      (const double *) problem->data);
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
@@ -212,20 +223,47 @@ static void f_step_ellipsoid_versatile_data_free(coco_problem_t *problem) {
   coco_problem_free(problem);
 }
 
+/**
+ * @brief Frees the clone of the basic step ellipsoid problem leaving the coefficients it shares with the
+ * original problem intact.
+ */
+static void f_step_ellipsoid_versatile_data_clone_free(coco_problem_t *problem) {
+  problem->data = NULL;
+  f_step_ellipsoid_versatile_data_free(problem);
+}
+
+/**
+ * @brief Clones the basic step ellipsoid problem, giving the clone its own versatile_data (the value of
+ * \hat{z}_1 is set in every evaluation).
+ */
+static coco_problem_t *f_step_ellipsoid_versatile_data_clone(const coco_problem_t *problem) {
+  coco_problem_t *clone = coco_problem_clone_duplicate(problem);
+  clone->data = problem->data;
+  clone->problem_free_function = f_step_ellipsoid_versatile_data_clone_free;
+  clone->versatile_data = (f_step_ellipsoid_versatile_data_t *) coco_allocate_memory(sizeof(f_step_ellipsoid_versatile_data_t));
+  ((f_step_ellipsoid_versatile_data_t *) clone->versatile_data)->zhat_1 =
+      ((f_step_ellipsoid_versatile_data_t *) problem->versatile_data)->zhat_1;
+  return clone;
+}
+
 
 
 /**
  * @brief Allocates the basic step ellipsoid problem.
  * an additional coordinate is added that will contain the value of \hat{z}_1 but that is ignored by functions other that f_step_ellipsoid_core and transform_vars_round_step. The latter sets it.
+ * The data of the problem is the vector of the coefficients 100^(i / (n - 1)).
  */
 static coco_problem_t *f_step_ellipsoid_allocate(const size_t number_of_variables) {
   
+  static const double condition = 100;
   coco_problem_t *problem = coco_problem_allocate_from_scalars("step ellipsoid function",
                                                                f_step_ellipsoid_permblock_evaluate, NULL, number_of_variables, -5.0, 5.0, 0.0);
+  problem->data = coco_allocate_conditioning_coefficients(condition, 1.0, number_of_variables);
   problem->versatile_data = (f_step_ellipsoid_versatile_data_t *) coco_allocate_memory(sizeof(f_step_ellipsoid_versatile_data_t));
   ((f_step_ellipsoid_versatile_data_t *) problem->versatile_data)->zhat_1 = 0;/*needed for xopt evaluation*/
   /* add the free function of the allocated versatile_data*/
   problem->problem_free_function = f_step_ellipsoid_versatile_data_free;
+  problem->problem_clone_function = f_step_ellipsoid_versatile_data_clone;
   
   coco_problem_set_id(problem, "%s_d%02lu", "step_ellipsoid", number_of_variables);
   /* Compute best solution, here done outside after the zhat is set to the best_value */
@@ -286,15 +324,11 @@ static coco_problem_t *f_step_ellipsoid_permblockdiag_bbob_problem_allocate(cons
 
   problem = f_step_ellipsoid_allocate(dimension);
 
-  problem = transform_vars_permutation(problem, P22, dimension);
-  problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
-  problem = transform_vars_permutation(problem, P21, dimension);
+  problem = transform_vars_permblockdiag(problem, B1_copy, P21, P22, dimension, block_sizes1, nb_blocks1);
   problem = transform_vars_round_step(problem, alpha);
   
   problem = transform_vars_conditioning(problem, 10.0);
-  problem = transform_vars_permutation(problem, P12, dimension);
-  problem = transform_vars_blockrotation(problem, B2_copy, dimension, block_sizes2, nb_blocks2);
-  problem = transform_vars_permutation(problem, P11, dimension);
+  problem = transform_vars_permblockdiag(problem, B2_copy, P11, P12, dimension, block_sizes2, nb_blocks2);
   problem = transform_vars_shift(problem, xopt, 0);
 
   problem = transform_obj_norm_by_dim(problem);
@@ -17,6 +17,7 @@
 #include "transform_vars_shift.c"
 #include "transform_vars_permutation.c"
 #include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
 #include "transform_obj_norm_by_dim.c"
 
 /** @brief Number of summands in the Weierstrass problem. */
@@ -29,6 +30,7 @@ typedef struct {
   double f0;
   double ak[F_WEIERSTRASS_SUMMANDS];
   double bk[F_WEIERSTRASS_SUMMANDS];
+  double two_pi_bk[F_WEIERSTRASS_SUMMANDS]; /**< @brief The values 2 * pi * bk used by the fast function. */
 } f_weierstrass_data_t;
 
 /**
@@ -62,6 +64,39 @@ static void f_weierstrass_evaluate(coco_problem_t *problem, const double *x, dou
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Implements the Weierstrass function with reordered floating-point operations (see
+ * f_fast_kernels.c).
+ *
+ * Uses the precomputed frequencies 2 * pi * bk and sums the terms of each variable separately.
+ */
+static double f_weierstrass_raw_fast(const double *x, const size_t number_of_variables, f_weierstrass_data_t *data) {
+
+  size_t i, j;
+  double result, sum;
+
+  result = 0.0;
+  for (i = 0; i < number_of_variables; ++i) {
+    const double phase = x[i] + 0.5;
+    sum = 0.0;
+    for (j = 0; j < F_WEIERSTRASS_SUMMANDS; ++j)
+      sum += cos(data->two_pi_bk[j] * phase) * data->ak[j];
+    result += sum;
+  }
+  result = result / (double) (long) number_of_variables - data->f0;
+
+  return 10.0 * result * result * result;
+}
+
+/**
+ * @brief Uses the fast raw function to evaluate the COCO problem (see f_fast_kernels.c).
+ */
+static void f_weierstrass_evaluate_fast(coco_problem_t *problem, const double *x, double *y) {
+  assert(problem->number_of_objectives == 1);
+  y[0] = f_weierstrass_raw_fast(x, problem->number_of_variables, (f_weierstrass_data_t *) problem->data);
+  assert(y[0] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Allocates the basic Weierstrass problem.
  */
@@ -79,6 +114,7 @@ static coco_problem_t *f_weierstrass_allocate(const size_t number_of_variables)
   for (i = 0; i < F_WEIERSTRASS_SUMMANDS; ++i) {
     data->ak[i] = pow(0.5, (double) i);
     data->bk[i] = pow(3., (double) i);
+    data->two_pi_bk[i] = 2 * coco_pi * data->bk[i];
     data->f0 += data->ak[i] * cos(2 * coco_pi * data->bk[i] * 0.5);
   }
   problem->data = data;
@@ -204,19 +240,13 @@ static coco_problem_t *f_weierstrass_permblockdiag_bbob_problem_allocate(const s
     coco_compute_truncated_uniform_swap_permutation(P22, rseed + 6000000, dimension, nb_swaps, swap_range);
     
     problem = f_weierstrass_allocate(dimension);
-    problem = transform_vars_permutation(problem, P22, dimension);
-    problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
-    problem = transform_vars_permutation(problem, P12, dimension);
+    problem = transform_vars_permblockdiag(problem, B1_copy, P12, P22, dimension, block_sizes1, nb_blocks1);
     
     problem = transform_vars_conditioning(problem, 1.0/condition);
-    problem = transform_vars_permutation(problem, P21, dimension);
-    problem = transform_vars_blockrotation(problem, B2_copy, dimension, block_sizes2, nb_blocks2);
-    problem = transform_vars_permutation(problem, P11, dimension);
+    problem = transform_vars_permblockdiag(problem, B2_copy, P11, P21, dimension, block_sizes2, nb_blocks2);
     
     problem = transform_vars_oscillate(problem);
-    problem = transform_vars_permutation(problem, P22, dimension);
-    problem = transform_vars_blockrotation(problem, B1_copy, dimension, block_sizes1, nb_blocks1);
-    problem = transform_vars_permutation(problem, P12, dimension);
+    problem = transform_vars_permblockdiag(problem, B1_copy, P12, P22, dimension, block_sizes1, nb_blocks1);
 
     problem = transform_vars_shift(problem, xopt, 0);
     /*problem = transform_obj_norm_by_dim(problem);*/ /* Wassim: there is already a normalization by dimension*/
@@ -24,6 +24,8 @@
 #include "coco_utilities.c"
 #include "coco_problem.c"
 #include "coco_string.c"
+#include "coco_writer.c"
+#include "coco_binary_results.c"
 #include "observer_bbob.c"
 
 static const double fvalue_logged_for_infinite = 3e21;   /* value used for logging try */
@@ -33,25 +35,6 @@ static const double weight_constraints = 1e0;  /* factor used in logged indicato
 
 /*static const size_t bbob_nbpts_nbevals = 20; Wassim: tentative, are now observer options with these default values*/
 /*static const size_t bbob_nbpts_fval = 5;*/
-static size_t bbob_current_dim = 0;
-static size_t bbob_current_funId = 0;
-static size_t bbob_infoFile_firstInstance = 0;
-char *bbob_infoFile_firstInstance_char;
-/* a possible solution: have a list of dims that are already in the file, if the ones we're about to log
- * is != bbob_current_dim and the funId is currend_funId, create a new .info file with as suffix the
- * number of the first instance */
-static const int bbob_number_of_dimensions = 6;
-static size_t bbob_dimensions_in_current_infoFile[6] = { 0, 0, 0, 0, 0, 0 }; /* TODO should use dimensions from the suite */
-
-/* The current_... mechanism fails if several problems are open.
- * For the time being this should lead to an error.
- *
- * A possible solution: bbob_logger_is_open becomes a reference
- * counter and as long as another logger is open, always a new info
- * file is generated.
- * TODO: Shouldn't the new way of handling observers already fix this?
- */
-static int bbob_logger_is_open = 0; /* this could become lock-list of .info files */
 
 /* TODO: add possibility of adding a prefix to the index files (easy to do through observer options) */
 
@@ -63,10 +46,13 @@ typedef struct {
   int is_initialized;
   /*char *path;// relative path to the data folder. //Wassim: now fetched from the observer */
   /*const char *alg_name; the alg name, for now, temporarily the same as the path. Wassim: Now in the observer */
-  FILE *index_file; /* index file */
-  FILE *fdata_file; /* function value aligned data file */
-  FILE *tdata_file; /* number of function evaluations aligned data file */
-  FILE *rdata_file; /* restart info data file */
+  observer_bbob_info_entry_t *info_entry; /* entry of the index file */
+  coco_writer_t *fdata_writer; /* function value aligned data file */
+  coco_writer_t *tdata_writer; /* number of function evaluations aligned data file */
+  coco_writer_t *rdata_writer; /* restart info data file */
+  coco_binary_results_block_t *fdata_block; /* rows of the .dat file in the bbob-binary format */
+  coco_binary_results_block_t *tdata_block; /* rows of the .tdat file in the bbob-binary format */
+  char *binary_file_path; /* path of the data files (without the extension) in the bbob-binary format */
   size_t number_of_evaluations;
   size_t number_of_evaluations_constraints;
   double best_fvalue;
@@ -81,6 +67,7 @@ typedef struct {
   size_t instance_id;
   size_t number_of_variables;
   size_t number_of_integer_variables;
+  size_t number_of_constraints;
   int log_discrete_as_int;            /**< @brief Whether to output discrete variables in int or double format. */
   double optimal_fvalue;
   char *suite_name;
@@ -138,11 +125,12 @@ static const char *bbob_file_header_str = "%% "
 
 static const char *logger_name = "bbob";
 static const char *data_format = "bbob-new2"; /* back to 5 columns, 5-th column writes single digit constraint values */
+static const char *binary_data_format = "bbob-binary"; /* the same data as "bbob-new2" in binary form */
 
 /**
  * adds a formated line to a data file
  */
-static void logger_bbob_write_data(FILE *target_file,
+static void logger_bbob_write_data(coco_writer_t *writer,
                                    size_t number_of_f_evaluations,
                                    size_t number_of_cons_evaluations,
                                    double fvalue,
@@ -158,34 +146,40 @@ static void logger_bbob_write_data(FILE *target_file,
   /* for some reason, it's %.0f in the old code instead of the 10.9e
    * in the documentation
    */
-  fprintf(target_file, "%lu %lu %+10.9e %+10.9e ",
-          (unsigned long) number_of_f_evaluations,
-    	  (unsigned long) number_of_cons_evaluations,
-          best_fvalue - best_value,
-    	  fvalue);
+  /* The line is the same as written by
+   * fprintf("%lu %lu %+10.9e %+10.9e ", ...), followed by the constraints ("%d" each) or "%+10.9e", the
+   * variables (" %d" or " %+5.4e" each) and a new line */
+  coco_writer_write_unsigned_long(writer, (unsigned long) number_of_f_evaluations);
+  coco_writer_write_char(writer, ' ');
+  coco_writer_write_unsigned_long(writer, (unsigned long) number_of_cons_evaluations);
+  coco_writer_write_char(writer, ' ');
+  coco_writer_write_exponential(writer, best_fvalue - best_value, 10, 9);
+  coco_writer_write_char(writer, ' ');
+  coco_writer_write_exponential(writer, fvalue, 10, 9);
+  coco_writer_write_char(writer, ' ');
 
   if (number_of_constraints > 0)
     for (i = 0; i < number_of_constraints; ++i)
-      fprintf(target_file, "%d",
+      coco_writer_write_int(writer,
               constraints ? single_digit_constraint_value(constraints[i])
                           : (int) (i % 10)); /* print 01234567890123..., may happen in last line of .tdat */
   else
-    fprintf(target_file, "%+10.9e", best_fvalue);
+    coco_writer_write_exponential(writer, best_fvalue, 10, 9);
 
   if ((number_of_variables - number_of_integer_variables) < 22) {
     for (i = 0; i < number_of_variables; i++) {
+      coco_writer_write_char(writer, ' ');
       if ((i < number_of_integer_variables) && (log_discrete_as_int))
-        fprintf(target_file, " %d", coco_double_to_int(x[i]));
+        coco_writer_write_int(writer, coco_double_to_int(x[i]));
       else
-        fprintf(target_file, " %+5.4e", x[i]);
+        coco_writer_write_exponential(writer, x[i], 5, 4);
     }
   }
-  fprintf(target_file, "\n");
 
-  /* Flush output so that impatient users can see progress.
-   * Otherwise it can take a long time until the output appears.
+  /* The writer flushes the output according to its flush policy (by default after every line, so that
+   * impatient users can see progress)
    */
-  fflush(target_file);
+  coco_writer_end_line(writer);
 }
 
 /**
@@ -250,8 +244,51 @@ static void logger_bbob_open_dataFile(FILE **target_file,
 }*/
 
 /**
- * Creates the index file fileName_prefix+problem_id+file_extension in
+ * Computes the path of the index file fileName_prefix+problem_id+file_extension in folder_path and the
+ * path of the data files (without the extension) for the given first instance of the index file.
+ */
+static void logger_bbob_get_index_file_paths(char *file_path,
+                                             char *used_dataFile_path,
+                                             const char *folder_path,
+                                             const char *indexFile_prefix,
+                                             const char *function_id_char,
+                                             const char *firstInstance_char,
+                                             const char *dataFile_path) {
+  char file_name[COCO_PATH_MAX + 2] = { 0 };
+
+  strncpy(file_name, indexFile_prefix, COCO_PATH_MAX - strlen(file_name) - 1);
+  strncat(file_name, "_f", COCO_PATH_MAX - strlen(file_name) - 1);
+  strncat(file_name, function_id_char, COCO_PATH_MAX - strlen(file_name) - 1);
+  strncat(file_name, "_i", COCO_PATH_MAX - strlen(file_name) - 1);
+  strncat(file_name, firstInstance_char, COCO_PATH_MAX - strlen(file_name) - 1);
+  strncat(file_name, ".info", COCO_PATH_MAX - strlen(file_name) - 1);
+  file_path[0] = '\0';
+  coco_join_path(file_path, COCO_PATH_MAX + 2, folder_path, file_name, NULL);
+
+  used_dataFile_path[0] = '\0';
+  strncpy(used_dataFile_path, dataFile_path, COCO_PATH_MAX - 1);
+  strncat(used_dataFile_path, "_i", COCO_PATH_MAX - strlen(used_dataFile_path) - 1);
+  strncat(used_dataFile_path, firstInstance_char, COCO_PATH_MAX - strlen(used_dataFile_path) - 1);
+}
+
+/**
+ * Returns the part of the info and data file names that follows "_i": the first instance of the current
+ * info file and, if the data files of this name were used by another open logger, the number -NNN.
+ */
+static char *logger_bbob_get_first_instance_string(const observer_bbob_data_t *observer_data) {
+  if (observer_data->info_file_number == 0)
+    return coco_strdupf("%lu", (unsigned long) observer_data->info_file_first_instance);
+  return coco_strdupf("%lu-%03lu", (unsigned long) observer_data->info_file_first_instance,
+      (unsigned long) observer_data->info_file_number);
+}
+
+/**
+ * Creates the entry of the index file fileName_prefix+problem_id+file_extension in
  * folder_path
+ *
+ * The entry is written to the index file by the observer when the logger starts and completed when the
+ * logger is freed (see observer_bbob_info_entry_t). A new index file is
+ * started if the data files the logger would write to are used by another open logger.
  */
 static void logger_bbob_openIndexFile(logger_bbob_data_t *logger,
                                       const char *folder_path,
@@ -259,113 +296,188 @@ static void logger_bbob_openIndexFile(logger_bbob_data_t *logger,
                                       const char *function_id,
                                       const char *dataFile_path,
                                       const char *suite_name) {
-  /* to add the instance number TODO: this should be done outside to avoid redoing this for the .*dat files */
+  observer_bbob_data_t *observer_data = (observer_bbob_data_t *) logger->observer->data;
   char used_dataFile_path[COCO_PATH_MAX + 2] = { 0 };
-  int errnum, newLine; /* newLine is at 1 if we need a new line in the info file */
+  int file_exists, newLine = 0; /* newLine is at 1 if we need a new line in the info file */
+  int new_file = 0; /* new_file is at 1 if we need to start a new info file */
   char *function_id_char; /* TODO: consider adding them to logger */
-  char file_name[COCO_PATH_MAX + 2] = { 0 };
+  char *firstInstance_char;
   char file_path[COCO_PATH_MAX + 2] = { 0 };
-  FILE **target_file;
-  FILE *tmp_file;
-  strncpy(used_dataFile_path, dataFile_path, COCO_PATH_MAX - strlen(used_dataFile_path) - 1);
-  if (bbob_infoFile_firstInstance == 0) {
-    bbob_infoFile_firstInstance = logger->instance_id;
+  char *tmp_string;
+  observer_bbob_info_entry_t *entry;
+  size_t i, j;
+
+  if (observer_data->info_file_first_instance == 0) {
+    observer_data->info_file_first_instance = logger->instance_id;
   }
   function_id_char = coco_strdupf("%lu", (unsigned long) logger->function_id);
-  bbob_infoFile_firstInstance_char = coco_strdupf("%lu", (unsigned long) bbob_infoFile_firstInstance);
-  target_file = &(logger->index_file);
-  tmp_file = NULL; /* to check whether the file already exists. Don't want to use target_file */
-  strncpy(file_name, indexFile_prefix, COCO_PATH_MAX - strlen(file_name) - 1);
-  strncat(file_name, "_f", COCO_PATH_MAX - strlen(file_name) - 1);
-  strncat(file_name, function_id_char, COCO_PATH_MAX - strlen(file_name) - 1);
-  strncat(file_name, "_i", COCO_PATH_MAX - strlen(file_name) - 1);
-  strncat(file_name, bbob_infoFile_firstInstance_char, COCO_PATH_MAX - strlen(file_name) - 1);
-  strncat(file_name, ".info", COCO_PATH_MAX - strlen(file_name) - 1);
-  coco_join_path(file_path, sizeof(file_path), folder_path, file_name, NULL);
-  if (*target_file == NULL) {
-    tmp_file = fopen(file_path, "r"); /* to check for existence */
-    if ((tmp_file) && (bbob_current_dim == logger->number_of_variables)
-        && (bbob_current_funId == logger->function_id)) {
-        /* new instance of current funId and current dim */
-      newLine = 0;
-      *target_file = fopen(file_path, "a+");
-      if (*target_file == NULL) {
-        errnum = errno;
-        logger_bbob_error_io(*target_file, errnum);
+  firstInstance_char = logger_bbob_get_first_instance_string(observer_data);
+  logger_bbob_get_index_file_paths(file_path, used_dataFile_path, folder_path, indexFile_prefix,
+      function_id_char, firstInstance_char, dataFile_path);
+  file_exists = observer_bbob_info_file_exists(observer_data, file_path);
+
+  if (file_exists && (observer_data->current_dim == logger->number_of_variables)
+      && (observer_data->current_fun_id == logger->function_id)
+      && !observer_bbob_data_file_is_open(observer_data, used_dataFile_path)) {
+    /* new instance of current funId and current dim */
+    entry = observer_bbob_info_entry_allocate(observer_data, file_path, used_dataFile_path);
+  } else { /* either file doesn't exist (new funId) or new Dim */
+    /* check that the dim was not already present earlier in the file, if so, create a new info file */
+    if (observer_data->current_dim != logger->number_of_variables) {
+      for (i = 0;
+          i < OBSERVER_BBOB_MAX_DIMENSIONS_IN_INFO_FILE && observer_data->dimensions_in_current_info_file[i] != 0
+              && observer_data->dimensions_in_current_info_file[i] != logger->number_of_variables; i++) {
+        ; /* checks whether dimension already present in the current infoFile */
       }
-      fclose(tmp_file);
-    } else { /* either file doesn't exist (new funId) or new Dim */
-      /* check that the dim was not already present earlier in the file, if so, create a new info file */
-      if (bbob_current_dim != logger->number_of_variables) {
-        int i, j;
-        for (i = 0;
-            i < bbob_number_of_dimensions && bbob_dimensions_in_current_infoFile[i] != 0
-                && bbob_dimensions_in_current_infoFile[i] != logger->number_of_variables; i++) {
-          ; /* checks whether dimension already present in the current infoFile */
-        }
-        if (i < bbob_number_of_dimensions && bbob_dimensions_in_current_infoFile[i] == 0) {
-          /* new dimension seen for the first time */
-          bbob_dimensions_in_current_infoFile[i] = logger->number_of_variables;
-          newLine = 1;
-        } else {
-          if (i < bbob_number_of_dimensions) { /* dimension already present, need to create a new file */
-            newLine = 0;
-            file_path[strlen(file_path) - strlen(bbob_infoFile_firstInstance_char) - 7] = 0; /* truncate the instance part */
-            bbob_infoFile_firstInstance = logger->instance_id;
-            coco_free_memory(bbob_infoFile_firstInstance_char);
-            bbob_infoFile_firstInstance_char = coco_strdupf("%lu", (unsigned long) bbob_infoFile_firstInstance);
-            strncat(file_path, "_i", COCO_PATH_MAX - strlen(file_name) - 1);
-            strncat(file_path, bbob_infoFile_firstInstance_char, COCO_PATH_MAX - strlen(file_name) - 1);
-            strncat(file_path, ".info", COCO_PATH_MAX - strlen(file_name) - 1);
-          } else { /* we have all dimensions */
-            newLine = 1;
-          }
-          for (j = 0; j < bbob_number_of_dimensions; j++) { /* new info file, reinitialize list of dims */
-            bbob_dimensions_in_current_infoFile[j] = 0;
-          }
-          bbob_dimensions_in_current_infoFile[i] = logger->number_of_variables;
-        }
-      } else {
-        if ( bbob_current_funId != logger->function_id ) {
-          /*new function in the same file */
-          newLine = 1;
+      if (i < OBSERVER_BBOB_MAX_DIMENSIONS_IN_INFO_FILE && observer_data->dimensions_in_current_info_file[i] == 0) {
+        /* new dimension seen for the first time */
+        observer_data->dimensions_in_current_info_file[i] = logger->number_of_variables;
+        newLine = 1;
+      } else if (i < OBSERVER_BBOB_MAX_DIMENSIONS_IN_INFO_FILE) {
+        /* dimension already present, need to create a new file */
+        new_file = 1;
+      } else { /* we have all dimensions */
+        newLine = 1;
+        for (j = 0; j < OBSERVER_BBOB_MAX_DIMENSIONS_IN_INFO_FILE; j++) {
+          observer_data->dimensions_in_current_info_file[j] = 0;
         }
+        observer_data->dimensions_in_current_info_file[0] = logger->number_of_variables;
       }
-      *target_file = fopen(file_path, "a+"); /* in any case, we append */
-      if (*target_file == NULL) {
-        errnum = errno;
-        logger_bbob_error_io(*target_file, errnum);
+    } else if (observer_data->current_fun_id != logger->function_id) {
+      /*new function in the same file */
+      newLine = 1;
+    }
+    if (!new_file && observer_bbob_data_file_is_open(observer_data, used_dataFile_path)) {
+      /* the data files are used by another open logger, need to create a new file */
+      new_file = 1;
+      i = 0;
+    }
+    if (new_file) {
+      /* the new info file is named after the instance, followed by the next free number -NNN if its data
+       * files are used by another open logger */
+      observer_data->info_file_first_instance = logger->instance_id;
+      observer_data->info_file_number = 0;
+      while (1) {
+        coco_free_memory(firstInstance_char);
+        firstInstance_char = logger_bbob_get_first_instance_string(observer_data);
+        logger_bbob_get_index_file_paths(file_path, used_dataFile_path, folder_path, indexFile_prefix,
+            function_id_char, firstInstance_char, dataFile_path);
+        if (!observer_bbob_data_file_is_open(observer_data, used_dataFile_path))
+          break;
+        if (observer_data->info_file_number >= 999)
+          coco_error("logger_bbob_openIndexFile(): unable to find unused data files %s", dataFile_path);
+        observer_data->info_file_number++;
       }
-      if (tmp_file) { /* File already exists, new dim so just a new line. Also, close the tmp_file */
-        if (newLine) {
-          fprintf(*target_file, "\n");
-        }
-        fclose(tmp_file);
+      file_exists = observer_bbob_info_file_exists(observer_data, file_path);
+      newLine = 1;
+      for (j = 0; j < OBSERVER_BBOB_MAX_DIMENSIONS_IN_INFO_FILE; j++) { /* new info file, reinitialize list of dims */
+        observer_data->dimensions_in_current_info_file[j] = 0;
       }
-      /* data_format = coco_strdup("bbob-constrained"); */
-      fprintf(*target_file,
-              "suite = '%s', funcId = %d, DIM = %lu, Precision = %.3e, algId = '%s', coco_version = '%s', logger = '%s', data_format = '%s'\n",
-              suite_name,
-              (int) strtol(function_id, NULL, 10),
-              (unsigned long) logger->number_of_variables,
-              pow(10, -8),
-              logger->observer->algorithm_name,
-              coco_version,
-              logger_name,
-              data_format);
-
-      fprintf(*target_file, "%%\n");
-      strncat(used_dataFile_path, "_i", COCO_PATH_MAX - strlen(used_dataFile_path) - 1);
-      strncat(used_dataFile_path, bbob_infoFile_firstInstance_char,
-      COCO_PATH_MAX - strlen(used_dataFile_path) - 1);
-      fprintf(*target_file, "%s.dat", used_dataFile_path); /* dataFile_path does not have the extension */
-      bbob_current_dim = logger->number_of_variables;
-      bbob_current_funId = logger->function_id;
+      observer_data->dimensions_in_current_info_file[i] = logger->number_of_variables;
+    }
+
+    entry = observer_bbob_info_entry_allocate(observer_data, file_path, used_dataFile_path);
+    if (file_exists && newLine) { /* File already exists, new dim so just a new line */
+      observer_bbob_info_entry_append(entry, "\n");
     }
+    /* data_format = coco_strdup("bbob-constrained"); */
+    tmp_string = coco_strdupf("suite = '%s', funcId = %d, DIM = %lu, Precision = %.3e, algId = '",
+        suite_name,
+        (int) strtol(function_id, NULL, 10),
+        (unsigned long) logger->number_of_variables,
+        pow(10, -8));
+    observer_bbob_info_entry_append(entry, tmp_string);
+    coco_free_memory(tmp_string);
+    observer_bbob_info_entry_append(entry, logger->observer->algorithm_name);
+    tmp_string = coco_strdupf("', coco_version = '%s', logger = '%s', data_format = '%s'\n%%\n",
+        coco_version,
+        logger_name,
+        observer_data->binary_data_files ? binary_data_format : data_format);
+    observer_bbob_info_entry_append(entry, tmp_string);
+    coco_free_memory(tmp_string);
+    observer_bbob_info_entry_append(entry, used_dataFile_path);
+    observer_bbob_info_entry_append(entry, ".dat"); /* dataFile_path does not have the extension */
+    observer_data->current_dim = logger->number_of_variables;
+    observer_data->current_fun_id = logger->function_id;
   }
+  logger->info_entry = entry;
+  coco_free_memory(firstInstance_char);
   coco_free_memory(function_id_char);
 }
 
+/**
+ * @brief Opens the data file with the given extension, writes its header and returns a writer for it that
+ * uses the flush policy of the observer.
+ */
+static coco_writer_t *logger_bbob_open_data_writer(logger_bbob_data_t *logger,
+                                                   const char *dataFile_path,
+                                                   const char *file_extension) {
+  observer_bbob_data_t *observer_data = (observer_bbob_data_t *) logger->observer->data;
+  coco_writer_t *writer;
+  FILE *data_file = NULL;
+  char *header;
+
+  logger_bbob_open_dataFile(&data_file, logger->observer->result_folder, dataFile_path, file_extension);
+  writer = coco_writer(data_file, observer_data->flush_policy, observer_data->flush_lines,
+      observer_data->flush_interval, logger->observer->io_thread);
+  header = coco_strdupf(bbob_file_header_str, logger->optimal_fvalue);
+  coco_writer_write_string(writer, header);
+  coco_free_memory(header);
+  return writer;
+}
+
+/**
+ * @brief Allocates a block for the rows of the data file with the given extension in the bbob-binary format.
+ */
+static coco_binary_results_block_t *logger_bbob_allocate_block(logger_bbob_data_t *logger,
+                                                               const char *file_extension) {
+  coco_binary_results_block_t *block;
+  char *file_path = coco_strconcat(logger->binary_file_path, file_extension);
+
+  block = coco_binary_results_block_allocate(file_path, logger->number_of_variables,
+      logger->number_of_integer_variables, logger->number_of_constraints, logger->log_discrete_as_int,
+      logger->optimal_fvalue);
+  coco_free_memory(file_path);
+  return block;
+}
+
+/**
+ * @brief Adds a line to the .dat or .tdat file (given by its writer in the text format or its block in the
+ * bbob-binary format) with the same arguments as logger_bbob_write_data.
+ */
+static void logger_bbob_add_data(coco_writer_t *writer,
+                                 coco_binary_results_block_t *block,
+                                 size_t number_of_f_evaluations,
+                                 size_t number_of_cons_evaluations,
+                                 double fvalue,
+                                 double best_fvalue,
+                                 double best_value,
+                                 const double *x,
+                                 size_t number_of_variables,
+                                 size_t number_of_integer_variables,
+                                 const double *constraints,
+                                 size_t number_of_constraints,
+                                 const int log_discrete_as_int) {
+  unsigned char *digits = NULL;
+  size_t i;
+
+  if (block == NULL) {
+    logger_bbob_write_data(writer, number_of_f_evaluations, number_of_cons_evaluations, fvalue, best_fvalue,
+        best_value, x, number_of_variables, number_of_integer_variables, constraints, number_of_constraints,
+        log_discrete_as_int);
+    return;
+  }
+  if (number_of_constraints > 0) {
+    digits = (unsigned char *) coco_allocate_memory(number_of_constraints);
+    for (i = 0; i < number_of_constraints; ++i)
+      digits[i] = (unsigned char) (constraints ? single_digit_constraint_value(constraints[i]) : (int) (i % 10));
+  }
+  coco_binary_results_block_append(block, number_of_f_evaluations, number_of_cons_evaluations, fvalue,
+      best_fvalue, x, digits);
+  if (digits != NULL)
+    coco_free_memory(digits);
+}
+
 /**
  * Generates the different files and folder needed by the logger to store the
  * data if these don't already exist
@@ -378,6 +490,7 @@ static void logger_bbob_initialize(logger_bbob_data_t *logger, coco_problem_t *i
   char folder_path[COCO_PATH_MAX + 2] = { 0 };
   char *tmpc_funId; /* serves to extract the function id as a char *. There should be a better way of doing this! */
   char *tmpc_dim; /* serves to extract the dimension as a char *. There should be a better way of doing this! */
+  char *tmpc_instance;
   char indexFile_prefix[10] = "bbobexp"; /* TODO (minor): make the prefix bbobexp a parameter that the user can modify */
 
   assert(logger != NULL);
@@ -405,39 +518,40 @@ static void logger_bbob_initialize(logger_bbob_data_t *logger, coco_problem_t *i
   assert(coco_problem_get_suite(inner_problem));
   logger_bbob_openIndexFile(logger, logger->observer->result_folder, indexFile_prefix, tmpc_funId,
       dataFile_path, coco_problem_get_suite(inner_problem)->suite_name);
-  fprintf(logger->index_file, ", %lu", (unsigned long) coco_problem_get_suite_dep_instance(inner_problem));
+  tmpc_instance = coco_strdupf(", %lu", (unsigned long) coco_problem_get_suite_dep_instance(inner_problem));
+  observer_bbob_info_entry_append(logger->info_entry, tmpc_instance);
+  coco_free_memory(tmpc_instance);
+  observer_bbob_info_entry_start(logger->info_entry);
   /* data files */
-  /* TODO: definitely improvable but works for now */
-  strncat(dataFile_path, "_i", COCO_PATH_MAX - strlen(dataFile_path) - 1);
-  strncat(dataFile_path, bbob_infoFile_firstInstance_char,
-  COCO_PATH_MAX - strlen(dataFile_path) - 1);
-
-  logger_bbob_open_dataFile(&(logger->fdata_file), logger->observer->result_folder, dataFile_path, ".dat");
-  fprintf(logger->fdata_file, bbob_file_header_str, logger->optimal_fvalue);
+  strncpy(dataFile_path, logger->info_entry->data_file_path, COCO_PATH_MAX);
+
+  if (((observer_bbob_data_t *) logger->observer->data)->binary_data_files) {
+    /* The blocks are appended to the data files when they are full and when the logger is freed */
+    char binary_file_path[COCO_PATH_MAX + 2] = { 0 };
+    coco_join_path(binary_file_path, sizeof(binary_file_path), logger->observer->result_folder, dataFile_path,
+        NULL);
+    logger->binary_file_path = coco_strdup(binary_file_path);
+    logger->fdata_block = logger_bbob_allocate_block(logger, ".dat");
+    logger->tdata_block = logger_bbob_allocate_block(logger, ".tdat");
+    logger->is_initialized = 1;
+    coco_free_memory(tmpc_dim);
+    coco_free_memory(tmpc_funId);
+    return;
+  }
 
-  logger_bbob_open_dataFile(&(logger->tdata_file), logger->observer->result_folder, dataFile_path, ".tdat");
-  fprintf(logger->tdata_file, bbob_file_header_str, logger->optimal_fvalue);
+  logger->fdata_writer = logger_bbob_open_data_writer(logger, dataFile_path, ".dat");
+  logger->tdata_writer = logger_bbob_open_data_writer(logger, dataFile_path, ".tdat");
 
-  logger_bbob_open_dataFile(&(logger->rdata_file), logger->observer->result_folder, dataFile_path, ".rdat");
-  fprintf(logger->rdata_file, bbob_file_header_str, logger->optimal_fvalue);
+  logger->rdata_writer = logger_bbob_open_data_writer(logger, dataFile_path, ".rdat");
   logger->is_initialized = 1;
   coco_free_memory(tmpc_dim);
   coco_free_memory(tmpc_funId);
-  coco_free_memory(bbob_infoFile_firstInstance_char);
 }
 
 /**
- * Layer added to the transformed-problem evaluate_function by the logger
+ * @brief Initializes the logger (if needed) before an evaluation.
  */
-static void logger_bbob_evaluate(coco_problem_t *problem, const double *x, double *y) {
-  size_t i;
-  double y_logged, max_fvalue, sum_cons;
-  double *cons;
-  logger_bbob_data_t *logger = (logger_bbob_data_t *) coco_problem_transformed_get_data(problem);
-  coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
-  const int is_feasible = problem->number_of_constraints <= 0
-                            || coco_is_feasible(inner_problem, x, NULL);
-
+static void logger_bbob_start_evaluation(logger_bbob_data_t *logger, coco_problem_t *inner_problem) {
   if (!logger->is_initialized) {
     logger_bbob_initialize(logger, inner_problem);
   }
@@ -445,8 +559,20 @@ static void logger_bbob_evaluate(coco_problem_t *problem, const double *x, doubl
     coco_debug("%4lu: ", (unsigned long) inner_problem->suite_dep_index);
     coco_debug("on problem %s ... ", coco_problem_get_id(inner_problem));
   }
+}
 
-  coco_evaluate_function(inner_problem, x, y); /* fulfill contract as "being" a coco evaluate function */
+/**
+ * @brief Logs the evaluation of x, which resulted in y.
+ */
+static void logger_bbob_log_evaluation(coco_problem_t *problem,
+                                       const double *x,
+                                       const double *y,
+                                       const int is_feasible) {
+  size_t i;
+  double y_logged, max_fvalue, sum_cons;
+  double *cons;
+  logger_bbob_data_t *logger = (logger_bbob_data_t *) coco_problem_transformed_get_data(problem);
+  coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
   logger->number_of_evaluations_constraints = coco_problem_get_evaluations_constraints(problem);
   logger->number_of_evaluations++; /* could be != coco_problem_get_evaluations(problem) for non-anytime logging? */
@@ -464,7 +590,7 @@ static void logger_bbob_evaluate(coco_problem_t *problem, const double *x, doubl
 
   /* Evaluate the constraints */
   if (problem->number_of_constraints > 0) {
-    cons = coco_allocate_vector(problem->number_of_constraints);
+    cons = coco_problem_scratch_allocate(problem, problem->number_of_constraints);
     inner_problem->evaluate_constraint(inner_problem, x, cons);
   }
 
@@ -496,8 +622,9 @@ static void logger_bbob_evaluate(coco_problem_t *problem, const double *x, doubl
      */
     if (logger->number_of_evaluations == 1 || coco_observer_targets_trigger(logger->targets,
                                         logger->best_fvalue - logger->optimal_fvalue)) {
-      logger_bbob_write_data(
-          logger->fdata_file,
+      logger_bbob_add_data(
+          logger->fdata_writer,
+          logger->fdata_block,
           logger->number_of_evaluations,
           logger->number_of_evaluations_constraints,
           y_logged,
@@ -515,8 +642,9 @@ static void logger_bbob_evaluate(coco_problem_t *problem, const double *x, doubl
   /* Add a line in the .tdat file each time an fevals trigger is reached.*/
   if (coco_observer_evaluations_trigger(logger->evaluations,
         logger->number_of_evaluations + logger->number_of_evaluations_constraints)) {
-    logger_bbob_write_data(
-        logger->tdata_file,
+    logger_bbob_add_data(
+        logger->tdata_writer,
+        logger->tdata_block,
         logger->number_of_evaluations,
         logger->number_of_evaluations_constraints,
         y_logged,
@@ -533,10 +661,65 @@ static void logger_bbob_evaluate(coco_problem_t *problem, const double *x, doubl
 
   /* Free allocated memory */
   if (problem->number_of_constraints > 0)
-    coco_free_memory(cons);
+    coco_problem_scratch_free(problem, cons, problem->number_of_constraints);
+}
 
+/**
+ * Layer added to the transformed-problem evaluate_function by the logger
+ */
+static void logger_bbob_evaluate(coco_problem_t *problem, const double *x, double *y) {
+  logger_bbob_data_t *logger = (logger_bbob_data_t *) coco_problem_transformed_get_data(problem);
+  coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  int is_feasible = 1;
+  double *cons;
+
+  if (problem->number_of_constraints > 0) {
+    cons = coco_problem_scratch_allocate(problem, problem->number_of_constraints);
+    is_feasible = coco_is_feasible(inner_problem, x, cons);
+    coco_problem_scratch_free(problem, cons, problem->number_of_constraints);
+  }
+
+  logger_bbob_start_evaluation(logger, inner_problem);
+
+  coco_evaluate_function(inner_problem, x, y); /* fulfill contract as "being" a coco evaluate function */
+
+  logger_bbob_log_evaluation(problem, x, y, is_feasible);
 }  /* end logger_bbob_evaluate */
 
+/**
+ * @brief Evaluates the function in a batch of points and logs the evaluations in the same way as
+ * logger_bbob_evaluate would do for each of the points in turn.
+ */
+static void logger_bbob_evaluate_batch(coco_problem_t *problem,
+                                       const size_t number_of_points,
+                                       const double *x,
+                                       double *y) {
+  size_t k;
+  double *is_feasible = NULL, *cons;
+  logger_bbob_data_t *logger = (logger_bbob_data_t *) coco_problem_transformed_get_data(problem);
+  coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  /* The feasibility of the points is stored as 1.0 (feasible) or 0.0 (infeasible) */
+  if (problem->number_of_constraints > 0) {
+    is_feasible = coco_problem_scratch_allocate(problem, number_of_points);
+    cons = coco_problem_scratch_allocate(problem, problem->number_of_constraints);
+    for (k = 0; k < number_of_points; k++)
+      is_feasible[k] = coco_is_feasible(inner_problem, x + k * problem->number_of_variables, cons);
+    coco_problem_scratch_free(problem, cons, problem->number_of_constraints);
+  }
+
+  logger_bbob_start_evaluation(logger, inner_problem);
+
+  coco_evaluate_function_batch(inner_problem, number_of_points, x, y);
+
+  for (k = 0; k < number_of_points; k++)
+    logger_bbob_log_evaluation(problem, x + k * problem->number_of_variables,
+        y + k * problem->number_of_objectives, is_feasible == NULL || is_feasible[k] != 0.0);
+
+  if (is_feasible != NULL)
+    coco_problem_scratch_free(problem, is_feasible, number_of_points);
+}
+
 /**
  * Also serves as a finalize run method so. Must be called at the end
  * of Each run to correctly fill the index file
@@ -554,25 +737,27 @@ static void logger_bbob_free(void *stuff) {
     coco_debug("best f=%e after %lu fevals (done observing)\n", logger->best_fvalue,
     		(unsigned long) logger->number_of_evaluations);
   }
-  if (logger->index_file != NULL) {
-    fprintf(logger->index_file, ":%lu|%.1e",
+  if (logger->info_entry != NULL) {
+    char *record = coco_strdupf(":%lu|%.1e",
             (unsigned long) logger->number_of_evaluations,
             logger->best_fvalue - logger->optimal_fvalue);
-    fclose(logger->index_file);
-    logger->index_file = NULL;
+    observer_bbob_info_entry_append(logger->info_entry, record);
+    coco_free_memory(record);
+    observer_bbob_info_entry_complete(logger->info_entry);
+    logger->info_entry = NULL;
   }
-  if (logger->fdata_file != NULL) {
-    fclose(logger->fdata_file);
-    logger->fdata_file = NULL;
+  if (logger->fdata_writer != NULL) {
+    coco_writer_close(logger->fdata_writer);
+    logger->fdata_writer = NULL;
   }
-  if (logger->tdata_file != NULL) {
+  if (logger->tdata_writer != NULL) {
     /* TODO: make sure it handles restarts well. i.e., it writes
      * at the end of a single run, not all the runs on a given
      * instance. Maybe start with forcing it to generate a new
      * "instance" of problem for each restart in the beginning
      */
     if (!logger->written_last_eval) {
-      logger_bbob_write_data(logger->tdata_file, 
+      logger_bbob_write_data(logger->tdata_writer,
           logger->number_of_evaluations,
           logger->number_of_evaluations_constraints,
           logger->best_fvalue,
@@ -585,13 +770,42 @@ static void logger_bbob_free(void *stuff) {
           0,
           logger->log_discrete_as_int);
 	}
-    fclose(logger->tdata_file);
-    logger->tdata_file = NULL;
+    coco_writer_close(logger->tdata_writer);
+    logger->tdata_writer = NULL;
+  }
+
+  if (logger->rdata_writer != NULL) {
+    coco_writer_close(logger->rdata_writer);
+    logger->rdata_writer = NULL;
   }
 
-  if (logger->rdata_file != NULL) {
-    fclose(logger->rdata_file);
-    logger->rdata_file = NULL;
+  if (logger->fdata_block != NULL) {
+    coco_binary_results_block_close(logger->fdata_block);
+    logger->fdata_block = NULL;
+  }
+  if (logger->tdata_block != NULL) {
+    if (!logger->written_last_eval) {
+      logger_bbob_add_data(NULL, logger->tdata_block,
+          logger->number_of_evaluations,
+          logger->number_of_evaluations_constraints,
+          logger->best_fvalue,
+          logger->best_fvalue,
+          logger->optimal_fvalue,
+          logger->best_solution,
+          logger->number_of_variables,
+          logger->number_of_integer_variables,
+          NULL,
+          0,
+          logger->log_discrete_as_int);
+    }
+    coco_binary_results_block_close(logger->tdata_block);
+    logger->tdata_block = NULL;
+    /* The .rdat file only contains the header line of the run */
+    coco_binary_results_block_close(logger_bbob_allocate_block(logger, ".rdat"));
+  }
+  if (logger->binary_file_path != NULL) {
+    coco_free_memory(logger->binary_file_path);
+    logger->binary_file_path = NULL;
   }
 
   if (logger->best_solution != NULL) {
@@ -608,8 +822,6 @@ static void logger_bbob_free(void *stuff) {
     coco_observer_evaluations_free(logger->evaluations);
     logger->evaluations = NULL;
   }
-
-  bbob_logger_is_open = 0;
 }
 
 static coco_problem_t *logger_bbob(coco_observer_t *observer, coco_problem_t *inner_problem) {
@@ -624,16 +836,18 @@ static coco_problem_t *logger_bbob(coco_observer_t *observer, coco_problem_t *in
         inner_problem->number_of_objectives);
   }
 
-  if (bbob_logger_is_open)
-    coco_error("The current bbob_logger (observer) must be closed before a new one is opened");
   /* This is the name of the folder which happens to be the algName */
   /*logger->path = coco_strdup(observer->output_folder);*/
-  logger_data->index_file = NULL;
-  logger_data->fdata_file = NULL;
-  logger_data->tdata_file = NULL;
-  logger_data->rdata_file = NULL;
+  logger_data->info_entry = NULL;
+  logger_data->fdata_writer = NULL;
+  logger_data->tdata_writer = NULL;
+  logger_data->rdata_writer = NULL;
+  logger_data->fdata_block = NULL;
+  logger_data->tdata_block = NULL;
+  logger_data->binary_file_path = NULL;
   logger_data->number_of_variables = inner_problem->number_of_variables;
   logger_data->number_of_integer_variables = inner_problem->number_of_integer_variables;
+  logger_data->number_of_constraints = inner_problem->number_of_constraints;
   if (inner_problem->best_value == NULL) {
     /* coco_error("Optimal f value must be defined for each problem in order for the logger to work properly"); */
     /* Setting the value to 0 results in the assertion y>=optimal_fvalue being susceptible to failure */
@@ -664,6 +878,19 @@ static coco_problem_t *logger_bbob(coco_observer_t *observer, coco_problem_t *in
   problem = coco_problem_transformed_allocate(inner_problem, logger_data, logger_bbob_free, observer->observer_name);
 
   problem->evaluate_function = logger_bbob_evaluate;
-  bbob_logger_is_open = 1;
+  problem->evaluate_function_batch = logger_bbob_evaluate_batch;
   return problem;
 }
+
+/**
+ * The header line of each run is the same as written by the bbob logger in the text format, so the text
+ * file is the same as if the data had been logged with the (default) data format "bbob-new2".
+ *
+ * @param input_file_name The name of a .dat, .tdat or .rdat file in the "bbob-binary" format.
+ * @param output_file_name The name of the text file (an existing file is overwritten).
+ *
+ * @return The number of runs in the file.
+ */
+size_t coco_bbob_results_to_text(const char *input_file_name, const char *output_file_name) {
+  return coco_binary_results_convert(input_file_name, output_file_name, bbob_file_header_str);
+}
@@ -14,7 +14,7 @@
  * number as well as for the last evaluation. One .tdat file is created for each problem function and
  * dimension (and indicator type) and contains information for all instances of that problem (and indicator
  * type).
- * - The "adat" files are archive files that contain function evaluations, 2 objectives and dim variables
+ * - The "adat" files are archive files that contain function evaluations, 2 (or 3) objectives and dim variables
  * for every nondominated solution. Whether these files are created, at what point in time the logger writes
  * nondominated solutions to the archive and whether the decision variables are output or not depends on
  * the values of log_nondom_mode and log_nondom_mode. See the bi-objective observer constructor
@@ -28,6 +28,11 @@
  *
  * @note This logger can handle both the original bbob-biobj test suite with 55 and the extended
  * bbob-biobj-ext test suite with 96 functions.
+ *
+ * @note The logger can also log problems with three objectives (for example, problems constructed by
+ * stacking three single-objective problems). Their archive is additionally kept in an ND-tree (see
+ * mo_nd_tree.c), which is searched for dominating and dominated solutions, and the hypervolume is updated by
+ * a dimension sweep over the neighbors of each new solution (see mo_hypervolume_3d.c).
  */
 
 #include <stdio.h>
@@ -40,23 +45,40 @@
 #include "coco_utilities.c"
 #include "coco_problem.c"
 #include "coco_string.c"
+#include "coco_writer.c"
 #include "mo_avl_tree.c"
 #include "observer_biobj.c"
 
 #include "mo_utilities.c"
+#include "mo_hypervolume_3d.c"
 
-/** @brief Number of implemented indicators */
-#define LOGGER_BIOBJ_NUMBER_OF_INDICATORS 1
-
-/** @brief Names of implemented indicators
+/**
+ * @brief The type for the node's item in the AVL tree as used by the bi-objective logger.
  *
- * "hyp" stands for the hypervolume indicator.
- * */
-const char *logger_biobj_indicators[LOGGER_BIOBJ_NUMBER_OF_INDICATORS] = { "hyp" };
+ * Contains information on the exact objective values (y) and their rounded normalized values (normalized_y).
+ * The exact values are used for output, while archive update and indicator computation use the normalized
+ * values.
+ */
+typedef struct {
+  double *x;                 /**< @brief The decision values of this solution. */
+  double *y;                 /**< @brief The values of objectives of this solution. */
+  double *normalized_y;      /**< @brief The values of normalized objectives of this solution. */
+  size_t evaluation_number;  /**< @brief The evaluation number of when the solution was created. */
+
+  double indicator_contribution[OBSERVER_BIOBJ_NUMBER_OF_INDICATORS];
+                      /**< @brief The contribution of this solution to the overall indicator values. */
+  int within_ROI;     /**< @brief Whether the solution is within the region of interest (ROI). */
+
+} logger_biobj_avl_item_t;
 
 /**
  * @brief The indicator type.
  *
+ * Each indicator is updated incrementally through its functions: remove_function is called for each
+ * solution that is removed from the archive (because it is dominated by a new solution), insert_function
+ * for each solution that is added to the archive and update_function computes the overall_value after the
+ * archive has been updated. See logger_biobj_indicator_plugins for the implemented indicators.
+ *
  * <B> The hypervolume indicator ("hyp") </B>
  *
  * The hypervolume indicator measures the volume of the portion of the ROI in the objective space that is
@@ -72,15 +94,32 @@ const char *logger_biobj_indicators[LOGGER_BIOBJ_NUMBER_OF_INDICATORS] = { "hyp"
  *
  * overall_value = best_value - current_value + additional_penalty
  *
- * @note Other indicators are yet to be implemented.
+ * <B> The additive epsilon indicator ("eps") and IGD+ ("igdp") </B>
+ *
+ * Both indicators compare the current Pareto front approximation to a reference set R in the normalized
+ * objective space. For each reference point r, reference_values holds the smallest value of
+ * max_i (a_i - r_i) (for "eps") or of sqrt(sum_i max(a_i - r_i, 0)^2) (for "igdp") over all solutions a that
+ * have been in the archive. Because a solution is only removed from the archive when it is dominated by a
+ * new one, whose values are not larger, these minima never need to be recomputed. The logged value
+ * (overall_value = current_value, best_value is 0) is the maximum (for "eps") or the mean (for "igdp") of
+ * reference_values.
  */
-typedef struct {
+typedef struct logger_biobj_indicator_s {
 
   char *name;                /**< @brief Name of the indicator used for identification and the output. */
+  observer_biobj_indicator_e type; /**< @brief The indicator (and index of its indicator_contribution). */
+  size_t number_of_objectives;     /**< @brief The number of objectives. */
+
+  void (*remove_function)(struct logger_biobj_indicator_s *indicator, const logger_biobj_avl_item_t *item);
+                             /**< @brief Updates the indicator after removing the item (can be NULL). */
+  void (*insert_function)(struct logger_biobj_indicator_s *indicator, avl_node_t *node);
+                             /**< @brief Updates the indicator after inserting the node into the archive. */
+  void (*update_function)(struct logger_biobj_indicator_s *indicator, const logger_biobj_avl_item_t *item);
+                             /**< @brief Computes the overall value after the update with the item. */
 
-  FILE *dat_file;            /**< @brief File for logging indicator values at predefined values. */
-  FILE *tdat_file;           /**< @brief File for logging indicator values at predefined evaluations. */
-  FILE *info_file;           /**< @brief File for logging summary information on algorithm performance. */
+  coco_writer_t *dat_writer;  /**< @brief Writer for logging indicator values at predefined values. */
+  coco_writer_t *tdat_writer; /**< @brief Writer for logging indicator values at predefined evaluations. */
+  coco_writer_t *info_writer; /**< @brief Writer for logging summary information on algorithm performance. */
 
   int target_hit;            /**< @brief Whether the target was hit in the latest evaluation. */
   coco_observer_targets_t *targets;
@@ -95,6 +134,14 @@ typedef struct {
   double overall_value;      /**< @brief The overall value of the indicator tested for target hits. */
   double previous_value;     /**< @brief The previous overall value of the indicator. */
 
+  const double *reference_set;   /**< @brief The normalized reference points (for "eps" and "igdp"). */
+  size_t reference_set_size;     /**< @brief The number of reference points. */
+  double *reference_values;      /**< @brief The value for each reference point (for "eps" and "igdp"). */
+
+  mo_hypervolume_3d_t *hypervolume_3d; /**< @brief The data for updating the hypervolume of three objectives
+                                            (for "hyp" with three objectives). */
+  mo_nd_tree_t *archive_3d;  /**< @brief The archive of the logger as an ND-tree (for three objectives). */
+
 } logger_biobj_indicator_t;
 
 /**
@@ -107,7 +154,7 @@ typedef struct {
 typedef struct {
   observer_biobj_log_nondom_e log_nondom_mode;
                                       /**< @brief Mode for archiving nondominated solutions. */
-  FILE *adat_file;                    /**< @brief File for archiving nondominated solutions (all or final). */
+  coco_writer_t *adat_writer;         /**< @brief Writer for archiving nondominated solutions (all or final). */
 
   int log_vars;                       /**< @brief Whether to log the decision values. */
 
@@ -118,7 +165,7 @@ typedef struct {
   size_t number_of_evaluations;       /**< @brief The number of evaluations performed so far. */
   size_t number_of_variables;         /**< @brief Dimension of the problem. */
   size_t number_of_integer_variables; /**< @brief Number of integer variables. */
-  size_t number_of_objectives;        /**< @brief Number of objectives (clearly equal to 2). */
+  size_t number_of_objectives;        /**< @brief Number of objectives (2 or 3). */
   size_t suite_dep_instance;          /**< @brief Suite-dependent instance number of the observed problem. */
 
   size_t previous_evaluations;        /**< @brief The number of evaluations from the previous call to the logger. */
@@ -126,36 +173,33 @@ typedef struct {
   avl_tree_t *archive_tree;           /**< @brief The tree keeping currently non-dominated solutions. */
   avl_tree_t *buffer_tree;            /**< @brief The tree with pointers to nondominated solutions that haven't
                                            been logged yet. */
+  avl_pool_t *node_pool;              /**< @brief The pool holding the nodes of all trees. */
+  avl_pool_t *item_pool;              /**< @brief The pool holding the items of the archive_tree. */
+  mo_nd_tree_t *archive_3d;           /**< @brief The ND-tree with the normalized solutions of the archive_tree
+                                           and their nodes as items (only for three objectives). */
 
-  /* Indicators (TODO: Implement others!) */
   int compute_indicators;             /**< @brief Whether to compute the indicators. */
-  logger_biobj_indicator_t *indicators[LOGGER_BIOBJ_NUMBER_OF_INDICATORS];
-                                      /**< @brief The implemented indicators. */
+  logger_biobj_indicator_t *indicators[OBSERVER_BIOBJ_NUMBER_OF_INDICATORS];
+                                      /**< @brief The computed indicators. */
+  size_t number_of_indicators;        /**< @brief The number of computed indicators. */
+  double *reference_set;              /**< @brief The normalized reference set (NULL if not needed). */
+  size_t reference_set_size;          /**< @brief The number of points in the reference set. */
 } logger_biobj_data_t;
 
 /**
- * @brief The type for the node's item in the AVL tree as used by the bi-objective logger.
- *
- * Contains information on the exact objective values (y) and their rounded normalized values (normalized_y).
- * The exact values are used for output, while archive update and indicator computation use the normalized
- * values.
+ * @brief Returns the size of the memory block holding a node's item together with its vectors.
  */
-typedef struct {
-  double *x;                 /**< @brief The decision values of this solution. */
-  double *y;                 /**< @brief The values of objectives of this solution. */
-  double *normalized_y;      /**< @brief The values of normalized objectives of this solution. */
-  size_t evaluation_number;  /**< @brief The evaluation number of when the solution was created. */
-
-  double indicator_contribution[LOGGER_BIOBJ_NUMBER_OF_INDICATORS];
-                      /**< @brief The contribution of this solution to the overall indicator values. */
-  int within_ROI;     /**< @brief Whether the solution is within the region of interest (ROI). */
-
-} logger_biobj_avl_item_t;
+static size_t logger_biobj_node_size(const size_t dim, const size_t num_obj) {
+  return sizeof(logger_biobj_avl_item_t) + (dim + 2 * num_obj) * sizeof(double);
+}
 
 /**
  * @brief Creates and returns the information on the solution in the form of a node's item in the AVL tree.
+ *
+ * The item and its vectors x, y and normalized_y are stored in a single block taken from the item_pool.
  */
-static logger_biobj_avl_item_t* logger_biobj_node_create(const coco_problem_t *problem,
+static logger_biobj_avl_item_t* logger_biobj_node_create(avl_pool_t *item_pool,
+                                                         const coco_problem_t *problem,
                                                          const double *x,
                                                          const double *y,
                                                          const size_t evaluation_number,
@@ -164,12 +208,15 @@ static logger_biobj_avl_item_t* logger_biobj_node_create(const coco_problem_t *p
 
   size_t i;
 
-  /* Allocate memory to hold the data structure logger_biobj_node_t */
-  logger_biobj_avl_item_t *item = (logger_biobj_avl_item_t*) coco_allocate_memory(sizeof(*item));
+  /* Allocate memory to hold the data structure logger_biobj_node_t together with its data */
+  logger_biobj_avl_item_t *item = (logger_biobj_avl_item_t*) avl_pool_allocate(item_pool);
+  if (item == NULL)
+    coco_error("logger_biobj_node_create(): failed to allocate memory");
 
-  /* Allocate memory to store the (copied) data of the new node */
-  item->x = coco_allocate_vector(dim);
-  item->y = coco_allocate_vector(num_obj);
+  assert(item_pool->block_size >= logger_biobj_node_size(dim, num_obj));
+  item->x = (double *) (item + 1);
+  item->y = item->x + dim;
+  item->normalized_y = item->y + num_obj;
 
   /* Copy the data */
   for (i = 0; i < dim; i++)
@@ -178,26 +225,21 @@ static logger_biobj_avl_item_t* logger_biobj_node_create(const coco_problem_t *p
     item->y[i] = y[i];
 
   /* Compute the normalized y */
-  item->normalized_y = mo_normalize(item->y, problem->best_value, problem->nadir_value, num_obj);
+  mo_normalize_to(item->y, problem->best_value, problem->nadir_value, num_obj, item->normalized_y);
   item->within_ROI = mo_is_within_ROI(item->normalized_y, num_obj);
 
   item->evaluation_number = evaluation_number;
-  for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++)
+  for (i = 0; i < OBSERVER_BIOBJ_NUMBER_OF_INDICATORS; i++)
     item->indicator_contribution[i] = 0;
 
   return item;
 }
 
 /**
- * @brief Frees the data of the given logger_biobj_avl_item_t.
+ * @brief Returns the given logger_biobj_avl_item_t to the item pool (passed as userdata).
  */
 static void logger_biobj_node_free(logger_biobj_avl_item_t *item, void *userdata) {
-
-  coco_free_memory(item->x);
-  coco_free_memory(item->y);
-  coco_free_memory(item->normalized_y);
-  coco_free_memory(item);
-  (void) userdata; /* To silence the compiler */
+  avl_pool_deallocate((avl_pool_t *) userdata, item);
 }
 
 /**
@@ -218,6 +260,30 @@ static int avl_tree_compare_by_last_objective(const logger_biobj_avl_item_t *ite
   (void) userdata; /* To silence the compiler */
 }
 
+/**
+ * @brief Defines the ordering of AVL tree nodes based on the value of the third objective (ties are broken by
+ * the values of the second and the first objective).
+ *
+ * @note This ordering is used by the archive_tree of problems with three objectives.
+ */
+static int avl_tree_compare_by_third_objective(const logger_biobj_avl_item_t *item1,
+                                               const logger_biobj_avl_item_t *item2,
+                                               void *userdata) {
+  int i;
+
+  for (i = 2; i >= 0; i--) {
+    if (coco_double_almost_equal(item1->normalized_y[i], item2->normalized_y[i], mo_precision))
+      continue;
+    else if (item1->normalized_y[i] < item2->normalized_y[i])
+      return -1;
+    else
+      return 1;
+  }
+  return 0;
+
+  (void) userdata; /* To silence the compiler */
+}
+
 /**
  * @brief Defines the ordering of AVL tree nodes based on the evaluation number (the time when the nodes were
  * created).
@@ -238,9 +304,22 @@ static int avl_tree_compare_by_eval_number(const logger_biobj_avl_item_t *item1,
 }
 
 /**
- * @brief Outputs the AVL tree to the given file. Returns the number of nodes in the tree.
+ * @brief Opens the file with the given path for appending and returns its writer (the file is flushed only
+ * when explicitly requested).
+ */
+static coco_writer_t *logger_biobj_open_writer(const coco_observer_t *observer, const char *path_name) {
+  FILE *file = fopen(path_name, "a");
+  if (file == NULL) {
+    coco_error("logger_biobj() failed to open file '%s'.", path_name);
+    return NULL; /* Never reached */
+  }
+  return coco_writer(file, COCO_WRITER_FLUSH_END, 0, 0, observer->io_thread);
+}
+
+/**
+ * @brief Outputs the AVL tree to the given writer. Returns the number of nodes in the tree.
  */
-static size_t logger_biobj_tree_output(FILE *file,
+static size_t logger_biobj_tree_output(coco_writer_t *writer,
                                        const avl_tree_t *tree,
                                        const size_t dim,
                                        const size_t num_int_vars,
@@ -259,17 +338,21 @@ static size_t logger_biobj_tree_output(FILE *file,
     /* There is at least a solution in the tree to output */
     solution = tree->head;
     while (solution != NULL) {
-      fprintf(file, "%lu\t", (unsigned long) ((logger_biobj_avl_item_t*) solution->item)->evaluation_number);
+      coco_writer_write_unsigned_long(writer,
+          (unsigned long) ((logger_biobj_avl_item_t*) solution->item)->evaluation_number);
+      coco_writer_write_char(writer, '\t');
       for (j = 0; j < num_obj; j++)
-        fprintf(file, "%.*e\t", precision_f, ((logger_biobj_avl_item_t*) solution->item)->y[j]);
+        coco_writer_write_formatted(writer, "%.*e\t", precision_f, ((logger_biobj_avl_item_t*) solution->item)->y[j]);
       if (log_vars) {
         for (i = 0; i < dim; i++)
-          if ((i < num_int_vars) && (log_discrete_as_int))
-            fprintf(file, "%d\t", coco_double_to_int(((logger_biobj_avl_item_t*) solution->item)->x[i]));
-          else
-            fprintf(file, "%.*e\t", precision_x, ((logger_biobj_avl_item_t*) solution->item)->x[i]);
+          if ((i < num_int_vars) && (log_discrete_as_int)) {
+            coco_writer_write_int(writer, coco_double_to_int(((logger_biobj_avl_item_t*) solution->item)->x[i]));
+            coco_writer_write_char(writer, '\t');
+          } else
+            coco_writer_write_formatted(writer, "%.*e\t", precision_x,
+                ((logger_biobj_avl_item_t*) solution->item)->x[i]);
       }
-      fprintf(file, "\n");
+      coco_writer_end_line(writer);
       solution = solution->next;
       number_of_nodes++;
     }
@@ -278,6 +361,234 @@ static size_t logger_biobj_tree_output(FILE *file,
   return number_of_nodes;
 }
 
+/**
+ * @brief Updates the indicators after removing the item from the archive.
+ */
+static void logger_biobj_indicators_remove(logger_biobj_data_t *logger, const logger_biobj_avl_item_t *item) {
+  size_t i;
+
+  for (i = 0; i < logger->number_of_indicators; i++) {
+    if (logger->indicators[i]->remove_function != NULL)
+      logger->indicators[i]->remove_function(logger->indicators[i], item);
+  }
+}
+
+/**
+ * @brief Subtracts the hypervolume contribution of the removed item.
+ */
+static void logger_biobj_hyp_remove(logger_biobj_indicator_t *indicator, const logger_biobj_avl_item_t *item) {
+  indicator->current_value -= item->indicator_contribution[indicator->type];
+}
+
+/**
+ * @brief Computes the hypervolume contribution of the new node and updates the contribution of the next
+ * node (the only one affected by the insertion).
+ */
+static void logger_biobj_hyp_insert(logger_biobj_indicator_t *indicator, avl_node_t *node) {
+  logger_biobj_avl_item_t *node_item = (logger_biobj_avl_item_t*) node->item;
+  logger_biobj_avl_item_t *next_item, *previous_item;
+  const size_t i = indicator->type;
+
+  if (!node_item->within_ROI)
+    return;
+
+  if (node->next != NULL) {
+    next_item = (logger_biobj_avl_item_t*) node->next->item;
+    if (next_item->within_ROI) {
+      indicator->current_value -= next_item->indicator_contribution[i];
+      next_item->indicator_contribution[i] = (node_item->normalized_y[0] - next_item->normalized_y[0])
+          * (1 - next_item->normalized_y[1]);
+      assert(next_item->indicator_contribution[i] >= 0);
+      indicator->current_value += next_item->indicator_contribution[i];
+    }
+  }
+
+  previous_item = (node->prev != NULL) ? (logger_biobj_avl_item_t*) node->prev->item : NULL;
+  if ((previous_item != NULL) && previous_item->within_ROI) {
+    node_item->indicator_contribution[i] = (previous_item->normalized_y[0] - node_item->normalized_y[0])
+        * (1 - node_item->normalized_y[1]);
+  } else {
+    /* Previous item does not exist or is out of ROI, use reference point instead */
+    node_item->indicator_contribution[i] = (1 - node_item->normalized_y[0]) * (1 - node_item->normalized_y[1]);
+  }
+  assert(node_item->indicator_contribution[i] >= 0);
+  indicator->current_value += node_item->indicator_contribution[i];
+}
+
+/**
+ * @brief Computes the hypervolume contribution of the new node for problems with three objectives.
+ *
+ * The contribution is computed exactly w.r.t. the solutions in the archive, including those dominated by the
+ * new one, which are removed from the archive only afterwards, and only the solutions found near the new one
+ * in the ND-tree are swept (see mo_hypervolume_3d_archive_contribution()). Only the overall hypervolume is
+ * kept up to date, removing dominated solutions does not change it, so that the contributions of the other
+ * solutions are not needed.
+ */
+static void logger_biobj_hyp_insert_3d(logger_biobj_indicator_t *indicator, avl_node_t *node) {
+  logger_biobj_avl_item_t *node_item = (logger_biobj_avl_item_t*) node->item;
+
+  if (!node_item->within_ROI)
+    return;
+
+  node_item->indicator_contribution[indicator->type] = mo_hypervolume_3d_archive_contribution(
+      indicator->hypervolume_3d, indicator->archive_3d, node_item->normalized_y);
+  indicator->current_value += node_item->indicator_contribution[indicator->type];
+}
+
+/**
+ * @brief Computes the overall value of the hypervolume indicator (including the penalty for the distance to
+ * the ROI while no solution is within the ROI).
+ */
+static void logger_biobj_hyp_update(logger_biobj_indicator_t *indicator, const logger_biobj_avl_item_t *item) {
+  double new_distance;
+
+  if (coco_double_almost_equal(indicator->current_value, 0, mo_precision)) {
+    /* Update the additional penalty for hypervolume (the minimal distance from the nondominated set
+     * to the ROI) */
+    new_distance = mo_get_distance_to_ROI(item->normalized_y, indicator->number_of_objectives);
+    indicator->additional_penalty = coco_double_min(indicator->additional_penalty, new_distance);
+    assert(indicator->additional_penalty >= 0);
+  } else {
+    indicator->additional_penalty = 0;
+  }
+  indicator->overall_value = indicator->best_value - indicator->current_value + indicator->additional_penalty;
+}
+
+/**
+ * @brief Updates the additive epsilon indicator with the new node.
+ *
+ * Each reference point keeps the smallest additive epsilon of a single archive solution, the indicator is
+ * their maximum.
+ */
+static void logger_biobj_eps_insert(logger_biobj_indicator_t *indicator, avl_node_t *node) {
+  const double *y = ((logger_biobj_avl_item_t*) node->item)->normalized_y;
+  const double *reference_point;
+  double value, max_value = 0;
+  size_t i, j;
+
+  for (i = 0; i < indicator->reference_set_size; i++) {
+    reference_point = indicator->reference_set + i * indicator->number_of_objectives;
+    value = y[0] - reference_point[0];
+    for (j = 1; j < indicator->number_of_objectives; j++)
+      value = coco_double_max(value, y[j] - reference_point[j]);
+    if (value < indicator->reference_values[i])
+      indicator->reference_values[i] = value;
+    if ((i == 0) || (indicator->reference_values[i] > max_value))
+      max_value = indicator->reference_values[i];
+  }
+  indicator->current_value = max_value;
+}
+
+/**
+ * @brief Updates the IGD+ indicator with the new node.
+ *
+ * Each reference point keeps the smallest IGD+ distance to a single archive solution, the indicator is their
+ * mean.
+ */
+static void logger_biobj_igdp_insert(logger_biobj_indicator_t *indicator, avl_node_t *node) {
+  const double *y = ((logger_biobj_avl_item_t*) node->item)->normalized_y;
+  const double *reference_point;
+  double distance, difference, sum = 0;
+  size_t i, j;
+
+  for (i = 0; i < indicator->reference_set_size; i++) {
+    reference_point = indicator->reference_set + i * indicator->number_of_objectives;
+    distance = 0;
+    for (j = 0; j < indicator->number_of_objectives; j++) {
+      difference = y[j] - reference_point[j];
+      if (difference > 0)
+        distance += difference * difference;
+    }
+    distance = sqrt(distance);
+    if (distance < indicator->reference_values[i])
+      indicator->reference_values[i] = distance;
+    sum += indicator->reference_values[i];
+  }
+  indicator->current_value = sum / (double) indicator->reference_set_size;
+}
+
+/**
+ * @brief Sets the overall value of an indicator computed against the reference set to its current value.
+ */
+static void logger_biobj_reference_update(logger_biobj_indicator_t *indicator, const logger_biobj_avl_item_t *item) {
+  indicator->overall_value = indicator->current_value - indicator->best_value;
+  (void) item; /* To silence the compiler */
+}
+
+/**
+ * @brief The functions of an indicator.
+ */
+typedef struct {
+  void (*remove_function)(logger_biobj_indicator_t *indicator, const logger_biobj_avl_item_t *item);
+  void (*insert_function)(logger_biobj_indicator_t *indicator, avl_node_t *node);
+  void (*update_function)(logger_biobj_indicator_t *indicator, const logger_biobj_avl_item_t *item);
+} logger_biobj_indicator_plugin_t;
+
+/**
+ * @brief The functions of the implemented indicators (in the order of observer_biobj_indicator_e).
+ */
+static const logger_biobj_indicator_plugin_t logger_biobj_indicator_plugins[OBSERVER_BIOBJ_NUMBER_OF_INDICATORS] = {
+    { logger_biobj_hyp_remove, logger_biobj_hyp_insert, logger_biobj_hyp_update },
+    { NULL, logger_biobj_eps_insert, logger_biobj_reference_update },
+    { NULL, logger_biobj_igdp_insert, logger_biobj_reference_update } };
+
+/**
+ * @brief The functions of the implemented indicators for problems with three objectives (in the order of
+ * observer_biobj_indicator_e).
+ */
+static const logger_biobj_indicator_plugin_t logger_biobj_indicator_plugins_3d[OBSERVER_BIOBJ_NUMBER_OF_INDICATORS] = {
+    { NULL, logger_biobj_hyp_insert_3d, logger_biobj_hyp_update },
+    { NULL, logger_biobj_eps_insert, logger_biobj_reference_update },
+    { NULL, logger_biobj_igdp_insert, logger_biobj_reference_update } };
+
+/**
+ * @brief Updates the archive and buffer trees with the given node for problems with three objectives.
+ *
+ * Unlike with two objectives, the solutions that dominate the new one or are dominated by it are not
+ * necessarily neighbors in the archive tree. They are found by searching the ND-tree that holds the same
+ * solutions (see mo_nd_tree.c) instead of traversing the archive tree linearly.
+ *
+ * @return 1 if the update was performed and 0 otherwise.
+ */
+static int logger_biobj_tree_update_3d(logger_biobj_data_t *logger,
+                                       logger_biobj_avl_item_t *node_item) {
+
+  avl_node_t *node, *new_node;
+  logger_biobj_avl_item_t *item;
+  size_t i, number_of_dominated;
+
+  /* Check whether the new point is dominated by or equal to an existing one */
+  if (mo_nd_tree_is_dominated(logger->archive_3d, node_item->normalized_y)) {
+    logger_biobj_node_free(node_item, logger->item_pool);
+    return 0;
+  }
+
+  /* The new point is inserted before removing the points that it dominates, so that the indicators are
+   * updated w.r.t. the archive before the update (which is what the hypervolume contribution needs) */
+  new_node = avl_item_insert(logger->archive_tree, node_item);
+  assert(new_node != NULL);
+  avl_item_insert(logger->buffer_tree, node_item);
+
+  if (logger->compute_indicators) {
+    for (i = 0; i < logger->number_of_indicators; i++)
+      logger->indicators[i]->insert_function(logger->indicators[i], new_node);
+  }
+
+  /* Remove the points dominated by the new point */
+  number_of_dominated = mo_nd_tree_remove_dominated(logger->archive_3d, node_item->normalized_y);
+  for (i = 0; i < number_of_dominated; i++) {
+    node = (avl_node_t *) logger->archive_3d->found_items[i];
+    item = (logger_biobj_avl_item_t*) node->item;
+    if (logger->compute_indicators)
+      logger_biobj_indicators_remove(logger, item);
+    avl_item_delete(logger->buffer_tree, item);
+    avl_node_delete(logger->archive_tree, node);
+  }
+
+  mo_nd_tree_insert(logger->archive_3d, node_item->normalized_y, new_node);
+  return 1;
+}
+
 /**
  * @brief Updates the archive and buffer trees with the given node.
  *
@@ -294,7 +605,9 @@ static int logger_biobj_tree_update(logger_biobj_data_t *logger,
   int trigger_update = 0;
   int dominance;
   size_t i;
-  int previous_unavailable = 0;
+
+  if (logger->number_of_objectives == 3)
+    return logger_biobj_tree_update_3d(logger, node_item);
 
   /* Find the first point that is not worse than the new point (NULL if such point does not exist) */
   node = avl_item_search_right(logger->archive_tree, node_item, NULL);
@@ -311,11 +624,8 @@ static int logger_biobj_tree_update(logger_biobj_data_t *logger,
       next_node = node->next;
       if (dominance == 1) {
         /* The new point dominates the next point, remove the next point */
-        if (logger->compute_indicators) {
-          for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-            logger->indicators[i]->current_value -= ((logger_biobj_avl_item_t*) node->item)->indicator_contribution[i];
-          }
-        }
+        if (logger->compute_indicators)
+          logger_biobj_indicators_remove(logger, (logger_biobj_avl_item_t*) node->item);
         avl_item_delete(logger->buffer_tree, node->item);
         avl_node_delete(logger->archive_tree, node);
       }
@@ -326,7 +636,7 @@ static int logger_biobj_tree_update(logger_biobj_data_t *logger,
   }
 
   if (!trigger_update) {
-    logger_biobj_node_free(node_item, NULL);
+    logger_biobj_node_free(node_item, logger->item_pool);
   } else {
     /* Perform tree update */
     while (next_node != NULL) {
@@ -338,11 +648,8 @@ static int logger_biobj_tree_update(logger_biobj_data_t *logger,
           ((logger_biobj_avl_item_t*) node->item)->normalized_y, logger->number_of_objectives);
       if (dominance == 1) {
         /* The new point dominates the next point, remove the next point */
-        if (logger->compute_indicators) {
-          for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-            logger->indicators[i]->current_value -= ((logger_biobj_avl_item_t*) node->item)->indicator_contribution[i];
-          }
-        }
+        if (logger->compute_indicators)
+          logger_biobj_indicators_remove(logger, (logger_biobj_avl_item_t*) node->item);
         next_node = node->next;
         avl_item_delete(logger->buffer_tree, node->item);
         avl_node_delete(logger->archive_tree, node);
@@ -356,73 +663,9 @@ static int logger_biobj_tree_update(logger_biobj_data_t *logger,
     avl_item_insert(logger->buffer_tree, node_item);
 
     if (logger->compute_indicators) {
-      if (node_item->within_ROI) {
-        /* Compute indicator value for new node and update the indicator value of the affected nodes */
-        logger_biobj_avl_item_t *next_item, *previous_item;
-
-        if (new_node->next != NULL) {
-          next_item = (logger_biobj_avl_item_t*) new_node->next->item;
-          if (next_item->within_ROI) {
-            for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-              logger->indicators[i]->current_value -= next_item->indicator_contribution[i];
-              if (strcmp(logger->indicators[i]->name, "hyp") == 0) {
-                next_item->indicator_contribution[i] = (node_item->normalized_y[0] - next_item->normalized_y[0])
-                    * (1 - next_item->normalized_y[1]);
-                assert(next_item->indicator_contribution[i] >= 0);
-              } else {
-                coco_error(
-                    "logger_biobj_tree_update(): Indicator computation not implemented yet for indicator %s",
-                    logger->indicators[i]->name);
-              }
-              logger->indicators[i]->current_value += next_item->indicator_contribution[i];
-            }
-          }
-        }
-
-        previous_unavailable = 0;
-        if (new_node->prev != NULL) {
-          previous_item = (logger_biobj_avl_item_t*) new_node->prev->item;
-          if (previous_item->within_ROI) {
-            for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-              if (strcmp(logger->indicators[i]->name, "hyp") == 0) {
-                node_item->indicator_contribution[i] = (previous_item->normalized_y[0] - node_item->normalized_y[0])
-                    * (1 - node_item->normalized_y[1]);
-                assert(node_item->indicator_contribution[i] >= 0);
-              } else {
-                coco_error(
-                    "logger_biobj_tree_update(): Indicator computation not implemented yet for indicator %s",
-                    logger->indicators[i]->name);
-              }
-            }
-          } else {
-            previous_unavailable = 1;
-          }
-        } else {
-          previous_unavailable = 1;
-        }
-
-        if (previous_unavailable) {
-          /* Previous item does not exist or is out of ROI, use reference point instead */
-          for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-            if (strcmp(logger->indicators[i]->name, "hyp") == 0) {
-              node_item->indicator_contribution[i] = (1 - node_item->normalized_y[0])
-                  * (1 - node_item->normalized_y[1]);
-              assert(node_item->indicator_contribution[i] >= 0);
-            } else {
-              coco_error(
-                  "logger_biobj_tree_update(): Indicator computation not implemented yet for indicator %s",
-                  logger->indicators[i]->name);
-            }
-          }
-        }
-
-        for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
-          if (strcmp(logger->indicators[i]->name, "hyp") == 0) {
-            assert(node_item->indicator_contribution[i] >= 0);
-            logger->indicators[i]->current_value += node_item->indicator_contribution[i];
-          }
-        }
-      }
+      /* Compute indicator value for new node and update the indicator value of the affected nodes */
+      for (i = 0; i < logger->number_of_indicators; i++)
+        logger->indicators[i]->insert_function(logger->indicators[i], new_node);
     }
   }
 
@@ -430,19 +673,22 @@ static int logger_biobj_tree_update(logger_biobj_data_t *logger,
 }
 
 /**
- * @brief Initializes the indicator with name indicator_name.
+ * @brief Initializes the indicator of the given type.
  *
  * Opens files for writing and resets counters.
  */
 static logger_biobj_indicator_t *logger_biobj_indicator(const logger_biobj_data_t *logger,
                                                         const coco_observer_t *observer,
                                                         const coco_problem_t *problem,
-                                                        const char *indicator_name) {
+                                                        const observer_biobj_indicator_e type) {
 
   observer_biobj_data_t *observer_data;
   logger_biobj_indicator_t *indicator;
+  const logger_biobj_indicator_plugin_t *plugin;
+  const char *indicator_name = observer_biobj_indicator_names[type];
   char *prefix, *file_name, *path_name;
   int info_file_exists = 0;
+  size_t i;
 
   indicator = (logger_biobj_indicator_t *) coco_allocate_memory(sizeof(*indicator));
   assert(observer);
@@ -450,9 +696,33 @@ static logger_biobj_indicator_t *logger_biobj_indicator(const logger_biobj_data_
   observer_data = (observer_biobj_data_t *) observer->data;
 
   indicator->name = coco_strdup(indicator_name);
+  indicator->type = type;
+  indicator->number_of_objectives = logger->number_of_objectives;
+  plugin = (logger->number_of_objectives == 3) ? &logger_biobj_indicator_plugins_3d[type]
+      : &logger_biobj_indicator_plugins[type];
+  indicator->remove_function = plugin->remove_function;
+  indicator->insert_function = plugin->insert_function;
+  indicator->update_function = plugin->update_function;
+  indicator->hypervolume_3d = NULL;
+  indicator->archive_3d = logger->archive_3d;
+  if ((type == INDICATOR_HYP) && (logger->number_of_objectives == 3))
+    indicator->hypervolume_3d = mo_hypervolume_3d_allocate();
 
   assert(problem->suite);
-  indicator->best_value = coco_suite_get_best_indicator_value(problem->suite, problem, indicator->name);
+  indicator->reference_set = NULL;
+  indicator->reference_set_size = 0;
+  indicator->reference_values = NULL;
+  if (type == INDICATOR_HYP) {
+    indicator->best_value = coco_suite_get_best_indicator_value(problem->suite, problem, indicator->name);
+  } else {
+    /* The indicators computed against the reference set are 0 for the reference set itself */
+    indicator->best_value = 0;
+    indicator->reference_set = logger->reference_set;
+    indicator->reference_set_size = logger->reference_set_size;
+    indicator->reference_values = coco_allocate_vector(logger->reference_set_size);
+    for (i = 0; i < logger->reference_set_size; i++)
+      indicator->reference_values[i] = DBL_MAX;
+  }
   indicator->target_hit = 0;
   indicator->evaluation_logged = 0;
   indicator->current_value = 0;
@@ -470,11 +740,7 @@ static logger_biobj_indicator_t *logger_biobj_indicator(const logger_biobj_data_
   file_name = coco_strdupf("%s_%s.info", problem->problem_type, indicator_name);
   coco_join_path(path_name, COCO_PATH_MAX, file_name, NULL);
   info_file_exists = coco_file_exists(path_name);
-  indicator->info_file = fopen(path_name, "a");
-  if (indicator->info_file == NULL) {
-    coco_error("logger_biobj_indicator() failed to open file '%s'.", path_name);
-    return NULL; /* Never reached */
-  }
+  indicator->info_writer = logger_biobj_open_writer(observer, path_name);
   coco_free_memory(file_name);
   coco_free_memory(path_name);
 
@@ -486,11 +752,7 @@ static logger_biobj_indicator_t *logger_biobj_indicator(const logger_biobj_data_
   prefix = coco_remove_from_string(problem->problem_id, "_i", "_d");
   file_name = coco_strdupf("%s_%s.tdat", prefix, indicator_name);
   coco_join_path(path_name, COCO_PATH_MAX, file_name, NULL);
-  indicator->tdat_file = fopen(path_name, "a");
-  if (indicator->tdat_file == NULL) {
-    coco_error("logger_biobj_indicator() failed to open file '%s'.", path_name);
-    return NULL; /* Never reached */
-  }
+  indicator->tdat_writer = logger_biobj_open_writer(observer, path_name);
   coco_free_memory(file_name);
   coco_free_memory(path_name);
 
@@ -501,28 +763,33 @@ static logger_biobj_indicator_t *logger_biobj_indicator(const logger_biobj_data_
   coco_create_directory(path_name);
   file_name = coco_strdupf("%s_%s.dat", prefix, indicator_name);
   coco_join_path(path_name, COCO_PATH_MAX, file_name, NULL);
-  indicator->dat_file = fopen(path_name, "a");
-  if (indicator->dat_file == NULL) {
-    coco_error("logger_biobj_indicator() failed to open file '%s'.", path_name);
-    return NULL; /* Never reached */
-  }
+  indicator->dat_writer = logger_biobj_open_writer(observer, path_name);
 
   /* Output header information to the info file */
   if (!info_file_exists) {
     /* Output algorithm name */
     assert(problem->suite);
-    fprintf(indicator->info_file,
-        "suite = '%s', algorithm = '%s', indicator = '%s', folder = '%s', coco_version = '%s'\n%% %s",
-        problem->suite->suite_name, observer->algorithm_name, indicator_name, problem->problem_type,
-        coco_version, observer->algorithm_info);
+    coco_writer_write_string(indicator->info_writer, "suite = '");
+    coco_writer_write_string(indicator->info_writer, problem->suite->suite_name);
+    coco_writer_write_string(indicator->info_writer, "', algorithm = '");
+    coco_writer_write_string(indicator->info_writer, observer->algorithm_name);
+    coco_writer_write_string(indicator->info_writer, "', indicator = '");
+    coco_writer_write_string(indicator->info_writer, indicator_name);
+    coco_writer_write_string(indicator->info_writer, "', folder = '");
+    coco_writer_write_string(indicator->info_writer, problem->problem_type);
+    coco_writer_write_string(indicator->info_writer, "', coco_version = '");
+    coco_writer_write_string(indicator->info_writer, coco_version);
+    coco_writer_write_string(indicator->info_writer, "'\n% ");
+    coco_writer_write_string(indicator->info_writer, observer->algorithm_info);
     if (logger->log_nondom_mode == LOG_NONDOM_READ)
-      fprintf(indicator->info_file, " (reconstructed)");
+      coco_writer_write_string(indicator->info_writer, " (reconstructed)");
   }
   if ((observer_data->previous_function != problem->suite_dep_function)
     || (observer_data->previous_dimension != problem->number_of_variables)) {
-    fprintf(indicator->info_file, "\nfunction = %2lu, ", (unsigned long) problem->suite_dep_function);
-    fprintf(indicator->info_file, "dim = %2lu, ", (unsigned long) problem->number_of_variables);
-    fprintf(indicator->info_file, "%s", file_name);
+    coco_writer_write_formatted(indicator->info_writer, "\nfunction = %2lu, ",
+        (unsigned long) problem->suite_dep_function);
+    coco_writer_write_formatted(indicator->info_writer, "dim = %2lu, ", (unsigned long) problem->number_of_variables);
+    coco_writer_write_string(indicator->info_writer, file_name);
   }
 
   coco_free_memory(prefix);
@@ -530,18 +797,20 @@ static logger_biobj_indicator_t *logger_biobj_indicator(const logger_biobj_data_
   coco_free_memory(path_name);
 
   /* Output header information to the dat file */
-  fprintf(indicator->dat_file, "%%\n%% index = %lu, name = %s\n", (unsigned long) problem->suite_dep_index,
-      problem->problem_name);
-  fprintf(indicator->dat_file, "%% instance = %lu, reference value = %.*e\n",
+  coco_writer_write_formatted(indicator->dat_writer, "%%\n%% index = %lu, name = ",
+      (unsigned long) problem->suite_dep_index);
+  coco_writer_write_string(indicator->dat_writer, problem->problem_name);
+  coco_writer_write_formatted(indicator->dat_writer, "\n%% instance = %lu, reference value = %.*e\n",
       (unsigned long) problem->suite_dep_instance, logger->precision_f, indicator->best_value);
-  fprintf(indicator->dat_file, "%% function evaluation | indicator value | target hit\n");
+  coco_writer_write_string(indicator->dat_writer, "% function evaluation | indicator value | target hit\n");
 
   /* Output header information to the tdat file */
-  fprintf(indicator->tdat_file, "%%\n%% index = %lu, name = %s\n", (unsigned long) problem->suite_dep_index,
-      problem->problem_name);
-  fprintf(indicator->tdat_file, "%% instance = %lu, reference value = %.*e\n",
+  coco_writer_write_formatted(indicator->tdat_writer, "%%\n%% index = %lu, name = ",
+      (unsigned long) problem->suite_dep_index);
+  coco_writer_write_string(indicator->tdat_writer, problem->problem_name);
+  coco_writer_write_formatted(indicator->tdat_writer, "\n%% instance = %lu, reference value = %.*e\n",
       (unsigned long) problem->suite_dep_instance, logger->precision_f, indicator->best_value);
-  fprintf(indicator->tdat_file, "%% function evaluation | indicator value\n");
+  coco_writer_write_string(indicator->tdat_writer, "% function evaluation | indicator value\n");
 
   return indicator;
 }
@@ -553,21 +822,23 @@ static void logger_biobj_indicator_finalize(logger_biobj_indicator_t *indicator,
 
   /* Log the last eval_number in the dat file if wasn't already logged */
   if (!indicator->target_hit) {
-    fprintf(indicator->dat_file, "%lu\t%.*e\t%.*e\n", (unsigned long) logger->number_of_evaluations,
+    coco_writer_write_formatted(indicator->dat_writer, "%lu\t%.*e\t%.*e\n",
+        (unsigned long) logger->number_of_evaluations,
         logger->precision_f, indicator->overall_value, logger->precision_f,
         ((coco_observer_targets_t *) indicator->targets)->value);
   }
 
   /* Log the last eval_number in the tdat file if wasn't already logged */
   if (!indicator->evaluation_logged) {
-    fprintf(indicator->tdat_file, "%lu\t%.*e\n", (unsigned long) logger->number_of_evaluations,
+    coco_writer_write_formatted(indicator->tdat_writer, "%lu\t%.*e\n",
+        (unsigned long) logger->number_of_evaluations,
         logger->precision_f, indicator->overall_value);
   }
 
   /* Log the information in the info file */
-  fprintf(indicator->info_file, ", %lu:%lu|%.1e", (unsigned long) logger->suite_dep_instance,
+  coco_writer_write_formatted(indicator->info_writer, ", %lu:%lu|%.1e", (unsigned long) logger->suite_dep_instance,
       (unsigned long) logger->number_of_evaluations, indicator->overall_value);
-  fflush(indicator->info_file);
+  coco_writer_flush(indicator->info_writer);
 }
 
 /**
@@ -585,19 +856,29 @@ static void logger_biobj_indicator_free(void *stuff) {
     indicator->name = NULL;
   }
 
-  if (indicator->dat_file != NULL) {
-    fclose(indicator->dat_file);
-    indicator->dat_file = NULL;
+  if (indicator->dat_writer != NULL) {
+    coco_writer_close(indicator->dat_writer);
+    indicator->dat_writer = NULL;
+  }
+
+  if (indicator->tdat_writer != NULL) {
+    coco_writer_close(indicator->tdat_writer);
+    indicator->tdat_writer = NULL;
+  }
+
+  if (indicator->info_writer != NULL) {
+    coco_writer_close(indicator->info_writer);
+    indicator->info_writer = NULL;
   }
 
-  if (indicator->tdat_file != NULL) {
-    fclose(indicator->tdat_file);
-    indicator->tdat_file = NULL;
+  if (indicator->reference_values != NULL) {
+    coco_free_memory(indicator->reference_values);
+    indicator->reference_values = NULL;
   }
 
-  if (indicator->info_file != NULL) {
-    fclose(indicator->info_file);
-    indicator->info_file = NULL;
+  if (indicator->hypervolume_3d != NULL) {
+    mo_hypervolume_3d_free(indicator->hypervolume_3d);
+    indicator->hypervolume_3d = NULL;
   }
 
   if (indicator->targets != NULL){
@@ -634,7 +915,7 @@ static void logger_biobj_output(logger_biobj_data_t *logger,
   logger_biobj_indicator_t *indicator;
 
   if (logger->compute_indicators) {
-    for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
+    for (i = 0; i < logger->number_of_indicators; i++) {
 
       indicator = logger->indicators[i];
       indicator->target_hit = 0;
@@ -643,22 +924,7 @@ static void logger_biobj_output(logger_biobj_data_t *logger,
       /* If the update was performed, update the overall indicator value */
       if (update_performed) {
         /* Compute the overall_value of an indicator */
-        if (strcmp(indicator->name, "hyp") == 0) {
-          if (coco_double_almost_equal(indicator->current_value, 0, mo_precision)) {
-            /* Update the additional penalty for hypervolume (the minimal distance from the nondominated set
-             * to the ROI) */
-            double new_distance = mo_get_distance_to_ROI(node_item->normalized_y, logger->number_of_objectives);
-            indicator->additional_penalty = coco_double_min(indicator->additional_penalty, new_distance);
-            assert(indicator->additional_penalty >= 0);
-          } else {
-            indicator->additional_penalty = 0;
-          }
-          indicator->overall_value = indicator->best_value - indicator->current_value
-              + indicator->additional_penalty;
-        } else {
-          coco_error("logger_biobj_evaluate(): Indicator computation not implemented yet for indicator %s",
-              indicator->name);
-        }
+        indicator->update_function(indicator, node_item);
 
         /* Check whether a target was hit */
         indicator->target_hit = coco_observer_targets_trigger(indicator->targets, indicator->overall_value);
@@ -666,7 +932,8 @@ static void logger_biobj_output(logger_biobj_data_t *logger,
 
       /* Log to the dat file if a target was hit */
       if (indicator->target_hit) {
-        fprintf(indicator->dat_file, "%lu\t%.*e\t%.*e\n", (unsigned long) logger->number_of_evaluations,
+        coco_writer_write_formatted(indicator->dat_writer, "%lu\t%.*e\t%.*e\n",
+            (unsigned long) logger->number_of_evaluations,
             logger->precision_f, indicator->overall_value, logger->precision_f,
             ((coco_observer_targets_t *) indicator->targets)->value);
       }
@@ -677,7 +944,7 @@ static void logger_biobj_output(logger_biobj_data_t *logger,
         for (j = logger->previous_evaluations + 1; j < logger->number_of_evaluations; j++) {
           indicator->evaluation_logged = coco_observer_evaluations_trigger(indicator->evaluations, j);
           if (indicator->evaluation_logged) {
-            fprintf(indicator->tdat_file, "%lu\t%.*e\n", (unsigned long) j, logger->precision_f,
+            coco_writer_write_formatted(indicator->tdat_writer, "%lu\t%.*e\n", (unsigned long) j, logger->precision_f,
                 indicator->previous_value);
           }
         }
@@ -687,7 +954,8 @@ static void logger_biobj_output(logger_biobj_data_t *logger,
       indicator->evaluation_logged = coco_observer_evaluations_trigger(indicator->evaluations,
           logger->number_of_evaluations);
       if (indicator->evaluation_logged) {
-        fprintf(indicator->tdat_file, "%lu\t%.*e\n", (unsigned long) logger->number_of_evaluations,
+        coco_writer_write_formatted(indicator->tdat_writer, "%lu\t%.*e\n",
+            (unsigned long) logger->number_of_evaluations,
             logger->precision_f, indicator->overall_value);
       }
 
@@ -696,10 +964,10 @@ static void logger_biobj_output(logger_biobj_data_t *logger,
 }
 
 /**
- * @brief Evaluates the function, increases the number of evaluations and outputs information according to
- * observer options.
+ * @brief Updates the archive with the evaluated solution and outputs information according to observer
+ * options.
  */
-static void logger_biobj_evaluate(coco_problem_t *problem, const double *x, double *y) {
+static void logger_biobj_log_evaluation(coco_problem_t *problem, const double *x, const double *y) {
 
   logger_biobj_data_t *logger;
   logger_biobj_avl_item_t *node_item;
@@ -709,12 +977,10 @@ static void logger_biobj_evaluate(coco_problem_t *problem, const double *x, doub
   logger = (logger_biobj_data_t *) coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
-  /* Evaluate function */
-  coco_evaluate_function(inner_problem, x, y);
   logger->number_of_evaluations++;
 
-  node_item = logger_biobj_node_create(inner_problem, x, y, logger->number_of_evaluations, logger->number_of_variables,
-      logger->number_of_objectives);
+  node_item = logger_biobj_node_create(logger->item_pool, inner_problem, x, y, logger->number_of_evaluations,
+      logger->number_of_variables, logger->number_of_objectives);
 
   /* Update the archive with the new solution, if it is not dominated by or equal to existing solutions in
    * the archive */
@@ -723,19 +989,46 @@ static void logger_biobj_evaluate(coco_problem_t *problem, const double *x, doub
   /* If the archive was updated and you need to log all nondominated solutions, output the new solution to
    * nondom_file */
   if (update_performed && (logger->log_nondom_mode == LOG_NONDOM_ALL)) {
-    logger_biobj_tree_output(logger->adat_file, logger->buffer_tree, logger->number_of_variables,
+    logger_biobj_tree_output(logger->adat_writer, logger->buffer_tree, logger->number_of_variables,
         logger->number_of_integer_variables, logger->number_of_objectives, logger->log_vars,
         logger->precision_x, logger->precision_f, logger->log_discrete_as_int);
     avl_tree_purge(logger->buffer_tree);
 
     /* Flush output so that impatient users can see progress. */
-    fflush(logger->adat_file);
+    coco_writer_flush(logger->adat_writer);
   }
 
   /* Output according to observer options */
   logger_biobj_output(logger, update_performed, node_item);
 }
 
+/**
+ * @brief Evaluates the function, increases the number of evaluations and outputs information according to
+ * observer options.
+ */
+static void logger_biobj_evaluate(coco_problem_t *problem, const double *x, double *y) {
+
+  /* Evaluate function */
+  coco_evaluate_function(coco_problem_transformed_get_inner_problem(problem), x, y);
+  logger_biobj_log_evaluation(problem, x, y);
+}
+
+/**
+ * @brief Evaluates the function in a batch of points and outputs information for each of them in the same
+ * way as logger_biobj_evaluate.
+ */
+static void logger_biobj_evaluate_batch(coco_problem_t *problem,
+                                        const size_t number_of_points,
+                                        const double *x,
+                                        double *y) {
+  size_t k;
+
+  coco_evaluate_function_batch(coco_problem_transformed_get_inner_problem(problem), number_of_points, x, y);
+  for (k = 0; k < number_of_points; k++)
+    logger_biobj_log_evaluation(problem, x + k * problem->number_of_variables,
+        y + k * problem->number_of_objectives);
+}
+
 /**
  * Sets the number of evaluations, adds the objective vector to the archive and outputs information according
  * to observer options (but does not output the archive).
@@ -773,7 +1066,7 @@ int coco_logger_biobj_feed_solution(coco_problem_t *problem, const size_t evalua
   x = coco_allocate_vector(problem->number_of_variables);
   for (i = 0; i < problem->number_of_variables; i++)
     x[i] = 0;
-  node_item = logger_biobj_node_create(inner_problem, x, y, logger->number_of_evaluations,
+  node_item = logger_biobj_node_create(logger->item_pool, inner_problem, x, y, logger->number_of_evaluations,
       logger->number_of_variables, logger->number_of_objectives);
   coco_free_memory(x);
 
@@ -795,7 +1088,8 @@ static void logger_biobj_finalize(logger_biobj_data_t *logger) {
   avl_node_t *solution;
 
   /* Re-sort archive_tree according to time stamp and then output it */
-  resorted_tree = avl_tree_construct((avl_compare_t) avl_tree_compare_by_eval_number, NULL);
+  resorted_tree = avl_tree_construct((avl_compare_t) avl_tree_compare_by_eval_number, NULL,
+      &logger->node_pool->allocator);
 
   if (logger->archive_tree->tail) {
     /* There is at least a solution in the tree to output */
@@ -806,7 +1100,7 @@ static void logger_biobj_finalize(logger_biobj_data_t *logger) {
     }
   }
 
-  logger_biobj_tree_output(logger->adat_file, resorted_tree, logger->number_of_variables,
+  logger_biobj_tree_output(logger->adat_writer, resorted_tree, logger->number_of_variables,
       logger->number_of_integer_variables, logger->number_of_objectives, logger->log_vars,
       logger->precision_x, logger->precision_f, logger->log_discrete_as_int);
 
@@ -829,22 +1123,105 @@ static void logger_biobj_free(void *stuff) {
   }
 
   if (logger->compute_indicators) {
-    for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++) {
+    for (i = 0; i < logger->number_of_indicators; i++) {
       logger_biobj_indicator_finalize(logger->indicators[i], logger);
       logger_biobj_indicator_free(logger->indicators[i]);
     }
   }
 
+  if (logger->reference_set != NULL) {
+    coco_free_memory(logger->reference_set);
+    logger->reference_set = NULL;
+  }
+
   if (((logger->log_nondom_mode == LOG_NONDOM_ALL) || (logger->log_nondom_mode == LOG_NONDOM_FINAL)) &&
-      (logger->adat_file != NULL)) {
-    fprintf(logger->adat_file, "%% evaluations = %lu\n", (unsigned long) logger->number_of_evaluations);
-    fclose(logger->adat_file);
-    logger->adat_file = NULL;
+      (logger->adat_writer != NULL)) {
+    coco_writer_write_formatted(logger->adat_writer, "%% evaluations = %lu\n",
+        (unsigned long) logger->number_of_evaluations);
+    coco_writer_close(logger->adat_writer);
+    logger->adat_writer = NULL;
   }
 
   avl_tree_destruct(logger->archive_tree);
   avl_tree_destruct(logger->buffer_tree);
+  if (logger->archive_3d != NULL)
+    mo_nd_tree_free(logger->archive_3d);
+  avl_pool_destruct(logger->node_pool);
+  avl_pool_destruct(logger->item_pool);
+
+}
+
+/**
+ * @brief Reads the normalized reference set of the problem into the logger.
+ *
+ * The reference set is read from the file PROBLEM_ID_reference.adat in the reference set folder of the
+ * observer (lines starting with % are skipped, the other lines contain the evaluation number followed by the
+ * objective values). If there is no such file, the reference set consists of the extreme points of the
+ * Pareto front.
+ */
+static void logger_biobj_read_reference_set(logger_biobj_data_t *logger,
+                                            const observer_biobj_data_t *observer_data,
+                                            const coco_problem_t *problem) {
+  char path_name[COCO_PATH_MAX + 1];
+  char *file_name;
+  double *y, *normalized_y;
+  size_t capacity = 0, i, j;
+  unsigned long evaluation;
+  FILE *file = NULL;
+  int c;
+
+  logger->reference_set_size = 0;
+  if (strlen(observer_data->reference_set_folder) > 0) {
+    path_name[0] = '\0';
+    file_name = coco_strdupf("%s_reference.adat", problem->problem_id);
+    coco_join_path(path_name, COCO_PATH_MAX, observer_data->reference_set_folder, file_name, NULL);
+    coco_free_memory(file_name);
+    file = fopen(path_name, "r");
+    if (file == NULL)
+      coco_warning("logger_biobj(): reference set '%s' not found, using the extreme points", path_name);
+  }
 
+  if (file != NULL) {
+    y = coco_allocate_vector(logger->number_of_objectives);
+    while ((c = fgetc(file)) != EOF) {
+      ungetc(c, file);
+      if ((c != '%') && (fscanf(file, "%lu", &evaluation) == 1)) {
+        for (j = 0; j < logger->number_of_objectives; j++) {
+          if (fscanf(file, "%lf", &y[j]) != 1)
+            coco_error("logger_biobj(): failed to read the reference set from '%s'", path_name);
+        }
+        if (logger->reference_set_size == capacity) {
+          capacity = (capacity == 0) ? 64 : 2 * capacity;
+          normalized_y = coco_allocate_vector(capacity * logger->number_of_objectives);
+          for (i = 0; i < logger->reference_set_size * logger->number_of_objectives; i++)
+            normalized_y[i] = logger->reference_set[i];
+          if (logger->reference_set != NULL)
+            coco_free_memory(logger->reference_set);
+          logger->reference_set = normalized_y;
+        }
+        normalized_y = mo_normalize(y, problem->best_value, problem->nadir_value, logger->number_of_objectives);
+        for (j = 0; j < logger->number_of_objectives; j++)
+          logger->reference_set[logger->reference_set_size * logger->number_of_objectives + j] = normalized_y[j];
+        coco_free_memory(normalized_y);
+        logger->reference_set_size++;
+      }
+      /* Skip the rest of the line */
+      while (((c = fgetc(file)) != EOF) && (c != '\n'))
+        ;
+    }
+    coco_free_memory(y);
+    fclose(file);
+  }
+
+  if (logger->reference_set_size == 0) {
+    /* The extreme points, where one objective is optimal and the other equals its nadir value */
+    logger->reference_set = coco_allocate_vector(logger->number_of_objectives * logger->number_of_objectives);
+    for (i = 0; i < logger->number_of_objectives; i++) {
+      for (j = 0; j < logger->number_of_objectives; j++)
+        logger->reference_set[i * logger->number_of_objectives + j] = (i == j) ? 0 : 1;
+    }
+    logger->reference_set_size = logger->number_of_objectives;
+  }
 }
 
 /**
@@ -865,7 +1242,7 @@ static coco_problem_t *logger_biobj(coco_observer_t *observer, coco_problem_t *i
   char *path_name, *file_name = NULL;
   size_t i;
 
-  if (inner_problem->number_of_objectives != 2) {
+  if ((inner_problem->number_of_objectives != 2) && (inner_problem->number_of_objectives != 3)) {
     coco_error("logger_biobj(): The bi-objective logger cannot log a problem with %d objective(s)",
         inner_problem->number_of_objectives);
     return NULL; /* Never reached. */
@@ -913,35 +1290,52 @@ static coco_problem_t *logger_biobj(coco_observer_t *observer, coco_problem_t *i
     coco_free_memory(file_name);
 
     /* Open and initialize the archive file */
-    logger_data->adat_file = fopen(path_name, "a");
-    if (logger_data->adat_file == NULL) {
-      coco_error("logger_biobj() failed to open file '%s'.", path_name);
-      return NULL; /* Never reached */
-    }
+    logger_data->adat_writer = logger_biobj_open_writer(observer, path_name);
     coco_free_memory(path_name);
 
     /* Output header information */
-    fprintf(logger_data->adat_file, "%% instance = %lu, name = %s\n",
-        (unsigned long) inner_problem->suite_dep_instance, inner_problem->problem_name);
+    coco_writer_write_formatted(logger_data->adat_writer, "%% instance = %lu, name = ",
+        (unsigned long) inner_problem->suite_dep_instance);
+    coco_writer_write_string(logger_data->adat_writer, inner_problem->problem_name);
+    coco_writer_write_char(logger_data->adat_writer, '\n');
     if (logger_data->log_vars) {
-      fprintf(logger_data->adat_file, "%% function evaluation | %lu objectives | %lu variables\n",
+      coco_writer_write_formatted(logger_data->adat_writer, "%% function evaluation | %lu objectives | %lu variables\n",
           (unsigned long) inner_problem->number_of_objectives,
           (unsigned long) inner_problem->number_of_variables);
     } else {
-      fprintf(logger_data->adat_file, "%% function evaluation | %lu objectives \n",
+      coco_writer_write_formatted(logger_data->adat_writer, "%% function evaluation | %lu objectives \n",
           (unsigned long) inner_problem->number_of_objectives);
     }
   }
 
-  /* Initialize the AVL trees */
-  logger_data->archive_tree = avl_tree_construct((avl_compare_t) avl_tree_compare_by_last_objective,
-      (avl_free_t) logger_biobj_node_free);
-  logger_data->buffer_tree = avl_tree_construct((avl_compare_t) avl_tree_compare_by_eval_number, NULL);
+  /* Initialize the AVL trees, their nodes and the items of the archive_tree are allocated from pools */
+  logger_data->node_pool = avl_pool_construct(sizeof(avl_node_t), 1024);
+  logger_data->item_pool = avl_pool_construct(logger_biobj_node_size(logger_data->number_of_variables,
+      logger_data->number_of_objectives), 256);
+  if ((logger_data->node_pool == NULL) || (logger_data->item_pool == NULL))
+    coco_error("logger_biobj(): failed to allocate the memory pools");
+  logger_data->archive_tree = avl_tree_construct((logger_data->number_of_objectives == 3)
+      ? (avl_compare_t) avl_tree_compare_by_third_objective : (avl_compare_t) avl_tree_compare_by_last_objective,
+      (avl_free_t) logger_biobj_node_free, &logger_data->node_pool->allocator);
+  logger_data->archive_tree->userdata = logger_data->item_pool;
+  logger_data->buffer_tree = avl_tree_construct((avl_compare_t) avl_tree_compare_by_eval_number, NULL,
+      &logger_data->node_pool->allocator);
+  logger_data->archive_3d = NULL;
+  if (logger_data->number_of_objectives == 3)
+    logger_data->archive_3d = mo_nd_tree_allocate(3);
 
   /* Initialize the indicators */
+  logger_data->number_of_indicators = 0;
+  logger_data->reference_set = NULL;
+  logger_data->reference_set_size = 0;
   if (logger_data->compute_indicators) {
-    for (i = 0; i < LOGGER_BIOBJ_NUMBER_OF_INDICATORS; i++)
-      logger_data->indicators[i] = logger_biobj_indicator(logger_data, observer, inner_problem, logger_biobj_indicators[i]);
+    if (observer_biobj_uses_indicator(observer_data, INDICATOR_EPS)
+        || observer_biobj_uses_indicator(observer_data, INDICATOR_IGDP))
+      logger_biobj_read_reference_set(logger_data, observer_data, inner_problem);
+    logger_data->number_of_indicators = observer_data->number_of_indicators;
+    for (i = 0; i < logger_data->number_of_indicators; i++)
+      logger_data->indicators[i] = logger_biobj_indicator(logger_data, observer, inner_problem,
+          observer_data->indicators[i]);
 
     observer_data->previous_function = (long) inner_problem->suite_dep_function;
     observer_data->previous_dimension = (long) inner_problem->number_of_variables;
@@ -949,6 +1343,7 @@ static coco_problem_t *logger_biobj(coco_observer_t *observer, coco_problem_t *i
 
   problem = coco_problem_transformed_allocate(inner_problem, logger_data, logger_biobj_free, observer->observer_name);
   problem->evaluate_function = logger_biobj_evaluate;
+  problem->evaluate_function_batch = logger_biobj_evaluate_batch;
 
   return problem;
 }
@@ -21,6 +21,7 @@
 #include "coco_utilities.c"
 #include "coco_problem.c"
 #include "coco_string.c"
+#include "coco_writer.c"
 #include "observer_rw.c"
 
 /**
@@ -31,7 +32,7 @@
  * finalization.
  */
 typedef struct {
-  FILE *out_file;                /**< @brief File for logging. */
+  coco_writer_t *out_writer;     /**< @brief Writer of the file for logging. */
   size_t number_of_evaluations;  /**< @brief The number of evaluations performed so far. */
 
   double best_value;             /**< @brief The best-so-far value. */
@@ -49,70 +50,131 @@ typedef struct {
 } logger_rw_data_t;
 
 /**
- * @brief Evaluates the function and constraints and outputs the information according to the
- * observer options.
+ * @brief Outputs the information on the evaluation of x (which resulted in y and the given constraint values)
+ * according to the observer options.
  */
-static void logger_rw_evaluate(coco_problem_t *problem, const double *x, double *y) {
+static void logger_rw_log_evaluation(coco_problem_t *problem,
+                                     const double *x,
+                                     const double *y,
+                                     const double *constraints,
+                                     const double seconds) {
 
   logger_rw_data_t *logger;
-  coco_problem_t *inner_problem;
-  double *constraints;
   size_t i;
   int log_this_time = 1;
-  time_t start, end;
 
   logger = (logger_rw_data_t *) coco_problem_transformed_get_data(problem);
-  inner_problem = coco_problem_transformed_get_inner_problem(problem);
-
-  /* Time the evaluations */
-  if (logger->log_time)
-    time(&start);
 
-  /* Evaluate the objective(s) */
-  coco_evaluate_function(inner_problem, x, y);
   logger->number_of_evaluations++;
   if (problem->number_of_objectives == 1)
     logger->current_value = y[0];
 
-  /* Evaluate the constraints */
-  if (problem->number_of_constraints > 0) {
-    constraints = coco_allocate_vector(problem->number_of_constraints);
-    inner_problem->evaluate_constraint(inner_problem, x, constraints);
-  }
-
-  /* Time the evaluations */
-  if (logger->log_time)
-    time(&end);
-
   /* Log to the output file */
   if ((problem->number_of_objectives == 1) && (logger->current_value < logger->best_value))
     logger->best_value = logger->current_value;
   else
     log_this_time = !logger->log_only_better;
   if (log_this_time) {
-    fprintf(logger->out_file, "%lu\t", (unsigned long) logger->number_of_evaluations);
+    coco_writer_write_unsigned_long(logger->out_writer, (unsigned long) logger->number_of_evaluations);
+    coco_writer_write_char(logger->out_writer, '\t');
     for (i = 0; i < problem->number_of_objectives; i++)
-      fprintf(logger->out_file, "%.*e\t", logger->precision_f, y[i]);
+      coco_writer_write_formatted(logger->out_writer, "%.*e\t", logger->precision_f, y[i]);
     if (logger->log_vars) {
       for (i = 0; i < problem->number_of_variables; i++) {
         if ((i < problem->number_of_integer_variables) && (logger->log_discrete_as_int))
-          fprintf(logger->out_file, " %d", coco_double_to_int(x[i]));
-        fprintf(logger->out_file, "%.*e\t", logger->precision_x, x[i]);
+          coco_writer_write_formatted(logger->out_writer, " %d", coco_double_to_int(x[i]));
+        coco_writer_write_formatted(logger->out_writer, "%.*e\t", logger->precision_x, x[i]);
       }
     }
     if (logger->log_cons) {
       for (i = 0; i < problem->number_of_constraints; i++)
-        fprintf(logger->out_file, "%.*e\t", logger->precision_g, constraints[i]);
+        coco_writer_write_formatted(logger->out_writer, "%.*e\t", logger->precision_g, constraints[i]);
     }
     /* Log time in seconds */
     if (logger->log_time)
-      fprintf(logger->out_file, "%.0f\t", difftime(end, start));
-    fprintf(logger->out_file, "\n");
+      coco_writer_write_formatted(logger->out_writer, "%.0f\t", seconds);
+    coco_writer_end_line(logger->out_writer);
+  }
+}
+
+/**
+ * @brief Evaluates the function and constraints and outputs the information according to the
+ * observer options.
+ */
+static void logger_rw_evaluate(coco_problem_t *problem, const double *x, double *y) {
+
+  logger_rw_data_t *logger;
+  coco_problem_t *inner_problem;
+  double *constraints = NULL;
+  time_t start, end;
+  double seconds = 0;
+
+  logger = (logger_rw_data_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  /* Time the evaluations */
+  if (logger->log_time)
+    time(&start);
+
+  /* Evaluate the objective(s) */
+  coco_evaluate_function(inner_problem, x, y);
+
+  /* Evaluate the constraints */
+  if (problem->number_of_constraints > 0) {
+    constraints = coco_problem_scratch_allocate(problem, problem->number_of_constraints);
+    inner_problem->evaluate_constraint(inner_problem, x, constraints);
+  }
+
+  /* Time the evaluations */
+  if (logger->log_time) {
+    time(&end);
+    seconds = difftime(end, start);
+  }
+
+  logger_rw_log_evaluation(problem, x, y, constraints, seconds);
+
+  if (problem->number_of_constraints > 0)
+    coco_problem_scratch_free(problem, constraints, problem->number_of_constraints);
+}
+
+/**
+ * @brief Evaluates the function and constraints in a batch of points and outputs the information for each
+ * of them in the same way as logger_rw_evaluate.
+ *
+ * When the evaluations are timed, the points are evaluated one by one so that each of them is timed
+ * separately.
+ */
+static void logger_rw_evaluate_batch(coco_problem_t *problem,
+                                     const size_t number_of_points,
+                                     const double *x,
+                                     double *y) {
+
+  logger_rw_data_t *logger;
+  coco_problem_t *inner_problem;
+  double *constraints = NULL;
+  size_t k;
+
+  logger = (logger_rw_data_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  if (logger->log_time) {
+    coco_problem_evaluate_function_batch_loop(problem, number_of_points, x, y);
+    return;
+  }
+
+  coco_evaluate_function_batch(inner_problem, number_of_points, x, y);
+
+  if (problem->number_of_constraints > 0)
+    constraints = coco_problem_scratch_allocate(problem, problem->number_of_constraints);
+  for (k = 0; k < number_of_points; k++) {
+    if (problem->number_of_constraints > 0)
+      inner_problem->evaluate_constraint(inner_problem, x + k * problem->number_of_variables, constraints);
+    logger_rw_log_evaluation(problem, x + k * problem->number_of_variables,
+        y + k * problem->number_of_objectives, constraints, 0);
   }
-  fflush(logger->out_file);
 
   if (problem->number_of_constraints > 0)
-    coco_free_memory(constraints);
+    coco_problem_scratch_free(problem, constraints, problem->number_of_constraints);
 }
 
 /**
@@ -125,9 +187,9 @@ static void logger_rw_free(void *stuff) {
   assert(stuff != NULL);
   logger = (logger_rw_data_t *) stuff;
 
-  if (logger->out_file != NULL) {
-    fclose(logger->out_file);
-    logger->out_file = NULL;
+  if (logger->out_writer != NULL) {
+    coco_writer_close(logger->out_writer);
+    logger->out_writer = NULL;
   }
 }
 
@@ -146,6 +208,7 @@ static coco_problem_t *logger_rw(coco_observer_t *observer, coco_problem_t *inne
   logger_rw_data_t *logger_data;
   observer_rw_data_t *observer_data;
   char *path_name, *file_name = NULL;
+  FILE *out_file;
 
   logger_data = (logger_rw_data_t *) coco_allocate_memory(sizeof(*logger_data));
   logger_data->number_of_evaluations = 0;
@@ -187,38 +250,47 @@ static coco_problem_t *logger_rw(coco_observer_t *observer, coco_problem_t *inne
   coco_join_path(path_name, COCO_PATH_MAX, file_name, NULL);
 
   /* Open and initialize the output file */
-  logger_data->out_file = fopen(path_name, "a");
-  if (logger_data->out_file == NULL) {
+  out_file = fopen(path_name, "a");
+  if (out_file == NULL) {
     coco_error("logger_rw() failed to open file '%s'.", path_name);
     return NULL; /* Never reached */
   }
   coco_free_memory(path_name);
   coco_free_memory(file_name);
+  logger_data->out_writer = coco_writer(out_file, observer_data->flush_policy, observer_data->flush_lines,
+      observer_data->flush_interval, observer->io_thread);
 
   /* Output header information */
-  fprintf(logger_data->out_file, "\n%% suite = '%s', problem_id = '%s', problem_name = '%s', coco_version = '%s'\n",
-          coco_problem_get_suite(inner_problem)->suite_name, coco_problem_get_id(inner_problem),
-          coco_problem_get_name(inner_problem), coco_version);
-  fprintf(logger_data->out_file, "%% evaluation | %lu objective",
+  coco_writer_write_string(logger_data->out_writer, "\n% suite = '");
+  coco_writer_write_string(logger_data->out_writer, coco_problem_get_suite(inner_problem)->suite_name);
+  coco_writer_write_string(logger_data->out_writer, "', problem_id = '");
+  coco_writer_write_string(logger_data->out_writer, coco_problem_get_id(inner_problem));
+  coco_writer_write_string(logger_data->out_writer, "', problem_name = '");
+  coco_writer_write_string(logger_data->out_writer, coco_problem_get_name(inner_problem));
+  coco_writer_write_string(logger_data->out_writer, "', coco_version = '");
+  coco_writer_write_string(logger_data->out_writer, coco_version);
+  coco_writer_write_string(logger_data->out_writer, "'\n");
+  coco_writer_write_formatted(logger_data->out_writer, "%% evaluation | %lu objective",
       (unsigned long) inner_problem->number_of_objectives);
   if (inner_problem->number_of_objectives > 1)
-    fprintf(logger_data->out_file, "s");
+    coco_writer_write_string(logger_data->out_writer, "s");
   if (logger_data->log_vars)
-    fprintf(logger_data->out_file, " | %lu variable",
+    coco_writer_write_formatted(logger_data->out_writer, " | %lu variable",
         (unsigned long) inner_problem->number_of_variables);
   if (inner_problem->number_of_variables > 1)
-    fprintf(logger_data->out_file, "s");
+    coco_writer_write_string(logger_data->out_writer, "s");
   if (logger_data->log_cons)
-    fprintf(logger_data->out_file, " | %lu constraint",
+    coco_writer_write_formatted(logger_data->out_writer, " | %lu constraint",
         (unsigned long) inner_problem->number_of_constraints);
   if (inner_problem->number_of_constraints > 1)
-    fprintf(logger_data->out_file, "s");
+    coco_writer_write_string(logger_data->out_writer, "s");
   if (logger_data->log_time)
-    fprintf(logger_data->out_file, " | evaluation time (s)");
-  fprintf(logger_data->out_file, "\n");
+    coco_writer_write_string(logger_data->out_writer, " | evaluation time (s)");
+  coco_writer_write_string(logger_data->out_writer, "\n");
 
   problem = coco_problem_transformed_allocate(inner_problem, logger_data, logger_rw_free, observer->observer_name);
   problem->evaluate_function = logger_rw_evaluate;
+  problem->evaluate_function_batch = logger_rw_evaluate_batch;
 
   return problem;
 }
@@ -45,15 +45,13 @@ static void logger_toy_free(void *stuff) {
 }
 
 /**
- * @brief Evaluates the function, increases the number of evaluations and outputs information based on the
- * targets that have been hit.
+ * @brief Logs the evaluation of x, which resulted in y.
  */
-static void logger_toy_evaluate(coco_problem_t *problem, const double *x, double *y) {
+static void logger_toy_log_evaluation(coco_problem_t *problem, const double *x, const double *y) {
 
   logger_toy_data_t *logger = (logger_toy_data_t *) coco_problem_transformed_get_data(problem);
   size_t i;
 
-  coco_evaluate_function(coco_problem_transformed_get_inner_problem(problem), x, y);
   logger->number_of_evaluations++;
 
   /* Output the solution when a new target that has been hit */
@@ -65,6 +63,39 @@ static void logger_toy_evaluate(coco_problem_t *problem, const double *x, double
     }
     fprintf(logger->log_file, "\n");
   }
+}
+
+/**
+ * @brief Evaluates the function, increases the number of evaluations and outputs information based on the
+ * targets that have been hit.
+ */
+static void logger_toy_evaluate(coco_problem_t *problem, const double *x, double *y) {
+
+  logger_toy_data_t *logger = (logger_toy_data_t *) coco_problem_transformed_get_data(problem);
+
+  coco_evaluate_function(coco_problem_transformed_get_inner_problem(problem), x, y);
+  logger_toy_log_evaluation(problem, x, y);
+
+  /* Flush output so that impatient users can see the progress */
+  fflush(logger->log_file);
+}
+
+/**
+ * @brief Evaluates the function in a batch of points and logs the evaluations.
+ *
+ * The output is the same as when evaluating the points one by one, but is flushed only once per batch.
+ */
+static void logger_toy_evaluate_batch(coco_problem_t *problem,
+                                      const size_t number_of_points,
+                                      const double *x,
+                                      double *y) {
+
+  logger_toy_data_t *logger = (logger_toy_data_t *) coco_problem_transformed_get_data(problem);
+  size_t k;
+
+  coco_evaluate_function_batch(coco_problem_transformed_get_inner_problem(problem), number_of_points, x, y);
+  for (k = 0; k < number_of_points; k++)
+    logger_toy_log_evaluation(problem, x + k * problem->number_of_variables, y + k * problem->number_of_objectives);
 
   /* Flush output so that impatient users can see the progress */
   fflush(logger->log_file);
@@ -93,6 +124,7 @@ static coco_problem_t *logger_toy(coco_observer_t *observer, coco_problem_t *inn
 
   problem = coco_problem_transformed_allocate(inner_problem, logger_data, logger_toy_free, observer->observer_name);
   problem->evaluate_function = logger_toy_evaluate;
+  problem->evaluate_function_batch = logger_toy_evaluate_batch;
 
   /* Output initial information */
   assert(coco_problem_get_suite(inner_problem));
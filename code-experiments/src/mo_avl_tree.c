@@ -102,6 +102,30 @@ typedef struct avl_allocator {
   avl_deallocate_t deallocate;
 } avl_allocator_t;
 
+/* A pool of memory blocks of a fixed size. The blocks are carved out of
+ * slabs of blocks_per_slab blocks, freed blocks are kept in a free list for
+ * reuse and the slabs are only returned to the system when the pool is
+ * destructed. A pool with blocks of at least sizeof(avl_node_t) bytes can be
+ * used as the allocator of trees (pass &pool->allocator to
+ * avl_tree_construct()), other pools hold the items of the trees.
+ * Added for COCO. */
+typedef struct avl_pool {
+  avl_allocator_t allocator; /* Must be the first member */
+  size_t block_size;
+  size_t blocks_per_slab;
+  void *free_blocks;         /* Linked through the first bytes of each block */
+  void *slabs;               /* Linked through the first block of each slab */
+  char *unused_blocks;       /* The blocks of the last slab never handed out */
+  size_t number_of_unused_blocks;
+} avl_pool_t;
+
+/* The alignment of the blocks in a pool */
+typedef union {
+  void *pointer;
+  double number;
+  long integer;
+} avl_pool_align_t;
+
 static void avl_rebalance(avl_tree_t *, avl_node_t *);
 static avl_node_t *avl_node_insert_after(avl_tree_t *avltree, avl_node_t *node, avl_node_t *newnode);
 
@@ -435,11 +459,16 @@ static avl_tree_t *avl_tree_init(avl_tree_t *avltree, avl_compare_t cmp, avl_fre
 }
 
 /* Allocates and initializes a new tree for elements that will be
- * ordered using the supplied strcmp()-like function.
+ * ordered using the supplied strcmp()-like function. The nodes are
+ * allocated by the given allocator (with malloc() if it is NULL), which
+ * needs to outlive the tree.
  * Returns NULL if memory could not be allocated.
  * O(1) */
-static avl_tree_t *avl_tree_construct(avl_compare_t cmp, avl_free_t free_item) {
-  return avl_tree_init((avl_tree_t *) malloc(sizeof(avl_tree_t)), cmp, free_item);
+static avl_tree_t *avl_tree_construct(avl_compare_t cmp, avl_free_t free_item, avl_allocator_t *allocator) {
+  avl_tree_t *avltree = avl_tree_init((avl_tree_t *) malloc(sizeof(avl_tree_t)), cmp, free_item);
+  if (avltree)
+    avltree->allocator = allocator;
+  return avltree;
 }
 
 /* Reinitializes the tree structure for reuse. Nothing is free()d.
@@ -511,6 +540,86 @@ static void avl_tree_destruct(avl_tree_t *avltree) {
   free(avltree);
 }
 
+/* Returns a block from the pool (or NULL if memory could not be allocated).
+ * O(1) */
+static void *avl_pool_allocate(avl_pool_t *pool) {
+  void *block;
+  char *slab;
+
+  if (pool->free_blocks) {
+    block = pool->free_blocks;
+    pool->free_blocks = *(void **) block;
+    return block;
+  }
+  if (pool->number_of_unused_blocks == 0) {
+    /* The first block of the slab links the slabs */
+    slab = (char *) malloc((pool->blocks_per_slab + 1) * pool->block_size);
+    if (!slab)
+      return NULL;
+    *(void **) slab = pool->slabs;
+    pool->slabs = slab;
+    pool->unused_blocks = slab + pool->block_size;
+    pool->number_of_unused_blocks = pool->blocks_per_slab;
+  }
+  block = pool->unused_blocks;
+  pool->unused_blocks += pool->block_size;
+  pool->number_of_unused_blocks--;
+  return block;
+}
+
+/* Returns the block to the pool.
+ * O(1) */
+static void avl_pool_deallocate(avl_pool_t *pool, void *block) {
+  *(void **) block = pool->free_blocks;
+  pool->free_blocks = block;
+}
+
+static avl_node_t *avl_pool_allocate_node(avl_allocator_t *allocator) {
+  return (avl_node_t *) avl_pool_allocate((avl_pool_t *) allocator);
+}
+
+static void avl_pool_deallocate_node(avl_allocator_t *allocator, avl_node_t *node) {
+  avl_pool_deallocate((avl_pool_t *) allocator, node);
+}
+
+/* Allocates and initializes a pool of blocks of (at least) block_size
+ * bytes, which are allocated in slabs of blocks_per_slab blocks.
+ * Returns NULL if memory could not be allocated.
+ * O(1) */
+static avl_pool_t *avl_pool_construct(size_t block_size, size_t blocks_per_slab) {
+  avl_pool_t *pool = (avl_pool_t *) malloc(sizeof(avl_pool_t));
+  if (pool) {
+    pool->allocator.allocate = avl_pool_allocate_node;
+    pool->allocator.deallocate = avl_pool_deallocate_node;
+    /* Round the block size up to keep all blocks aligned */
+    if (block_size < sizeof(avl_pool_align_t))
+      block_size = sizeof(avl_pool_align_t);
+    pool->block_size = (block_size + sizeof(avl_pool_align_t) - 1) / sizeof(avl_pool_align_t)
+        * sizeof(avl_pool_align_t);
+    pool->blocks_per_slab = blocks_per_slab ? blocks_per_slab : 1;
+    pool->free_blocks = NULL;
+    pool->slabs = NULL;
+    pool->unused_blocks = NULL;
+    pool->number_of_unused_blocks = 0;
+  }
+  return pool;
+}
+
+/* Frees the pool together with all its blocks (the trees using the pool
+ * need to be destructed first).
+ * O(number of slabs) */
+static void avl_pool_destruct(avl_pool_t *pool) {
+  void *slab, *next;
+
+  if (!pool)
+    return;
+  for (slab = pool->slabs; slab; slab = next) {
+    next = *(void **) slab;
+    free(slab);
+  }
+  free(pool);
+}
+
 static void avl_node_clear(avl_node_t *newnode) {
   newnode->left = newnode->right = NULL;
 #   ifdef AVL_COUNT
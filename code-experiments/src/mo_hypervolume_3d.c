@@ -0,0 +1,299 @@
+/**
+ * @file mo_hypervolume_3d.c
+ * @brief Exact computation of the hypervolume of normalized solutions with three objectives.
+ *
+ * The hypervolume is measured w.r.t. the reference point (1, 1, 1), that is, within the normalized region
+ * of interest [0, 1]^3. It is computed by a dimension sweep: the solutions are processed in the order of
+ * increasing values of the third objective while the nondominated front of their projections onto the
+ * first two objectives (the staircase) is kept in an AVL tree ordered by the first objective. Each projection
+ * is inserted into and removed from the staircase at most once and the area dominated by the staircase is
+ * updated incrementally, so that the volume dominated by n solutions is computed in O(n log n) time.
+ *
+ * The same sweep restricted to the box between a solution and the reference point yields the exact
+ * hypervolume contribution of the solution w.r.t. a set of other solutions, which is how the hypervolume of
+ * an archive is updated when a new solution is added to it. When the archive is kept in an ND-tree (see
+ * mo_nd_tree.c), the sweep only needs the few solutions that can limit the contribution, which are found by
+ * searching the tree (see mo_hypervolume_3d_archive_contribution()).
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "coco.h"
+#include "mo_avl_tree.c"
+#include "mo_nd_tree.c"
+
+/**
+ * @brief The data needed to compute the hypervolume of solutions with three objectives.
+ *
+ * The memory is kept between the computations to avoid allocations when the hypervolume of an archive is
+ * updated repeatedly.
+ */
+typedef struct {
+  avl_pool_t *node_pool;      /**< @brief The pool of the nodes of the staircase. */
+  avl_tree_t *staircase;      /**< @brief The projections of the swept solutions that are nondominated in the
+                                   first two objectives ordered by the first objective. */
+  double *projections;        /**< @brief The projections of the swept solutions (two values each). */
+  size_t projections_capacity;/**< @brief The number of projections that fit into the allocated memory. */
+  const double **points;      /**< @brief Memory for the pointers to the solutions given by the caller. */
+  size_t points_capacity;     /**< @brief The number of pointers that fit into the allocated memory. */
+} mo_hypervolume_3d_t;
+
+/**
+ * @brief Defines the ordering of the staircase by the first objective.
+ */
+static int mo_hypervolume_3d_compare(const double *projection1, const double *projection2, void *userdata) {
+  if (projection1[0] < projection2[0])
+    return -1;
+  else if (projection1[0] > projection2[0])
+    return 1;
+  else
+    return 0;
+
+  (void) userdata; /* To silence the compiler */
+}
+
+/**
+ * @brief Allocates the data needed to compute the hypervolume of solutions with three objectives.
+ */
+static mo_hypervolume_3d_t *mo_hypervolume_3d_allocate(void) {
+
+  mo_hypervolume_3d_t *hypervolume = (mo_hypervolume_3d_t *) coco_allocate_memory(sizeof(*hypervolume));
+
+  hypervolume->node_pool = avl_pool_construct(sizeof(avl_node_t), 256);
+  if (hypervolume->node_pool == NULL)
+    coco_error("mo_hypervolume_3d_allocate(): failed to allocate the memory pool");
+  hypervolume->staircase = avl_tree_construct((avl_compare_t) mo_hypervolume_3d_compare, NULL,
+      &hypervolume->node_pool->allocator);
+  hypervolume->projections = NULL;
+  hypervolume->projections_capacity = 0;
+  hypervolume->points = NULL;
+  hypervolume->points_capacity = 0;
+  return hypervolume;
+}
+
+/**
+ * @brief Frees the data needed to compute the hypervolume of solutions with three objectives.
+ */
+static void mo_hypervolume_3d_free(mo_hypervolume_3d_t *hypervolume) {
+
+  avl_tree_destruct(hypervolume->staircase);
+  avl_pool_destruct(hypervolume->node_pool);
+  if (hypervolume->projections != NULL)
+    coco_free_memory(hypervolume->projections);
+  if (hypervolume->points != NULL)
+    coco_free_memory((void *) hypervolume->points);
+  coco_free_memory(hypervolume);
+}
+
+/**
+ * @brief Returns memory for (at least) the given number of pointers to solutions, which the caller can use
+ * to collect the solutions passed to the other functions. The memory is invalidated by the next call.
+ */
+static const double **mo_hypervolume_3d_get_points(mo_hypervolume_3d_t *hypervolume,
+                                                   const size_t number_of_points) {
+
+  if (number_of_points > hypervolume->points_capacity) {
+    if (hypervolume->points != NULL)
+      coco_free_memory((void *) hypervolume->points);
+    while (hypervolume->points_capacity < number_of_points)
+      hypervolume->points_capacity = (hypervolume->points_capacity == 0) ? 64 : 2 * hypervolume->points_capacity;
+    hypervolume->points = (const double **) coco_allocate_memory(hypervolume->points_capacity * sizeof(double *));
+  }
+  return hypervolume->points;
+}
+
+/**
+ * @brief Inserts the projection into the staircase and returns the increase of the area (within [0, 1]^2)
+ * dominated by the staircase.
+ *
+ * The projections dominated by the new one are removed from the staircase, a weakly dominated projection is
+ * not inserted.
+ */
+static double mo_hypervolume_3d_staircase_insert(avl_tree_t *staircase, const double *projection) {
+
+  avl_node_t *previous_node, *node, *next_node, *new_node;
+  const double *item;
+  double x, height, added_height, added_area = 0;
+  int exact;
+
+  /* The last projection with a first objective not larger than the new one */
+  previous_node = avl_item_search_right(staircase, projection, &exact);
+  if ((previous_node != NULL) && (((const double *) previous_node->item)[1] <= projection[1]))
+    return 0;
+
+  /* Starting from the first objective of the new projection, the area under the staircase grows from the
+   * height of the previous projection to the height of the new one until the first projection that is not
+   * dominated by the new one, the dominated projections are removed from the staircase on the way */
+  x = projection[0];
+  height = (previous_node != NULL) ? 1 - ((const double *) previous_node->item)[1] : 0;
+  added_height = 1 - projection[1];
+  if (exact) {
+    /* The previous projection has the same first objective (and is dominated) */
+    node = previous_node;
+    previous_node = previous_node->prev;
+  } else {
+    node = (previous_node != NULL) ? previous_node->next : staircase->head;
+  }
+  while ((node != NULL) && (((const double *) node->item)[1] >= projection[1])) {
+    item = (const double *) node->item;
+    added_area += (item[0] - x) * (added_height - height);
+    x = item[0];
+    height = 1 - item[1];
+    next_node = node->next;
+    avl_node_delete(staircase, node);
+    node = next_node;
+  }
+  added_area += (((node != NULL) ? ((const double *) node->item)[0] : 1) - x) * (added_height - height);
+
+  new_node = avl_alloc(staircase, projection);
+  if (new_node == NULL)
+    coco_error("mo_hypervolume_3d_staircase_insert(): failed to allocate memory");
+  avl_node_insert_after(staircase, previous_node, new_node);
+
+  return added_area;
+}
+
+/**
+ * @brief Returns the volume of the box between the lower point and the reference point (1, 1, 1) that is
+ * dominated by the given solutions.
+ *
+ * With the lower point (0, 0, 0) this is the hypervolume of the solutions. The solutions need to be ordered
+ * by (non-decreasing values of) the third objective, solutions outside the region of interest do not
+ * dominate any volume and are skipped. Takes O(n log n) time for n solutions.
+ */
+static double mo_hypervolume_3d_dominated(mo_hypervolume_3d_t *hypervolume,
+                                          const double *lower,
+                                          const double **points,
+                                          const size_t number_of_points) {
+
+  avl_tree_t *staircase = hypervolume->staircase;
+  const double *head;
+  double *projection;
+  double volume = 0, area = 0, z = lower[2], next_z;
+  size_t i, number_of_projections = 0;
+
+  if ((lower[0] >= 1) || (lower[1] >= 1) || (lower[2] >= 1))
+    return 0;
+
+  if (number_of_points > hypervolume->projections_capacity) {
+    if (hypervolume->projections != NULL)
+      coco_free_memory(hypervolume->projections);
+    while (hypervolume->projections_capacity < number_of_points)
+      hypervolume->projections_capacity = (hypervolume->projections_capacity == 0) ? 64
+          : 2 * hypervolume->projections_capacity;
+    hypervolume->projections = coco_allocate_vector(2 * hypervolume->projections_capacity);
+  }
+
+  for (i = 0; i < number_of_points; i++) {
+    if (points[i][2] >= 1)
+      break;
+    if ((points[i][0] >= 1) || (points[i][1] >= 1))
+      continue;
+    assert((i == 0) || (points[i - 1][2] <= points[i][2]));
+
+    /* The area dominated so far extends up to the third objective of this solution */
+    next_z = coco_double_max(points[i][2], lower[2]);
+    volume += area * (next_z - z);
+    z = next_z;
+
+    /* The solution dominates the box between the lower point and the solution, if any */
+    projection = hypervolume->projections + 2 * number_of_projections++;
+    projection[0] = coco_double_max(points[i][0], lower[0]);
+    projection[1] = coco_double_max(points[i][1], lower[1]);
+    area += mo_hypervolume_3d_staircase_insert(staircase, projection);
+
+    head = (const double *) staircase->head->item;
+    if ((head[0] <= lower[0]) && (head[1] <= lower[1])) {
+      /* The whole area is dominated, the remaining solutions cannot add anything */
+      area = (1 - lower[0]) * (1 - lower[1]);
+      break;
+    }
+  }
+  volume += area * (1 - z);
+
+  avl_tree_purge(staircase);
+  return volume;
+}
+
+/**
+ * @brief Returns the hypervolume contribution of the solution w.r.t. the given solutions, that is, the
+ * volume dominated by the solution (within the region of interest) and not by any of the given solutions.
+ *
+ * The given solutions need to be ordered by the third objective (see mo_hypervolume_3d_dominated()), the
+ * contribution of a solution weakly dominated by one of them is 0.
+ */
+static double mo_hypervolume_3d_contribution(mo_hypervolume_3d_t *hypervolume,
+                                             const double *point,
+                                             const double **points,
+                                             const size_t number_of_points) {
+  double lower[3], volume, dominated;
+  size_t i;
+
+  for (i = 0; i < 3; i++) {
+    if (point[i] >= 1)
+      return 0;
+    lower[i] = coco_double_max(point[i], 0);
+  }
+
+  volume = (1 - lower[0]) * (1 - lower[1]) * (1 - lower[2]);
+  dominated = mo_hypervolume_3d_dominated(hypervolume, lower, points, number_of_points);
+  return (volume > dominated) ? volume - dominated : 0;
+}
+
+/**
+ * @brief Defines the ordering of pointers to solutions by the third objective (used with qsort).
+ */
+static int mo_hypervolume_3d_compare_points(const void *point1, const void *point2) {
+  const double z1 = (*(const double * const *) point1)[2];
+  const double z2 = (*(const double * const *) point2)[2];
+
+  if (z1 < z2)
+    return -1;
+  else if (z1 > z2)
+    return 1;
+  else
+    return 0;
+}
+
+/**
+ * @brief Returns the hypervolume contribution of the solution w.r.t. the solutions in the archive given as
+ * an ND-tree (see mo_hypervolume_3d_contribution()).
+ *
+ * For each objective k, let g be the solution in the archive with the smallest value of objective k among
+ * those that are not larger than the given solution in the other two objectives. Clamped to the box of the
+ * given solution, g dominates the clamped box of every solution that is not smaller than g in objective k.
+ * The contribution is therefore computed by the sweep over these (at most three) solutions g and the
+ * solutions that are smaller than all of them in the respective objectives, which are found by searching the
+ * tree instead of going through the whole archive.
+ */
+static double mo_hypervolume_3d_archive_contribution(mo_hypervolume_3d_t *hypervolume,
+                                                     mo_nd_tree_t *archive,
+                                                     const double *point) {
+  const double *generators[3], **points;
+  double upper[3];
+  size_t i, number_of_generators = 0, number_of_points;
+
+  assert(archive->number_of_objectives == 3);
+  for (i = 0; i < 3; i++) {
+    if (point[i] >= 1)
+      return 0;
+  }
+
+  for (i = 0; i < 3; i++) {
+    upper[i] = 1;
+    generators[number_of_generators] = mo_nd_tree_min_search(archive, point, i);
+    if ((generators[number_of_generators] != NULL) && (generators[number_of_generators][i] < 1))
+      upper[i] = generators[number_of_generators++][i];
+  }
+
+  number_of_points = mo_nd_tree_box_search(archive, upper);
+  points = mo_hypervolume_3d_get_points(hypervolume, number_of_points + number_of_generators);
+  for (i = 0; i < number_of_points; i++)
+    points[i] = archive->found_points[i];
+  for (i = 0; i < number_of_generators; i++)
+    points[number_of_points++] = generators[i];
+  if (number_of_points > 1)
+    qsort((void *) points, number_of_points, sizeof(const double *), mo_hypervolume_3d_compare_points);
+
+  return mo_hypervolume_3d_contribution(hypervolume, point, points, number_of_points);
+}
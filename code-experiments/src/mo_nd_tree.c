@@ -0,0 +1,544 @@
+/**
+ * @file mo_nd_tree.c
+ * @brief Implementation of the ND-tree, a tree for searching a set of mutually nondominated normalized
+ * solutions with up to three objectives.
+ *
+ * The tree follows the ND-tree of Jaszkiewicz and Lust (ND-Tree-based update: a fast algorithm for the
+ * dynamic nondominance problem, IEEE Transactions on Evolutionary Computation, 2018), but its nodes are
+ * split like the nodes of an R-tree, so that the tree stays balanced regardless of the order of the
+ * insertions. Each node keeps the bounding box of its solutions given by their ideal and nadir points. A
+ * search skips every node whose bounding box cannot contain a solution of interest, so that checking
+ * whether a solution is dominated, removing the solutions dominated by a new one and finding the
+ * neighbors of a solution visit only a small part of the tree instead of all the solutions.
+ *
+ * The tree stores pointers to the objective values of the solutions together with an item given by the
+ * caller, neither of which is copied or freed by the tree.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "coco.h"
+#include "mo_utilities.c"
+
+/**
+ * @brief The maximal number of objectives supported by the ND-tree.
+ */
+#define MO_ND_TREE_MAX_OBJECTIVES 3
+
+/**
+ * @brief The maximal number of children of an internal node and of solutions of a leaf.
+ *
+ * A node is split as soon as it holds more entries.
+ */
+#define MO_ND_TREE_NODE_SIZE 16
+
+/**
+ * @brief The ND-tree node type.
+ */
+typedef struct mo_nd_tree_node_s {
+  double ideal[MO_ND_TREE_MAX_OBJECTIVES]; /**< @brief The ideal point of the solutions in the node. */
+  double nadir[MO_ND_TREE_MAX_OBJECTIVES]; /**< @brief The nadir point of the solutions in the node. */
+  struct mo_nd_tree_node_s *parent;        /**< @brief The parent node (NULL for the root). */
+  int is_leaf;                             /**< @brief Whether the node holds solutions or children. */
+  size_t number_of_entries;                /**< @brief The number of children or solutions. */
+  struct mo_nd_tree_node_s *children[MO_ND_TREE_NODE_SIZE + 1]; /**< @brief The children (internal nodes). */
+  const double *points[MO_ND_TREE_NODE_SIZE + 1];               /**< @brief The solutions (leaves). */
+  void *items[MO_ND_TREE_NODE_SIZE + 1];                        /**< @brief The items of the solutions. */
+} mo_nd_tree_node_t;
+
+/**
+ * @brief The ND-tree type.
+ *
+ * The searches that return several solutions store them (and their items) in found_points and found_items,
+ * which remain valid until the next such search.
+ */
+typedef struct {
+  size_t number_of_objectives; /**< @brief The number of objectives (at most MO_ND_TREE_MAX_OBJECTIVES). */
+  mo_nd_tree_node_t *root;     /**< @brief The root of the tree (an empty leaf for an empty tree). */
+  size_t number_of_points;     /**< @brief The number of solutions in the tree. */
+  const double **found_points; /**< @brief The solutions found by the latest search. */
+  void **found_items;          /**< @brief The items of the solutions found by the latest search. */
+  size_t number_found;         /**< @brief The number of solutions found by the latest search. */
+  size_t found_capacity;       /**< @brief The number of solutions that fit into the allocated memory. */
+} mo_nd_tree_t;
+
+/**
+ * @brief Allocates an empty node.
+ */
+static mo_nd_tree_node_t *mo_nd_tree_node_allocate(mo_nd_tree_node_t *parent, const int is_leaf) {
+
+  mo_nd_tree_node_t *node = (mo_nd_tree_node_t *) coco_allocate_memory(sizeof(*node));
+  node->parent = parent;
+  node->is_leaf = is_leaf;
+  node->number_of_entries = 0;
+  return node;
+}
+
+/**
+ * @brief Frees the node and its subtree.
+ */
+static void mo_nd_tree_node_free(mo_nd_tree_node_t *node) {
+
+  size_t i;
+
+  if (!node->is_leaf) {
+    for (i = 0; i < node->number_of_entries; i++)
+      mo_nd_tree_node_free(node->children[i]);
+  }
+  coco_free_memory(node);
+}
+
+/**
+ * @brief Allocates an empty ND-tree for solutions with the given number of objectives.
+ */
+static mo_nd_tree_t *mo_nd_tree_allocate(const size_t number_of_objectives) {
+
+  mo_nd_tree_t *tree;
+
+  if ((number_of_objectives < 1) || (number_of_objectives > MO_ND_TREE_MAX_OBJECTIVES))
+    coco_error("mo_nd_tree_allocate(): %lu objectives not supported", (unsigned long) number_of_objectives);
+
+  tree = (mo_nd_tree_t *) coco_allocate_memory(sizeof(*tree));
+  tree->number_of_objectives = number_of_objectives;
+  tree->root = mo_nd_tree_node_allocate(NULL, 1);
+  tree->number_of_points = 0;
+  tree->found_points = NULL;
+  tree->found_items = NULL;
+  tree->number_found = 0;
+  tree->found_capacity = 0;
+  return tree;
+}
+
+/**
+ * @brief Frees the ND-tree (but not the solutions and items stored in it).
+ */
+static void mo_nd_tree_free(mo_nd_tree_t *tree) {
+
+  mo_nd_tree_node_free(tree->root);
+  if (tree->found_points != NULL)
+    coco_free_memory((void *) tree->found_points);
+  if (tree->found_items != NULL)
+    coco_free_memory(tree->found_items);
+  coco_free_memory(tree);
+}
+
+/**
+ * @brief Adds the solution and its item to the result of the current search.
+ */
+static void mo_nd_tree_found_add(mo_nd_tree_t *tree, const double *point, void *item) {
+
+  const double **found_points;
+  void **found_items;
+  size_t i;
+
+  if (tree->number_found == tree->found_capacity) {
+    tree->found_capacity = (tree->found_capacity == 0) ? 64 : 2 * tree->found_capacity;
+    found_points = (const double **) coco_allocate_memory(tree->found_capacity * sizeof(double *));
+    found_items = (void **) coco_allocate_memory(tree->found_capacity * sizeof(void *));
+    for (i = 0; i < tree->number_found; i++) {
+      found_points[i] = tree->found_points[i];
+      found_items[i] = tree->found_items[i];
+    }
+    if (tree->found_points != NULL)
+      coco_free_memory((void *) tree->found_points);
+    if (tree->found_items != NULL)
+      coco_free_memory(tree->found_items);
+    tree->found_points = found_points;
+    tree->found_items = found_items;
+  }
+  tree->found_points[tree->number_found] = point;
+  tree->found_items[tree->number_found] = item;
+  tree->number_found++;
+}
+
+/**
+ * @brief Recomputes the bounding box of the (nonempty) node from its entries.
+ */
+static void mo_nd_tree_node_update_bounds(const mo_nd_tree_t *tree, mo_nd_tree_node_t *node) {
+
+  const double *ideal, *nadir;
+  size_t i, k;
+
+  assert(node->number_of_entries > 0);
+  for (i = 0; i < node->number_of_entries; i++) {
+    ideal = node->is_leaf ? node->points[i] : node->children[i]->ideal;
+    nadir = node->is_leaf ? node->points[i] : node->children[i]->nadir;
+    for (k = 0; k < tree->number_of_objectives; k++) {
+      if ((i == 0) || (ideal[k] < node->ideal[k]))
+        node->ideal[k] = ideal[k];
+      if ((i == 0) || (nadir[k] > node->nadir[k]))
+        node->nadir[k] = nadir[k];
+    }
+  }
+}
+
+/**
+ * @brief Returns 1 if the solution is weakly dominated by (or equal to) a solution in the subtree of the
+ * node and 0 otherwise (with the precision of mo_get_dominance()).
+ */
+static int mo_nd_tree_node_is_dominated(const mo_nd_tree_t *tree,
+                                        const mo_nd_tree_node_t *node,
+                                        const double *point) {
+  size_t i, k;
+  int nadir_dominates = 1;
+
+  for (k = 0; k < tree->number_of_objectives; k++) {
+    /* No solution in the node can be better than the ideal point */
+    if (node->ideal[k] - point[k] >= mo_precision)
+      return 0;
+    if (node->nadir[k] - point[k] >= mo_precision)
+      nadir_dominates = 0;
+  }
+  /* All solutions in the node are at least as good as the nadir point */
+  if (nadir_dominates)
+    return 1;
+
+  for (i = 0; i < node->number_of_entries; i++) {
+    if (node->is_leaf) {
+      if (mo_get_dominance(point, node->points[i], tree->number_of_objectives) < 0)
+        return 1;
+    } else if (mo_nd_tree_node_is_dominated(tree, node->children[i], point)) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief Returns 1 if the solution is weakly dominated by (or equal to) a solution in the tree and 0
+ * otherwise (with the precision of mo_get_dominance()).
+ */
+static int mo_nd_tree_is_dominated(const mo_nd_tree_t *tree, const double *point) {
+
+  if (tree->number_of_points == 0)
+    return 0;
+  return mo_nd_tree_node_is_dominated(tree, tree->root, point);
+}
+
+/**
+ * @brief Moves all solutions in the subtree of the node to the result of the current search and frees the
+ * subtree.
+ */
+static void mo_nd_tree_node_collect(mo_nd_tree_t *tree, mo_nd_tree_node_t *node) {
+
+  size_t i;
+
+  for (i = 0; i < node->number_of_entries; i++) {
+    if (node->is_leaf)
+      mo_nd_tree_found_add(tree, node->points[i], node->items[i]);
+    else
+      mo_nd_tree_node_collect(tree, node->children[i]);
+  }
+  coco_free_memory(node);
+}
+
+/**
+ * @brief Removes the solutions dominated by the given one from the subtree of the node (see
+ * mo_nd_tree_remove_dominated()) and returns 1 if the subtree has changed and 0 otherwise.
+ */
+static int mo_nd_tree_node_remove_dominated(mo_nd_tree_t *tree, mo_nd_tree_node_t *node, const double *point) {
+
+  mo_nd_tree_node_t *child;
+  size_t i, j, k;
+  int ideal_dominated = 1, changed = 0, child_dominated;
+
+  for (k = 0; k < tree->number_of_objectives; k++) {
+    /* No solution in the node can be worse than the nadir point */
+    if (point[k] - node->nadir[k] >= mo_precision)
+      return 0;
+    if (point[k] - node->ideal[k] >= mo_precision)
+      ideal_dominated = 0;
+  }
+
+  for (i = 0, j = 0; i < node->number_of_entries; i++) {
+    if (node->is_leaf) {
+      /* The given solution is not weakly dominated by any solution in the tree, so that it dominates each
+       * solution that it weakly dominates */
+      if (ideal_dominated || (mo_get_dominance(point, node->points[i], tree->number_of_objectives) == 1)) {
+        mo_nd_tree_found_add(tree, node->points[i], node->items[i]);
+        changed = 1;
+        continue;
+      }
+      node->points[j] = node->points[i];
+      node->items[j++] = node->items[i];
+    } else {
+      child = node->children[i];
+      child_dominated = 1;
+      for (k = 0; k < tree->number_of_objectives; k++) {
+        if (point[k] - child->ideal[k] >= mo_precision)
+          child_dominated = 0;
+      }
+      if (child_dominated) {
+        mo_nd_tree_node_collect(tree, child);
+        changed = 1;
+        continue;
+      }
+      if (mo_nd_tree_node_remove_dominated(tree, child, point)) {
+        changed = 1;
+        if (child->number_of_entries == 0) {
+          mo_nd_tree_node_free(child);
+          continue;
+        }
+      }
+      node->children[j++] = child;
+    }
+  }
+  node->number_of_entries = j;
+
+  if (changed && (node->number_of_entries > 0))
+    mo_nd_tree_node_update_bounds(tree, node);
+  return changed;
+}
+
+/**
+ * @brief Removes the solutions dominated by the given one from the tree and returns their number.
+ *
+ * The removed solutions and their items are stored in found_points and found_items of the tree. The given
+ * solution must not be weakly dominated by any solution in the tree (see mo_nd_tree_is_dominated()).
+ */
+static size_t mo_nd_tree_remove_dominated(mo_nd_tree_t *tree, const double *point) {
+
+  mo_nd_tree_node_t *root;
+
+  tree->number_found = 0;
+  if (tree->number_of_points == 0)
+    return 0;
+
+  mo_nd_tree_node_remove_dominated(tree, tree->root, point);
+  tree->number_of_points -= tree->number_found;
+
+  /* Shorten the tree while the root has a single child */
+  root = tree->root;
+  while (!root->is_leaf && (root->number_of_entries == 1)) {
+    tree->root = root->children[0];
+    tree->root->parent = NULL;
+    coco_free_memory(root);
+    root = tree->root;
+  }
+  if (root->number_of_entries == 0)
+    root->is_leaf = 1;
+
+  return tree->number_found;
+}
+
+/**
+ * @brief Splits the node that holds too many entries into two, which can cause its parent to be split as
+ * well.
+ *
+ * The entries are divided into halves along the objective in which they are spread the most (the midpoints
+ * of the bounding boxes are used for the children of an internal node).
+ */
+static void mo_nd_tree_node_split(mo_nd_tree_t *tree, mo_nd_tree_node_t *node) {
+
+  mo_nd_tree_node_t *sibling, *parent, *child;
+  double keys[MO_ND_TREE_NODE_SIZE + 1], key, spread, largest_spread = -1;
+  const double *point;
+  void *item;
+  size_t i, j, k, axis = 0, half;
+
+  assert(node->number_of_entries == MO_ND_TREE_NODE_SIZE + 1);
+  for (k = 0; k < tree->number_of_objectives; k++) {
+    spread = node->nadir[k] - node->ideal[k];
+    if (spread > largest_spread) {
+      largest_spread = spread;
+      axis = k;
+    }
+  }
+
+  /* Sort the entries by the chosen objective (insertion sort suffices for so few entries) */
+  for (i = 0; i < node->number_of_entries; i++) {
+    keys[i] = node->is_leaf ? node->points[i][axis]
+        : (node->children[i]->ideal[axis] + node->children[i]->nadir[axis]) / 2;
+  }
+  for (i = 1; i < node->number_of_entries; i++) {
+    key = keys[i];
+    for (j = i; (j > 0) && (keys[j - 1] > key); j--)
+      keys[j] = keys[j - 1];
+    keys[j] = key;
+    if (node->is_leaf) {
+      point = node->points[i];
+      item = node->items[i];
+      memmove((void *) &node->points[j + 1], (void *) &node->points[j], (i - j) * sizeof(double *));
+      memmove(&node->items[j + 1], &node->items[j], (i - j) * sizeof(void *));
+      node->points[j] = point;
+      node->items[j] = item;
+    } else {
+      child = node->children[i];
+      memmove(&node->children[j + 1], &node->children[j], (i - j) * sizeof(mo_nd_tree_node_t *));
+      node->children[j] = child;
+    }
+  }
+
+  /* Move the second half of the entries to the sibling */
+  sibling = mo_nd_tree_node_allocate(node->parent, node->is_leaf);
+  half = node->number_of_entries / 2;
+  for (i = half; i < node->number_of_entries; i++) {
+    if (node->is_leaf) {
+      sibling->points[sibling->number_of_entries] = node->points[i];
+      sibling->items[sibling->number_of_entries] = node->items[i];
+    } else {
+      sibling->children[sibling->number_of_entries] = node->children[i];
+      node->children[i]->parent = sibling;
+    }
+    sibling->number_of_entries++;
+  }
+  node->number_of_entries = half;
+  mo_nd_tree_node_update_bounds(tree, node);
+  mo_nd_tree_node_update_bounds(tree, sibling);
+
+  parent = node->parent;
+  if (parent == NULL) {
+    /* The tree grows by a new root */
+    parent = mo_nd_tree_node_allocate(NULL, 0);
+    parent->children[parent->number_of_entries++] = node;
+    node->parent = parent;
+    sibling->parent = parent;
+    tree->root = parent;
+  }
+  parent->children[parent->number_of_entries++] = sibling;
+  mo_nd_tree_node_update_bounds(tree, parent);
+  if (parent->number_of_entries > MO_ND_TREE_NODE_SIZE)
+    mo_nd_tree_node_split(tree, parent);
+}
+
+/**
+ * @brief Inserts the solution with its item into the tree.
+ *
+ * The solution should not be weakly dominated by any solution in the tree and the solutions it dominates
+ * should have been removed before (see mo_nd_tree_is_dominated() and mo_nd_tree_remove_dominated()). It is
+ * inserted into the leaf reached by always descending into the child whose bounding box has the closest
+ * midpoint.
+ */
+static void mo_nd_tree_insert(mo_nd_tree_t *tree, const double *point, void *item) {
+
+  mo_nd_tree_node_t *node = tree->root, *child;
+  double distance, closest_distance, difference;
+  size_t i, k;
+
+  for (;;) {
+    /* Extend the bounding box of the node by the new solution */
+    for (k = 0; k < tree->number_of_objectives; k++) {
+      if ((node->number_of_entries == 0) || (point[k] < node->ideal[k]))
+        node->ideal[k] = point[k];
+      if ((node->number_of_entries == 0) || (point[k] > node->nadir[k]))
+        node->nadir[k] = point[k];
+    }
+    if (node->is_leaf)
+      break;
+
+    child = node->children[0];
+    closest_distance = -1;
+    for (i = 0; i < node->number_of_entries; i++) {
+      distance = 0;
+      for (k = 0; k < tree->number_of_objectives; k++) {
+        difference = (node->children[i]->ideal[k] + node->children[i]->nadir[k]) / 2 - point[k];
+        distance += difference * difference;
+      }
+      if ((closest_distance < 0) || (distance < closest_distance)) {
+        closest_distance = distance;
+        child = node->children[i];
+      }
+    }
+    node = child;
+  }
+
+  node->points[node->number_of_entries] = point;
+  node->items[node->number_of_entries] = item;
+  node->number_of_entries++;
+  tree->number_of_points++;
+  if (node->number_of_entries > MO_ND_TREE_NODE_SIZE)
+    mo_nd_tree_node_split(tree, node);
+}
+
+/**
+ * @brief Searches the subtree of the node for the solution with the smallest value of the given objective
+ * among those that are not larger than the given solution in the other objectives (see
+ * mo_nd_tree_min_search()).
+ */
+static void mo_nd_tree_node_min_search(const mo_nd_tree_t *tree,
+                                       const mo_nd_tree_node_t *node,
+                                       const double *point,
+                                       const size_t objective,
+                                       const double **best) {
+  const double *candidate;
+  size_t i, k;
+
+  if ((*best != NULL) && (node->ideal[objective] >= (*best)[objective]))
+    return;
+  for (k = 0; k < tree->number_of_objectives; k++) {
+    if ((k != objective) && (node->ideal[k] > point[k]))
+      return;
+  }
+
+  for (i = 0; i < node->number_of_entries; i++) {
+    if (!node->is_leaf) {
+      mo_nd_tree_node_min_search(tree, node->children[i], point, objective, best);
+      continue;
+    }
+    candidate = node->points[i];
+    if ((*best != NULL) && (candidate[objective] >= (*best)[objective]))
+      continue;
+    for (k = 0; k < tree->number_of_objectives; k++) {
+      if ((k != objective) && (candidate[k] > point[k]))
+        break;
+    }
+    if (k == tree->number_of_objectives)
+      *best = candidate;
+  }
+}
+
+/**
+ * @brief Returns the solution with the smallest value of the given objective among the solutions in the
+ * tree that are not larger than the given solution in all other objectives (NULL if there is no such
+ * solution).
+ */
+static const double *mo_nd_tree_min_search(const mo_nd_tree_t *tree, const double *point, const size_t objective) {
+
+  const double *best = NULL;
+
+  assert(objective < tree->number_of_objectives);
+  if (tree->number_of_points > 0)
+    mo_nd_tree_node_min_search(tree, tree->root, point, objective, &best);
+  return best;
+}
+
+/**
+ * @brief Searches the subtree of the node for the solutions smaller than the upper point in all objectives.
+ */
+static void mo_nd_tree_node_box_search(mo_nd_tree_t *tree, const mo_nd_tree_node_t *node, const double *upper) {
+
+  size_t i, k;
+
+  for (k = 0; k < tree->number_of_objectives; k++) {
+    if (node->ideal[k] >= upper[k])
+      return;
+  }
+
+  for (i = 0; i < node->number_of_entries; i++) {
+    if (!node->is_leaf) {
+      mo_nd_tree_node_box_search(tree, node->children[i], upper);
+      continue;
+    }
+    for (k = 0; k < tree->number_of_objectives; k++) {
+      if (node->points[i][k] >= upper[k])
+        break;
+    }
+    if (k == tree->number_of_objectives)
+      mo_nd_tree_found_add(tree, node->points[i], node->items[i]);
+  }
+}
+
+/**
+ * @brief Finds the solutions in the tree that are smaller than the upper point in all objectives and returns
+ * their number.
+ *
+ * The found solutions and their items are stored in found_points and found_items of the tree.
+ */
+static size_t mo_nd_tree_box_search(mo_nd_tree_t *tree, const double *upper) {
+
+  tree->number_found = 0;
+  if (tree->number_of_points > 0)
+    mo_nd_tree_node_box_search(tree, tree->root, upper);
+  return tree->number_found;
+}
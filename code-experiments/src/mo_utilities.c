@@ -40,15 +40,18 @@ static double mo_get_norm(const double *first, const double *second, const size_
 }
 
 /**
- * @brief Creates a rounded normalized version of the given solution w.r.t. the given ROI.
+ * @brief Stores a rounded normalized version of the given solution w.r.t. the given ROI into normalized_y.
  *
- * If the solution seems to be better than the extremes it is corrected (2 objectives are assumed).
- * The caller is responsible for freeing the allocated memory using coco_free_memory().
+ * If the solution seems to be better than the extremes it is corrected (only with 2 objectives, where the
+ * extremes are known).
  */
-static double *mo_normalize(const double *y, const double *ideal, const double *nadir, const size_t num_obj) {
+static void mo_normalize_to(const double *y,
+                            const double *ideal,
+                            const double *nadir,
+                            const size_t num_obj,
+                            double *normalized_y) {
 
   size_t i;
-  double *normalized_y = coco_allocate_vector(num_obj);
 
   for (i = 0; i < num_obj; i++) {
     assert((nadir[i] - ideal[i]) > mo_discretization);
@@ -60,14 +63,27 @@ static double *mo_normalize(const double *y, const double *ideal, const double *
     }
   }
 
+  if (num_obj != 2)
+    return;
+
   for (i = 0; i < num_obj; i++) {
-    assert(num_obj == 2);
     if (coco_double_almost_equal(normalized_y[i], 0, mo_precision) && (normalized_y[1-i] < 1)) {
       coco_debug("Adjusting %.15e to %.15e", y[1-i], nadir[1-i]);
       normalized_y[1-i] = 1;
     }
   }
+}
 
+/**
+ * @brief Creates a rounded normalized version of the given solution w.r.t. the given ROI.
+ *
+ * See mo_normalize_to() for details. The caller is responsible for freeing the allocated memory using
+ * coco_free_memory().
+ */
+static double *mo_normalize(const double *y, const double *ideal, const double *nadir, const size_t num_obj) {
+
+  double *normalized_y = coco_allocate_vector(num_obj);
+  mo_normalize_to(y, ideal, nadir, num_obj, normalized_y);
   return normalized_y;
 }
 
@@ -133,26 +149,21 @@ static int mo_is_within_ROI(const double *normalized_y, const size_t num_obj) {
  * @brief Computes and returns the minimal normalized distance of the point normalized_y from the ROI
  * (equals 0 if within the ROI).
  *
- *  @note Assumes num_obj = 2 and normalized_y >= 0
+ *  @note Assumes normalized_y >= 0
  */
 static double mo_get_distance_to_ROI(const double *normalized_y, const size_t num_obj) {
 
-  double diff_0, diff_1;
+  double diff, distance = 0;
+  size_t i;
 
   if (mo_is_within_ROI(normalized_y, num_obj))
     return 0;
 
-  assert(num_obj == 2);
-  assert(normalized_y[0] >= 0);
-  assert(normalized_y[1] >= 0);
-
-  diff_0 = normalized_y[0] - 1;
-  diff_1 = normalized_y[1] - 1;
-  if ((diff_0 > 0) && (diff_1 > 0)) {
-    return sqrt(pow(diff_0, 2) + pow(diff_1, 2));
+  for (i = 0; i < num_obj; i++) {
+    assert(normalized_y[i] >= 0);
+    diff = normalized_y[i] - 1;
+    if (diff > 0)
+      distance += pow(diff, 2);
   }
-  else if (diff_0 > 0)
-    return diff_0;
-  else
-    return diff_1;
+  return sqrt(distance);
 }
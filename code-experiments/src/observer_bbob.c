@@ -3,34 +3,315 @@
  * @brief Implementation of the bbob observer.
  */
 
+#include <stdio.h>
+
 #include "coco.h"
 #include "coco_utilities.c"
+#include "coco_string.c"
+#include "coco_writer.c"
 
 static coco_problem_t *logger_bbob(coco_observer_t *observer, coco_problem_t *problem);
 static void logger_bbob_free(void *logger);
 
+/**
+ * @brief The maximal number of dimensions in one info file.
+ *
+ * If a dimension is logged again after all these dimensions are present in the current info file, the
+ * dimension is simply added once more.
+ */
+#define OBSERVER_BBOB_MAX_DIMENSIONS_IN_INFO_FILE 6
+
+struct observer_bbob_data_s;
+
+/**
+ * @brief The part of an info file written by one bbob logger.
+ *
+ * The loggers do not write to the info files directly. Instead, each logger fills its own entry, which
+ * contains the header of the info file block (if the logger starts a new block), the data file line and the
+ * logger's instance record. The text of an entry is written as soon as all entries of the same info file
+ * that were started before it are complete (their loggers have been freed). When the loggers are used one
+ * after another, the header and the data file line are therefore written when the logger starts, as
+ * before, and only the trailing record of a logger that is open at the same time as an earlier logger of
+ * the same info file waits. This way the output of loggers that are open at the same time is not
+ * interleaved and is the same as if the problems had been logged one after another.
+ */
+typedef struct observer_bbob_info_entry_s {
+  char *info_file_path;      /**< @brief The path of the info file. */
+  char *data_file_path;      /**< @brief The path of the data files (without the extension). */
+  char *text;                /**< @brief The text to be appended to the info file. */
+  int is_complete;           /**< @brief Whether the logger has finished writing to this entry. */
+  struct observer_bbob_data_s *observer_data;
+                             /**< @brief The observer data (NULL if the observer has already been freed). */
+  struct observer_bbob_info_entry_s *next; /**< @brief The next entry in the queue. */
+} observer_bbob_info_entry_t;
+
 /**
  * @brief The bbob observer data type.
+ *
+ * Contains the state that is shared by all loggers of the observer and that is needed to decide into
+ * which info and data files a logger writes.
  */
-typedef struct {
-  /* TODO: Can be used to store variables that need to be accessible during one run (i.e. for multiple
-   * problems). For example, the following global variables from logger_bbob.c could be stored here: */
-  size_t current_dim;
-  size_t current_fun_id;
-  /* ... and others */
+typedef struct observer_bbob_data_s {
+  size_t current_dim;                    /**< @brief Dimension of the last info file block. */
+  size_t current_fun_id;                 /**< @brief Function of the last info file block. */
+  size_t info_file_first_instance;       /**< @brief Instance used in the name of the current info file. */
+  size_t info_file_number;               /**< @brief Number appended to the name of the current info file
+                                              (0 if none, see logger_bbob_openIndexFile). */
+  size_t dimensions_in_current_info_file[OBSERVER_BBOB_MAX_DIMENSIONS_IN_INFO_FILE];
+                                         /**< @brief Dimensions already present in the current info file. */
+  observer_bbob_info_entry_t *first_entry; /**< @brief The oldest info entry not yet written to a file. */
+  observer_bbob_info_entry_t *last_entry;  /**< @brief The newest info entry not yet written to a file. */
+  coco_writer_flush_policy_t flush_policy; /**< @brief The flush policy of the data files. */
+  size_t flush_lines;                    /**< @brief The number of lines between flushes of the data files. */
+  double flush_interval;                 /**< @brief The number of seconds between flushes of the data files. */
+  int binary_data_files;                 /**< @brief Whether the data files use the bbob-binary format. */
 } observer_bbob_data_t;
 
+/**
+ * @brief Allocates a new info entry and appends it to the queue of the observer.
+ */
+static observer_bbob_info_entry_t *observer_bbob_info_entry_allocate(observer_bbob_data_t *observer_data,
+                                                                     const char *info_file_path,
+                                                                     const char *data_file_path) {
+  observer_bbob_info_entry_t *entry;
+
+  entry = (observer_bbob_info_entry_t *) coco_allocate_memory(sizeof(*entry));
+  entry->info_file_path = coco_strdup(info_file_path);
+  entry->data_file_path = coco_strdup(data_file_path);
+  entry->text = coco_strdup("");
+  entry->is_complete = 0;
+  entry->observer_data = observer_data;
+  entry->next = NULL;
+
+  if (observer_data->last_entry == NULL)
+    observer_data->first_entry = entry;
+  else
+    observer_data->last_entry->next = entry;
+  observer_data->last_entry = entry;
+  return entry;
+}
+
+/**
+ * @brief Frees the info entry.
+ */
+static void observer_bbob_info_entry_free(observer_bbob_info_entry_t *entry) {
+  coco_free_memory(entry->info_file_path);
+  coco_free_memory(entry->data_file_path);
+  coco_free_memory(entry->text);
+  coco_free_memory(entry);
+}
+
+/**
+ * @brief Appends the given text to the info entry.
+ */
+static void observer_bbob_info_entry_append(observer_bbob_info_entry_t *entry, const char *text) {
+  char *new_text = coco_strconcat(entry->text, text);
+  coco_free_memory(entry->text);
+  entry->text = new_text;
+}
+
+/**
+ * @brief Appends the text of the info entry to its info file and empties the text.
+ */
+static void observer_bbob_info_entry_write(observer_bbob_info_entry_t *entry) {
+  FILE *info_file;
+
+  if (strlen(entry->text) == 0)
+    return;
+  info_file = fopen(entry->info_file_path, "a+");
+  if (info_file == NULL) {
+    coco_error("observer_bbob_info_entry_write(): failed to open file %s", entry->info_file_path);
+    return; /* Never reached */
+  }
+  fputs(entry->text, info_file);
+  fclose(info_file);
+  entry->text[0] = '\0';
+}
+
+/**
+ * @brief Writes the text of all info entries that are not preceded by an incomplete entry of the same info
+ * file and frees the written entries that are complete.
+ */
+static void observer_bbob_flush(observer_bbob_data_t *observer_data) {
+  observer_bbob_info_entry_t *entry, *previous, *earlier;
+  int is_blocked;
+
+  previous = NULL;
+  entry = observer_data->first_entry;
+  while (entry != NULL) {
+    /* The complete entries that could be written have already been removed from the queue, so all earlier
+     * entries still in the queue are incomplete */
+    is_blocked = 0;
+    for (earlier = observer_data->first_entry; earlier != entry; earlier = earlier->next) {
+      if (strcmp(earlier->info_file_path, entry->info_file_path) == 0) {
+        is_blocked = 1;
+        break;
+      }
+    }
+    if (is_blocked) {
+      previous = entry;
+      entry = entry->next;
+      continue;
+    }
+    observer_bbob_info_entry_write(entry);
+    if (!entry->is_complete) {
+      previous = entry;
+      entry = entry->next;
+      continue;
+    }
+    if (previous == NULL)
+      observer_data->first_entry = entry->next;
+    else
+      previous->next = entry->next;
+    if (observer_data->last_entry == entry)
+      observer_data->last_entry = previous;
+    earlier = entry;
+    entry = entry->next;
+    observer_bbob_info_entry_free(earlier);
+  }
+}
+
+/**
+ * @brief Writes the beginning of the info entry (the header and the data file line) unless an earlier
+ * logger of the same info file is still open.
+ */
+static void observer_bbob_info_entry_start(observer_bbob_info_entry_t *entry) {
+  if (entry->observer_data != NULL)
+    observer_bbob_flush(entry->observer_data);
+}
+
+/**
+ * @brief Marks the info entry as complete.
+ *
+ * The rest of the entry is written together with all entries it was blocking. If the observer has already
+ * been freed, the entry is written and freed immediately.
+ */
+static void observer_bbob_info_entry_complete(observer_bbob_info_entry_t *entry) {
+  if (entry->observer_data == NULL) {
+    observer_bbob_info_entry_write(entry);
+    observer_bbob_info_entry_free(entry);
+    return;
+  }
+  entry->is_complete = 1;
+  observer_bbob_flush(entry->observer_data);
+}
+
+/**
+ * @brief Returns 1 if the info file exists or will be written by one of the queued info entries and 0
+ * otherwise.
+ */
+static int observer_bbob_info_file_exists(const observer_bbob_data_t *observer_data, const char *info_file_path) {
+  const observer_bbob_info_entry_t *entry;
+  FILE *info_file;
+
+  for (entry = observer_data->first_entry; entry != NULL; entry = entry->next) {
+    if (strcmp(entry->info_file_path, info_file_path) == 0)
+      return 1;
+  }
+  info_file = fopen(info_file_path, "r");
+  if (info_file == NULL)
+    return 0;
+  fclose(info_file);
+  return 1;
+}
+
+/**
+ * @brief Returns 1 if the data files with the given path are currently used by an open logger and 0
+ * otherwise.
+ */
+static int observer_bbob_data_file_is_open(const observer_bbob_data_t *observer_data, const char *data_file_path) {
+  const observer_bbob_info_entry_t *entry;
+
+  for (entry = observer_data->first_entry; entry != NULL; entry = entry->next) {
+    if ((!entry->is_complete) && (strcmp(entry->data_file_path, data_file_path) == 0))
+      return 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Frees the bbob observer data.
+ *
+ * Writes all queued info entries. The entries of loggers that are still open are detached from the
+ * observer, so that the loggers can write the rest of their entries when they are freed.
+ */
+static void observer_bbob_data_free(void *stuff) {
+  observer_bbob_data_t *observer_data = (observer_bbob_data_t *) stuff;
+  observer_bbob_info_entry_t *entry, *next;
+
+  entry = observer_data->first_entry;
+  while (entry != NULL) {
+    next = entry->next;
+    observer_bbob_info_entry_write(entry);
+    if (entry->is_complete) {
+      observer_bbob_info_entry_free(entry);
+    } else {
+      entry->observer_data = NULL;
+      entry->next = NULL;
+    }
+    entry = next;
+  }
+  observer_data->first_entry = NULL;
+  observer_data->last_entry = NULL;
+}
+
 /**
  * @brief Initializes the bbob observer.
+ *
+ * Possible options:
+ *
+ * - "flush_policy: STRING" determines when the .dat and .tdat files are flushed. STRING can take on the
+ * values "line" (after every line), "lines" (after every flush_lines lines), "interval" (after a line once
+ * flush_interval seconds have passed since the last flush) and "end" (only when the problem is freed). The
+ * default value is "line".
+ *
+ * - "flush_lines: VALUE" determines the number of lines between flushes for the "lines" policy. The default
+ * value is 100.
+ *
+ * - "flush_interval: VALUE" determines the number of seconds between flushes for the "interval" policy. The
+ * default value is 10.
+ *
+ * - "data_format: STRING" determines the format of the .dat, .tdat and .rdat files. STRING can take on the
+ * values "bbob-new2" (text, the default) and "bbob-binary" (the same data in a compact binary form, see
+ * coco_binary_results.c). In the binary format, the data of a run is written in blocks of 256 lines and
+ * when the problem is freed (the flush options are ignored) and the files can be converted to text with
+ * coco_bbob_results_to_text.
  */
 static void observer_bbob(coco_observer_t *observer, const char *options, coco_option_keys_t **option_keys) {
 
+  observer_bbob_data_t *observer_data;
+  char string_value[COCO_PATH_MAX + 1];
+  size_t i;
+
+  /* Sets the valid keys for bbob observer options
+   * IMPORTANT: This list should be up-to-date with the code and the documentation */
+  const char *known_keys[] = { "flush_policy", "flush_lines", "flush_interval", "data_format" };
+
+  observer_data = (observer_bbob_data_t *) coco_allocate_memory(sizeof(*observer_data));
+  observer_data->current_dim = 0;
+  observer_data->current_fun_id = 0;
+  observer_data->info_file_first_instance = 0;
+  observer_data->info_file_number = 0;
+  for (i = 0; i < OBSERVER_BBOB_MAX_DIMENSIONS_IN_INFO_FILE; i++)
+    observer_data->dimensions_in_current_info_file[i] = 0;
+  observer_data->first_entry = NULL;
+  observer_data->last_entry = NULL;
+
+  observer_data->flush_policy = coco_writer_read_flush_options(options, "bbob", COCO_WRITER_FLUSH_LINE,
+      &observer_data->flush_lines, &observer_data->flush_interval);
+
+  observer_data->binary_data_files = 0;
+  if (coco_options_read_string(options, "data_format", string_value) > 0) {
+    if (strcmp(string_value, "bbob-binary") == 0)
+      observer_data->binary_data_files = 1;
+    else if (strcmp(string_value, "bbob-new2") != 0)
+      coco_warning("observer_bbob(): unknown data_format '%s', using 'bbob-new2'", string_value);
+  }
+
   observer->logger_allocate_function = logger_bbob;
   observer->logger_free_function = logger_bbob_free;
-  observer->data_free_function = NULL;
-  observer->data = NULL;
-
-  *option_keys = NULL;
+  observer->data_free_function = observer_bbob_data_free;
+  observer->data = observer_data;
 
-  (void) options; /* To silence the compiler */
+  *option_keys = coco_option_keys_allocate(sizeof(known_keys) / sizeof(char *), known_keys);
 }
@@ -7,6 +7,7 @@
 #include "coco_internal.h"
 
 #include "coco_utilities.c"
+#include "coco_string.c"
 #include "mo_utilities.c"
 
 /** @brief Enum for denoting the way in which the nondominated solutions are treated. */
@@ -19,6 +20,22 @@ typedef enum {
   LOG_VARS_NEVER, LOG_VARS_LOW_DIM, LOG_VARS_ALWAYS
 } observer_biobj_log_vars_e;
 
+/** @brief Enum for denoting the implemented indicators (in the order of observer_biobj_indicator_names). */
+typedef enum {
+  INDICATOR_HYP, INDICATOR_EPS, INDICATOR_IGDP
+} observer_biobj_indicator_e;
+
+/** @brief Number of implemented indicators */
+#define OBSERVER_BIOBJ_NUMBER_OF_INDICATORS 3
+
+/**
+ * @brief Names of implemented indicators
+ *
+ * "hyp" stands for the hypervolume indicator, "eps" for the additive epsilon indicator and "igdp" for the
+ * inverted generational distance plus (IGD+).
+ */
+static const char *observer_biobj_indicator_names[OBSERVER_BIOBJ_NUMBER_OF_INDICATORS] = { "hyp", "eps", "igdp" };
+
 /**
  * @brief The bbob-biobj observer data type.
  */
@@ -27,6 +44,11 @@ typedef struct {
   observer_biobj_log_vars_e log_vars_mode;     /**< @brief When the decision variables are logged. */
 
   int compute_indicators;                      /**< @brief Whether to compute indicators. */
+  observer_biobj_indicator_e indicators[OBSERVER_BIOBJ_NUMBER_OF_INDICATORS];
+                                               /**< @brief The indicators to compute. */
+  size_t number_of_indicators;                 /**< @brief The number of indicators to compute. */
+  char reference_set_folder[COCO_PATH_MAX + 1];
+                                               /**< @brief Folder with the reference sets ("" if none). */
   int produce_all_data;                        /**< @brief Whether to produce all data. */
 
   long previous_function;                      /**< @brief Function of the previous logged problem. */
@@ -37,6 +59,20 @@ typedef struct {
 static coco_problem_t *logger_biobj(coco_observer_t *observer, coco_problem_t *problem);
 static void logger_biobj_free(void *logger);
 
+/**
+ * @brief Returns 1 if the given indicator is among the indicators computed by the observer and 0 otherwise.
+ */
+static int observer_biobj_uses_indicator(const observer_biobj_data_t *observer_data,
+                                         const observer_biobj_indicator_e indicator) {
+  size_t i;
+
+  for (i = 0; i < observer_data->number_of_indicators; i++) {
+    if (observer_data->indicators[i] == indicator)
+      return 1;
+  }
+  return 0;
+}
+
 /**
  * @brief Initializes the bi-objective observer.
  *
@@ -56,6 +92,16 @@ static void logger_biobj_free(void *logger);
  * - "compute_indicators: VALUE" determines whether to compute and output performance indicators (1) or not
  * (0). The default value is 1.
  *
+ * - "indicator_names: LIST" determines which indicators are computed (if compute_indicators is 1). LIST is a
+ * comma-separated list of the values "hyp" (hypervolume), "eps" (additive epsilon) and "igdp" (IGD+). The
+ * default value is "hyp".
+ *
+ * - "reference_set_folder: PATH" determines the folder with the reference sets used by the "eps" and "igdp"
+ * indicators. The reference set of a problem is read from the file PROBLEM_ID_reference.adat in this
+ * folder, which has the format of the archive (.adat) files. If the option is not given or the file does
+ * not exist, the reference set consists of the two extreme points of the Pareto front (the corners of the
+ * ROI where one objective is optimal and the other equals its nadir value).
+ *
  * - "produce_all_data: VALUE" determines whether to produce all data required for the workshop. If set to 1,
  * it overwrites some other options and is equivalent to setting "log_nondominated: all",
  * "log_decision_variables: low_dim" and "compute_indicators: 1". If set to 0, it does not change the values
@@ -65,11 +111,13 @@ static void observer_biobj(coco_observer_t *observer, const char *options, coco_
 
   observer_biobj_data_t *observer_data;
   char string_value[COCO_PATH_MAX + 1];
+  char **names;
+  size_t i, j;
 
   /* Sets the valid keys for bbob-biobj observer options
    * IMPORTANT: This list should be up-to-date with the code and the documentation */
   const char *known_keys[] = { "log_nondominated", "log_decision_variables", "compute_indicators",
-      "produce_all_data" };
+      "produce_all_data", "indicator_names", "reference_set_folder" };
   *option_keys = coco_option_keys_allocate(sizeof(known_keys) / sizeof(char *), known_keys);
 
   observer_data = (observer_biobj_data_t *) coco_allocate_memory(sizeof(*observer_data));
@@ -99,6 +147,28 @@ static void observer_biobj(coco_observer_t *observer, const char *options, coco_
   if (coco_options_read_int(options, "compute_indicators", &(observer_data->compute_indicators)) == 0)
     observer_data->compute_indicators = 1;
 
+  observer_data->number_of_indicators = 0;
+  if (coco_options_read_string(options, "indicator_names", string_value) > 0) {
+    names = coco_string_split(string_value, ',');
+    for (i = 0; names[i] != NULL; i++) {
+      for (j = 0; j < OBSERVER_BIOBJ_NUMBER_OF_INDICATORS; j++) {
+        if (strcmp(names[i], observer_biobj_indicator_names[j]) == 0)
+          break;
+      }
+      if (j == OBSERVER_BIOBJ_NUMBER_OF_INDICATORS)
+        coco_warning("observer_biobj(): unknown indicator '%s' ignored", names[i]);
+      else if (!observer_biobj_uses_indicator(observer_data, (observer_biobj_indicator_e) j))
+        observer_data->indicators[observer_data->number_of_indicators++] = (observer_biobj_indicator_e) j;
+      coco_free_memory(names[i]);
+    }
+    coco_free_memory(names);
+  }
+  if (observer_data->number_of_indicators == 0)
+    observer_data->indicators[observer_data->number_of_indicators++] = INDICATOR_HYP;
+
+  observer_data->reference_set_folder[0] = '\0';
+  coco_options_read_string(options, "reference_set_folder", observer_data->reference_set_folder);
+
   if (coco_options_read_int(options, "produce_all_data", &(observer_data->produce_all_data)) == 0)
     observer_data->produce_all_data = 0;
 
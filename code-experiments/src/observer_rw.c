@@ -7,6 +7,7 @@
 #include "coco_internal.h"
 
 #include "coco_utilities.c"
+#include "coco_writer.c"
 
 /** @brief Enum for denoting when the decision variables and constraints are logged. */
 typedef enum {
@@ -24,6 +25,9 @@ typedef struct {
   int log_only_better;               /**< @brief Whether to log only solutions that are better than previous
                                                  ones (only for the single-objective problems). */
   int log_time;                      /**< @brief Whether to log time. */
+  coco_writer_flush_policy_t flush_policy; /**< @brief The flush policy of the output files. */
+  size_t flush_lines;                /**< @brief The number of lines between flushes of the output files. */
+  double flush_interval;             /**< @brief The number of seconds between flushes of the output files. */
 } observer_rw_data_t;
 
 static coco_problem_t *logger_rw(coco_observer_t *observer, coco_problem_t *problem);
@@ -55,6 +59,11 @@ static void logger_rw_free(void *logger);
  *
  * - "log_time: 0/1" determines whether the time needed to evaluate each solution is logged (0) or not (1).
  * The default value is 0.
+ *
+ * - "flush_policy: STRING", "flush_lines: VALUE" and "flush_interval: VALUE" determine when the output
+ * files are flushed, as for the bbob observer (see observer_bbob). Because every evaluation is logged, the
+ * default policy is "interval" (after a line once flush_interval seconds have passed since the last flush,
+ * 10 seconds by default) instead of flushing after every evaluation.
  */
 static void observer_rw(coco_observer_t *observer, const char *options, coco_option_keys_t **option_keys) {
 
@@ -64,7 +73,7 @@ static void observer_rw(coco_observer_t *observer, const char *options, coco_opt
   /* Sets the valid keys for rw observer options
    * IMPORTANT: This list should be up-to-date with the code and the documentation */
   const char *known_keys[] = { "log_variables", "log_constraints", "low_dim_vars", "low_dim_cons",
-      "log_only_better", "log_time" };
+      "log_only_better", "log_time", "flush_policy", "flush_lines", "flush_interval" };
   *option_keys = coco_option_keys_allocate(sizeof(known_keys) / sizeof(char *), known_keys);
 
   observer_data = (observer_rw_data_t *) coco_allocate_memory(sizeof(*observer_data));
@@ -101,6 +110,9 @@ static void observer_rw(coco_observer_t *observer, const char *options, coco_opt
   if (coco_options_read_int(options, "log_time", &(observer_data->log_time)) == 0)
     observer_data->log_time = 0;
 
+  observer_data->flush_policy = coco_writer_read_flush_options(options, "rw", COCO_WRITER_FLUSH_INTERVAL,
+      &observer_data->flush_lines, &observer_data->flush_interval);
+
   observer->logger_allocate_function = logger_rw;
   observer->logger_free_function = logger_rw_free;
   observer->data_free_function = NULL;
@@ -8,8 +8,10 @@
 
 #include <math.h>
 #include <stdio.h>
+#include <string.h>
 #include <assert.h>
 #include "coco.h"
+#include "coco_instance_cache.c"
 
 /** @brief Maximal dimension used in BBOB2009. */
 #define SUITE_BBOB2009_MAX_DIM 40
@@ -72,8 +74,10 @@ static void bbob2009_unif(double *r, size_t N, long inseed) {
   if (inseed < 1)
     inseed = 1;
   aktseed = inseed;
+  /* As aktseed and aktrand are positive, the integer divisions give the same results as the floor of the
+   * floating-point divisions in the original code but are much cheaper */
   for (i = 39; i >= 0; i--) {
-    tmp = (int) floor((double) aktseed / (double) 127773);
+    tmp = aktseed / 127773;
     aktseed = 16807 * (aktseed - tmp * 127773) - 2836 * tmp;
     if (aktseed < 0)
       aktseed = aktseed + 2147483647;
@@ -82,11 +86,11 @@ static void bbob2009_unif(double *r, size_t N, long inseed) {
   }
   aktrand = rgrand[0];
   for (i = 0; i < N; i++) {
-    tmp = (int) floor((double) aktseed / (double) 127773);
+    tmp = aktseed / 127773;
     aktseed = 16807 * (aktseed - tmp * 127773) - 2836 * tmp;
     if (aktseed < 0)
       aktseed = aktseed + 2147483647;
-    tmp = (int) floor((double) aktrand / (double) 67108865);
+    tmp = aktrand / 67108865;
     aktrand = rgrand[tmp];
     rgrand[tmp] = aktseed;
     r[i] = (double) aktrand / 2.147483647e9;
@@ -112,11 +116,14 @@ static double **bbob2009_reshape(double **B, double *vector, const size_t m, con
 
 /**
  * @brief Generates N Gaussian random numbers using the given seed and stores them in g.
+ *
+ * The uniform numbers are kept on the stack for N < 3000 (which covers all uses in BBOB2009) and on the
+ * heap otherwise.
  */
 static void bbob2009_gauss(double *g, const size_t N, const long seed) {
   size_t i;
-  double uniftmp[6000];
-  assert(2 * N < 6000);
+  double uniftmp_on_stack[6000];
+  double *uniftmp = (2 * N < 6000) ? uniftmp_on_stack : coco_allocate_vector(2 * N);
   bbob2009_unif(uniftmp, 2 * N, seed);
 
   for (i = 0; i < N; i++) {
@@ -124,39 +131,68 @@ static void bbob2009_gauss(double *g, const size_t N, const long seed) {
     if (g[i] == 0.)
       g[i] = 1e-99;
   }
+  if (uniftmp != uniftmp_on_stack)
+    coco_free_memory(uniftmp);
   return;
 }
 
 /**
  * @brief Computes a DIM by DIM rotation matrix based on seed and stores it in B.
+ *
+ * The columns of a matrix of Gaussian random numbers are orthonormalized with the modified Gram-Schmidt
+ * process. The random numbers are generated column after column, so each column is orthonormalized in
+ * place in a contiguous vector and only copied to B at the end. The operations are the same (and performed
+ * in the same order) as in the original BBOB2009 code, which worked on the columns of B directly, so the
+ * results are bit-for-bit identical for all dimensions, while the function now works for any dimension.
+ *
+ * The matrix is taken from the instance cache if it has been computed before.
  */
 static void bbob2009_compute_rotation(double **B, const long seed, const size_t DIM) {
-  /* To ensure temporary data fits into gvec */
-  double prod;
-  double gvect[2000];
-  long i, j, k; /* Loop over pairs of column vectors. */
+  double prod, norm;
+  double *gvect, *column_i;
+  const double *column_j;
+  const double *cached;
+  double *copy;
+  size_t i, j, k; /* Loop over pairs of column vectors. */
 
-  assert(DIM * DIM < 2000);
+  cached = (const double *) coco_instance_cache_acquire("bbob2009_compute_rotation", seed, DIM, 0, 0,
+      DIM * DIM * sizeof(double));
+  if (cached != NULL) {
+    for (i = 0; i < DIM; i++)
+      memcpy(B[i], cached + i * DIM, DIM * sizeof(double));
+    coco_instance_cache_release(cached);
+    return;
+  }
 
+  /* The i-th column of the matrix is stored in gvect[i * DIM], ..., gvect[i * DIM + DIM - 1] */
+  gvect = coco_allocate_vector(DIM * DIM);
   bbob2009_gauss(gvect, DIM * DIM, seed);
-  bbob2009_reshape(B, gvect, DIM, DIM);
-  /*1st coordinate is row, 2nd is column.*/
 
   for (i = 0; i < DIM; i++) {
+    column_i = gvect + i * DIM;
     for (j = 0; j < i; j++) {
+      column_j = gvect + j * DIM;
       prod = 0;
       for (k = 0; k < DIM; k++)
-        prod += B[k][i] * B[k][j];
+        prod += column_i[k] * column_j[k];
       for (k = 0; k < DIM; k++)
-        B[k][i] -= prod * B[k][j];
+        column_i[k] -= prod * column_j[k];
     }
     prod = 0;
     for (k = 0; k < DIM; k++)
-      prod += B[k][i] * B[k][i];
+      prod += column_i[k] * column_i[k];
+    norm = sqrt(prod);
     for (k = 0; k < DIM; k++)
-      B[k][i] /= sqrt(prod);
+      column_i[k] /= norm;
   }
+  /*1st coordinate is row, 2nd is column.*/
+  bbob2009_reshape(B, gvect, DIM, DIM);
+  coco_free_memory(gvect);
 
+  copy = coco_allocate_vector(DIM * DIM);
+  for (i = 0; i < DIM; i++)
+    memcpy(copy + i * DIM, B[i], DIM * sizeof(double));
+  coco_instance_cache_insert("bbob2009_compute_rotation", seed, DIM, 0, 0, copy, DIM * DIM * sizeof(double));
 }
 
 static void bbob2009_copy_rotation_matrix(double **rot, double *M, double *b, const size_t DIM) {
@@ -177,12 +213,24 @@ static void bbob2009_copy_rotation_matrix(double **rot, double *M, double *b, co
  */
 static void bbob2009_compute_xopt(double *xopt, const long seed, const size_t DIM) {
   long i;
+  const double *cached;
+
+  cached = (const double *) coco_instance_cache_acquire("bbob2009_compute_xopt", seed, DIM, 0, 0,
+      DIM * sizeof(double));
+  if (cached != NULL) {
+    memcpy(xopt, cached, DIM * sizeof(double));
+    coco_instance_cache_release(cached);
+    return;
+  }
+
   bbob2009_unif(xopt, DIM, seed);
   for (i = 0; i < DIM; i++) {
     xopt[i] = 8 * floor(1e4 * xopt[i]) / 1e4 - 4;
     if (xopt[i] == 0.0)
       xopt[i] = -1e-5;
   }
+  coco_instance_cache_insert("bbob2009_compute_xopt", seed, DIM, 0, 0, coco_duplicate_vector(xopt, DIM),
+      DIM * sizeof(double));
 }
 
 /**
@@ -89,6 +89,8 @@ static coco_problem_t *suite_biobj_get_problem(coco_suite_t *suite,
 
   problem = coco_get_biobj_problem(function, dimension, instance, coco_get_bbob_problem, &new_inst_data,
       suite->number_of_instances, suite->dimensions, suite->number_of_dimensions);
+  /* Keep the new instances (if any) for the next problems */
+  suite->data = new_inst_data;
 
   problem->suite_dep_function = function;
   problem->suite_dep_instance = instance;
@@ -7,9 +7,15 @@
  * suite_biobj_instances. If a new instance of the problem is called, a check ensures that the two underlying
  * single-objective instances create a true bi-objective problem. However, these new instances need to be
  * manually added to suite_biobj_instances, otherwise they will be computed each time the suite constructor
- * is invoked with these instances.
+ * is invoked with these instances (unless they are persisted in an instance file, see
+ * suite_biobj_set_instance_file).
  */
 
+#include "coco_platform.h"
+
+#include <stdlib.h>
+#include <string.h>
+
 #include "coco.h"
 #include "suite_biobj_best_values_hyp.c"
 #include "suite_biobj_mixint_best_values_hyp.c"
@@ -38,6 +44,12 @@ static const size_t suite_biobj_instances[][3] = {
     { 15, 31, 34 }
 }; 
  
+#ifndef SUITE_BIOBJ_SEARCH_THREADS
+/** @brief The number of threads that construct the single-objective problems needed by the search for new
+ * instances (only used if the code is compiled with COCO_THREADS). */
+#define SUITE_BIOBJ_SEARCH_THREADS 4
+#endif
+
 /**
  * @brief A structure containing information about the new instances.
  */
@@ -49,6 +61,10 @@ typedef struct {
 
   size_t max_new_instances;  /**< @brief The maximal number of new instances. */
 
+  char *suite_name;          /**< @brief The name of the suite (used as a key in the instance file). */
+
+  char *file_name;           /**< @brief The file in which the new instances are persisted (can be NULL). */
+
 } suite_biobj_new_inst_t;
 
 /**
@@ -72,63 +88,374 @@ static void suite_biobj_new_inst_free(void *stuff) {
   }
   coco_free_memory(data->new_instances);
   data->new_instances = NULL;
+  if (data->suite_name != NULL)
+    coco_free_memory(data->suite_name);
+  data->suite_name = NULL;
+  if (data->file_name != NULL)
+    coco_free_memory(data->file_name);
+  data->file_name = NULL;
+}
+
+/**
+ * @brief Allocates the information about the new instances with space for max_new_instances instances.
+ */
+static suite_biobj_new_inst_t *suite_biobj_new_inst_allocate(const size_t max_new_instances) {
+
+  suite_biobj_new_inst_t *data;
+  size_t i, j;
+
+  data = (suite_biobj_new_inst_t *) coco_allocate_memory(sizeof(*data));
+
+  /* Most often the actual number of new instances will be lower than max_new_instances, because
+   * some of them are already in suite_biobj_instances. However, in order to avoid iterating over
+   * suite_biobj_new_inst_t, the allocation uses max_new_instances. */
+  data->max_new_instances = max_new_instances;
+
+  data->new_instances = (size_t **) coco_allocate_memory(data->max_new_instances * sizeof(size_t *));
+  for (i = 0; i < data->max_new_instances; i++) {
+    data->new_instances[i] = (size_t *) coco_allocate_memory(3 * sizeof(size_t));
+    for (j = 0; j < 3; j++) {
+      data->new_instances[i][j] = 0;
+    }
+  }
+  data->suite_name = NULL;
+  data->file_name = NULL;
+  return data;
+}
+
+/**
+ * @brief Saves the new instance to new_instances.
+ */
+static void suite_biobj_new_inst_add(suite_biobj_new_inst_t *new_inst_data,
+                                     const size_t instance,
+                                     const size_t instance1,
+                                     const size_t instance2) {
+  size_t i;
+
+  for (i = 0; i < new_inst_data->max_new_instances; i++) {
+    if (new_inst_data->new_instances[i][0] == 0) {
+      new_inst_data->new_instances[i][0] = instance;
+      new_inst_data->new_instances[i][1] = instance1;
+      new_inst_data->new_instances[i][2] = instance2;
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Sets the file in which the new instances of the suite are persisted (see the "biobj_instance_file"
+ * suite option in coco_suite).
+ *
+ * Each line of the file contains the key of a new instance, that is, the suite name, the comma-separated
+ * list of dimensions considered by the search and the instance, followed by the two instances of the
+ * underlying single-objective problems, for example "bbob-biobj 2,3,5,10,20,40 16 33 34". Instances found
+ * in the file do not need to be searched for, while the results of new searches are appended to it.
+ */
+static void suite_biobj_set_instance_file(coco_suite_t *suite, const char *file_name) {
+
+  suite_biobj_new_inst_t *data;
+
+  if (suite->data_free_function != suite_biobj_new_inst_free) {
+    coco_warning("suite_biobj_set_instance_file(): suite %s does not use new bi-objective instances, "
+        "the instance file %s is ignored", suite->suite_name, file_name);
+    return;
+  }
+  if (suite->data == NULL)
+    suite->data = suite_biobj_new_inst_allocate(suite->number_of_instances);
+  data = (suite_biobj_new_inst_t *) suite->data;
+  if (data->file_name != NULL)
+    coco_free_memory(data->file_name);
+  if (data->suite_name != NULL)
+    coco_free_memory(data->suite_name);
+  data->file_name = coco_strdup(file_name);
+  data->suite_name = coco_strdup(suite->suite_name);
+}
+
+/**
+ * @brief Writes the comma-separated list of the dimensions considered by the search for new instances
+ * (the ones that have not been filtered out) to dimensions_string.
+ */
+static void suite_biobj_get_dimensions_string(const size_t *dimensions,
+                                              const size_t num_dimensions,
+                                              char *dimensions_string) {
+  size_t d;
+  char *ptr = dimensions_string;
+
+  *ptr = '\0';
+  for (d = 0; d < num_dimensions; d++) {
+    if (dimensions[d] == 0)
+      continue;
+    ptr += sprintf(ptr, (ptr == dimensions_string) ? "%lu" : ",%lu", (unsigned long) dimensions[d]);
+  }
+}
+
+/**
+ * @brief Looks up the new instance in the instance file.
+ *
+ * @return The instance of the second problem/objective if the file contains the instance (with the same
+ * suite name, dimensions and instance of the first problem/objective) and 0 otherwise.
+ */
+static size_t suite_biobj_read_new_instance(const suite_biobj_new_inst_t *new_inst_data,
+                                            const size_t instance,
+                                            const size_t instance1,
+                                            const char *dimensions_string) {
+  FILE *file;
+  char line[COCO_PATH_MAX + 1], suite_name[COCO_PATH_MAX + 1], dimensions[COCO_PATH_MAX + 1];
+  unsigned long read_instance, read_instance1, read_instance2;
+  size_t instance2 = 0;
+
+  file = fopen(new_inst_data->file_name, "r");
+  if (file == NULL)
+    return 0;
+  while (fgets(line, COCO_PATH_MAX + 1, file) != NULL) {
+    if (sscanf(line, "%s %s %lu %lu %lu", suite_name, dimensions, &read_instance, &read_instance1,
+        &read_instance2) != 5)
+      continue;
+    if ((strcmp(suite_name, new_inst_data->suite_name) == 0) && (strcmp(dimensions, dimensions_string) == 0)
+        && (read_instance == instance) && (read_instance1 == instance1) && (read_instance2 > instance1)) {
+      instance2 = (size_t) read_instance2;
+      break;
+    }
+  }
+  fclose(file);
+  return instance2;
+}
+
+/**
+ * @brief Appends the new instance to the instance file.
+ */
+static void suite_biobj_write_new_instance(const suite_biobj_new_inst_t *new_inst_data,
+                                           const size_t instance,
+                                           const size_t instance1,
+                                           const size_t instance2,
+                                           const char *dimensions_string) {
+  FILE *file;
+
+  file = fopen(new_inst_data->file_name, "a");
+  if (file == NULL) {
+    coco_warning("suite_biobj_write_new_instance(): failed to open file %s", new_inst_data->file_name);
+    return;
+  }
+  fprintf(file, "%s %s %lu %lu %lu\n", new_inst_data->suite_name, dimensions_string, (unsigned long) instance,
+      (unsigned long) instance1, (unsigned long) instance2);
+  fclose(file);
+}
+
+/**
+ * @brief The single-objective problems of one instance needed by the search for new instances.
+ *
+ * The problems of all given functions in all given dimensions are constructed in advance (by several threads
+ * if the code has been compiled with COCO_THREADS), so that each of them is constructed only once per
+ * search instead of once for each pair of functions it takes part in.
+ */
+typedef struct {
+  const size_t *functions;     /**< @brief The functions. */
+  size_t number_of_functions;  /**< @brief The number of functions. */
+  const size_t *dimensions;    /**< @brief The dimensions (0 for the ones that have been filtered out). */
+  size_t number_of_dimensions; /**< @brief The number of dimensions. */
+  size_t instance;             /**< @brief The instance. */
+  coco_problem_t **problems;   /**< @brief The problems indexed by (function - 1) * number_of_dimensions + d. */
+  size_t number_of_problems;   /**< @brief The size of the problems array. */
+  size_t next_task;            /**< @brief The next problem to be constructed (see suite_biobj_problems_work). */
+  int is_parallel;             /**< @brief Whether several threads are used (and the mutex exists). */
+#if defined(HAVE_PTHREAD)
+  pthread_mutex_t mutex;       /**< @brief The mutex guarding next_task. */
+#elif defined(HAVE_WIN_THREADS)
+  CRITICAL_SECTION mutex;      /**< @brief The mutex guarding next_task. */
+#endif
+} suite_biobj_problems_t;
+
+/**
+ * @brief Constructs the problems taking them one by one until all of them have been constructed.
+ *
+ * The problems of the largest dimensions (which take the longest to construct) are handed out first.
+ */
+static void suite_biobj_problems_work(suite_biobj_problems_t *problems) {
+
+  const size_t number_of_tasks = problems->number_of_functions * problems->number_of_dimensions;
+  size_t task, function, d;
+
+  for (;;) {
+#if defined(HAVE_PTHREAD)
+    if (problems->is_parallel)
+      pthread_mutex_lock(&problems->mutex);
+#elif defined(HAVE_WIN_THREADS)
+    if (problems->is_parallel)
+      EnterCriticalSection(&problems->mutex);
+#endif
+    task = problems->next_task++;
+#if defined(HAVE_PTHREAD)
+    if (problems->is_parallel)
+      pthread_mutex_unlock(&problems->mutex);
+#elif defined(HAVE_WIN_THREADS)
+    if (problems->is_parallel)
+      LeaveCriticalSection(&problems->mutex);
+#endif
+    if (task >= number_of_tasks)
+      break;
+
+    d = problems->number_of_dimensions - 1 - task / problems->number_of_functions;
+    function = problems->functions[task % problems->number_of_functions];
+    if (problems->dimensions[d] == 0)
+      continue;
+    problems->problems[(function - 1) * problems->number_of_dimensions + d] = coco_get_bbob_problem(function,
+        problems->dimensions[d], problems->instance);
+  }
+}
+
+#if defined(HAVE_PTHREAD)
+/**
+ * @brief The function run by each thread constructing problems.
+ */
+static void *suite_biobj_problems_thread(void *problems) {
+  suite_biobj_problems_work((suite_biobj_problems_t *) problems);
+  return NULL;
+}
+#elif defined(HAVE_WIN_THREADS)
+/**
+ * @brief The function run by each thread constructing problems.
+ */
+static DWORD WINAPI suite_biobj_problems_thread(LPVOID problems) {
+  suite_biobj_problems_work((suite_biobj_problems_t *) problems);
+  return 0;
+}
+#endif
+
+/**
+ * @brief Constructs the problems of the given functions in the given dimensions for the given instance.
+ */
+static suite_biobj_problems_t *suite_biobj_problems_allocate(const size_t *functions,
+                                                             const size_t number_of_functions,
+                                                             const size_t *dimensions,
+                                                             const size_t number_of_dimensions,
+                                                             const size_t instance) {
+
+  suite_biobj_problems_t *problems;
+  size_t i, max_function = 0;
+#if defined(HAVE_PTHREAD)
+  pthread_t threads[SUITE_BIOBJ_SEARCH_THREADS];
+#elif defined(HAVE_WIN_THREADS)
+  HANDLE threads[SUITE_BIOBJ_SEARCH_THREADS];
+#endif
+
+  for (i = 0; i < number_of_functions; i++) {
+    if (functions[i] > max_function)
+      max_function = functions[i];
+  }
+
+  problems = (suite_biobj_problems_t *) coco_allocate_memory(sizeof(*problems));
+  problems->functions = functions;
+  problems->number_of_functions = number_of_functions;
+  problems->dimensions = dimensions;
+  problems->number_of_dimensions = number_of_dimensions;
+  problems->instance = instance;
+  problems->number_of_problems = max_function * number_of_dimensions;
+  problems->problems = (coco_problem_t **) coco_allocate_memory(problems->number_of_problems
+      * sizeof(coco_problem_t *));
+  for (i = 0; i < problems->number_of_problems; i++)
+    problems->problems[i] = NULL;
+  problems->next_task = 0;
+  problems->is_parallel = 0;
+
+#if defined(HAVE_PTHREAD)
+  pthread_mutex_init(&problems->mutex, NULL);
+  problems->is_parallel = 1;
+  for (i = 0; i < SUITE_BIOBJ_SEARCH_THREADS; i++) {
+    if (pthread_create(&threads[i], NULL, suite_biobj_problems_thread, problems) != 0)
+      coco_error("suite_biobj_problems_allocate(): failed to create thread %lu", (unsigned long) i);
+  }
+  for (i = 0; i < SUITE_BIOBJ_SEARCH_THREADS; i++)
+    pthread_join(threads[i], NULL);
+  pthread_mutex_destroy(&problems->mutex);
+#elif defined(HAVE_WIN_THREADS)
+  InitializeCriticalSection(&problems->mutex);
+  problems->is_parallel = 1;
+  for (i = 0; i < SUITE_BIOBJ_SEARCH_THREADS; i++) {
+    threads[i] = CreateThread(NULL, 0, suite_biobj_problems_thread, problems, 0, NULL);
+    if (threads[i] == NULL)
+      coco_error("suite_biobj_problems_allocate(): failed to create thread %lu", (unsigned long) i);
+  }
+  for (i = 0; i < SUITE_BIOBJ_SEARCH_THREADS; i++) {
+    WaitForSingleObject(threads[i], INFINITE);
+    CloseHandle(threads[i]);
+  }
+  DeleteCriticalSection(&problems->mutex);
+#else
+  suite_biobj_problems_work(problems);
+#endif
+  problems->is_parallel = 0;
+
+  return problems;
+}
+
+/**
+ * @brief Frees the problems.
+ */
+static void suite_biobj_problems_free(suite_biobj_problems_t *problems) {
+
+  size_t i;
+
+  for (i = 0; i < problems->number_of_problems; i++) {
+    if (problems->problems[i] != NULL)
+      coco_problem_free(problems->problems[i]);
+  }
+  coco_free_memory(problems->problems);
+  coco_free_memory(problems);
+}
+
+/**
+ * @brief Returns the problem of the given function in the dimension with index d.
+ */
+static coco_problem_t *suite_biobj_problems_get(const suite_biobj_problems_t *problems,
+                                                const size_t function,
+                                                const size_t d) {
+  coco_problem_t *problem;
+
+  assert((function - 1) * problems->number_of_dimensions + d < problems->number_of_problems);
+  problem = problems->problems[(function - 1) * problems->number_of_dimensions + d];
+  assert(problem != NULL);
+  return problem;
 }
 
 /**
  * @brief  Performs a few checks and returns whether the two given problem instances should break the search
  * for new instances in suite_biobj_get_new_instance().
+ *
+ * The ideal and nadir points are computed as in coco_problem_stacked_allocate(), but without constructing
+ * the bi-objective problem.
  */
-static int suite_biobj_check_inst_consistency(const size_t dimension,
-                                              size_t function1,
-                                              size_t instance1,
-                                              size_t function2,
-                                              size_t instance2) {
-  coco_problem_t *problem = NULL;
-  coco_problem_t *problem1, *problem2;
+static int suite_biobj_check_inst_consistency(coco_problem_t *problem1, coco_problem_t *problem2) {
+
   int break_search = 0;
   double norm;
-  double *smallest_values_of_interest, *largest_values_of_interest;
+  double ideal[2], nadir[2];
   const double apart_enough = 1e-4;
 
-  problem1 = coco_get_bbob_problem(function1, dimension, instance1);
-  problem2 = coco_get_bbob_problem(function2, dimension, instance2);
-
-  /* Set smallest and largest values of interest to some value (not important which, it just needs to be a
-   * vector of doubles of the right dimension) */
-  smallest_values_of_interest = coco_allocate_vector_with_value(dimension, -100);
-  largest_values_of_interest = coco_allocate_vector_with_value(dimension, 100);
-  problem = coco_problem_stacked_allocate(problem1, problem2, smallest_values_of_interest,
-          largest_values_of_interest);
-  coco_free_memory(smallest_values_of_interest);
-  coco_free_memory(largest_values_of_interest);
+  ideal[0] = problem1->best_value[0];
+  ideal[1] = problem2->best_value[0];
+  coco_evaluate_function(problem1, problem2->best_parameter, &nadir[0]);
+  coco_evaluate_function(problem2, problem1->best_parameter, &nadir[1]);
 
   /* Check whether the ideal and nadir points are too close in the objective space */
-  norm = mo_get_norm(problem->best_value, problem->nadir_value, 2);
+  norm = mo_get_norm(ideal, nadir, 2);
   if (norm < 1e-1) { /* TODO How to set this value in a sensible manner? */
     coco_debug(
-        "suite_biobj_check_inst_consistency(): The ideal and nadir points of %s are too close in the objective space",
-        problem->problem_id);
-    coco_debug("norm = %e, ideal = %e\t%e, nadir = %e\t%e", norm, problem->best_value[0],
-        problem->best_value[1], problem->nadir_value[0], problem->nadir_value[1]);
+        "suite_biobj_check_inst_consistency(): The ideal and nadir points of %s__%s are too close in the objective space",
+        problem1->problem_id, problem2->problem_id);
+    coco_debug("norm = %e, ideal = %e\t%e, nadir = %e\t%e", norm, ideal[0], ideal[1], nadir[0], nadir[1]);
     break_search = 1;
   }
 
   /* Check whether the extreme optimal points are too close in the decision space */
-  norm = mo_get_norm(problem1->best_parameter, problem2->best_parameter, problem->number_of_variables);
+  norm = mo_get_norm(problem1->best_parameter, problem2->best_parameter, problem1->number_of_variables);
   if (norm < apart_enough) {
     coco_debug(
-        "suite_biobj_check_inst_consistency(): The extreme points of %s are too close in the decision space",
-        problem->problem_id);
+        "suite_biobj_check_inst_consistency(): The extreme points of %s__%s are too close in the decision space",
+        problem1->problem_id, problem2->problem_id);
     coco_debug("norm = %e", norm);
     break_search = 1;
   }
 
-  /* Clean up */
-  if (problem) {
-    coco_problem_stacked_free(problem);
-    problem = NULL;
-  }
-
   return break_search;
 
 }
@@ -142,7 +469,12 @@ static int suite_biobj_check_inst_consistency(const size_t dimension,
  * An appropriate instance is the one for which the resulting bi-objective problem (in any considered
  * dimension) has the ideal and nadir points apart enough in the objective space and the extreme optimal
  * points apart enough in the decision space. When the instance has been found, it is output through
- * coco_warning, so that the user can see it and eventually manually add it to suite_biobj_instances.
+ * coco_info, so that the user can see it and eventually manually add it to suite_biobj_instances.
+ *
+ * The single-objective problems of instance1 are constructed once for the whole search and those of each
+ * tried instance2 once for the try (see suite_biobj_problems_t). If the suite has an instance file (see
+ * suite_biobj_set_instance_file), the instance is first looked up in the file and the result of the search
+ * is appended to it.
  */
 static size_t suite_biobj_get_new_instance(suite_biobj_new_inst_t *new_inst_data,
                                            const size_t instance,
@@ -158,14 +490,40 @@ static size_t suite_biobj_get_new_instance(suite_biobj_new_inst_t *new_inst_data
   size_t num_tries = 0;
   const size_t max_tries = 1000;
   int appropriate_instance_found = 0, break_search, warning_produced = 0;
-  size_t d, f1, f2, i;
-  size_t function1, function2, dimension;
+  size_t d, f1, f2;
+  size_t function1, function2;
+  suite_biobj_problems_t *problems1 = NULL, *problems2;
+  char dimensions_string[COCO_PATH_MAX + 1];
+
+  for (d = 0; d < num_dimensions; d++) {
+    if ((dimensions[d] == 0) && !warning_produced) {
+      coco_warning("suite_biobj_get_new_instance(): remove filtering of dimensions to get generally acceptable instances!");
+      warning_produced = 1;
+    }
+  }
+
+  if (new_inst_data->file_name != NULL) {
+    suite_biobj_get_dimensions_string(dimensions, num_dimensions, dimensions_string);
+    instance2 = suite_biobj_read_new_instance(new_inst_data, instance, instance1, dimensions_string);
+    if (instance2 > 0) {
+      coco_debug("suite_biobj_get_new_instance(): Instance %lu read from file %s", (unsigned long) instance,
+          new_inst_data->file_name);
+      suite_biobj_new_inst_add(new_inst_data, instance, instance1, instance2);
+      return instance2;
+    }
+  }
 
   while ((!appropriate_instance_found) && (num_tries < max_tries)) {
     num_tries++;
     instance2 = instance1 + num_tries;
     break_search = 0;
 
+    if (problems1 == NULL)
+      problems1 = suite_biobj_problems_allocate(bbob_functions, num_bbob_functions, dimensions, num_dimensions,
+          instance1);
+    problems2 = suite_biobj_problems_allocate(bbob_functions, num_bbob_functions, dimensions, num_dimensions,
+        instance2);
+
     /* An instance is "appropriate" if the ideal and nadir points in the objective space and the two
      * extreme optimal points in the decisions space are apart enough for all problems (all dimensions
      * and function combinations); therefore iterate over all dimensions and function combinations */
@@ -175,16 +533,10 @@ static size_t suite_biobj_get_new_instance(suite_biobj_new_inst_t *new_inst_data
       for (f2 = f1+1; (f2 < num_bbob_functions) && !break_search; f2++) {
         function2 = bbob_functions[f2];
         for (d = 0; (d < num_dimensions) && !break_search; d++) {
-          dimension = dimensions[d];
-
-          if (dimension == 0) {
-            if (!warning_produced)
-              coco_warning("suite_biobj_get_new_instance(): remove filtering of dimensions to get generally acceptable instances!");
-            warning_produced = 1;
+          if (dimensions[d] == 0)
             continue;
-          }
-
-          break_search = suite_biobj_check_inst_consistency(dimension, function1, instance1, function2, instance2);
+          break_search = suite_biobj_check_inst_consistency(suite_biobj_problems_get(problems1, function1, d),
+              suite_biobj_problems_get(problems2, function2, d));
         }
       }
     }
@@ -194,19 +546,15 @@ static size_t suite_biobj_get_new_instance(suite_biobj_new_inst_t *new_inst_data
       function1 = sel_bbob_functions[f1];
       function2 = sel_bbob_functions[f1];
       for (d = 0; (d < num_dimensions) && !break_search; d++) {
-        dimension = dimensions[d];
-
-        if (dimension == 0) {
-            if (!warning_produced)
-              coco_warning("suite_biobj_get_new_instance(): remove filtering of dimensions to get generally acceptable instances!");
-            warning_produced = 1;
-            continue;
-          }
-
-        break_search = suite_biobj_check_inst_consistency(dimension, function1, instance1, function2, instance2);
+        if (dimensions[d] == 0)
+          continue;
+        break_search = suite_biobj_check_inst_consistency(suite_biobj_problems_get(problems1, function1, d),
+            suite_biobj_problems_get(problems2, function2, d));
       }
     }
 
+    suite_biobj_problems_free(problems2);
+
     if (break_search) {
       /* The search was broken, continue with next instance2 */
       continue;
@@ -216,18 +564,16 @@ static size_t suite_biobj_get_new_instance(suite_biobj_new_inst_t *new_inst_data
       coco_info("suite_biobj_get_new_instance(): Instance %lu created from instances %lu and %lu",
           (unsigned long) instance, (unsigned long) instance1, (unsigned long) instance2);
 
-      /* Save the instance to new_instances */
-      for (i = 0; i < new_inst_data->max_new_instances; i++) {
-        if (new_inst_data->new_instances[i][0] == 0) {
-          new_inst_data->new_instances[i][0] = instance;
-          new_inst_data->new_instances[i][1] = instance1;
-          new_inst_data->new_instances[i][2] = instance2;
-          break;
-        };
-      }
+      /* Save the instance to new_instances and to the instance file */
+      suite_biobj_new_inst_add(new_inst_data, instance, instance1, instance2);
+      if (new_inst_data->file_name != NULL)
+        suite_biobj_write_new_instance(new_inst_data, instance, instance1, instance2, dimensions_string);
     }
   }
 
+  if (problems1 != NULL)
+    suite_biobj_problems_free(problems1);
+
   if (!appropriate_instance_found) {
     coco_error("suite_biobj_get_new_instance(): Could not find suitable instance %lu in %lu tries",
         (unsigned long) instance, (unsigned long) num_tries);
@@ -281,7 +627,7 @@ static coco_problem_t *coco_get_biobj_problem(const size_t function,
   size_t function1_idx, function2_idx;
   const size_t function_idx = function - 1;
 
-  size_t i, j;
+  size_t i;
   const size_t num_existing_instances = sizeof(suite_biobj_instances) / sizeof(suite_biobj_instances[0]);
   int instance_found = 0;
 
@@ -446,20 +792,7 @@ static coco_problem_t *coco_get_biobj_problem(const size_t function,
 
     if ((*new_inst_data) == NULL) {
       /* Allocate space needed for saving new instances */
-      (*new_inst_data) = (suite_biobj_new_inst_t *) coco_allocate_memory(sizeof(**new_inst_data));
-
-      /* Most often the actual number of new instances will be lower than max_new_instances, because
-       * some of them are already in suite_biobj_instances. However, in order to avoid iterating over
-       * suite_biobj_new_inst_t, the allocation uses max_new_instances. */
-      (*new_inst_data)->max_new_instances = num_new_instances;
-
-      (*new_inst_data)->new_instances = (size_t **) coco_allocate_memory((*new_inst_data)->max_new_instances * sizeof(size_t *));
-      for (i = 0; i < (*new_inst_data)->max_new_instances; i++) {
-        (*new_inst_data)->new_instances[i] = (size_t *) malloc(3 * sizeof(size_t));
-        for (j = 0; j < 3; j++) {
-          (*new_inst_data)->new_instances[i][j] = 0;
-        }
-      }
+      (*new_inst_data) = suite_biobj_new_inst_allocate(num_new_instances);
     }
 
     /* A simple formula to set the first instance */
@@ -500,49 +833,179 @@ static coco_problem_t *coco_get_biobj_problem(const size_t function,
   return problem;
 }
 
+/**
+ * @brief An entry of the index of best hypervolume values.
+ */
+typedef struct {
+  unsigned long key; /**< @brief The function, instance and dimension packed by suite_biobj_hyp_key_parse(). */
+  double value;      /**< @brief The best known hypervolume value. */
+} suite_biobj_hyp_entry_t;
+
+/**
+ * @brief The index of the best hypervolume values of a suite, which is sorted by the key.
+ *
+ * The string tables in suite_biobj_best_values_hyp.c and suite_biobj_mixint_best_values_hyp.c remain the
+ * source of the values (they are parsed by the pre-processing scripts as well), the index is built from them
+ * on the first lookup and kept in static memory afterwards.
+ */
+typedef struct {
+  const char *prefix;               /**< @brief The prefix of the keys (the suite name followed by "_f"). */
+  const char **strings;             /**< @brief The table of strings "key value". */
+  suite_biobj_hyp_entry_t *entries; /**< @brief The entries (one for each string). */
+  size_t number_of_entries;         /**< @brief The number of strings and entries. */
+  int is_built;                     /**< @brief Whether the entries have been filled and sorted. */
+} suite_biobj_hyp_index_t;
+
+/** @brief The entries of the index of the bbob-biobj suite. */
+static suite_biobj_hyp_entry_t suite_biobj_hyp_entries[sizeof(suite_biobj_best_values_hyp) / sizeof(char *)];
+
+/** @brief The entries of the index of the bbob-biobj-mixint suite. */
+static suite_biobj_hyp_entry_t suite_biobj_mixint_hyp_entries[sizeof(suite_biobj_mixint_best_values_hyp) /
+                                                              sizeof(char *)];
+
+/** @brief The index of the best hypervolume values of the bbob-biobj suite. */
+static suite_biobj_hyp_index_t suite_biobj_hyp_index = { "bbob-biobj_f", suite_biobj_best_values_hyp,
+    suite_biobj_hyp_entries, sizeof(suite_biobj_best_values_hyp) / sizeof(char *), 0 };
+
+/** @brief The index of the best hypervolume values of the bbob-biobj-mixint suite. */
+static suite_biobj_hyp_index_t suite_biobj_mixint_hyp_index = { "bbob-biobj-mixint_f",
+    suite_biobj_mixint_best_values_hyp, suite_biobj_mixint_hyp_entries,
+    sizeof(suite_biobj_mixint_best_values_hyp) / sizeof(char *), 0 };
+
+#if defined(HAVE_PTHREAD)
+/** @brief The lock that guards building the indices of best hypervolume values. */
+static pthread_mutex_t suite_biobj_hyp_index_mutex = PTHREAD_MUTEX_INITIALIZER;
+#elif defined(HAVE_WIN_THREADS)
+/** @brief The lock that guards building the indices of best hypervolume values. */
+static SRWLOCK suite_biobj_hyp_index_mutex = SRWLOCK_INIT;
+#endif
+
+/**
+ * @brief Parses a number of at most three decimal digits at *string and advances *string past it.
+ *
+ * @return 1 on success and 0 otherwise.
+ */
+static int suite_biobj_hyp_number_parse(const char **string, unsigned long *number) {
+
+  size_t i;
+
+  *number = 0;
+  for (i = 0; ((*string)[i] >= '0') && ((*string)[i] <= '9'); i++) {
+    if (i == 3)
+      return 0;
+    *number = 10 * *number + (unsigned long) ((*string)[i] - '0');
+  }
+  *string += i;
+  return (i > 0);
+}
+
+/**
+ * @brief Parses a key of the form <prefix>XX_iXX_dXX (as in "bbob-biobj_f01_i01_d02", the prefix includes
+ * the "_f") into a single number that increases with the function, instance and dimension (in this order).
+ *
+ * @return A pointer to the first character after the key or NULL if the string does not start with a valid key.
+ */
+static const char *suite_biobj_hyp_key_parse(const char *string, const char *prefix, unsigned long *key) {
+
+  unsigned long function, instance, dimension;
+  const size_t prefix_length = strlen(prefix);
+
+  if (strncmp(string, prefix, prefix_length) != 0)
+    return NULL;
+  string += prefix_length;
+  if (!suite_biobj_hyp_number_parse(&string, &function) || (strncmp(string, "_i", 2) != 0))
+    return NULL;
+  string += 2;
+  if (!suite_biobj_hyp_number_parse(&string, &instance) || (strncmp(string, "_d", 2) != 0))
+    return NULL;
+  string += 2;
+  if (!suite_biobj_hyp_number_parse(&string, &dimension))
+    return NULL;
+
+  *key = (function * 1000 + instance) * 1000 + dimension;
+  return string;
+}
+
+/**
+ * @brief Defines the ordering of the index entries by their keys.
+ */
+static int suite_biobj_hyp_entry_compare(const void *a, const void *b) {
+  const unsigned long key1 = ((const suite_biobj_hyp_entry_t *) a)->key;
+  const unsigned long key2 = ((const suite_biobj_hyp_entry_t *) b)->key;
+  return (key1 < key2) ? -1 : ((key1 > key2) ? 1 : 0);
+}
+
+/**
+ * @brief Fills the index from its table of strings and sorts it (if this has not been done yet).
+ */
+static void suite_biobj_hyp_index_build(suite_biobj_hyp_index_t *index) {
+
+  const char *string;
+  char *end;
+  size_t i;
+
+#if defined(HAVE_PTHREAD)
+  pthread_mutex_lock(&suite_biobj_hyp_index_mutex);
+#elif defined(HAVE_WIN_THREADS)
+  AcquireSRWLockExclusive(&suite_biobj_hyp_index_mutex);
+#endif
+
+  if (!index->is_built) {
+    for (i = 0; i < index->number_of_entries; i++) {
+      string = suite_biobj_hyp_key_parse(index->strings[i], index->prefix, &index->entries[i].key);
+      if ((string == NULL) || (*string != ' '))
+        coco_error("suite_biobj_hyp_index_build(): cannot parse the key of '%s'", index->strings[i]);
+      index->entries[i].value = strtod(string, &end);
+      if (end == string)
+        coco_error("suite_biobj_hyp_index_build(): cannot parse the value of '%s'", index->strings[i]);
+    }
+    qsort(index->entries, index->number_of_entries, sizeof(suite_biobj_hyp_entry_t),
+        suite_biobj_hyp_entry_compare);
+    index->is_built = 1;
+  }
+
+#if defined(HAVE_PTHREAD)
+  pthread_mutex_unlock(&suite_biobj_hyp_index_mutex);
+#elif defined(HAVE_WIN_THREADS)
+  ReleaseSRWLockExclusive(&suite_biobj_hyp_index_mutex);
+#endif
+}
+
 /**
  * @brief Returns the best known value for the hypervolume indicator matching the given key if the key is found, and
  * throws a coco_error otherwise.
  *
+ * The value is found by a binary search in the index of the suite, which is built on the first call (see
+ * suite_biobj_hyp_index_t).
+ *
  * @note This function needs to be updated when a new biobjective suite is added to COCO.
  */
 static double suite_biobj_get_best_hyp_value(const char *suite_name, const char *key) {
 
-  size_t i, count;
-  double best_value = 0;
-  char *curr_key;
+  suite_biobj_hyp_index_t *index;
+  suite_biobj_hyp_entry_t entry;
+  const suite_biobj_hyp_entry_t *found = NULL;
+  const char *end;
 
   if (strcmp(suite_name, "bbob-biobj") == 0) {
-    curr_key = coco_allocate_string(COCO_PATH_MAX + 1);
-    count = sizeof(suite_biobj_best_values_hyp) / sizeof(char *);
-    for (i = 0; i < count; i++) {
-      sscanf(suite_biobj_best_values_hyp[i], "%s %lf", curr_key, &best_value);
-      if (strcmp(curr_key, key) == 0) {
-        coco_free_memory(curr_key);
-        return best_value;
-      }
-    }
+    index = &suite_biobj_hyp_index;
   }
   else if (strcmp(suite_name, "bbob-biobj-mixint") == 0) {
-    curr_key = coco_allocate_string(COCO_PATH_MAX + 1);
-    count = sizeof(suite_biobj_mixint_best_values_hyp) / sizeof(char *);
-    for (i = 0; i < count; i++) {
-      sscanf(suite_biobj_mixint_best_values_hyp[i], "%s %lf", curr_key, &best_value);
-      if (strcmp(curr_key, key) == 0) {
-        coco_free_memory(curr_key);
-        return best_value;
-      }
-    }
+    index = &suite_biobj_mixint_hyp_index;
   }
   else {
     coco_error("suite_biobj_get_best_hyp_value(): suite %s not supported", suite_name);
     return 0; /* Never reached */
   }
 
-  coco_free_memory(curr_key);
+  suite_biobj_hyp_index_build(index);
+  end = suite_biobj_hyp_key_parse(key, index->prefix, &entry.key);
+  if ((end != NULL) && (*end == '\0'))
+    found = (const suite_biobj_hyp_entry_t *) bsearch(&entry, index->entries, index->number_of_entries,
+        sizeof(suite_biobj_hyp_entry_t), suite_biobj_hyp_entry_compare);
+  if (found != NULL)
+    return found->value;
+
   coco_warning("suite_biobj_get_best_hyp_value(): best value of %s could not be found; set to 1.0", key);
   return 1.0;
-
-  coco_error("suite_biobj_get_best_hyp_value(): unexpected exception");
-  return 0; /* Never reached */
 }
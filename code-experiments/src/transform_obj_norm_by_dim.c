@@ -21,6 +21,23 @@ static void transform_obj_norm_by_dim_evaluate(coco_problem_t *problem, const do
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the transformation in a batch of points.
+ */
+static void transform_obj_norm_by_dim_evaluate_batch(coco_problem_t *problem,
+                                                     const size_t number_of_points,
+                                                     const double *x,
+                                                     double *y) {
+  size_t k;
+  const double factor = bbob2009_fmin(1, 40. / ((double) problem->number_of_variables));
+
+  coco_evaluate_function_batch(coco_problem_transformed_get_inner_problem(problem), number_of_points, x, y);
+  for (k = 0; k < number_of_points; k++) {
+    y[k * problem->number_of_objectives] *= factor;
+    assert(y[k * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
+  }
+}
+
 /**
  * @brief Creates the transformation.
  */
@@ -29,5 +46,6 @@ static coco_problem_t *transform_obj_norm_by_dim(coco_problem_t *inner_problem)
 
   problem = coco_problem_transformed_allocate(inner_problem, NULL, NULL, "transform_obj_norm_by_dim");
   problem->evaluate_function = transform_obj_norm_by_dim_evaluate;
+  problem->evaluate_function_batch = transform_obj_norm_by_dim_evaluate_batch;
   return problem;
 }
@@ -36,6 +36,33 @@ static void transform_obj_oscillate_evaluate(coco_problem_t *problem, const doub
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the transformation in a batch of points.
+ */
+static void transform_obj_oscillate_evaluate_batch(coco_problem_t *problem,
+                                                   const size_t number_of_points,
+                                                   const double *x,
+                                                   double *y) {
+  static const double factor = 0.1;
+  size_t i, k;
+
+  coco_evaluate_function_batch(coco_problem_transformed_get_inner_problem(problem), number_of_points, x, y);
+
+  for (i = 0; i < number_of_points * problem->number_of_objectives; i++) {
+      if (y[i] != 0) {
+          double log_y;
+          log_y = log(fabs(y[i])) / factor;
+          if (y[i] > 0) {
+              y[i] = pow(exp(log_y + 0.49 * (sin(log_y) + sin(0.79 * log_y))), factor);
+          } else {
+              y[i] = -pow(exp(log_y + 0.49 * (sin(0.55 * log_y) + sin(0.31 * log_y))), factor);
+          }
+      }
+  }
+  for (k = 0; k < number_of_points; k++)
+    assert(y[k * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Creates the transformation.
  */
@@ -43,6 +70,7 @@ static coco_problem_t *transform_obj_oscillate(coco_problem_t *inner_problem) {
   coco_problem_t *problem;
   problem = coco_problem_transformed_allocate(inner_problem, NULL, NULL, "transform_obj_oscillate");
   problem->evaluate_function = transform_obj_oscillate_evaluate;
+  problem->evaluate_function_batch = transform_obj_oscillate_evaluate_batch;
   /* Compute best value */
   /* Maybe not the most efficient solution */
   transform_obj_oscillate_evaluate(problem, problem->best_parameter, problem->best_value);
@@ -50,6 +50,41 @@ static void transform_obj_penalize_evaluate(coco_problem_t *problem, const doubl
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the transformation in a batch of points.
+ */
+static void transform_obj_penalize_evaluate_batch(coco_problem_t *problem,
+                                                  const size_t number_of_points,
+                                                  const double *x,
+                                                  double *y) {
+  transform_obj_penalize_data_t *data = (transform_obj_penalize_data_t *) coco_problem_transformed_get_data(problem);
+  const double *lower_bounds = problem->smallest_values_of_interest;
+  const double *upper_bounds = problem->largest_values_of_interest;
+  const size_t n = problem->number_of_variables;
+  double penalty;
+  size_t i, k;
+
+  assert(coco_problem_transformed_get_inner_problem(problem) != NULL);
+  coco_evaluate_function_batch(coco_problem_transformed_get_inner_problem(problem), number_of_points, x, y);
+
+  for (k = 0; k < number_of_points; ++k) {
+    penalty = 0.0;
+    for (i = 0; i < n; ++i) {
+      const double c1 = x[k * n + i] - upper_bounds[i];
+      const double c2 = lower_bounds[i] - x[k * n + i];
+      if (c1 > 0.0) {
+        penalty += c1 * c1;
+      } else if (c2 > 0.0) {
+        penalty += c2 * c2;
+      }
+    }
+    for (i = 0; i < problem->number_of_objectives; ++i) {
+      y[k * problem->number_of_objectives + i] += data->factor * penalty;
+    }
+    assert(y[k * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
+  }
+}
+
 /**
  * @brief Creates the transformation.
  */
@@ -62,6 +97,7 @@ static coco_problem_t *transform_obj_penalize(coco_problem_t *inner_problem, con
   data->factor = factor;
   problem = coco_problem_transformed_allocate(inner_problem, data, NULL, "transform_obj_penalize");
   problem->evaluate_function = transform_obj_penalize_evaluate;
+  problem->evaluate_function_batch = transform_obj_penalize_evaluate_batch;
   /* No need to update the best value as the best parameter is feasible */
   return problem;
 }
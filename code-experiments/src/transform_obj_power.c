@@ -37,6 +37,26 @@ static void transform_obj_power_evaluate(coco_problem_t *problem, const double *
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the transformation in a batch of points.
+ */
+static void transform_obj_power_evaluate_batch(coco_problem_t *problem,
+                                               const size_t number_of_points,
+                                               const double *x,
+                                               double *y) {
+  transform_obj_power_data_t *data;
+  size_t i, k;
+
+  data = (transform_obj_power_data_t *) coco_problem_transformed_get_data(problem);
+  coco_evaluate_function_batch(coco_problem_transformed_get_inner_problem(problem), number_of_points, x, y);
+
+  for (i = 0; i < number_of_points * problem->number_of_objectives; i++) {
+      y[i] = pow(y[i], data->exponent);
+  }
+  for (k = 0; k < number_of_points; k++)
+    assert(y[k * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Creates the transformation.
  */
@@ -49,6 +69,7 @@ static coco_problem_t *transform_obj_power(coco_problem_t *inner_problem, const
 
   problem = coco_problem_transformed_allocate(inner_problem, data, NULL, "transform_obj_power");
   problem->evaluate_function = transform_obj_power_evaluate;
+  problem->evaluate_function_batch = transform_obj_power_evaluate_batch;
   /* Compute best value */
   transform_obj_power_evaluate(problem, problem->best_parameter, problem->best_value);
   return problem;
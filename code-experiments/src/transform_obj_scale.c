@@ -36,15 +36,34 @@ static void transform_obj_scale_evaluate_function(coco_problem_t *problem, const
     y[i] *= data->factor;
 
   if (problem->number_of_constraints > 0) {
-    cons_values = coco_allocate_vector(problem->number_of_constraints);
+    cons_values = coco_problem_scratch_allocate(problem, problem->number_of_constraints);
     is_feasible = coco_is_feasible(problem, x, cons_values);
-    coco_free_memory(cons_values);
+    coco_problem_scratch_free(problem, cons_values, problem->number_of_constraints);
     if (is_feasible)
       assert(y[0] + 1e-13 >= problem->best_value[0]);
   }
   else assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the transformed objective function in a batch of points.
+ */
+static void transform_obj_scale_evaluate_function_batch(coco_problem_t *problem,
+                                                        const size_t number_of_points,
+                                                        const double *x,
+                                                        double *y) {
+  transform_obj_scale_data_t *data;
+  size_t i;
+
+  data = (transform_obj_scale_data_t *) coco_problem_transformed_get_data(problem);
+  coco_evaluate_function_batch(coco_problem_transformed_get_inner_problem(problem), number_of_points, x, y);
+
+  for (i = 0; i < number_of_points * problem->number_of_objectives; i++)
+    y[i] *= data->factor;
+
+  coco_problem_batch_assert_best_value(problem, number_of_points, x, y);
+}
+
 /**
  * @brief Evaluates the gradient of the transformed function at x
  */
@@ -78,8 +97,10 @@ static coco_problem_t *transform_obj_scale(coco_problem_t *inner_problem, const
   problem = coco_problem_transformed_allocate(inner_problem, data,
     NULL, "transform_obj_scale");
 
-  if (inner_problem->number_of_objectives > 0)
+  if (inner_problem->number_of_objectives > 0) {
     problem->evaluate_function = transform_obj_scale_evaluate_function;
+    problem->evaluate_function_batch = transform_obj_scale_evaluate_function_batch;
+  }
 
   problem->evaluate_gradient = transform_obj_scale_evaluate_gradient;
 
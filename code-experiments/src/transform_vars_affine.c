@@ -20,15 +20,96 @@
  * @brief Data type for transform_vars_affine.
  */
 typedef struct {
-  double *M, *b, *x;
+  double *M, *b;
 } transform_vars_affine_data_t;
 
+/**
+ * @brief Computes y = Mx + b, where M has number_of_rows rows and number_of_columns columns.
+ *
+ * Four rows are computed at the same time, so that each x[j] is loaded once for four rows and the four
+ * sums are independent of each other. Each sum is accumulated in the same order as in a row-by-row loop,
+ * so the results are exactly the same.
+ */
+static void transform_vars_affine_apply(const transform_vars_affine_data_t *data,
+                                        const size_t number_of_columns,
+                                        const size_t number_of_rows,
+                                        const double *x,
+                                        double *y) {
+  size_t i, j;
+
+  for (i = 0; i + 4 <= number_of_rows; i += 4) {
+    const double *row0 = data->M + i * number_of_columns;
+    const double *row1 = row0 + number_of_columns;
+    const double *row2 = row1 + number_of_columns;
+    const double *row3 = row2 + number_of_columns;
+    double sum0 = data->b[i], sum1 = data->b[i + 1], sum2 = data->b[i + 2], sum3 = data->b[i + 3];
+    for (j = 0; j < number_of_columns; ++j) {
+      const double xj = x[j];
+      sum0 += xj * row0[j];
+      sum1 += xj * row1[j];
+      sum2 += xj * row2[j];
+      sum3 += xj * row3[j];
+    }
+    y[i] = sum0;
+    y[i + 1] = sum1;
+    y[i + 2] = sum2;
+    y[i + 3] = sum3;
+  }
+  for (; i < number_of_rows; ++i) {
+    const double *row = data->M + i * number_of_columns;
+    double sum = data->b[i];
+    for (j = 0; j < number_of_columns; ++j)
+      sum += x[j] * row[j];
+    y[i] = sum;
+  }
+}
+
+/**
+ * @brief Computes y_k = Mx_k + b for number_of_points points x_k stored one after another in x.
+ *
+ * Four points are multiplied by each row of M at the same time, so that M is read only once for every
+ * four points. The results are exactly the same as those of transform_vars_affine_apply.
+ */
+static void transform_vars_affine_apply_batch(const transform_vars_affine_data_t *data,
+                                              const size_t number_of_columns,
+                                              const size_t number_of_rows,
+                                              const size_t number_of_points,
+                                              const double *x,
+                                              double *y) {
+  size_t i, j, k;
+
+  for (k = 0; k + 4 <= number_of_points; k += 4) {
+    const double *x0 = x + k * number_of_columns;
+    const double *x1 = x0 + number_of_columns;
+    const double *x2 = x1 + number_of_columns;
+    const double *x3 = x2 + number_of_columns;
+    double *y0 = y + k * number_of_rows;
+    for (i = 0; i < number_of_rows; ++i) {
+      const double *row = data->M + i * number_of_columns;
+      double sum0 = data->b[i], sum1 = data->b[i], sum2 = data->b[i], sum3 = data->b[i];
+      for (j = 0; j < number_of_columns; ++j) {
+        const double mij = row[j];
+        sum0 += x0[j] * mij;
+        sum1 += x1[j] * mij;
+        sum2 += x2[j] * mij;
+        sum3 += x3[j] * mij;
+      }
+      y0[i] = sum0;
+      y0[number_of_rows + i] = sum1;
+      y0[2 * number_of_rows + i] = sum2;
+      y0[3 * number_of_rows + i] = sum3;
+    }
+  }
+  for (; k < number_of_points; ++k)
+    transform_vars_affine_apply(data, number_of_columns, number_of_rows, x + k * number_of_columns,
+        y + k * number_of_rows);
+}
+
 /**
  * @brief Evaluates the transformed objective function.
  */
 static void transform_vars_affine_evaluate_function(coco_problem_t *problem, const double *x, double *y) {
-  size_t i, j;
-  double *cons_values;
+  double *cons_values, *inner_x;
   int is_feasible;
   transform_vars_affine_data_t *data;
   coco_problem_t *inner_problem;
@@ -41,32 +122,55 @@ static void transform_vars_affine_evaluate_function(coco_problem_t *problem, con
   data = (transform_vars_affine_data_t *) coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
-  for (i = 0; i < inner_problem->number_of_variables; ++i) {
-    /* data->M has problem->number_of_variables columns and inner_problem->number_of_variables rows. */
-    const double *current_row = data->M + i * problem->number_of_variables;
-    data->x[i] = data->b[i];
-    for (j = 0; j < problem->number_of_variables; ++j) {
-      data->x[i] += x[j] * current_row[j];
-    }
-  }
+  inner_x = coco_problem_scratch_allocate(problem, inner_problem->number_of_variables);
+  /* data->M has problem->number_of_variables columns and inner_problem->number_of_variables rows. */
+  transform_vars_affine_apply(data, problem->number_of_variables, inner_problem->number_of_variables, x, inner_x);
   
-  coco_evaluate_function(inner_problem, data->x, y);
+  coco_evaluate_function(inner_problem, inner_x, y);
+  coco_problem_scratch_free(problem, inner_x, inner_problem->number_of_variables);
   
   if (problem->number_of_constraints > 0) {
-    cons_values = coco_allocate_vector(problem->number_of_constraints);
+    cons_values = coco_problem_scratch_allocate(problem, problem->number_of_constraints);
     is_feasible = coco_is_feasible(problem, x, cons_values);
-    coco_free_memory(cons_values);    
+    coco_problem_scratch_free(problem, cons_values, problem->number_of_constraints);
     if (is_feasible)
       assert(y[0] + 1e-13 >= problem->best_value[0]);
   }
   else assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the transformed objective function in a batch of points.
+ */
+static void transform_vars_affine_evaluate_function_batch(coco_problem_t *problem,
+                                                          const size_t number_of_points,
+                                                          const double *x,
+                                                          double *y) {
+  double *batch_x;
+  transform_vars_affine_data_t *data;
+  coco_problem_t *inner_problem;
+  size_t n, inner_n;
+
+  data = (transform_vars_affine_data_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  n = problem->number_of_variables;
+  inner_n = inner_problem->number_of_variables;
+
+  batch_x = coco_problem_scratch_allocate(problem, number_of_points * inner_n);
+  /* data->M has problem->number_of_variables columns and inner_problem->number_of_variables rows. */
+  transform_vars_affine_apply_batch(data, n, inner_n, number_of_points, x, batch_x);
+
+  coco_evaluate_function_batch(inner_problem, number_of_points, batch_x, y);
+  coco_problem_scratch_free(problem, batch_x, number_of_points * inner_n);
+
+  coco_problem_batch_assert_best_value(problem, number_of_points, x, y);
+}
+
 /**
  * @brief Evaluates the transformed constraint.
  */
 static void transform_vars_affine_evaluate_constraint(coco_problem_t *problem, const double *x, double *y) {
-  size_t i, j;  
+  double *inner_x;
   transform_vars_affine_data_t *data;
   coco_problem_t *inner_problem;
   
@@ -78,15 +182,11 @@ static void transform_vars_affine_evaluate_constraint(coco_problem_t *problem, c
   data = (transform_vars_affine_data_t *) coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
-  for (i = 0; i < inner_problem->number_of_variables; ++i) {
-    /* data->M has problem->number_of_variables columns and inner_problem->number_of_variables rows. */
-    const double *current_row = data->M + i * problem->number_of_variables;
-    data->x[i] = data->b[i];
-    for (j = 0; j < problem->number_of_variables; ++j) {
-      data->x[i] += x[j] * current_row[j];
-    }
-  }
-  coco_evaluate_constraint(inner_problem, data->x, y);
+  inner_x = coco_problem_scratch_allocate(problem, inner_problem->number_of_variables);
+  /* data->M has problem->number_of_variables columns and inner_problem->number_of_variables rows. */
+  transform_vars_affine_apply(data, problem->number_of_variables, inner_problem->number_of_variables, x, inner_x);
+  coco_evaluate_constraint(inner_problem, inner_x, y);
+  coco_problem_scratch_free(problem, inner_x, inner_problem->number_of_variables);
 }
 
 /**
@@ -97,7 +197,7 @@ static void transform_vars_affine_evaluate_gradient(coco_problem_t *problem, con
   transform_vars_affine_data_t *data;
   coco_problem_t *inner_problem;
   double *current_row;
-  double *gradient;
+  double *gradient, *inner_x;
   
   if (coco_vector_contains_nan(x, coco_problem_get_dimension(problem))) {
   	coco_vector_set_to_nan(y, coco_problem_get_number_of_objectives(problem));
@@ -107,28 +207,24 @@ static void transform_vars_affine_evaluate_gradient(coco_problem_t *problem, con
   data = (transform_vars_affine_data_t *) coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
-  gradient = coco_allocate_vector(inner_problem->number_of_variables);
+  gradient = coco_problem_scratch_allocate(problem, inner_problem->number_of_variables);
   
   for (i = 0; i < inner_problem->number_of_variables; ++i)
     gradient[i] = 0.0;
 
-  for (i = 0; i < inner_problem->number_of_variables; ++i) {
-    /* data->M has problem->number_of_variables columns and inner_problem->number_of_variables rows. */
-    current_row = data->M + i * problem->number_of_variables;
-    data->x[i] = data->b[i];
-    for (j = 0; j < problem->number_of_variables; ++j) {
-      data->x[i] += x[j] * current_row[j];
-    }
-  }
+  inner_x = coco_problem_scratch_allocate(problem, inner_problem->number_of_variables);
+  /* data->M has problem->number_of_variables columns and inner_problem->number_of_variables rows. */
+  transform_vars_affine_apply(data, problem->number_of_variables, inner_problem->number_of_variables, x, inner_x);
   
-  bbob_evaluate_gradient(inner_problem, data->x, y);
+  bbob_evaluate_gradient(inner_problem, inner_x, y);
+  coco_problem_scratch_free(problem, inner_x, inner_problem->number_of_variables);
   
   /* grad_(f o g )(x), where g(x) = M * x + b, equals to
-   * M^T * grad_f(M *x + b) 
+   * M^T * grad_f(M *x + b), which is accumulated row by row of M
    */
-  for (j = 0; j < inner_problem->number_of_variables; ++j) {
-    for (i = 0; i < inner_problem->number_of_variables; ++i) {
-       current_row = data->M + i * problem->number_of_variables;
+  for (i = 0; i < inner_problem->number_of_variables; ++i) {
+    current_row = data->M + i * problem->number_of_variables;
+    for (j = 0; j < inner_problem->number_of_variables; ++j) {
        gradient[j] += y[i] * current_row[j];
     }
   }
@@ -137,7 +233,7 @@ static void transform_vars_affine_evaluate_gradient(coco_problem_t *problem, con
      y[i] = gradient[i];
   
   current_row = NULL;
-  coco_free_memory(gradient);
+  coco_problem_scratch_free(problem, gradient, inner_problem->number_of_variables);
 }
 
 /**
@@ -147,7 +243,6 @@ static void transform_vars_affine_free(void *thing) {
   transform_vars_affine_data_t *data = (transform_vars_affine_data_t *) thing;
   coco_free_memory(data->M);
   coco_free_memory(data->b);
-  coco_free_memory(data->x);
 }
 
 /**
@@ -167,18 +262,20 @@ static coco_problem_t *transform_vars_affine(coco_problem_t *inner_problem,
   coco_problem_t *problem;
   transform_vars_affine_data_t *data;
   size_t entries_in_M;
+  double *inner_best_parameter;
 
   entries_in_M = inner_problem->number_of_variables * number_of_variables;
   data = (transform_vars_affine_data_t *) coco_allocate_memory(sizeof(*data));
   data->M = coco_duplicate_vector(M, entries_in_M);
   data->b = coco_duplicate_vector(b, inner_problem->number_of_variables);
-  data->x = coco_allocate_vector(inner_problem->number_of_variables);
 
   problem = coco_problem_transformed_allocate(inner_problem, data, 
     transform_vars_affine_free, "transform_vars_affine");
     
-  if (inner_problem->number_of_objectives > 0)
+  if (inner_problem->number_of_objectives > 0) {
     problem->evaluate_function = transform_vars_affine_evaluate_function;
+    problem->evaluate_function_batch = transform_vars_affine_evaluate_function_batch;
+  }
     
   if (inner_problem->number_of_constraints > 0)
     problem->evaluate_constraint = transform_vars_affine_evaluate_constraint;
@@ -195,15 +292,17 @@ static coco_problem_t *transform_vars_affine(coco_problem_t *inner_problem,
     if (!coco_is_orthogonal(data->M, problem->number_of_variables, inner_problem->number_of_variables))
         coco_warning("transform_vars_affine(): rotation matrix is not orthogonal. Best parameter not updated");
     else {
+        inner_best_parameter = coco_allocate_vector(inner_problem->number_of_variables);
         for (i = 0; i < inner_problem->number_of_variables; ++i) {
-            data->x[i] = inner_problem->best_parameter[i] - data->b[i];
+            inner_best_parameter[i] = inner_problem->best_parameter[i] - data->b[i];
         }
         for (i = 0; i < problem->number_of_variables; ++i) {
             problem->best_parameter[i] = 0;
             for (j = 0; j < inner_problem->number_of_variables; ++j) {
-                problem->best_parameter[i] += data->M[j * problem->number_of_variables + i] * data->x[j];
+                problem->best_parameter[i] += data->M[j * problem->number_of_variables + i] * inner_best_parameter[j];
             }
         }
+        coco_free_memory(inner_best_parameter);
     }
   }
 
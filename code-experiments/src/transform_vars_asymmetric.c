@@ -13,7 +13,6 @@
  * @brief Data type for transform_vars_asymmetric.
  */
 typedef struct {
-  double *x;
   double beta;
 } transform_vars_asymmetric_data_t;
 
@@ -24,7 +23,7 @@ static void transform_vars_asymmetric_evaluate_function(coco_problem_t *problem,
                                                         const double *x, 
                                                         double *y) {
   size_t i;
-  double exponent, *cons_values;
+  double exponent, *cons_values, *inner_x;
   int is_feasible;
   transform_vars_asymmetric_data_t *data;
   coco_problem_t *inner_problem;
@@ -37,28 +36,65 @@ static void transform_vars_asymmetric_evaluate_function(coco_problem_t *problem,
   data = (transform_vars_asymmetric_data_t *) coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
+  inner_x = coco_problem_scratch_allocate(problem, inner_problem->number_of_variables);
   for (i = 0; i < problem->number_of_variables; ++i) {
     if (x[i] > 0.0) {
       exponent = 1.0
           + ((data->beta * (double) (long) i) / ((double) (long) problem->number_of_variables - 1.0)) * sqrt(x[i]);
-      data->x[i] = pow(x[i], exponent);
+      inner_x[i] = pow(x[i], exponent);
     } else {
-      data->x[i] = x[i];
+      inner_x[i] = x[i];
     }
   }
   
-  coco_evaluate_function(inner_problem, data->x, y);
+  coco_evaluate_function(inner_problem, inner_x, y);
+  coco_problem_scratch_free(problem, inner_x, inner_problem->number_of_variables);
   
   if (problem->number_of_constraints > 0) {
-    cons_values = coco_allocate_vector(problem->number_of_constraints);
+    cons_values = coco_problem_scratch_allocate(problem, problem->number_of_constraints);
     is_feasible = coco_is_feasible(problem, x, cons_values);
-    coco_free_memory(cons_values);    
+    coco_problem_scratch_free(problem, cons_values, problem->number_of_constraints);
     if (is_feasible)
       assert(y[0] + 1e-13 >= problem->best_value[0]);
   }
   else assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the transformed objective function in a batch of points.
+ */
+static void transform_vars_asymmetric_evaluate_function_batch(coco_problem_t *problem,
+                                                              const size_t number_of_points,
+                                                              const double *x,
+                                                              double *y) {
+  size_t i, k;
+  double exponent, *batch_x;
+  transform_vars_asymmetric_data_t *data;
+  coco_problem_t *inner_problem;
+  const size_t n = problem->number_of_variables;
+
+  data = (transform_vars_asymmetric_data_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  batch_x = coco_problem_scratch_allocate(problem, number_of_points * n);
+  for (k = 0; k < number_of_points; ++k) {
+    for (i = 0; i < n; ++i) {
+      if (x[k * n + i] > 0.0) {
+        exponent = 1.0
+            + ((data->beta * (double) (long) i) / ((double) (long) n - 1.0)) * sqrt(x[k * n + i]);
+        batch_x[k * n + i] = pow(x[k * n + i], exponent);
+      } else {
+        batch_x[k * n + i] = x[k * n + i];
+      }
+    }
+  }
+
+  coco_evaluate_function_batch(inner_problem, number_of_points, batch_x, y);
+  coco_problem_scratch_free(problem, batch_x, number_of_points * n);
+
+  coco_problem_batch_assert_best_value(problem, number_of_points, x, y);
+}
+
 /**
  * @brief Evaluates the transformed constraint.
  */
@@ -66,7 +102,7 @@ static void transform_vars_asymmetric_evaluate_constraint(coco_problem_t *proble
                                                           const double *x, 
                                                           double *y) {
   size_t i;
-  double exponent;
+  double exponent, *inner_x;
   transform_vars_asymmetric_data_t *data;
   coco_problem_t *inner_problem;
   
@@ -78,21 +114,18 @@ static void transform_vars_asymmetric_evaluate_constraint(coco_problem_t *proble
   data = (transform_vars_asymmetric_data_t *) coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
+  inner_x = coco_problem_scratch_allocate(problem, inner_problem->number_of_variables);
   for (i = 0; i < problem->number_of_variables; ++i) {
     if (x[i] > 0.0) {
       exponent = 1.0
           + ((data->beta * (double) (long) i) / ((double) (long) problem->number_of_variables - 1.0)) * sqrt(x[i]);
-      data->x[i] = pow(x[i], exponent);
+      inner_x[i] = pow(x[i], exponent);
     } else {
-      data->x[i] = x[i];
+      inner_x[i] = x[i];
     }
   }
-  coco_evaluate_constraint(inner_problem, data->x, y);
-}
-
-static void transform_vars_asymmetric_free(void *thing) {
-  transform_vars_asymmetric_data_t *data = (transform_vars_asymmetric_data_t *) thing;
-  coco_free_memory(data->x);
+  coco_evaluate_constraint(inner_problem, inner_x, y);
+  coco_problem_scratch_free(problem, inner_x, inner_problem->number_of_variables);
 }
 
 /**
@@ -107,13 +140,13 @@ static coco_problem_t *transform_vars_asymmetric(coco_problem_t *inner_problem,
   coco_problem_t *problem;
   
   data = (transform_vars_asymmetric_data_t *) coco_allocate_memory(sizeof(*data));
-  data->x = coco_allocate_vector(inner_problem->number_of_variables);
   data->beta = beta;
-  problem = coco_problem_transformed_allocate(inner_problem, data, 
-    transform_vars_asymmetric_free, "transform_vars_asymmetric");
+  problem = coco_problem_transformed_allocate(inner_problem, data, NULL, "transform_vars_asymmetric");
     
-  if (inner_problem->number_of_objectives > 0)
+  if (inner_problem->number_of_objectives > 0) {
     problem->evaluate_function = transform_vars_asymmetric_evaluate_function;
+    problem->evaluate_function_batch = transform_vars_asymmetric_evaluate_function_batch;
+  }
     
   if (inner_problem->number_of_constraints > 0) {
 	  
@@ -3,7 +3,8 @@
  * @brief Implementation of performing a block-rotation transformation on decision values.
  *
  * x |-> Bx
- * The matrix B is stored in a 2-D array. Only the content of the blocks are stored
+ * Only the content of the blocks is stored, contiguously, one block after another and each block in
+ * row-major format.
  */
 
 #include <assert.h>
@@ -16,13 +17,10 @@
  * @brief Data type for transform_vars_blockrotation.
  */
 typedef struct {
-  double **B; /**< @brief the block-diagonal matrices*/
-  double *Bx;
+  double *B; /**< @brief the blocks of the block-diagonal matrix (see coco_copy_block_matrix_contiguous)*/
   size_t dimension;
   size_t *block_sizes; /**< @brief the list of block-sizes*/
   size_t nb_blocks; /**< @brief the number of blocks in the matrix */
-  size_t *block_size_map; /**< @brief maps a row to the block-size of the block to which it belong, keep until better way is found */
-  size_t *first_non_zero_map; /**< @brief maps a row to the index of its first non zero element */
 } transform_vars_blockrotation_t;
 
 /*
@@ -31,65 +29,87 @@ typedef struct {
 static void transform_vars_blockrotation_get_row(coco_problem_t *problem,
                                                size_t i,
                                                double *y) {
-  size_t j, current_blocksize, first_non_zero_ind; /* cp-paste from apply */
+  size_t j, idx_block, current_blocksize, first_non_zero_ind;
+  const double *current_block;
   transform_vars_blockrotation_t *data;
 
   data = (transform_vars_blockrotation_t *) coco_problem_transformed_get_data(problem);
-  current_blocksize = data->block_size_map[i];
-  first_non_zero_ind = data->first_non_zero_map[i];
+  /* Find the block of the i-th row */
+  current_block = data->B;
+  first_non_zero_ind = 0;
+  current_blocksize = data->block_sizes[0];
+  for (idx_block = 0; first_non_zero_ind + current_blocksize <= i; idx_block++) {
+    current_block += current_blocksize * current_blocksize;
+    first_non_zero_ind += current_blocksize;
+    current_blocksize = data->block_sizes[idx_block + 1];
+  }
 
   for (j = 0; j < data->dimension; ++j) {
     y[j] = (j < first_non_zero_ind || j >= first_non_zero_ind + current_blocksize) ?
-        0 : data->B[i][j - first_non_zero_ind]; /*all B lines start at 0*/
+        0 : current_block[(i - first_non_zero_ind) * current_blocksize + j - first_non_zero_ind];
   }
 }
 
 /*
  * @brief Computes y = Bx, where all the pertinent information about B is given in the problem data.
+ *
+ * x and y may point to the same vector, in which case Bx is first computed in the scratch memory.
  */
 static void transform_vars_blockrotation_apply(coco_problem_t *problem,
                                                const double *x,
                                                double *y) {
-  size_t i, j, current_blocksize, first_non_zero_ind;
+  size_t i;
+  double *Bx;
   transform_vars_blockrotation_t *data;
 
   data = (transform_vars_blockrotation_t *) coco_problem_transformed_get_data(problem);
-  assert(x != data->Bx);
-  for (i = 0; i < data->dimension; ++i) {
-    current_blocksize = data->block_size_map[i];
-    first_non_zero_ind = data->first_non_zero_map[i];
-    data->Bx[i] = 0;
-    /*compute y[i] = < B[i,:] , x >  */
-    for (j = first_non_zero_ind; j < first_non_zero_ind + current_blocksize; ++j) {
-      data->Bx[i] += data->B[i][j - first_non_zero_ind] * x[j]; /*all B lines start at 0*/
-    }
-  }
-  if (y != data->Bx) {
+  Bx = (x == y) ? coco_problem_scratch_allocate(problem, data->dimension) : y;
+  coco_block_matrix_apply(data->B, data->block_sizes, data->nb_blocks, NULL, x, Bx);
+  if (y != Bx) {
     for (i = 0; i < data->dimension; ++i) {
-      y[i] = data->Bx[i];
+      y[i] = Bx[i];
     }
+    coco_problem_scratch_free(problem, Bx, data->dimension);
   }
 }
 
 static void transform_vars_blockrotation_evaluate(coco_problem_t *problem, const double *x, double *y) {
   coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
-  transform_vars_blockrotation_t *data;
-  data = (transform_vars_blockrotation_t *) coco_problem_transformed_get_data(problem);
+  double *Bx;
 
-  transform_vars_blockrotation_apply(problem, x, data->Bx);
+  Bx = coco_problem_scratch_allocate(problem, problem->number_of_variables);
+  transform_vars_blockrotation_apply(problem, x, Bx);
   
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
-  coco_evaluate_function(inner_problem, data->Bx, y);
+  coco_evaluate_function(inner_problem, Bx, y);
+  coco_problem_scratch_free(problem, Bx, problem->number_of_variables);
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+static void transform_vars_blockrotation_evaluate_batch(coco_problem_t *problem,
+                                                        const size_t number_of_points,
+                                                        const double *x,
+                                                        double *y) {
+  coco_problem_t *inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  const size_t n = problem->number_of_variables;
+  double *batch_x;
+  size_t k;
+
+  batch_x = coco_problem_scratch_allocate(problem, number_of_points * n);
+  for (k = 0; k < number_of_points; ++k)
+    transform_vars_blockrotation_apply(problem, x + k * n, batch_x + k * n);
+
+  coco_evaluate_function_batch(inner_problem, number_of_points, batch_x, y);
+  coco_problem_scratch_free(problem, batch_x, number_of_points * n);
+
+  for (k = 0; k < number_of_points; ++k)
+    assert(y[k * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
+}
+
 static void transform_vars_blockrotation_free(void *stuff) {
   transform_vars_blockrotation_t *data = (transform_vars_blockrotation_t *) stuff;
-  coco_free_block_matrix(data->B, data->dimension);
+  coco_free_memory(data->B);
   coco_free_memory(data->block_sizes);
-  coco_free_memory(data->Bx);
-  coco_free_memory(data->block_size_map);
-  coco_free_memory(data->first_non_zero_map);
 }
 
 /*
@@ -122,39 +142,19 @@ static coco_problem_t *transform_vars_blockrotation(coco_problem_t *inner_proble
                                                     const size_t nb_blocks) {
   coco_problem_t *problem;
   transform_vars_blockrotation_t *data;
-  size_t entries_in_M, idx_blocksize, next_bs_change, current_blocksize;
-  size_t i;
-  entries_in_M = 0;
   assert(number_of_variables > 0);/*tmp*/
-  for (i = 0; i < nb_blocks; i++) {
-    entries_in_M += block_sizes[i] * block_sizes[i];
-  }
   data = (transform_vars_blockrotation_t *) coco_allocate_memory(sizeof(*data));
   data->dimension = number_of_variables;
-  data->B = coco_copy_block_matrix(B, number_of_variables, block_sizes, nb_blocks);
-  data->Bx = coco_allocate_vector(inner_problem->number_of_variables);
+  data->B = coco_copy_block_matrix_contiguous(B, block_sizes, nb_blocks);
   data->block_sizes = coco_duplicate_size_t_vector(block_sizes, nb_blocks);
   data->nb_blocks = nb_blocks;
-  data->block_size_map = coco_allocate_vector_size_t(number_of_variables);
-  data->first_non_zero_map = coco_allocate_vector_size_t(number_of_variables);
-  
-  idx_blocksize = 0;
-  next_bs_change = block_sizes[idx_blocksize];
-  for (i = 0; i < number_of_variables; i++) {
-    if (i >= next_bs_change) {
-      idx_blocksize++;
-      next_bs_change += block_sizes[idx_blocksize];
-    }
-    current_blocksize = block_sizes[idx_blocksize];
-    data->block_size_map[i] = current_blocksize;
-    data->first_non_zero_map[i] = next_bs_change - current_blocksize;/* next_bs_change serves also as a cumsum for blocksizes*/
-  }
   if (coco_problem_best_parameter_not_zero(inner_problem)) {
     coco_debug("transform_vars_blockrotation(): 'best_parameter' not updated, set to NAN");
     coco_vector_set_to_nan(inner_problem->best_parameter, inner_problem->number_of_variables);
   }
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_blockrotation_free, "transform_vars_blockrotation");
   problem->evaluate_function = transform_vars_blockrotation_evaluate;
+  problem->evaluate_function_batch = transform_vars_blockrotation_evaluate_batch;
   
   if (number_of_variables < 100) {
     /* 1e-11 still passes and 1e-12 fails under macOS */
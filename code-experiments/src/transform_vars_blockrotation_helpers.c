@@ -101,7 +101,6 @@ static void coco_compute_blockrotation(double **B, long seed, size_t n, size_t *
   for (idx_block = 0; idx_block < nb_blocks; idx_block++) {
     current_blocksize = block_sizes[idx_block];
     current_block = bbob2009_allocate_matrix(current_blocksize, current_blocksize);
-    assert(current_blocksize <= 44);
     bbob2009_compute_rotation(current_block, seed + (long) 1000000 * (long) idx_block, current_blocksize);
 
     /* now fill the block matrix*/
@@ -166,3 +165,87 @@ static size_t *coco_get_block_sizes(size_t *nb_blocks, size_t dimension, const c
     return NULL;
   }
 }
+
+/**
+ * @brief Returns a copy of the block matrix B in which the blocks are stored contiguously, one after
+ * another, each in row-major format.
+ */
+static double *coco_copy_block_matrix_contiguous(const double *const *B,
+                                                 const size_t *block_sizes,
+                                                 const size_t nb_blocks) {
+  double *blocks, *current_block;
+  size_t i, j, idx_block, current_blocksize, first_row, nb_entries;
+
+  nb_entries = 0;
+  for (idx_block = 0; idx_block < nb_blocks; idx_block++)
+    nb_entries += block_sizes[idx_block] * block_sizes[idx_block];
+
+  blocks = coco_allocate_vector(nb_entries);
+  current_block = blocks;
+  first_row = 0;
+  for (idx_block = 0; idx_block < nb_blocks; idx_block++) {
+    current_blocksize = block_sizes[idx_block];
+    for (i = 0; i < current_blocksize; i++) {
+      for (j = 0; j < current_blocksize; j++) {
+        current_block[i * current_blocksize + j] = B[first_row + i][j];
+      }
+    }
+    current_block += current_blocksize * current_blocksize;
+    first_row += current_blocksize;
+  }
+  return blocks;
+}
+
+/**
+ * @brief Computes the product of a contiguously stored block matrix (see
+ * coco_copy_block_matrix_contiguous) and x and saves its i-th entry in y[row_map[i]] (or in y[i] if
+ * row_map is NULL).
+ *
+ * The blocks are processed one after another and four rows of a block at a time, so that the entries of
+ * x used by a block stay in the cache and the four sums are independent of each other. Each sum is
+ * accumulated in the order of the columns, so the results do not depend on the blocking. x and y must not
+ * overlap.
+ */
+static void coco_block_matrix_apply(const double *blocks,
+                                    const size_t *block_sizes,
+                                    const size_t nb_blocks,
+                                    const size_t *row_map,
+                                    const double *x,
+                                    double *y) {
+  const double *current_block = blocks;
+  const double *current_x = x;
+  size_t i, j, idx_block, current_blocksize, first_row = 0;
+  double sum0, sum1, sum2, sum3;
+
+  for (idx_block = 0; idx_block < nb_blocks; idx_block++) {
+    current_blocksize = block_sizes[idx_block];
+    for (i = 0; i + 4 <= current_blocksize; i += 4) {
+      const double *row0 = current_block + i * current_blocksize;
+      const double *row1 = row0 + current_blocksize;
+      const double *row2 = row1 + current_blocksize;
+      const double *row3 = row2 + current_blocksize;
+      sum0 = sum1 = sum2 = sum3 = 0;
+      for (j = 0; j < current_blocksize; j++) {
+        sum0 += row0[j] * current_x[j];
+        sum1 += row1[j] * current_x[j];
+        sum2 += row2[j] * current_x[j];
+        sum3 += row3[j] * current_x[j];
+      }
+      y[row_map ? row_map[first_row + i] : first_row + i] = sum0;
+      y[row_map ? row_map[first_row + i + 1] : first_row + i + 1] = sum1;
+      y[row_map ? row_map[first_row + i + 2] : first_row + i + 2] = sum2;
+      y[row_map ? row_map[first_row + i + 3] : first_row + i + 3] = sum3;
+    }
+    for (; i < current_blocksize; i++) {
+      const double *row = current_block + i * current_blocksize;
+      sum0 = 0;
+      for (j = 0; j < current_blocksize; j++) {
+        sum0 += row[j] * current_x[j];
+      }
+      y[row_map ? row_map[first_row + i] : first_row + i] = sum0;
+    }
+    current_block += current_blocksize * current_blocksize;
+    current_x += current_blocksize;
+    first_row += current_blocksize;
+  }
+}
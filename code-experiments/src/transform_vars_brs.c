@@ -9,20 +9,13 @@
 #include "coco.h"
 #include "coco_problem.c"
 
-/**
- * @brief Data type for transform_vars_brs.
- */
-typedef struct {
-  double *x;
-} transform_vars_brs_data_t;
-
 /**
  * @brief Evaluates the transformation.
  */
 static void transform_vars_brs_evaluate(coco_problem_t *problem, const double *x, double *y) {
   size_t i;
-  double factor;
-  transform_vars_brs_data_t *data;
+  double factor, *inner_x;
+  const double *coefficients;
   coco_problem_t *inner_problem;
 
   if (coco_vector_contains_nan(x, coco_problem_get_dimension(problem))) {
@@ -30,15 +23,12 @@ static void transform_vars_brs_evaluate(coco_problem_t *problem, const double *x
   	return;
   }
 
-  data = (transform_vars_brs_data_t *) coco_problem_transformed_get_data(problem);
+  coefficients = (const double *) coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
+  inner_x = coco_problem_scratch_allocate(problem, problem->number_of_variables);
   for (i = 0; i < problem->number_of_variables; ++i) {
-    /* Function documentation says we should compute 10^(0.5 *
-     * (i-1)/(D-1)). Instead we compute the equivalent
-     * sqrt(10)^((i-1)/(D-1)) just like the legacy code.
-     */
-    factor = pow(sqrt(10.0), (double) (long) i / ((double) (long) problem->number_of_variables - 1.0));
+    factor = coefficients[i];
     /* Documentation specifies odd indices and starts indexing
      * from 1, we use all even indices since C starts indexing
      * with 0.
@@ -46,31 +36,65 @@ static void transform_vars_brs_evaluate(coco_problem_t *problem, const double *x
     if (x[i] > 0.0 && i % 2 == 0) {
       factor *= 10.0;
     }
-    data->x[i] = factor * x[i];
+    inner_x[i] = factor * x[i];
   }
-  coco_evaluate_function(inner_problem, data->x, y);
+  coco_evaluate_function(inner_problem, inner_x, y);
+  coco_problem_scratch_free(problem, inner_x, problem->number_of_variables);
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
 /**
- * @brief Frees the data object.
+ * @brief Evaluates the transformation in a batch of points.
  */
-static void transform_vars_brs_free(void *thing) {
-  transform_vars_brs_data_t *data = (transform_vars_brs_data_t *) thing;
-  coco_free_memory(data->x);
+static void transform_vars_brs_evaluate_batch(coco_problem_t *problem,
+                                              const size_t number_of_points,
+                                              const double *x,
+                                              double *y) {
+  size_t i, k;
+  double factor, *batch_x;
+  const double *coefficients;
+  coco_problem_t *inner_problem;
+  const size_t n = problem->number_of_variables;
+
+  coefficients = (const double *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  batch_x = coco_problem_scratch_allocate(problem, number_of_points * n);
+  for (i = 0; i < n; ++i) {
+    /* The factor does not depend on the point, only the sign of x[i] does */
+    const double base_factor = coefficients[i];
+    for (k = 0; k < number_of_points; ++k) {
+      factor = base_factor;
+      if (x[k * n + i] > 0.0 && i % 2 == 0) {
+        factor *= 10.0;
+      }
+      batch_x[k * n + i] = factor * x[k * n + i];
+    }
+  }
+  coco_evaluate_function_batch(inner_problem, number_of_points, batch_x, y);
+  coco_problem_scratch_free(problem, batch_x, number_of_points * n);
+
+  for (k = 0; k < number_of_points; ++k)
+    assert(y[k * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
 }
 
 /**
  * @brief Creates the transformation.
+ *
+ * The data of the transformation is the vector of the coefficients sqrt(10)^(i / (n - 1)).
  */
 static coco_problem_t *transform_vars_brs(coco_problem_t *inner_problem) {
-  transform_vars_brs_data_t *data;
   coco_problem_t *problem;
+  double *coefficients;
 
-  data = (transform_vars_brs_data_t *) coco_allocate_memory(sizeof(*data));
-  data->x = coco_allocate_vector(inner_problem->number_of_variables);
-  problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_brs_free, "transform_vars_brs");
+  /* Function documentation says we should compute 10^(0.5 *
+   * (i-1)/(D-1)). Instead we compute the equivalent
+   * sqrt(10)^((i-1)/(D-1)) just like the legacy code.
+   */
+  coefficients = coco_allocate_conditioning_coefficients(sqrt(10.0), 1.0, inner_problem->number_of_variables);
+  problem = coco_problem_transformed_allocate(inner_problem, coefficients, NULL, "transform_vars_brs");
   problem->evaluate_function = transform_vars_brs_evaluate;
+  problem->evaluate_function_batch = transform_vars_brs_evaluate_batch;
 
   if (coco_problem_best_parameter_not_zero(inner_problem)) {
     coco_warning("transform_vars_brs(): 'best_parameter' not updated, set to NAN");
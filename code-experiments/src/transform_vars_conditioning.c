@@ -13,15 +13,24 @@
  * @brief Data type for transform_vars_conditioning.
  */
 typedef struct {
-  double *x;
   double alpha;
+  double *coefficients; /**< @brief The coefficients alpha^(0.5 * i / (n - 1)). */
 } transform_vars_conditioning_data_t;
 
+/**
+ * @brief Frees the data object.
+ */
+static void transform_vars_conditioning_free(void *thing) {
+  transform_vars_conditioning_data_t *data = (transform_vars_conditioning_data_t *) thing;
+  coco_free_memory(data->coefficients);
+}
+
 /**
  * @brief Evaluates the transformation.
  */
 static void transform_vars_conditioning_evaluate(coco_problem_t *problem, const double *x, double *y) {
   size_t i;
+  double *inner_x;
   transform_vars_conditioning_data_t *data;
   coco_problem_t *inner_problem;
 
@@ -33,17 +42,45 @@ static void transform_vars_conditioning_evaluate(coco_problem_t *problem, const
   data = (transform_vars_conditioning_data_t *) coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
+  inner_x = coco_problem_scratch_allocate(problem, inner_problem->number_of_variables);
   for (i = 0; i < problem->number_of_variables; ++i) {
-    /* OME: We could precalculate the scaling coefficients if we
-     * really wanted to.
-     */
-    data->x[i] = pow(data->alpha, 0.5 * (double) (long) i / ((double) (long) problem->number_of_variables - 1.0))
-        * x[i];
+    inner_x[i] = data->coefficients[i] * x[i];
   }
-  coco_evaluate_function(inner_problem, data->x, y);
+  coco_evaluate_function(inner_problem, inner_x, y);
+  coco_problem_scratch_free(problem, inner_x, inner_problem->number_of_variables);
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the transformation in a batch of points.
+ */
+static void transform_vars_conditioning_evaluate_batch(coco_problem_t *problem,
+                                                       const size_t number_of_points,
+                                                       const double *x,
+                                                       double *y) {
+  size_t i, k;
+  double *batch_x;
+  transform_vars_conditioning_data_t *data;
+  coco_problem_t *inner_problem;
+  const size_t n = problem->number_of_variables;
+
+  data = (transform_vars_conditioning_data_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  batch_x = coco_problem_scratch_allocate(problem, number_of_points * n);
+  for (i = 0; i < n; ++i) {
+    const double factor = data->coefficients[i];
+    for (k = 0; k < number_of_points; ++k) {
+      batch_x[k * n + i] = factor * x[k * n + i];
+    }
+  }
+  coco_evaluate_function_batch(inner_problem, number_of_points, batch_x, y);
+  coco_problem_scratch_free(problem, batch_x, number_of_points * n);
+
+  for (k = 0; k < number_of_points; ++k)
+    assert(y[k * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Evaluates the gradient of the transformed function.
  */
@@ -51,7 +88,7 @@ static void transform_vars_conditioning_evaluate_gradient(coco_problem_t *proble
   size_t i;
   transform_vars_conditioning_data_t *data;
   coco_problem_t *inner_problem;
-  double *gradient;
+  double *gradient, *inner_x;
 
   if (coco_vector_contains_nan(x, coco_problem_get_dimension(problem))) {
   	coco_vector_set_to_nan(y, coco_problem_get_number_of_objectives(problem));
@@ -61,13 +98,15 @@ static void transform_vars_conditioning_evaluate_gradient(coco_problem_t *proble
   data = (transform_vars_conditioning_data_t *) coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
-  gradient = coco_allocate_vector(inner_problem->number_of_variables);
+  gradient = coco_problem_scratch_allocate(problem, inner_problem->number_of_variables);
   
+  inner_x = coco_problem_scratch_allocate(problem, inner_problem->number_of_variables);
   for (i = 0; i < problem->number_of_variables; ++i) {
-    gradient[i] = pow(data->alpha, 0.5 * (double) (long) i / ((double) (long) problem->number_of_variables - 1.0));
-    data->x[i] = gradient[i] * x[i];
+    gradient[i] = data->coefficients[i];
+    inner_x[i] = gradient[i] * x[i];
   }
-  bbob_evaluate_gradient(inner_problem, data->x, y);
+  bbob_evaluate_gradient(inner_problem, inner_x, y);
+  coco_problem_scratch_free(problem, inner_x, inner_problem->number_of_variables);
   
   for (i = 0; i < inner_problem->number_of_variables; ++i)
     gradient[i] *= y[i];
@@ -75,12 +114,7 @@ static void transform_vars_conditioning_evaluate_gradient(coco_problem_t *proble
   for (i = 0; i < inner_problem->number_of_variables; ++i)
     y[i] = gradient[i];
     
-  coco_free_memory(gradient);
-}
-
-static void transform_vars_conditioning_free(void *thing) {
-  transform_vars_conditioning_data_t *data = (transform_vars_conditioning_data_t *) thing;
-  coco_free_memory(data->x);
+  coco_problem_scratch_free(problem, gradient, inner_problem->number_of_variables);
 }
 
 /**
@@ -91,10 +125,12 @@ static coco_problem_t *transform_vars_conditioning(coco_problem_t *inner_problem
   coco_problem_t *problem;
 
   data = (transform_vars_conditioning_data_t *) coco_allocate_memory(sizeof(*data));
-  data->x = coco_allocate_vector(inner_problem->number_of_variables);
   data->alpha = alpha;
-  problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_conditioning_free, "transform_vars_conditioning");
+  data->coefficients = coco_allocate_conditioning_coefficients(alpha, 0.5, inner_problem->number_of_variables);
+  problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_conditioning_free,
+      "transform_vars_conditioning");
   problem->evaluate_function = transform_vars_conditioning_evaluate;
+  problem->evaluate_function_batch = transform_vars_conditioning_evaluate_batch;
   problem->evaluate_gradient = transform_vars_conditioning_evaluate_gradient;
 
   if (coco_problem_best_parameter_not_zero(inner_problem)) {
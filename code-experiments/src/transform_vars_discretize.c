@@ -50,7 +50,9 @@ static void transform_vars_discretize_evaluate_function(coco_problem_t *problem,
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
   /* Transform x to fit in the discretized space */
-  discretized_x = coco_duplicate_vector(x, problem->number_of_variables);
+  discretized_x = coco_problem_scratch_allocate(problem, problem->number_of_variables);
+  for (i = 0; i < problem->number_of_variables; ++i)
+    discretized_x[i] = x[i];
   for (i = 0; i < problem->number_of_integer_variables; ++i) {
     outer_l = problem->smallest_values_of_interest[i];
     outer_u = problem->largest_values_of_interest[i];
@@ -70,7 +72,7 @@ static void transform_vars_discretize_evaluate_function(coco_problem_t *problem,
   }
 
   coco_evaluate_function(inner_problem, discretized_x, y);
-  coco_free_memory(discretized_x);
+  coco_problem_scratch_free(problem, discretized_x, problem->number_of_variables);
 }
 
 /**
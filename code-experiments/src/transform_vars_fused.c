@@ -0,0 +1,423 @@
+/**
+ * @file transform_vars_fused.c
+ * @brief Implementation of fusing adjacent linear transformations of decision values into a single
+ * affine transformation.
+ *
+ * A problem is constructed as an onion of transformations, where each layer has its own scratch vector and
+ * its own call to coco_evaluate_function. When a problem is "compiled", the chain of transformations is
+ * walked once and every run of adjacent linear transformations (shift, affine, scale, conditioning,
+ * permutation, block-rotation and permuted block-rotation) that contains at least one dense affine
+ * transformation is replaced by a single affine transformation x |-> M(x - c) + b - d. Runs without a dense
+ * affine transformation are left as they are, since a dense matrix would be more expensive to apply than
+ * the original sparse layers.
+ *
+ * The offsets c and d collect the shifts at the start and at the end of the run, so that the usual
+ * combinations of a shift and a rotation are computed with exactly the same operations as before. Other
+ * runs return the same values as the original problem up to rounding errors.
+ */
+
+#include <assert.h>
+
+#include "coco.h"
+#include "coco_problem.c"
+#include "transform_vars_affine.c"
+#include "transform_vars_shift.c"
+#include "transform_vars_scale.c"
+#include "transform_vars_conditioning.c"
+#include "transform_vars_permutation.c"
+#include "transform_vars_blockrotation.c"
+#include "transform_vars_permblockdiag.c"
+
+/**
+ * @brief Data type for transform_vars_fused.
+ */
+typedef struct {
+  double *M, *b, *c, *d;
+} transform_vars_fused_data_t;
+
+/**
+ * @brief Computes y = M(x - c) + b - d.
+ *
+ * The difference x - c is computed once into shifted_x (a vector of the given size provided by the caller)
+ * before the rows of M are applied to it.
+ */
+static void transform_vars_fused_apply_affine(const transform_vars_fused_data_t *data,
+                                              const size_t number_of_variables,
+                                              const double *x,
+                                              double *shifted_x,
+                                              double *y) {
+  size_t i, j;
+
+  for (j = 0; j < number_of_variables; ++j)
+    shifted_x[j] = x[j] - data->c[j];
+  for (i = 0; i < number_of_variables; ++i) {
+    const double *current_row = data->M + i * number_of_variables;
+    y[i] = data->b[i];
+    for (j = 0; j < number_of_variables; ++j) {
+      y[i] += shifted_x[j] * current_row[j];
+    }
+    y[i] -= data->d[i];
+  }
+}
+
+/**
+ * @brief Evaluates the transformed objective function.
+ */
+static void transform_vars_fused_evaluate_function(coco_problem_t *problem, const double *x, double *y) {
+  transform_vars_fused_data_t *data;
+  coco_problem_t *inner_problem;
+  double *inner_x;
+
+  data = (transform_vars_fused_data_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  /* The second half of the vector holds x - c */
+  inner_x = coco_problem_scratch_allocate(problem, 2 * problem->number_of_variables);
+  transform_vars_fused_apply_affine(data, problem->number_of_variables, x, inner_x + problem->number_of_variables,
+      inner_x);
+  coco_evaluate_function(inner_problem, inner_x, y);
+  coco_problem_scratch_free(problem, inner_x, 2 * problem->number_of_variables);
+  coco_problem_batch_assert_best_value(problem, 1, x, y);
+}
+
+/**
+ * @brief Evaluates the transformed objective function in a batch of points.
+ */
+static void transform_vars_fused_evaluate_function_batch(coco_problem_t *problem,
+                                                         const size_t number_of_points,
+                                                         const double *x,
+                                                         double *y) {
+  transform_vars_fused_data_t *data;
+  coco_problem_t *inner_problem;
+  const size_t n = problem->number_of_variables;
+  double *batch_x;
+  size_t k;
+
+  data = (transform_vars_fused_data_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  /* The vector after the transformed points holds x - c */
+  batch_x = coco_problem_scratch_allocate(problem, (number_of_points + 1) * n);
+  for (k = 0; k < number_of_points; ++k)
+    transform_vars_fused_apply_affine(data, n, x + k * n, batch_x + number_of_points * n, batch_x + k * n);
+  coco_evaluate_function_batch(inner_problem, number_of_points, batch_x, y);
+  coco_problem_scratch_free(problem, batch_x, (number_of_points + 1) * n);
+
+  coco_problem_batch_assert_best_value(problem, number_of_points, x, y);
+}
+
+/**
+ * @brief Evaluates the transformed constraint function.
+ */
+static void transform_vars_fused_evaluate_constraint(coco_problem_t *problem, const double *x, double *y) {
+  transform_vars_fused_data_t *data;
+  coco_problem_t *inner_problem;
+  double *inner_x;
+
+  data = (transform_vars_fused_data_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  /* The second half of the vector holds x - c */
+  inner_x = coco_problem_scratch_allocate(problem, 2 * problem->number_of_variables);
+  transform_vars_fused_apply_affine(data, problem->number_of_variables, x, inner_x + problem->number_of_variables,
+      inner_x);
+  coco_evaluate_constraint(inner_problem, inner_x, y);
+  coco_problem_scratch_free(problem, inner_x, 2 * problem->number_of_variables);
+}
+
+/**
+ * @brief Evaluates the gradient of the transformed function, which equals M^T * grad_f(M(x - c) + b - d).
+ */
+static void transform_vars_fused_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
+  transform_vars_fused_data_t *data;
+  coco_problem_t *inner_problem;
+  const size_t n = problem->number_of_variables;
+  double *gradient, *inner_x;
+  size_t i, j;
+
+  data = (transform_vars_fused_data_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  gradient = coco_problem_scratch_allocate(problem, n);
+  inner_x = coco_problem_scratch_allocate(problem, 2 * n);
+  transform_vars_fused_apply_affine(data, n, x, inner_x + n, inner_x);
+  bbob_evaluate_gradient(inner_problem, inner_x, gradient);
+  coco_problem_scratch_free(problem, inner_x, 2 * n);
+  for (j = 0; j < n; ++j) {
+    y[j] = 0.0;
+    for (i = 0; i < n; ++i)
+      y[j] += gradient[i] * data->M[i * n + j];
+  }
+  coco_problem_scratch_free(problem, gradient, n);
+}
+
+/**
+ * @brief Frees the data object.
+ */
+static void transform_vars_fused_free(void *thing) {
+  transform_vars_fused_data_t *data = (transform_vars_fused_data_t *) thing;
+  coco_free_memory(data->M);
+  coco_free_memory(data->b);
+  coco_free_memory(data->c);
+  coco_free_memory(data->d);
+}
+
+/**
+ * @brief Returns 1 if the problem is a transformed problem and 0 otherwise.
+ */
+static int transform_vars_fused_is_transformed(const coco_problem_t *problem) {
+  return (problem->problem_free_function == coco_problem_transformed_free);
+}
+
+/**
+ * @brief Returns 1 if the problem is a linear transformation of decision values that can be fused and 0
+ * otherwise.
+ */
+static int transform_vars_fused_is_linear(const coco_problem_t *problem) {
+  const coco_evaluate_function_t evaluate_function = problem->evaluate_function;
+
+  if (!transform_vars_fused_is_transformed(problem))
+    return 0;
+  if (coco_problem_transformed_get_inner_problem(problem)->number_of_variables != problem->number_of_variables)
+    return 0;
+  return ((evaluate_function == transform_vars_shift_evaluate_function)
+      || (evaluate_function == transform_vars_affine_evaluate_function)
+      || (evaluate_function == transform_vars_scale_evaluate)
+      || (evaluate_function == transform_vars_conditioning_evaluate)
+      || (evaluate_function == transform_vars_inverse_permutation_evaluate)
+      || (evaluate_function == transform_vars_blockrotation_evaluate)
+      || (evaluate_function == transform_vars_permblockdiag_evaluate));
+}
+
+/**
+ * @brief Applies the linear transformation of the given problem to x and saves the result in y.
+ *
+ * If with_offset is 0, only the linear part of the transformation is applied (the offsets of the shift
+ * and affine transformations are ignored).
+ */
+static void transform_vars_fused_apply(coco_problem_t *problem, const double *x, double *y, const int with_offset) {
+  const coco_evaluate_function_t evaluate_function = problem->evaluate_function;
+  const size_t n = problem->number_of_variables;
+  size_t i, j;
+
+  if (evaluate_function == transform_vars_shift_evaluate_function) {
+    transform_vars_shift_data_t *data = (transform_vars_shift_data_t *) coco_problem_transformed_get_data(problem);
+    for (i = 0; i < n; ++i)
+      y[i] = with_offset ? x[i] - data->offset[i] : x[i];
+  } else if (evaluate_function == transform_vars_affine_evaluate_function) {
+    transform_vars_affine_data_t *data = (transform_vars_affine_data_t *) coco_problem_transformed_get_data(problem);
+    for (i = 0; i < n; ++i) {
+      const double *current_row = data->M + i * n;
+      y[i] = with_offset ? data->b[i] : 0.0;
+      for (j = 0; j < n; ++j) {
+        y[i] += x[j] * current_row[j];
+      }
+    }
+  } else if (evaluate_function == transform_vars_scale_evaluate) {
+    transform_vars_scale_data_t *data = (transform_vars_scale_data_t *) coco_problem_transformed_get_data(problem);
+    for (i = 0; i < n; ++i)
+      y[i] = data->factor * x[i];
+  } else if (evaluate_function == transform_vars_conditioning_evaluate) {
+    transform_vars_conditioning_data_t *data = (transform_vars_conditioning_data_t *) coco_problem_transformed_get_data(problem);
+    for (i = 0; i < n; ++i)
+      y[i] = data->coefficients[i] * x[i];
+  } else if (evaluate_function == transform_vars_inverse_permutation_evaluate) {
+    transform_vars_permutation_t *data = (transform_vars_permutation_t *) coco_problem_transformed_get_data(problem);
+    for (i = 0; i < n; ++i)
+      y[data->P[i]] = x[i];
+  } else if (evaluate_function == transform_vars_blockrotation_evaluate) {
+    transform_vars_blockrotation_apply(problem, x, y);
+  } else if (evaluate_function == transform_vars_permblockdiag_evaluate) {
+    transform_vars_permblockdiag_t *data = (transform_vars_permblockdiag_t *) coco_problem_transformed_get_data(problem);
+    double *z = coco_allocate_vector(n);
+    transform_vars_permblockdiag_apply(data, x, z, y);
+    coco_free_memory(z);
+  } else {
+    coco_error("transform_vars_fused_apply(): transformation of problem %s cannot be fused", problem->problem_id);
+  }
+}
+
+/**
+ * @brief Replaces the run of linear transformations from first (the outermost) to last (the innermost)
+ * with a single transformation x |-> M(x - c) + b - d and returns it.
+ *
+ * The returned problem takes over all the properties of first, while the layers of the run are freed
+ * without freeing the inner problem of last.
+ */
+static coco_problem_t *transform_vars_fused_replace_run(coco_problem_t *first, coco_problem_t *last) {
+  coco_problem_t *problem, *layer, *rest, *rest_last, *inner_problem;
+  transform_vars_fused_data_t *data;
+  const size_t n = first->number_of_variables;
+  double *v, *w, *tmp;
+  size_t i, j;
+
+  inner_problem = coco_problem_transformed_get_inner_problem(last);
+
+  data = (transform_vars_fused_data_t *) coco_allocate_memory(sizeof(*data));
+  data->M = coco_allocate_vector(n * n);
+  data->b = coco_allocate_vector(n);
+  data->c = coco_allocate_vector(n);
+  data->d = coco_allocate_vector(n);
+  v = coco_allocate_vector(n);
+  w = coco_allocate_vector(n);
+
+  /* c is the sum of the offsets of the shifts at the start of the run */
+  for (i = 0; i < n; ++i)
+    data->c[i] = 0.0;
+  rest = first;
+  while (rest->evaluate_function == transform_vars_shift_evaluate_function) {
+    transform_vars_shift_data_t *shift_data = (transform_vars_shift_data_t *) coco_problem_transformed_get_data(rest);
+    for (i = 0; i < n; ++i)
+      data->c[i] += shift_data->offset[i];
+    rest = coco_problem_transformed_get_inner_problem(rest);
+  }
+  assert(rest != inner_problem);
+
+  /* d is the sum of the offsets of the shifts at the end of the run (following rest_last) */
+  rest_last = rest;
+  for (layer = rest; layer != inner_problem; layer = coco_problem_transformed_get_inner_problem(layer)) {
+    if (layer->evaluate_function != transform_vars_shift_evaluate_function)
+      rest_last = layer;
+  }
+  for (i = 0; i < n; ++i)
+    data->d[i] = 0.0;
+  for (layer = coco_problem_transformed_get_inner_problem(rest_last); layer != inner_problem;
+      layer = coco_problem_transformed_get_inner_problem(layer)) {
+    transform_vars_shift_data_t *shift_data = (transform_vars_shift_data_t *) coco_problem_transformed_get_data(layer);
+    for (i = 0; i < n; ++i)
+      data->d[i] += shift_data->offset[i];
+  }
+
+  /* b is the image of the zero vector under the layers from rest to rest_last */
+  for (i = 0; i < n; ++i)
+    v[i] = 0.0;
+  layer = rest;
+  while (1) {
+    transform_vars_fused_apply(layer, v, w, 1);
+    tmp = v; v = w; w = tmp;
+    if (layer == rest_last)
+      break;
+    layer = coco_problem_transformed_get_inner_problem(layer);
+  }
+  for (i = 0; i < n; ++i)
+    data->b[i] = v[i];
+
+  /* The j-th column of M is the image of the j-th unit vector under the linear parts of the same layers */
+  for (j = 0; j < n; ++j) {
+    for (i = 0; i < n; ++i)
+      v[i] = (i == j) ? 1.0 : 0.0;
+    layer = rest;
+    while (1) {
+      transform_vars_fused_apply(layer, v, w, 0);
+      tmp = v; v = w; w = tmp;
+      if (layer == rest_last)
+        break;
+      layer = coco_problem_transformed_get_inner_problem(layer);
+    }
+    for (i = 0; i < n; ++i)
+      data->M[i * n + j] = v[i];
+  }
+  coco_free_memory(v);
+  coco_free_memory(w);
+
+  problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_fused_free, "transform_vars_fused");
+  if (inner_problem->number_of_objectives > 0) {
+    problem->evaluate_function = transform_vars_fused_evaluate_function;
+    problem->evaluate_function_batch = transform_vars_fused_evaluate_function_batch;
+  }
+  if (inner_problem->number_of_constraints > 0)
+    problem->evaluate_constraint = transform_vars_fused_evaluate_constraint;
+  problem->evaluate_gradient = transform_vars_fused_evaluate_gradient;
+
+  /* Take over the properties of the outermost layer */
+  for (i = 0; i < n; ++i) {
+    problem->smallest_values_of_interest[i] = first->smallest_values_of_interest[i];
+    problem->largest_values_of_interest[i] = first->largest_values_of_interest[i];
+    if (first->best_parameter)
+      problem->best_parameter[i] = first->best_parameter[i];
+  }
+  if (problem->initial_solution) {
+    coco_free_memory(problem->initial_solution);
+    problem->initial_solution = NULL;
+  }
+  if (first->initial_solution)
+    problem->initial_solution = coco_duplicate_vector(first->initial_solution, n);
+  for (i = 0; i < problem->number_of_objectives; ++i) {
+    problem->best_value[i] = first->best_value[i];
+    if (first->nadir_value)
+      problem->nadir_value[i] = first->nadir_value[i];
+  }
+  coco_free_memory(problem->problem_name);
+  coco_free_memory(problem->problem_id);
+  coco_free_memory(problem->problem_type);
+  problem->problem_name = coco_strdup(first->problem_name);
+  problem->problem_id = coco_strdup(first->problem_id);
+  problem->problem_type = coco_strdup(first->problem_type);
+  problem->evaluations = first->evaluations;
+  problem->evaluations_constraints = first->evaluations_constraints;
+  problem->final_target_delta[0] = first->final_target_delta[0];
+  problem->best_observed_fvalue[0] = first->best_observed_fvalue[0];
+  problem->best_observed_evaluation[0] = first->best_observed_evaluation[0];
+  problem->suite = first->suite;
+  problem->suite_dep_index = first->suite_dep_index;
+  problem->suite_dep_function = first->suite_dep_function;
+  problem->suite_dep_instance = first->suite_dep_instance;
+
+  /* Free the layers of the run, but not the inner problem */
+  layer = first;
+  while (1) {
+    coco_problem_t *next = coco_problem_transformed_get_inner_problem(layer);
+    const int is_last = (layer == last);
+    coco_problem_transformed_free_data(layer);
+    if (is_last)
+      break;
+    layer = next;
+  }
+
+  return problem;
+}
+
+/**
+ * @brief Fuses the runs of adjacent linear transformations of the given problem and returns the resulting
+ * problem, which replaces the given one (the given problem must not be used afterwards).
+ *
+ * Stacked problems are fused by fusing each of the underlying problems.
+ */
+static coco_problem_t *transform_vars_fused(coco_problem_t *problem) {
+  coco_problem_t *outer_problem = problem;
+  coco_problem_t *parent = NULL, *current, *last;
+  int has_affine;
+  size_t run_length;
+
+  current = problem;
+  while (transform_vars_fused_is_transformed(current)) {
+    if (transform_vars_fused_is_linear(current)) {
+      /* Find the run of linear transformations starting with current */
+      last = current;
+      run_length = 1;
+      has_affine = (current->evaluate_function == transform_vars_affine_evaluate_function);
+      while (transform_vars_fused_is_linear(coco_problem_transformed_get_inner_problem(last))) {
+        last = coco_problem_transformed_get_inner_problem(last);
+        run_length++;
+        has_affine = has_affine || (last->evaluate_function == transform_vars_affine_evaluate_function);
+      }
+      if ((run_length > 1) && has_affine) {
+        current = transform_vars_fused_replace_run(current, last);
+        if (parent == NULL)
+          outer_problem = current;
+        else
+          ((coco_problem_transformed_data_t *) parent->data)->inner_problem = current;
+      }
+    }
+    parent = current;
+    current = coco_problem_transformed_get_inner_problem(current);
+  }
+
+  if (current->problem_free_function == coco_problem_stacked_free) {
+    coco_problem_stacked_data_t *data = (coco_problem_stacked_data_t *) current->data;
+    data->problem1 = transform_vars_fused(data->problem1);
+    data->problem2 = transform_vars_fused(data->problem2);
+  }
+
+  return outer_problem;
+}
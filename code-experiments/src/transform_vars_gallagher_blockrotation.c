@@ -13,21 +13,6 @@
 /* #include "coco_utilities.c" */
 
 
-/**
- * @brief Data type for transform_vars_gallagher_blockrotation.
- */
-typedef struct {
-  double *x;
-} transform_vars_gallagher_blockrotation_t;
-
-/**
- * @brief Frees the data object.
- */
-static void transform_vars_gallagher_blockrotation_free(void *thing) {
-  transform_vars_gallagher_blockrotation_t *data = (transform_vars_gallagher_blockrotation_t *) thing;
-  coco_free_memory(data->x);
-}
-
 /**
  * @brief Data type in problem->versatile_data of f_gallagher.c
  */
@@ -79,11 +64,9 @@ static void f_gallagher_versatile_data_free(coco_problem_t *problem) {
  */
 static void transform_vars_gallagher_blockrotation_evaluate(coco_problem_t *problem, const double *x, double *y) {
   size_t i, j;
-  transform_vars_gallagher_blockrotation_t *data;
   coco_problem_t *inner_problem;
   f_gallagher_versatile_data_t *versatile_data;
 
-  data = (transform_vars_gallagher_blockrotation_t *) coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
   versatile_data = (f_gallagher_versatile_data_t *) problem->versatile_data;
   
@@ -93,10 +76,9 @@ static void transform_vars_gallagher_blockrotation_evaluate(coco_problem_t *prob
       versatile_data->rotated_x[i] += versatile_data->B[i][j - versatile_data->first_non_zero_map[i]] * x[j];
     }
     /*((f_gallagher_versatile_data_t *) problem->versatile_data)->rotated_x[i] = x[i];*/
-    data->x[i] = x[i];/* to avoid pointer problems*/
   }
 
-  coco_evaluate_function(inner_problem, data->x, y);/* does not modify the argument of the call since rotated_x will be used later in the sub_problems*/
+  coco_evaluate_function(inner_problem, x, y);/* does not modify the argument of the call since rotated_x will be used later in the sub_problems*/
   /* this function serves only to compute rotated_x on the problem level, not for each sub-problem
    */
   assert(y[0] + 1e-13 >= problem->best_value[0]);
@@ -105,16 +87,12 @@ static void transform_vars_gallagher_blockrotation_evaluate(coco_problem_t *prob
 
 static coco_problem_t *transform_vars_gallagher_blockrotation(coco_problem_t *inner_problem) {
   coco_problem_t *problem;
-  transform_vars_gallagher_blockrotation_t *data;
-
-  data = (transform_vars_gallagher_blockrotation_t *) coco_allocate_memory(sizeof(*data));
-  data->x = coco_allocate_vector(inner_problem->number_of_variables);
 
   if (coco_problem_best_parameter_not_zero(inner_problem)) {
     coco_debug("transform_vars_gallagher_blockrotation(): 'best_parameter' not updated, set to NAN");
     coco_vector_set_to_nan(inner_problem->best_parameter, inner_problem->number_of_variables);
   }
-  problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_gallagher_blockrotation_free, "transform_vars_gallagher_blockrotation");
+  problem = coco_problem_transformed_allocate(inner_problem, NULL, NULL, "transform_vars_gallagher_blockrotation");
   problem->evaluate_function = transform_vars_gallagher_blockrotation_evaluate;
   return problem;
 }
@@ -9,13 +9,6 @@
 #include "coco.h"
 #include "coco_problem.c"
 
-/**
- * @brief Data type for transform_vars_oscillate.
- */
-typedef struct {
-  double *oscillated_x;
-} transform_vars_oscillate_data_t;
-
 /**
  * @brief Evaluates the transformed objective functions.
  */
@@ -24,7 +17,6 @@ static void transform_vars_oscillate_evaluate_function(coco_problem_t *problem,
   double tmp, base, *oscillated_x, *cons_values;
   int is_feasible;
   size_t i;
-  transform_vars_oscillate_data_t *data;
   coco_problem_t *inner_problem;
   
   if (coco_vector_contains_nan(x, coco_problem_get_dimension(problem))) {
@@ -32,9 +24,8 @@ static void transform_vars_oscillate_evaluate_function(coco_problem_t *problem,
   	return;
   }
 
-  data = (transform_vars_oscillate_data_t *) coco_problem_transformed_get_data(problem);
-  oscillated_x = data->oscillated_x; /* short cut to make code more readable */
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  oscillated_x = coco_problem_scratch_allocate(problem, problem->number_of_variables);
 
   for (i = 0; i < problem->number_of_variables; ++i) {
     if (x[i] > 0.0) {
@@ -50,17 +41,57 @@ static void transform_vars_oscillate_evaluate_function(coco_problem_t *problem,
     }
   }
   coco_evaluate_function(inner_problem, oscillated_x, y);
+  coco_problem_scratch_free(problem, oscillated_x, problem->number_of_variables);
   
   if (problem->number_of_constraints > 0) {
-    cons_values = coco_allocate_vector(problem->number_of_constraints);
+    cons_values = coco_problem_scratch_allocate(problem, problem->number_of_constraints);
     is_feasible = coco_is_feasible(problem, x, cons_values);
-    coco_free_memory(cons_values);    
+    coco_problem_scratch_free(problem, cons_values, problem->number_of_constraints);
     if (is_feasible)
       assert(y[0] + 1e-13 >= problem->best_value[0]);
   }
   else assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the transformed objective function in a batch of points.
+ */
+static void transform_vars_oscillate_evaluate_function_batch(coco_problem_t *problem,
+                                                             const size_t number_of_points,
+                                                             const double *x,
+                                                             double *y) {
+  static const double alpha = 0.1;
+  double tmp, base, *oscillated_x;
+  size_t i, k;
+  coco_problem_t *inner_problem;
+  const size_t n = problem->number_of_variables;
+
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  oscillated_x = coco_problem_scratch_allocate(problem, number_of_points * n);
+  for (k = 0; k < number_of_points; ++k) {
+    for (i = 0; i < n; ++i) {
+      const double xi = x[k * n + i];
+      if (xi > 0.0) {
+        tmp = log(xi) / alpha;
+        base = exp(tmp + 0.49 * (sin(tmp) + sin(0.79 * tmp)));
+        oscillated_x[k * n + i] = pow(base, alpha);
+      } else if (xi < 0.0) {
+        tmp = log(-xi) / alpha;
+        base = exp(tmp + 0.49 * (sin(0.55 * tmp) + sin(0.31 * tmp)));
+        oscillated_x[k * n + i] = -pow(base, alpha);
+      } else {
+        oscillated_x[k * n + i] = 0.0;
+      }
+    }
+  }
+
+  coco_evaluate_function_batch(inner_problem, number_of_points, oscillated_x, y);
+  coco_problem_scratch_free(problem, oscillated_x, number_of_points * n);
+
+  coco_problem_batch_assert_best_value(problem, number_of_points, x, y);
+}
+
 /**
  * @brief Evaluates the transformed constraints.
  */
@@ -68,7 +99,6 @@ static void transform_vars_oscillate_evaluate_constraint(coco_problem_t *problem
   static const double alpha = 0.1;
   double tmp, base, *oscillated_x;
   size_t i;
-  transform_vars_oscillate_data_t *data;
   coco_problem_t *inner_problem;
   
   if (coco_vector_contains_nan(x, coco_problem_get_dimension(problem))) {
@@ -76,9 +106,8 @@ static void transform_vars_oscillate_evaluate_constraint(coco_problem_t *problem
   	return;
   }
 
-  data = (transform_vars_oscillate_data_t *) coco_problem_transformed_get_data(problem);
-  oscillated_x = data->oscillated_x; /* short cut to make code more readable */
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
+  oscillated_x = coco_problem_scratch_allocate(problem, problem->number_of_variables);
 
   for (i = 0; i < problem->number_of_variables; ++i) {
     if (x[i] > 0.0) {
@@ -94,14 +123,7 @@ static void transform_vars_oscillate_evaluate_constraint(coco_problem_t *problem
     }
   }
   coco_evaluate_constraint(inner_problem, oscillated_x, y);
-}
-
-/**
- * @brief Frees the data object.
- */
-static void transform_vars_oscillate_free(void *thing) {
-  transform_vars_oscillate_data_t *data = (transform_vars_oscillate_data_t *) thing;
-  coco_free_memory(data->oscillated_x);
+  coco_problem_scratch_free(problem, oscillated_x, problem->number_of_variables);
 }
 
 /**
@@ -112,16 +134,14 @@ static coco_problem_t *transform_vars_oscillate(coco_problem_t *inner_problem) {
   size_t i;
   int is_feasible;
   double alpha, *cons_values;
-  transform_vars_oscillate_data_t *data;
   coco_problem_t *problem;
-  data = (transform_vars_oscillate_data_t *) coco_allocate_memory(sizeof(*data));
-  data->oscillated_x = coco_allocate_vector(inner_problem->number_of_variables);
 
-  problem = coco_problem_transformed_allocate(inner_problem, data, 
-    transform_vars_oscillate_free, "transform_vars_oscillate");
+  problem = coco_problem_transformed_allocate(inner_problem, NULL, NULL, "transform_vars_oscillate");
     
-  if (inner_problem->number_of_objectives > 0)
+  if (inner_problem->number_of_objectives > 0) {
     problem->evaluate_function = transform_vars_oscillate_evaluate_function;
+    problem->evaluate_function_batch = transform_vars_oscillate_evaluate_function_batch;
+  }
     
   if (inner_problem->number_of_constraints > 0) {
     problem->evaluate_constraint = transform_vars_oscillate_evaluate_constraint;
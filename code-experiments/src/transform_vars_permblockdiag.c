@@ -1,5 +1,15 @@
 /**
  * @file transform_vars_permblockdiag.c
+ * @brief Implementation of performing a permuted block-rotation transformation on decision values.
+ *
+ * x |-> P2 B P1 x
+ * where P1 and P2 are permutations and B is a block-diagonal matrix. Instead of permuting the decision
+ * vector in separate transformations before and after transform_vars_blockrotation, the permutations are
+ * fused into the product with B: the entries of x are gathered according to P1 before the product and the
+ * entries of the result are scattered according to the inverse of P2 when they are stored. This saves two
+ * passes over the decision vector and two levels of transformed problems in each evaluation.
+ *
+ * The blocks of B are stored contiguously (see coco_copy_block_matrix_contiguous).
  */
 
 #include <assert.h>
@@ -9,62 +19,115 @@
 #include "transform_vars_permutation_helpers.c"
 #include "transform_vars_blockrotation_helpers.c"
 
-
 /**
  * @brief Data type for transform_vars_permblockdiag.
  */
 typedef struct {
-  double **B;
-  double *x;
-  size_t *P1; /*permutation matrices, P1 for the columns of B and P2 for its rows*/
-  size_t *P2;
-  size_t *block_sizes;
-  size_t nb_blocks;
-  size_t *block_size_map; /* maps rows to blocksizes, keep until better way is found */
-  size_t *first_non_zero_map; /* maps a row to the index of its first non zero element */
+  double *B;            /**< @brief the blocks of the block-diagonal matrix */
+  size_t *P1;           /**< @brief the permutation applied to x before the product with B */
+  size_t *P2_inverse;   /**< @brief the inverse of the permutation applied to the product with B */
+  size_t dimension;
+  size_t *block_sizes;  /**< @brief the list of block-sizes*/
+  size_t nb_blocks;     /**< @brief the number of blocks in the matrix */
 } transform_vars_permblockdiag_t;
 
+/**
+ * @brief Computes y = P2 B P1 x, where x and y must not overlap.
+ *
+ * z is a vector of the size of x used to store P1 x.
+ */
+static void transform_vars_permblockdiag_apply(const transform_vars_permblockdiag_t *data,
+                                               const double *x,
+                                               double *z,
+                                               double *y) {
+  size_t i;
+
+  for (i = 0; i < data->dimension; ++i) {
+    z[i] = x[data->P1[i]];
+  }
+  coco_block_matrix_apply(data->B, data->block_sizes, data->nb_blocks, data->P2_inverse, z, y);
+}
+
 static void transform_vars_permblockdiag_evaluate(coco_problem_t *problem, const double *x, double *y) {
-  size_t i, j, current_blocksize, first_non_zero_ind;
   transform_vars_permblockdiag_t *data;
   coco_problem_t *inner_problem;
-  
-  if (coco_vector_contains_nan(x, coco_problem_get_dimension(problem))) {
-  	coco_vector_set_to_nan(y, coco_problem_get_number_of_objectives(problem));
-  	return;
-  }
+  double *inner_x, *z;
 
   data = (transform_vars_permblockdiag_t *) coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
-  for (i = 0; i < inner_problem->number_of_variables; ++i) {
-    current_blocksize = data->block_size_map[data->P2[i]];  /* the block_size is that of the permuted line */
-    first_non_zero_ind = data->first_non_zero_map[data->P2[i]];
-    data->x[i] = 0;
-    /* compute data->x[i] = < B[P2[i]] , x[P1] > */
-    for (j = first_non_zero_ind; j < first_non_zero_ind + current_blocksize; ++j) {  /* blocksize[P2[i]] */
-      data->x[i] += data->B[data->P2[i]][j - first_non_zero_ind] * x[data->P1[j]];   /* all B lines start at 0 */
-    }
-  }
 
-  coco_evaluate_function(inner_problem, data->x, y);
+  inner_x = coco_problem_scratch_allocate(problem, 2 * data->dimension);
+  z = inner_x + data->dimension;
+  transform_vars_permblockdiag_apply(data, x, z, inner_x);
+
+  coco_evaluate_function(inner_problem, inner_x, y);
+  coco_problem_scratch_free(problem, inner_x, 2 * data->dimension);
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the transformation in a batch of points.
+ */
+static void transform_vars_permblockdiag_evaluate_batch(coco_problem_t *problem,
+                                                        const size_t number_of_points,
+                                                        const double *x,
+                                                        double *y) {
+  transform_vars_permblockdiag_t *data;
+  coco_problem_t *inner_problem;
+  const size_t n = problem->number_of_variables;
+  double *batch_x, *z;
+  size_t k;
+
+  data = (transform_vars_permblockdiag_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  batch_x = coco_problem_scratch_allocate(problem, (number_of_points + 1) * n);
+  z = batch_x + number_of_points * n;
+  for (k = 0; k < number_of_points; ++k)
+    transform_vars_permblockdiag_apply(data, x + k * n, z, batch_x + k * n);
+
+  coco_evaluate_function_batch(inner_problem, number_of_points, batch_x, y);
+  coco_problem_scratch_free(problem, batch_x, (number_of_points + 1) * n);
+
+  for (k = 0; k < number_of_points; ++k)
+    assert(y[k * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
+}
+
 static void transform_vars_permblockdiag_free(void *thing) {
   transform_vars_permblockdiag_t *data = (transform_vars_permblockdiag_t *) thing;
   coco_free_memory(data->B);
   coco_free_memory(data->P1);
-  coco_free_memory(data->P2);
+  coco_free_memory(data->P2_inverse);
   coco_free_memory(data->block_sizes);
-  coco_free_memory(data->x);
-  coco_free_memory(data->block_size_map);
 }
 
 /*
- * Apply a double permuted orthogonal block-diagonal transfromation matrix to the search space
- *
- *
- * The matrix M is stored in row-major format.
+ * @brief Tests the orthogonality of the blocks of B and raises coco_error in case
+ */
+static void transform_vars_permblockdiag_test(const transform_vars_permblockdiag_t *data, double precision) {
+  const double *current_block = data->B;
+  size_t i, j, k, idx_block, current_blocksize;
+  double product;
+
+  for (idx_block = 0; idx_block < data->nb_blocks; idx_block++) {
+    current_blocksize = data->block_sizes[idx_block];
+    for (i = 0; i < current_blocksize; ++i) {
+      for (j = 0; j < current_blocksize; ++j) {
+        product = 0;
+        for (k = 0; k < current_blocksize; ++k)
+          product += current_block[i * current_blocksize + k] * current_block[j * current_blocksize + k];
+        if (!coco_double_almost_equal(product, i == j, precision)) {
+          coco_error("transform_vars_permblockdiag_test() with precision %e failed on row %lu of block %lu",
+                     precision, (unsigned long) i, (unsigned long) idx_block);
+        }
+      }
+    }
+    current_block += current_blocksize * current_blocksize;
+  }
+}
+
+/**
+ * @brief Creates the transformation x |-> P2 B P1 x, where (P1 x)[i] = x[P1[i]] and (P2 y)[i] = y[P2[i]].
  */
 static coco_problem_t *transform_vars_permblockdiag(coco_problem_t *inner_problem,
                                                     const double * const *B,
@@ -75,38 +138,31 @@ static coco_problem_t *transform_vars_permblockdiag(coco_problem_t *inner_proble
                                                     const size_t nb_blocks) {
   coco_problem_t *problem;
   transform_vars_permblockdiag_t *data;
-  size_t entries_in_M, idx_blocksize, next_bs_change, current_blocksize;
-  int i;
-  entries_in_M = 0;
+  size_t i;
+
   assert(number_of_variables > 0);/*tmp*/
-  for (i = 0; i < nb_blocks; i++) {
-    entries_in_M += block_sizes[i] * block_sizes[i];
-  }
   data = (transform_vars_permblockdiag_t *) coco_allocate_memory(sizeof(*data));
-  data->B = ls_copy_block_matrix(B, number_of_variables, block_sizes, nb_blocks);
-  data->x = coco_allocate_vector(inner_problem->number_of_variables);
-  data->P1 = coco_duplicate_size_t_vector(P1, inner_problem->number_of_variables);
-  data->P2 = coco_duplicate_size_t_vector(P2, inner_problem->number_of_variables);
+  data->dimension = number_of_variables;
+  data->B = coco_copy_block_matrix_contiguous(B, block_sizes, nb_blocks);
+  data->P1 = coco_duplicate_size_t_vector(P1, number_of_variables);
+  data->P2_inverse = coco_allocate_vector_size_t(number_of_variables);
+  for (i = 0; i < number_of_variables; ++i) {
+    data->P2_inverse[P2[i]] = i;
+  }
   data->block_sizes = coco_duplicate_size_t_vector(block_sizes, nb_blocks);
   data->nb_blocks = nb_blocks;
-  data->block_size_map = coco_allocate_vector_size_t(number_of_variables);
-  data->first_non_zero_map = coco_allocate_vector_size_t(number_of_variables);
-  
-  idx_blocksize = 0;
-  next_bs_change = block_sizes[idx_blocksize];
-  for (i = 0; i < number_of_variables; i++) {
-    if (i >= next_bs_change) {
-      idx_blocksize++;
-      next_bs_change += block_sizes[idx_blocksize];
-    }
-    current_blocksize=block_sizes[idx_blocksize];
-    data->block_size_map[i] = current_blocksize;
-    data->first_non_zero_map[i] = next_bs_change - current_blocksize; /* next_bs_change serves also as a cumsum for blocksizes */
+  if (coco_problem_best_parameter_not_zero(inner_problem)) {
+    coco_debug("transform_vars_permblockdiag(): 'best_parameter' not updated, set to NAN");
+    coco_vector_set_to_nan(inner_problem->best_parameter, inner_problem->number_of_variables);
   }
-  
-  problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_permblockdiag_free, "transform_vars_permblockdiag");
+  problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_permblockdiag_free,
+      "transform_vars_permblockdiag");
   problem->evaluate_function = transform_vars_permblockdiag_evaluate;
+  problem->evaluate_function_batch = transform_vars_permblockdiag_evaluate_batch;
+
+  if (number_of_variables < 100) {
+    /* 1e-11 still passes and 1e-12 fails under macOS */
+    transform_vars_permblockdiag_test(data, 1e-5);
+  }
   return problem;
 }
-
-
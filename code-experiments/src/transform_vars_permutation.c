@@ -1,6 +1,8 @@
 /**
  * @file transform_vars_permutation.c
  * @brief Implementation of permuting the decision values.
+ *
+ * Permutations around a block-rotation are applied by transform_vars_permblockdiag.
  */
 
 #include <assert.h>
@@ -14,65 +16,62 @@
  * @brief Data type for transform_vars_permutation.
  */
 typedef struct {
-  double *x;
   size_t *P; /**< @brief the permutation matrices*/
 } transform_vars_permutation_t;
 
-static void transform_vars_permutation_evaluate(coco_problem_t *problem, const double *x, double *y) {
-  size_t i;
-  transform_vars_permutation_t *data;
-  coco_problem_t *inner_problem;
-
-  data = (transform_vars_permutation_t *) coco_problem_transformed_get_data(problem);
-  inner_problem = coco_problem_transformed_get_inner_problem(problem);
-  for (i = 0; i < inner_problem->number_of_variables; ++i) {
-    data->x[i] = x[data->P[i]];
-  }
-
-  coco_evaluate_function(inner_problem, data->x, y);
-  assert(y[0] + 1e-13 >= problem->best_value[0]);
-}
-
 static void transform_vars_permutation_free(void *thing) {
   transform_vars_permutation_t *data = (transform_vars_permutation_t *) thing;
-  coco_free_memory(data->x);
   coco_free_memory(data->P);
 }
 
 
-static coco_problem_t *transform_vars_permutation(coco_problem_t *inner_problem,
-                                                    const size_t *P,
-                                                    const size_t number_of_variables) {
-  coco_problem_t *problem;
-  transform_vars_permutation_t *data;
-
-  assert(number_of_variables > 0);/*tmp*/
-
-  data = (transform_vars_permutation_t *) coco_allocate_memory(sizeof(*data));
-  data->x = coco_allocate_vector(inner_problem->number_of_variables);
-  data->P = coco_duplicate_size_t_vector(P, inner_problem->number_of_variables);
-
-  problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_permutation_free, "transform_vars_permutation");
-  problem->evaluate_function = transform_vars_permutation_evaluate;
-  return problem;
-}
-
-
 static void transform_vars_inverse_permutation_evaluate(coco_problem_t *problem, const double *x, double *y) {
     size_t i;
+    double *inner_x;
     transform_vars_permutation_t *data;
     coco_problem_t *inner_problem;
     
     data = (transform_vars_permutation_t *) coco_problem_transformed_get_data(problem);
     inner_problem = coco_problem_transformed_get_inner_problem(problem);
+    inner_x = coco_problem_scratch_allocate(problem, inner_problem->number_of_variables);
     for (i = 0; i < inner_problem->number_of_variables; ++i) {
-        data->x[data->P[i]] = x[i];
+        inner_x[data->P[i]] = x[i];
     }
     
-    coco_evaluate_function(inner_problem, data->x, y);
+    coco_evaluate_function(inner_problem, inner_x, y);
+    coco_problem_scratch_free(problem, inner_x, inner_problem->number_of_variables);
     assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the inverse transformation in a batch of points.
+ */
+static void transform_vars_inverse_permutation_evaluate_batch(coco_problem_t *problem,
+                                                              const size_t number_of_points,
+                                                              const double *x,
+                                                              double *y) {
+    size_t i, k;
+    double *batch_x;
+    transform_vars_permutation_t *data;
+    coco_problem_t *inner_problem;
+    const size_t n = problem->number_of_variables;
+
+    data = (transform_vars_permutation_t *) coco_problem_transformed_get_data(problem);
+    inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+    batch_x = coco_problem_scratch_allocate(problem, number_of_points * n);
+    for (k = 0; k < number_of_points; ++k) {
+        for (i = 0; i < n; ++i) {
+            batch_x[k * n + data->P[i]] = x[k * n + i];
+        }
+    }
+    coco_evaluate_function_batch(inner_problem, number_of_points, batch_x, y);
+    coco_problem_scratch_free(problem, batch_x, number_of_points * n);
+
+    for (k = 0; k < number_of_points; ++k)
+        assert(y[k * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
+}
+
 
 static coco_problem_t *transform_vars_inverse_permutation(coco_problem_t *inner_problem,
                                                   const size_t *P,
@@ -83,10 +82,10 @@ static coco_problem_t *transform_vars_inverse_permutation(coco_problem_t *inner_
     assert(number_of_variables > 0);/*tmp*/
     
     data = (transform_vars_permutation_t *) coco_allocate_memory(sizeof(*data));
-    data->x = coco_allocate_vector(inner_problem->number_of_variables);
     data->P = coco_duplicate_size_t_vector(P, inner_problem->number_of_variables);
     
     problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_permutation_free, "transform_vars_inverse_permutation");
     problem->evaluate_function = transform_vars_inverse_permutation_evaluate;
+    problem->evaluate_function_batch = transform_vars_inverse_permutation_evaluate_batch;
     return problem;
 }
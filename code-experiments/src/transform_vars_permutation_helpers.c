@@ -4,6 +4,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <assert.h>
 #include "coco.h"
 
@@ -79,16 +80,35 @@ static long coco_random_unif_integer(long lower_bound, long upper_bound, long se
 }
 
 
+/**
+ * @brief duplicates a size_t vector
+ */
+static size_t *coco_duplicate_size_t_vector(const size_t *src, const size_t number_of_elements) {
+  size_t i;
+  size_t *dst;
+
+  assert(src != NULL);
+  assert(number_of_elements > 0);
+
+  dst = coco_allocate_vector_size_t(number_of_elements);
+  for (i = 0; i < number_of_elements; ++i) {
+    dst[i] = src[i];
+  }
+  return dst;
+}
+
 /**
  * @brief generates a random permutation resulting from nb_swaps truncated uniform swaps of range swap_range
  * missing parameters: dynamic_not_static pool, seems empirically irrelevant
  * for now so dynamic is implemented (simple since no need for tracking indices
  * if swap_range is 0, a random uniform permutation is generated
+ * the permutation is taken from the instance cache if it has been computed before
  */
 static void coco_compute_truncated_uniform_swap_permutation(size_t *P, long seed, size_t n, size_t nb_swaps, size_t swap_range) {
   long i, idx_swap;
   size_t lower_bound, upper_bound, first_swap_var, second_swap_var, tmp;
   size_t *idx_order;
+  const size_t *cached;
 
   if (n <= 40) {
     /* Do an identity permutation for dimensions <= 40 */
@@ -97,6 +117,14 @@ static void coco_compute_truncated_uniform_swap_permutation(size_t *P, long seed
     return;
   }
 
+  cached = (const size_t *) coco_instance_cache_acquire("coco_compute_truncated_uniform_swap_permutation",
+      seed, n, nb_swaps, swap_range, n * sizeof(size_t));
+  if (cached != NULL) {
+    memcpy(P, cached, n * sizeof(size_t));
+    coco_instance_cache_release(cached);
+    return;
+  }
+
   perm_random_data = coco_allocate_vector(n);
   bbob2009_unif(perm_random_data, n, seed);
 
@@ -142,29 +170,14 @@ static void coco_compute_truncated_uniform_swap_permutation(size_t *P, long seed
   }
   coco_free_memory(idx_order);
   coco_free_memory(perm_random_data);
-}
-
-
-
-/**
- * @brief duplicates a size_t vector
- */
-static size_t *coco_duplicate_size_t_vector(const size_t *src, const size_t number_of_elements) {
-  size_t i;
-  size_t *dst;
 
-  assert(src != NULL);
-  assert(number_of_elements > 0);
-
-  dst = coco_allocate_vector_size_t(number_of_elements);
-  for (i = 0; i < number_of_elements; ++i) {
-    dst[i] = src[i];
-  }
-  return dst;
+  coco_instance_cache_insert("coco_compute_truncated_uniform_swap_permutation", seed, n, nb_swaps, swap_range,
+      coco_duplicate_size_t_vector(P, n), n * sizeof(size_t));
 }
 
 
 
+
 /**
  * @brief return the swap_range corresponding to the problem in the given suite
  */
@@ -13,7 +13,6 @@
  */
 typedef struct {
   double factor;
-  double *x;
 } transform_vars_scale_data_t;
 
 /**
@@ -21,6 +20,7 @@ typedef struct {
  */
 static void transform_vars_scale_evaluate(coco_problem_t *problem, const double *x, double *y) {
   size_t i;
+  double *inner_x;
   transform_vars_scale_data_t *data;
   coco_problem_t *inner_problem;
 
@@ -34,20 +34,41 @@ static void transform_vars_scale_evaluate(coco_problem_t *problem, const double
   do {
     const double factor = data->factor;
 
+    inner_x = coco_problem_scratch_allocate(problem, problem->number_of_variables);
     for (i = 0; i < problem->number_of_variables; ++i) {
-      data->x[i] = factor * x[i];
+      inner_x[i] = factor * x[i];
     }
-    coco_evaluate_function(inner_problem, data->x, y);
+    coco_evaluate_function(inner_problem, inner_x, y);
+    coco_problem_scratch_free(problem, inner_x, problem->number_of_variables);
     assert(y[0] + 1e-13 >= problem->best_value[0]);
   } while (0);
 }
 
 /**
- * @brief Frees the data object.
+ * @brief Evaluates the transformation in a batch of points.
  */
-static void transform_vars_scale_free(void *thing) {
-  transform_vars_scale_data_t *data = (transform_vars_scale_data_t *) thing;
-  coco_free_memory(data->x);
+static void transform_vars_scale_evaluate_batch(coco_problem_t *problem,
+                                                const size_t number_of_points,
+                                                const double *x,
+                                                double *y) {
+  size_t i, k;
+  double *batch_x;
+  transform_vars_scale_data_t *data;
+  coco_problem_t *inner_problem;
+  const size_t n = problem->number_of_variables;
+
+  data = (transform_vars_scale_data_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  batch_x = coco_problem_scratch_allocate(problem, number_of_points * n);
+  for (i = 0; i < number_of_points * n; ++i) {
+    batch_x[i] = data->factor * x[i];
+  }
+  coco_evaluate_function_batch(inner_problem, number_of_points, batch_x, y);
+  coco_problem_scratch_free(problem, batch_x, number_of_points * n);
+
+  for (k = 0; k < number_of_points; ++k)
+    assert(y[k * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
 }
 
 /**
@@ -59,10 +80,10 @@ static coco_problem_t *transform_vars_scale(coco_problem_t *inner_problem, const
   size_t i;
   data = (transform_vars_scale_data_t *) coco_allocate_memory(sizeof(*data));
   data->factor = factor;
-  data->x = coco_allocate_vector(inner_problem->number_of_variables);
 
-  problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_scale_free, "transform_vars_scale");
+  problem = coco_problem_transformed_allocate(inner_problem, data, NULL, "transform_vars_scale");
   problem->evaluate_function = transform_vars_scale_evaluate;
+  problem->evaluate_function_batch = transform_vars_scale_evaluate_batch;
   /* Compute best parameter */
   if (data->factor != 0.) {
       for (i = 0; i < problem->number_of_variables; i++) {
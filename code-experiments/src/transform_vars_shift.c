@@ -13,7 +13,6 @@
  */
 typedef struct {
   double *offset;
-  double *shifted_x;
   coco_problem_free_function_t old_free_problem;
 } transform_vars_shift_data_t;
 
@@ -22,7 +21,7 @@ typedef struct {
  */
 static void transform_vars_shift_evaluate_function(coco_problem_t *problem, const double *x, double *y) {
   size_t i;
-  double *cons_values;
+  double *cons_values, *shifted_x;
   int is_feasible;
   transform_vars_shift_data_t *data;
   coco_problem_t *inner_problem;
@@ -35,27 +34,59 @@ static void transform_vars_shift_evaluate_function(coco_problem_t *problem, cons
   data = (transform_vars_shift_data_t *) coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
+  shifted_x = coco_problem_scratch_allocate(problem, problem->number_of_variables);
   for (i = 0; i < problem->number_of_variables; ++i) {
-    data->shifted_x[i] = x[i] - data->offset[i];
+    shifted_x[i] = x[i] - data->offset[i];
   }
   
-  coco_evaluate_function(inner_problem, data->shifted_x, y);
+  coco_evaluate_function(inner_problem, shifted_x, y);
+  coco_problem_scratch_free(problem, shifted_x, problem->number_of_variables);
   
   if (problem->number_of_constraints > 0) {
-    cons_values = coco_allocate_vector(problem->number_of_constraints);
+    cons_values = coco_problem_scratch_allocate(problem, problem->number_of_constraints);
     is_feasible = coco_is_feasible(problem, x, cons_values);
-    coco_free_memory(cons_values);    
+    coco_problem_scratch_free(problem, cons_values, problem->number_of_constraints);
     if (is_feasible)
       assert(y[0] + 1e-13 >= problem->best_value[0]);
   }
   else assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the transformed objective function in a batch of points.
+ */
+static void transform_vars_shift_evaluate_function_batch(coco_problem_t *problem,
+                                                         const size_t number_of_points,
+                                                         const double *x,
+                                                         double *y) {
+  size_t i, k;
+  double *shifted_x;
+  transform_vars_shift_data_t *data;
+  coco_problem_t *inner_problem;
+  const size_t n = problem->number_of_variables;
+
+  data = (transform_vars_shift_data_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  shifted_x = coco_problem_scratch_allocate(problem, number_of_points * n);
+  for (k = 0; k < number_of_points; ++k) {
+    for (i = 0; i < n; ++i) {
+      shifted_x[k * n + i] = x[k * n + i] - data->offset[i];
+    }
+  }
+
+  coco_evaluate_function_batch(inner_problem, number_of_points, shifted_x, y);
+  coco_problem_scratch_free(problem, shifted_x, number_of_points * n);
+
+  coco_problem_batch_assert_best_value(problem, number_of_points, x, y);
+}
+
 /**
  * @brief Evaluates the transformed constraint function.
  */
 static void transform_vars_shift_evaluate_constraint(coco_problem_t *problem, const double *x, double *y) {
   size_t i;
+  double *shifted_x;
   transform_vars_shift_data_t *data;
   coco_problem_t *inner_problem;
   
@@ -67,10 +98,12 @@ static void transform_vars_shift_evaluate_constraint(coco_problem_t *problem, co
   data = (transform_vars_shift_data_t *) coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
+  shifted_x = coco_problem_scratch_allocate(problem, problem->number_of_variables);
   for (i = 0; i < problem->number_of_variables; ++i) {
-    data->shifted_x[i] = x[i] - data->offset[i];
+    shifted_x[i] = x[i] - data->offset[i];
   }
-  coco_evaluate_constraint(inner_problem, data->shifted_x, y);
+  coco_evaluate_constraint(inner_problem, shifted_x, y);
+  coco_problem_scratch_free(problem, shifted_x, problem->number_of_variables);
 }
 
 /**
@@ -78,6 +111,7 @@ static void transform_vars_shift_evaluate_constraint(coco_problem_t *problem, co
  */
 static void transform_vars_shift_evaluate_gradient(coco_problem_t *problem, const double *x, double *y) {
   size_t i;
+  double *shifted_x;
   transform_vars_shift_data_t *data;
   coco_problem_t *inner_problem;
   
@@ -89,10 +123,12 @@ static void transform_vars_shift_evaluate_gradient(coco_problem_t *problem, cons
   data = (transform_vars_shift_data_t *) coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
 		  
+  shifted_x = coco_problem_scratch_allocate(problem, problem->number_of_variables);
   for (i = 0; i < problem->number_of_variables; ++i) {
-    data->shifted_x[i] = x[i] - data->offset[i];
+    shifted_x[i] = x[i] - data->offset[i];
   }
-  bbob_evaluate_gradient(inner_problem, data->shifted_x, y);
+  bbob_evaluate_gradient(inner_problem, shifted_x, y);
+  coco_problem_scratch_free(problem, shifted_x, problem->number_of_variables);
 
 }
 
@@ -101,7 +137,6 @@ static void transform_vars_shift_evaluate_gradient(coco_problem_t *problem, cons
  */
 static void transform_vars_shift_free(void *thing) {
   transform_vars_shift_data_t *data = (transform_vars_shift_data_t *) thing;
-  coco_free_memory(data->shifted_x);
   coco_free_memory(data->offset);
 }
 
@@ -119,13 +154,14 @@ static coco_problem_t *transform_vars_shift(coco_problem_t *inner_problem,
 
   data = (transform_vars_shift_data_t *) coco_allocate_memory(sizeof(*data));
   data->offset = coco_duplicate_vector(offset, inner_problem->number_of_variables);
-  data->shifted_x = coco_allocate_vector(inner_problem->number_of_variables);
 
   problem = coco_problem_transformed_allocate(inner_problem, data, 
     transform_vars_shift_free, "transform_vars_shift");
     
-  if (inner_problem->number_of_objectives > 0)
+  if (inner_problem->number_of_objectives > 0) {
     problem->evaluate_function = transform_vars_shift_evaluate_function;
+    problem->evaluate_function_batch = transform_vars_shift_evaluate_function_batch;
+  }
     
   if (inner_problem->number_of_constraints > 0)
     problem->evaluate_constraint = transform_vars_shift_evaluate_constraint;
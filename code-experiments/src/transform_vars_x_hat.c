@@ -14,7 +14,7 @@
  */
 typedef struct {
   long seed;
-  double *x;
+  double *random_numbers; /**< @brief Uniform random numbers drawn from the seed, negating x[i] if below 0.5 */
   coco_problem_free_function_t old_free_problem;
 } transform_vars_x_hat_data_t;
 
@@ -23,6 +23,7 @@ typedef struct {
  */
 static void transform_vars_x_hat_evaluate(coco_problem_t *problem, const double *x, double *y) {
   size_t i;
+  double *inner_x;
   transform_vars_x_hat_data_t *data;
   coco_problem_t *inner_problem;
 
@@ -34,26 +35,59 @@ static void transform_vars_x_hat_evaluate(coco_problem_t *problem, const double
  data = (transform_vars_x_hat_data_t *) coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
   do {
-    bbob2009_unif(data->x, problem->number_of_variables, data->seed);
-
+    inner_x = coco_problem_scratch_allocate(problem, problem->number_of_variables);
     for (i = 0; i < problem->number_of_variables; ++i) {
-      if (data->x[i] < 0.5) {
-        data->x[i] = -x[i];
+      if (data->random_numbers[i] < 0.5) {
+        inner_x[i] = -x[i];
       } else {
-        data->x[i] = x[i];
+        inner_x[i] = x[i];
       }
     }
-    coco_evaluate_function(inner_problem, data->x, y);
+    coco_evaluate_function(inner_problem, inner_x, y);
+    coco_problem_scratch_free(problem, inner_x, problem->number_of_variables);
     assert(y[0] + 1e-13 >= problem->best_value[0]);
   } while (0);
 }
 
+/**
+ * @brief Evaluates the transformation in a batch of points.
+ */
+static void transform_vars_x_hat_evaluate_batch(coco_problem_t *problem,
+                                                const size_t number_of_points,
+                                                const double *x,
+                                                double *y) {
+  size_t i, k;
+  double *batch_x;
+  transform_vars_x_hat_data_t *data;
+  coco_problem_t *inner_problem;
+  const size_t n = problem->number_of_variables;
+
+  data = (transform_vars_x_hat_data_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  batch_x = coco_problem_scratch_allocate(problem, number_of_points * n);
+  for (k = 0; k < number_of_points; ++k) {
+    for (i = 0; i < n; ++i) {
+      if (data->random_numbers[i] < 0.5) {
+        batch_x[k * n + i] = -x[k * n + i];
+      } else {
+        batch_x[k * n + i] = x[k * n + i];
+      }
+    }
+  }
+  coco_evaluate_function_batch(inner_problem, number_of_points, batch_x, y);
+  coco_problem_scratch_free(problem, batch_x, number_of_points * n);
+
+  for (k = 0; k < number_of_points; ++k)
+    assert(y[k * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Frees the data object.
  */
 static void transform_vars_x_hat_free(void *thing) {
   transform_vars_x_hat_data_t *data = (transform_vars_x_hat_data_t *) thing;
-  coco_free_memory(data->x);
+  coco_free_memory(data->random_numbers);
 }
 
 /**
@@ -66,14 +100,16 @@ static coco_problem_t *transform_vars_x_hat(coco_problem_t *inner_problem, const
 
   data = (transform_vars_x_hat_data_t *) coco_allocate_memory(sizeof(*data));
   data->seed = seed;
-  data->x = coco_allocate_vector(inner_problem->number_of_variables);
+  /* The random signs depend only on the seed and are therefore drawn once */
+  data->random_numbers = coco_allocate_vector(inner_problem->number_of_variables);
+  bbob2009_unif(data->random_numbers, inner_problem->number_of_variables, data->seed);
 
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_x_hat_free, "transform_vars_x_hat");
   problem->evaluate_function = transform_vars_x_hat_evaluate;
+  problem->evaluate_function_batch = transform_vars_x_hat_evaluate_batch;
   if (coco_problem_best_parameter_not_zero(problem)) {
-    bbob2009_unif(data->x, problem->number_of_variables, data->seed);
 	for (i = 0; i < problem->number_of_variables; ++i)
-	  if (data->x[i] < 0.5)  /* with probability 1/2 */
+	  if (data->random_numbers[i] < 0.5)  /* with probability 1/2 */
 		problem->best_parameter[i] *= -1;
   }
   return problem;
@@ -15,7 +15,6 @@
  */
 typedef struct {
   double *sign_vector;
-  double *x;
   coco_problem_free_function_t old_free_problem;
 } transform_vars_x_hat_generic_data_t;
 
@@ -34,16 +33,19 @@ typedef struct {
  */
 static void transform_vars_x_hat_generic_evaluate(coco_problem_t *problem, const double *x, double *y) {
   size_t i;
+  double *inner_x;
   transform_vars_x_hat_generic_data_t *data;
   coco_problem_t *inner_problem;
   data = (transform_vars_x_hat_generic_data_t *) coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
+  inner_x = coco_problem_scratch_allocate(problem, problem->number_of_variables);
   for (i = 0; i < problem->number_of_variables; ++i) {
-    data->x[i] = 2.0 * data->sign_vector[i] * x[i];
-    ((f_lunacek_bi_rastrigin_versatile_data_t *) problem->versatile_data)->x_hat[i] = data->x[i];
+    inner_x[i] = 2.0 * data->sign_vector[i] * x[i];
+    ((f_lunacek_bi_rastrigin_versatile_data_t *) problem->versatile_data)->x_hat[i] = inner_x[i];
   }
-  coco_evaluate_function(inner_problem, data->x, y);
+  coco_evaluate_function(inner_problem, inner_x, y);
+  coco_problem_scratch_free(problem, inner_x, problem->number_of_variables);
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
@@ -52,7 +54,6 @@ static void transform_vars_x_hat_generic_evaluate(coco_problem_t *problem, const
  */
 static void transform_vars_x_hat_generic_free(void *thing) {
   transform_vars_x_hat_generic_data_t *data = (transform_vars_x_hat_generic_data_t *) thing;
-  coco_free_memory(data->x);
   coco_free_memory(data->sign_vector);
 }
 
@@ -65,7 +66,6 @@ static coco_problem_t *transform_vars_x_hat_generic(coco_problem_t *inner_proble
   size_t i;
 
   data = (transform_vars_x_hat_generic_data_t *) coco_allocate_memory(sizeof(*data));
-  data->x = coco_allocate_vector(inner_problem->number_of_variables);
   data->sign_vector = coco_allocate_vector(inner_problem->number_of_variables);
   for (i = 0; i < inner_problem->number_of_variables; ++i) {
     data->sign_vector[i] = sign_vector[i];
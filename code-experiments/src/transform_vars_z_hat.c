@@ -13,7 +13,6 @@
  */
 typedef struct {
   double *xopt;
-  double *z;
   coco_problem_free_function_t old_free_problem;
 } transform_vars_z_hat_data_t;
 
@@ -22,6 +21,7 @@ typedef struct {
  */
 static void transform_vars_z_hat_evaluate(coco_problem_t *problem, const double *x, double *y) {
   size_t i;
+  double *z;
   transform_vars_z_hat_data_t *data;
   coco_problem_t *inner_problem;
 
@@ -33,22 +33,53 @@ static void transform_vars_z_hat_evaluate(coco_problem_t *problem, const double
   data = (transform_vars_z_hat_data_t *) coco_problem_transformed_get_data(problem);
   inner_problem = coco_problem_transformed_get_inner_problem(problem);
 
-  data->z[0] = x[0];
+  z = coco_problem_scratch_allocate(problem, problem->number_of_variables);
+  z[0] = x[0];
 
   for (i = 1; i < problem->number_of_variables; ++i) {
-    data->z[i] = x[i] + 0.25 * (x[i - 1] - 2.0 * fabs(data->xopt[i - 1]));
+    z[i] = x[i] + 0.25 * (x[i - 1] - 2.0 * fabs(data->xopt[i - 1]));
   }
-  coco_evaluate_function(inner_problem, data->z, y);
+  coco_evaluate_function(inner_problem, z, y);
+  coco_problem_scratch_free(problem, z, problem->number_of_variables);
   assert(y[0] + 1e-13 >= problem->best_value[0]);
 }
 
+/**
+ * @brief Evaluates the transformation in a batch of points.
+ */
+static void transform_vars_z_hat_evaluate_batch(coco_problem_t *problem,
+                                                const size_t number_of_points,
+                                                const double *x,
+                                                double *y) {
+  size_t i, k;
+  double *z;
+  transform_vars_z_hat_data_t *data;
+  coco_problem_t *inner_problem;
+  const size_t n = problem->number_of_variables;
+
+  data = (transform_vars_z_hat_data_t *) coco_problem_transformed_get_data(problem);
+  inner_problem = coco_problem_transformed_get_inner_problem(problem);
+
+  z = coco_problem_scratch_allocate(problem, number_of_points * n);
+  for (k = 0; k < number_of_points; ++k) {
+    z[k * n] = x[k * n];
+    for (i = 1; i < n; ++i) {
+      z[k * n + i] = x[k * n + i] + 0.25 * (x[k * n + i - 1] - 2.0 * fabs(data->xopt[i - 1]));
+    }
+  }
+  coco_evaluate_function_batch(inner_problem, number_of_points, z, y);
+  coco_problem_scratch_free(problem, z, number_of_points * n);
+
+  for (k = 0; k < number_of_points; ++k)
+    assert(y[k * problem->number_of_objectives] + 1e-13 >= problem->best_value[0]);
+}
+
 /**
  * @brief Frees the data object.
  */
 static void transform_vars_z_hat_free(void *thing) {
   transform_vars_z_hat_data_t *data = (transform_vars_z_hat_data_t *) thing;
   coco_free_memory(data->xopt);
-  coco_free_memory(data->z);
 }
 
 /**
@@ -59,10 +90,10 @@ static coco_problem_t *transform_vars_z_hat(coco_problem_t *inner_problem, const
   coco_problem_t *problem;
   data = (transform_vars_z_hat_data_t *) coco_allocate_memory(sizeof(*data));
   data->xopt = coco_duplicate_vector(xopt, inner_problem->number_of_variables);
-  data->z = coco_allocate_vector(inner_problem->number_of_variables);
 
   problem = coco_problem_transformed_allocate(inner_problem, data, transform_vars_z_hat_free, "transform_vars_z_hat");
   problem->evaluate_function = transform_vars_z_hat_evaluate;
+  problem->evaluate_function_batch = transform_vars_z_hat_evaluate_batch;
   /* TODO: implement best_parameter transformation if needed in the case of not zero:
      see also issue #814.
   The correct update of best_parameter seems not too difficult and should not anymore
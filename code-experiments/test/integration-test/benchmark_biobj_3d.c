@@ -0,0 +1,230 @@
+/**
+ * Benchmarks the archive and hypervolume update of the bbob-biobj logger on problems with three objectives.
+ *
+ * Solutions around a spherical front are fed through the logger, which keeps its archive in an ND-tree and
+ * updates the hypervolume by a sweep over the neighbors of each new solution. For comparison, the same
+ * solutions are also added to a linear archive, where each update scans all solutions and sweeps over all of
+ * them (as the logger did before). The hypervolume of both is checked against the one of the final archive.
+ *
+ * Run with "./benchmark_biobj_3d" or "./benchmark_biobj_3d <evaluations>" for a single number of
+ * evaluations. Returns a nonzero value if the hypervolume values do not match.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "coco.h"
+#include "coco.c"
+
+/**
+ * The largest number of evaluations for which the linear archive is also timed.
+ */
+static const size_t LINEAR_MAX_EVALUATIONS = 20000;
+
+/**
+ * The objectives equal the variables (the normalized objective space is [0, 1]^3).
+ */
+static void benchmark_evaluate_identity(coco_problem_t *problem, const double *x, double *y) {
+  size_t i;
+
+  for (i = 0; i < problem->number_of_objectives; i++)
+    y[i] = x[i];
+}
+
+/**
+ * Samples a solution around the spherical front through (1, 0, 0), (0, 1, 0) and (0, 0, 1).
+ */
+static void benchmark_sample(coco_random_state_t *random, double *x) {
+  double norm = 0;
+  size_t i;
+
+  for (i = 0; i < 3; i++) {
+    x[i] = coco_random_uniform(random);
+    norm += x[i] * x[i];
+  }
+  norm = sqrt(norm) / (0.98 + 0.04 * coco_random_uniform(random));
+  for (i = 0; i < 3; i++)
+    x[i] /= norm;
+}
+
+/**
+ * Returns the relative difference of the two values.
+ */
+static double benchmark_difference(const double a, const double b) {
+  return fabs(a - b) / coco_double_max(fabs(b), 1e-300);
+}
+
+/**
+ * Feeds the given number of solutions through the logger and returns the elapsed time. The hypervolume
+ * computed by the logger and the one of its final archive are returned in the given variables.
+ */
+static double benchmark_logger(const size_t number_of_evaluations,
+                               double *hypervolume,
+                               double *archive_hypervolume,
+                               size_t *archive_size) {
+
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem;
+  coco_random_state_t *random = coco_random_new(7);
+  logger_biobj_data_t *logger;
+  logger_biobj_indicator_t *indicator;
+  logger_biobj_avl_item_t *item;
+  avl_node_t *node;
+  const double lower[3] = { 0, 0, 0 };
+  const double **points;
+  double x[3], y[3];
+  char *previous_log_level;
+  clock_t start;
+  double elapsed;
+  size_t i, number_of_points = 0;
+
+  /* The suite is only needed for its name, the best hypervolume value of the problem is not known, which
+   * is reported as a warning (the output of the observer is not needed either) */
+  previous_log_level = coco_strdup(coco_set_log_level("error"));
+  suite = coco_suite("bbob-biobj", "instances: 1", "dimensions: 2 function_indices: 1");
+  observer = coco_observer("bbob-biobj", "result_folder: benchmark_biobj_3d log_nondominated: none");
+
+  problem = coco_problem_allocate(3, 3, 0);
+  for (i = 0; i < 3; i++) {
+    problem->smallest_values_of_interest[i] = 0;
+    problem->largest_values_of_interest[i] = 1.1;
+    problem->best_value[i] = 0;
+    problem->nadir_value[i] = 1;
+  }
+  problem->evaluate_function = benchmark_evaluate_identity;
+  coco_problem_set_name(problem, "benchmark sphere with three objectives");
+  coco_problem_set_id(problem, "benchmark-triobj_f01_i01_d03");
+  coco_problem_set_type(problem, "benchmark-triobj");
+  problem->suite = suite;
+  problem = coco_problem_add_observer(problem, observer);
+  coco_set_log_level(previous_log_level);
+  coco_free_memory(previous_log_level);
+
+  start = clock();
+  for (i = 0; i < number_of_evaluations; i++) {
+    benchmark_sample(random, x);
+    coco_evaluate_function(problem, x, y);
+  }
+  elapsed = (double) (clock() - start) / CLOCKS_PER_SEC;
+
+  logger = (logger_biobj_data_t *) coco_problem_transformed_get_data(problem);
+  indicator = logger->indicators[0];
+  *hypervolume = indicator->current_value;
+  *archive_size = (size_t) avl_count(logger->archive_tree);
+  points = mo_hypervolume_3d_get_points(indicator->hypervolume_3d, *archive_size);
+  for (node = logger->archive_tree->head; node != NULL; node = node->next) {
+    item = (logger_biobj_avl_item_t *) node->item;
+    if (item->within_ROI)
+      points[number_of_points++] = item->normalized_y;
+  }
+  *archive_hypervolume = mo_hypervolume_3d_dominated(indicator->hypervolume_3d, lower, points,
+      number_of_points);
+
+  problem = coco_problem_remove_observer(problem, observer);
+  coco_problem_free(problem);
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+  coco_random_free(random);
+  return elapsed;
+}
+
+/**
+ * Orders the pointers to solutions by the third objective.
+ */
+static int benchmark_compare(const void *a, const void *b) {
+  const double z1 = (*(const double * const *) a)[2];
+  const double z2 = (*(const double * const *) b)[2];
+  return (z1 < z2) ? -1 : ((z1 > z2) ? 1 : 0);
+}
+
+/**
+ * Adds the same solutions as benchmark_logger() to a linear archive and returns the elapsed time. Each
+ * update scans the whole archive and computes the hypervolume contribution by a sweep over all solutions.
+ */
+static double benchmark_linear(const size_t number_of_evaluations, double *hypervolume) {
+
+  coco_random_state_t *random = coco_random_new(7);
+  mo_hypervolume_3d_t *data = mo_hypervolume_3d_allocate();
+  double *solutions = coco_allocate_vector(3 * number_of_evaluations);
+  const double **archive = (const double **) coco_allocate_memory(number_of_evaluations * sizeof(double *));
+  const double **points;
+  double *x;
+  clock_t start;
+  size_t i, j, archive_size = 0;
+
+  *hypervolume = 0;
+  start = clock();
+  for (i = 0; i < number_of_evaluations; i++) {
+    x = solutions + 3 * i;
+    benchmark_sample(random, x);
+    for (j = 0; j < archive_size; j++) {
+      if (mo_get_dominance(x, archive[j], 3) < 0)
+        break;
+    }
+    if (j < archive_size)
+      continue;
+
+    points = mo_hypervolume_3d_get_points(data, archive_size);
+    for (j = 0; j < archive_size; j++)
+      points[j] = archive[j];
+    if (archive_size > 1)
+      qsort((void *) points, archive_size, sizeof(const double *), benchmark_compare);
+    *hypervolume += mo_hypervolume_3d_contribution(data, x, points, archive_size);
+
+    for (j = 0; j < archive_size; j++) {
+      if (mo_get_dominance(x, archive[j], 3) == 1)
+        archive[j--] = archive[--archive_size];
+    }
+    archive[archive_size++] = x;
+  }
+
+  coco_free_memory((void *) archive);
+  coco_free_memory(solutions);
+  mo_hypervolume_3d_free(data);
+  coco_random_free(random);
+  return (double) (clock() - start) / CLOCKS_PER_SEC;
+}
+
+int main(int argc, char *argv[]) {
+
+  size_t evaluations[] = { 1000, 5000, 20000, 100000 };
+  size_t number_of_runs = sizeof(evaluations) / sizeof(evaluations[0]);
+  double hypervolume, archive_hypervolume, linear_hypervolume, logger_time, linear_time;
+  size_t i, archive_size;
+  int errors = 0;
+
+  if (argc == 2) {
+    evaluations[0] = (size_t) strtoul(argv[1], NULL, 10);
+    number_of_runs = 1;
+  }
+
+  printf("%12s %12s %14s %14s %16s\n", "evaluations", "archive", "logger [s]", "linear [s]", "hypervolume");
+  for (i = 0; i < number_of_runs; i++) {
+    logger_time = benchmark_logger(evaluations[i], &hypervolume, &archive_hypervolume, &archive_size);
+    if (benchmark_difference(hypervolume, archive_hypervolume) > 1e-9) {
+      printf("The hypervolume of the logger %.15f differs from the one of its archive %.15f\n", hypervolume,
+          archive_hypervolume);
+      errors++;
+    }
+    if (evaluations[i] <= LINEAR_MAX_EVALUATIONS) {
+      linear_time = benchmark_linear(evaluations[i], &linear_hypervolume);
+      if (benchmark_difference(linear_hypervolume, archive_hypervolume) > 1e-9) {
+        printf("The hypervolume of the linear archive %.15f differs from the one of the logger %.15f\n",
+            linear_hypervolume, archive_hypervolume);
+        errors++;
+      }
+      printf("%12lu %12lu %14.3f %14.3f %16.12f\n", (unsigned long) evaluations[i],
+          (unsigned long) archive_size, logger_time, linear_time, hypervolume);
+    } else {
+      printf("%12lu %12lu %14.3f %14s %16.12f\n", (unsigned long) evaluations[i], (unsigned long) archive_size,
+          logger_time, "-", hypervolume);
+    }
+    fflush(stdout);
+  }
+
+  coco_remove_directory("exdata");
+  return (errors > 0) ? 1 : 0;
+}
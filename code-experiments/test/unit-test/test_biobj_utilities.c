@@ -27,10 +27,91 @@ MU_TEST(test_biobj_utilities_instances) {
   coco_suite_free(suite);
 }
 
+/**
+ * Tests the lookup of the best hypervolume values against the string tables.
+ */
+MU_TEST(test_biobj_utilities_best_hyp_value) {
+
+  char key[COCO_PATH_MAX + 1];
+  char *previous_log_level;
+  double value = 0;
+  size_t i;
+
+  for (i = 0; i < sizeof(suite_biobj_best_values_hyp) / sizeof(char *); i++) {
+    sscanf(suite_biobj_best_values_hyp[i], "%s %lf", key, &value);
+    mu_check(suite_biobj_get_best_hyp_value("bbob-biobj", key) == value);
+  }
+  for (i = 0; i < sizeof(suite_biobj_mixint_best_values_hyp) / sizeof(char *); i++) {
+    sscanf(suite_biobj_mixint_best_values_hyp[i], "%s %lf", key, &value);
+    mu_check(suite_biobj_get_best_hyp_value("bbob-biobj-mixint", key) == value);
+  }
+
+  mu_check(suite_biobj_get_best_hyp_value("bbob-biobj", "bbob-biobj_f01_i01_d02") == 0.833332923849452);
+  mu_check(suite_biobj_get_best_hyp_value("bbob-biobj", "bbob-biobj_f55_i10_d40") == 0.320849661893284);
+
+  /* Unknown keys are reported as a warning and get the value 1 */
+  previous_log_level = coco_strdup(coco_set_log_level("error"));
+  mu_check(suite_biobj_get_best_hyp_value("bbob-biobj", "bbob-biobj_f01_i01_d04") == 1.0);
+  mu_check(suite_biobj_get_best_hyp_value("bbob-biobj", "bbob-biobj_f01_i01_d02_") == 1.0);
+  mu_check(suite_biobj_get_best_hyp_value("bbob-biobj", "bbob-biobj-mixint_f001_i01_d005") == 1.0);
+  coco_set_log_level(previous_log_level);
+  coco_free_memory(previous_log_level);
+}
+
+/**
+ * Tests persisting the new instances of the bi-objective suites in an instance file.
+ */
+MU_TEST(test_biobj_utilities_instance_file) {
+
+  const char *file_name = "test_biobj_instances.txt";
+  const char *options = "dimensions: 2,3 function_indices: 1-2 biobj_instance_file: test_biobj_instances.txt";
+  coco_suite_t *suite;
+  coco_problem_t *problem;
+  FILE *file;
+  char line[COCO_PATH_MAX + 1];
+  char *previous_log_level;
+  size_t number_of_lines = 0;
+
+  remove(file_name);
+
+  /* The search is done once for each instance (and not once for each problem) */
+  previous_log_level = coco_strdup(coco_set_log_level("error"));
+  suite = coco_suite("bbob-biobj", "instances: 16-17", options);
+  while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL)
+    ;
+  coco_suite_free(suite);
+
+  file = fopen(file_name, "r");
+  mu_check(file != NULL);
+  while (fgets(line, COCO_PATH_MAX + 1, file) != NULL) {
+    if (number_of_lines == 0)
+      mu_check(strcmp(line, "bbob-biobj 2,3 16 33 34\n") == 0);
+    else
+      mu_check(strcmp(line, "bbob-biobj 2,3 17 35 36\n") == 0);
+    number_of_lines++;
+  }
+  fclose(file);
+  mu_check(number_of_lines == 2);
+
+  /* The instances are read from the file (only if the key matches) */
+  file = fopen(file_name, "w");
+  fprintf(file, "bbob-biobj 2,3,5 16 33 38\nbbob-biobj 2,3 16 33 40\n");
+  fclose(file);
+  suite = coco_suite("bbob-biobj", "instances: 16", options);
+  problem = coco_suite_get_next_problem(suite, NULL);
+  mu_check(strcmp(coco_problem_get_name(problem), "bbob_f001_i33_d02__bbob_f001_i40_d02") == 0);
+  coco_suite_free(suite);
+  coco_set_log_level(previous_log_level);
+  coco_free_memory(previous_log_level);
+
+  remove(file_name);
+}
+
 /**
  * Run all tests in this file.
  */
 MU_TEST_SUITE(test_all_biobj_utilities) {
   MU_RUN_TEST(test_biobj_utilities_instances);
+  MU_RUN_TEST(test_biobj_utilities_best_hyp_value);
+  MU_RUN_TEST(test_biobj_utilities_instance_file);
 }
-
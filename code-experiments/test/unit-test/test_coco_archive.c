@@ -261,6 +261,116 @@ MU_TEST(test_coco_archive_precision_issues) {
   coco_archive_free(archive);
 }
 
+/**
+ * Tests that adding solutions at once gives the same archive as adding them one by one.
+ */
+MU_TEST(test_coco_archive_add_solutions) {
+
+  const size_t number_of_solutions = 10000;
+  coco_archive_t *archive_single, *archive_bulk;
+  coco_random_state_t *random = coco_random_new(12345);
+  double *y1 = coco_allocate_vector(number_of_solutions);
+  double *y2 = coco_allocate_vector(number_of_solutions);
+  size_t *text_offsets = (size_t *) coco_allocate_memory(number_of_solutions * sizeof(size_t));
+  char *text = (char *) coco_allocate_memory(number_of_solutions * 16);
+  const char *text_single, *text_bulk;
+  size_t i, number_of_updates = 0, offset = 0;
+  double u;
+
+  archive_single = coco_archive("bbob-biobj", 23, 2, 5);
+  archive_bulk = coco_archive("bbob-biobj", 23, 2, 5);
+
+  for (i = 0; i < number_of_solutions; i++) {
+    /* Solutions on a coarse grid (with many equal ones) around a front, some of them outside the ROI */
+    u = floor(coco_random_uniform(random) * 50) / 40;
+    y1[i] = archive_single->ideal[0] + (archive_single->nadir[0] - archive_single->ideal[0]) * u;
+    u = 1 - u + floor(coco_random_uniform(random) * 10) / 40 - 0.1;
+    y2[i] = archive_single->ideal[1] + (archive_single->nadir[1] - archive_single->ideal[1]) * u;
+    text_offsets[i] = offset;
+    sprintf(text + offset, "%lu\n", (unsigned long) i);
+    offset += strlen(text + offset) + 1;
+    number_of_updates += (size_t) coco_archive_add_solution(archive_single, y1[i], y2[i], text + text_offsets[i]);
+  }
+  mu_check(number_of_updates > 0);
+  mu_check(coco_archive_add_solutions(archive_bulk, 0, NULL, NULL, NULL, NULL) == 0);
+  number_of_updates = coco_archive_add_solutions(archive_bulk, number_of_solutions, y1, y2, text, text_offsets);
+
+  mu_check(coco_archive_get_number_of_solutions(archive_bulk) == coco_archive_get_number_of_solutions(archive_single));
+  mu_check(number_of_updates + 2 == coco_archive_get_number_of_solutions(archive_bulk));
+  mu_check(coco_archive_get_hypervolume(archive_bulk) == coco_archive_get_hypervolume(archive_single));
+  do {
+    text_single = coco_archive_get_next_solution_text(archive_single);
+    text_bulk = coco_archive_get_next_solution_text(archive_bulk);
+    mu_check(strcmp(text_single, text_bulk) == 0);
+  } while (strcmp(text_single, "") != 0);
+
+  /* Adding the same solutions again does not update the archive */
+  mu_check(coco_archive_add_solutions(archive_bulk, number_of_solutions, y1, y2, text, text_offsets) == 0);
+
+  coco_archive_free(archive_single);
+  coco_archive_free(archive_bulk);
+  coco_random_free(random);
+  coco_free_memory(y1);
+  coco_free_memory(y2);
+  coco_free_memory(text_offsets);
+  coco_free_memory(text);
+}
+
+/**
+ * Tests merging archive files with coco_archive_merge().
+ */
+MU_TEST(test_coco_archive_merge) {
+
+  const size_t number_of_solutions = 2000;
+  const char *file_names[2] = { "test_archive_merge/bbob-biobj_f23_i05_d02_nondominated.adat",
+      "test_archive_merge/bbob-biobj_f23_d02_nondominated.adat" };
+  char line[256];
+  coco_archive_t *archive;
+  coco_random_state_t *random = coco_random_new(54321);
+  FILE *files[2], *file;
+  const char *text;
+  size_t i;
+  double y1, y2, u;
+
+  coco_create_directory("test_archive_merge");
+  files[0] = fopen(file_names[0], "w");
+  files[1] = fopen(file_names[1], "w");
+  mu_check((files[0] != NULL) && (files[1] != NULL));
+  fprintf(files[1], "%% instance = 6\n%%\n1\t1.0e+02\t1.0e+02\t0.0\t0.0\n");
+  fprintf(files[1], "%% instance = 5\n%%\n");
+
+  /* The solutions of instance 5 are split between the two files, the reference archive gets them all */
+  archive = coco_archive("bbob-biobj", 23, 2, 5);
+  for (i = 0; i < number_of_solutions; i++) {
+    u = coco_random_uniform(random) * 1.2;
+    y1 = archive->ideal[0] + (archive->nadir[0] - archive->ideal[0]) * u;
+    u = 1 - u + coco_random_uniform(random) * 0.2;
+    y2 = archive->ideal[1] + (archive->nadir[1] - archive->ideal[1]) * u;
+    sprintf(line, "%lu\t%.15e\t%.15e\t%.8e\t%.8e\n", (unsigned long) i, y1, y2, u, -u);
+    coco_archive_add_solution(archive, y1, y2, line);
+    fputs(line, files[i % 2]);
+  }
+  fclose(files[0]);
+  fclose(files[1]);
+
+  mu_check(coco_archive_merge(2, file_names, "test_archive_merge/merged", "number_of_threads: 2") == 2);
+
+  /* The merged archive contains the same solutions as the reference archive */
+  file = fopen("test_archive_merge/merged/bbob-biobj_f23_i05_d02_nondominated.adat", "r");
+  mu_check(file != NULL);
+  mu_check((fgets(line, sizeof(line), file) != NULL) && (strcmp(line, "% instance = 5\n") == 0));
+  mu_check((fgets(line, sizeof(line), file) != NULL) && (strcmp(line, "%\n") == 0));
+  while (strcmp(text = coco_archive_get_next_solution_text(archive), "") != 0) {
+    mu_check((fgets(line, sizeof(line), file) != NULL) && (strcmp(line, text) == 0));
+  }
+  mu_check(fgets(line, sizeof(line), file) == NULL);
+  fclose(file);
+
+  coco_archive_free(archive);
+  coco_random_free(random);
+  coco_remove_directory("test_archive_merge");
+}
+
 /**
  * Run all tests in this file.
  */
@@ -268,4 +378,6 @@ MU_TEST_SUITE(test_all_coco_archive) {
   MU_RUN_TEST(test_coco_archive);
   MU_RUN_TEST(test_coco_archive_extreme_solutions);
   MU_RUN_TEST(test_coco_archive_precision_issues);
+  MU_RUN_TEST(test_coco_archive_add_solutions);
+  MU_RUN_TEST(test_coco_archive_merge);
 }
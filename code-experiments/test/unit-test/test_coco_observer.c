@@ -117,10 +117,348 @@ MU_TEST(test_coco_observer_evaluations_trigger) {
   coco_observer_evaluations_free(evaluations);
 }
 
+/**
+ * Returns 1 if the file with the given name in the given folder contains the given text and 0 otherwise.
+ */
+static int test_file_contains(const char *folder, const char *file_name, const char *text) {
+  char path[COCO_PATH_MAX + 1] = { 0 };
+  char content[4096] = { 0 };
+  size_t length;
+  FILE *file;
+
+  coco_join_path(path, sizeof(path), folder, file_name, NULL);
+  file = fopen(path, "r");
+  if (file == NULL)
+    return 0;
+  length = fread(content, 1, sizeof(content) - 1, file);
+  content[length] = '\0';
+  fclose(file);
+  return strstr(content, text) != NULL;
+}
+
+/**
+ * Tests whether several problems can be observed by the bbob observer at the same time.
+ */
+MU_TEST(test_coco_observer_bbob_open_loggers) {
+
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem1, *problem2, *problem3;
+  const char *result_folder;
+  double x[3] = { 0, 0, 0 };
+  double y[1];
+
+  suite = coco_suite("bbob", NULL, NULL);
+  observer = coco_observer("bbob", "result_folder: test_open_loggers");
+  result_folder = coco_observer_get_result_folder(observer);
+
+  problem1 = coco_suite_get_problem_by_function_dimension_instance(suite, 1, 2, 1);
+  problem1 = coco_problem_add_observer(problem1, observer);
+  problem2 = coco_suite_get_problem_by_function_dimension_instance(suite, 1, 2, 2);
+  problem2 = coco_problem_add_observer(problem2, observer);
+  problem3 = coco_suite_get_problem_by_function_dimension_instance(suite, 1, 3, 1);
+  problem3 = coco_problem_add_observer(problem3, observer);
+
+  coco_evaluate_function(problem1, x, y);
+  coco_evaluate_function(problem2, x, y);
+  coco_evaluate_function(problem3, x, y);
+  coco_evaluate_function(problem1, x, y);
+
+  /* The headers are written when the loggers start, unless an earlier logger of the info file is open */
+  mu_check(test_file_contains(result_folder, "bbobexp_f1_i1.info", "bbobexp_f1_DIM2_i1.dat, 1"));
+  mu_check(test_file_contains(result_folder, "bbobexp_f1_i2.info", "bbobexp_f1_DIM2_i2.dat, 2"));
+  mu_check(!test_file_contains(result_folder, "bbobexp_f1_i2.info", "DIM = 3"));
+
+  /* The second logger must not write to the data files of the first one */
+  coco_problem_free(coco_problem_remove_observer(problem2, observer));
+  mu_check(test_file_contains(result_folder, "bbobexp_f1_i2.info", "bbobexp_f1_DIM2_i2.dat, 2:1|"));
+  mu_check(test_file_contains(result_folder, "bbobexp_f1_i2.info", "bbobexp_f1_DIM3_i2.dat, 1"));
+  coco_problem_free(coco_problem_remove_observer(problem1, observer));
+  mu_check(test_file_contains(result_folder, "bbobexp_f1_i1.info", "bbobexp_f1_DIM2_i1.dat, 1:2|"));
+  mu_check(test_file_contains(result_folder, "bbobexp_f1_i2.info", "bbobexp_f1_DIM2_i2.dat, 2:1|"));
+  mu_check(test_file_contains(result_folder, "data_f1/bbobexp_f1_DIM2_i2.dat", "%"));
+
+  /* The observer is freed before the third logger */
+  result_folder = coco_strdup(result_folder);
+  coco_observer_free(observer);
+  mu_check(test_file_contains(result_folder, "bbobexp_f1_i2.info", "\nsuite = 'bbob', funcId = 1, DIM = 3,"));
+  mu_check(!test_file_contains(result_folder, "bbobexp_f1_i2.info", "bbobexp_f1_DIM3_i2.dat, 1:1|"));
+  coco_problem_free(problem3);
+  mu_check(test_file_contains(result_folder, "bbobexp_f1_i2.info", "bbobexp_f1_DIM3_i2.dat, 1:1|"));
+
+  coco_free_memory((char *) result_folder);
+  coco_suite_free(suite);
+}
+
+/**
+ * Returns 1 if the two files exist and have the same content and 0 otherwise.
+ */
+static int test_files_equal(const char *path1, const char *path2) {
+  int result = 1, c1, c2;
+  FILE *file1, *file2;
+
+  file1 = fopen(path1, "rb");
+  file2 = fopen(path2, "rb");
+  if ((file1 == NULL) || (file2 == NULL))
+    result = 0;
+  while (result) {
+    c1 = fgetc(file1);
+    c2 = fgetc(file2);
+    if (c1 != c2)
+      result = 0;
+    if (c1 == EOF)
+      break;
+  }
+  if (file1 != NULL)
+    fclose(file1);
+  if (file2 != NULL)
+    fclose(file2);
+  return result;
+}
+
+/**
+ * Returns 1 if the file with the given name in the first folder, converted from the bbob-binary format to
+ * text, is the same as the file with the given name in the second folder and 0 otherwise.
+ */
+static int test_binary_file_equals(const char *binary_folder, const char *text_folder, const char *file_name) {
+  char path[COCO_PATH_MAX + 1] = { 0 };
+  const char *converted_file_name = "test_binary_results.txt";
+  int result;
+
+  coco_join_path(path, sizeof(path), binary_folder, file_name, NULL);
+  coco_bbob_results_to_text(path, converted_file_name);
+  path[0] = '\0';
+  coco_join_path(path, sizeof(path), text_folder, file_name, NULL);
+  result = test_files_equal(converted_file_name, path);
+  remove(converted_file_name);
+  return result;
+}
+
+/**
+ * Runs a random search on two instances of a problem of the suite with the given observer.
+ */
+static void test_coco_observer_run_random_search(const char *suite_name, coco_observer_t *observer) {
+  coco_suite_t *suite;
+  coco_problem_t *problem;
+  coco_random_state_t *random_generator = coco_random_new(1);
+  const double *lower, *upper;
+  double x[5], y[1];
+  size_t instance, i, j;
+
+  suite = coco_suite(suite_name, NULL, NULL);
+  for (instance = 1; instance <= 2; instance++) {
+    problem = coco_suite_get_problem_by_function_dimension_instance(suite, 2, 5, instance);
+    problem = coco_problem_add_observer(problem, observer);
+    lower = coco_problem_get_smallest_values_of_interest(problem);
+    upper = coco_problem_get_largest_values_of_interest(problem);
+    for (i = 0; i < 300; i++) {
+      for (j = 0; j < 5; j++)
+        x[j] = lower[j] + coco_random_uniform(random_generator) * (upper[j] - lower[j]);
+      coco_evaluate_function(problem, x, y);
+    }
+    coco_problem_free(coco_problem_remove_observer(problem, observer));
+  }
+  coco_suite_free(suite);
+  coco_random_free(random_generator);
+}
+
+/**
+ * Runs the same random search as test_coco_observer_run_random_search, but evaluates the points with
+ * coco_evaluate_function_batch in batches of the given size.
+ */
+static void test_coco_observer_run_random_search_batch(const char *suite_name,
+                                                       coco_observer_t *observer,
+                                                       const size_t batch_size) {
+  coco_suite_t *suite;
+  coco_problem_t *problem;
+  coco_random_state_t *random_generator = coco_random_new(1);
+  const double *lower, *upper;
+  double *x, *y;
+  size_t instance, i, j, k, number_of_points;
+
+  x = coco_allocate_vector(batch_size * 5);
+  y = coco_allocate_vector(batch_size);
+  suite = coco_suite(suite_name, NULL, NULL);
+  for (instance = 1; instance <= 2; instance++) {
+    problem = coco_suite_get_problem_by_function_dimension_instance(suite, 2, 5, instance);
+    problem = coco_problem_add_observer(problem, observer);
+    lower = coco_problem_get_smallest_values_of_interest(problem);
+    upper = coco_problem_get_largest_values_of_interest(problem);
+    for (i = 0; i < 300; i += number_of_points) {
+      number_of_points = (300 - i < batch_size) ? 300 - i : batch_size;
+      for (k = 0; k < number_of_points; k++) {
+        for (j = 0; j < 5; j++)
+          x[k * 5 + j] = lower[j] + coco_random_uniform(random_generator) * (upper[j] - lower[j]);
+      }
+      coco_evaluate_function_batch(problem, number_of_points, x, y);
+    }
+    coco_problem_free(coco_problem_remove_observer(problem, observer));
+  }
+  coco_suite_free(suite);
+  coco_random_free(random_generator);
+  coco_free_memory(x);
+  coco_free_memory(y);
+}
+
+/**
+ * Tests whether evaluating the points in batches produces the same files as evaluating them one by one.
+ */
+MU_TEST(test_coco_observer_bbob_batch_evaluation) {
+
+  const char *file_names[] = { "bbobexp_f2_i1.info", "data_f2/bbobexp_f2_DIM5_i1.dat",
+      "data_f2/bbobexp_f2_DIM5_i1.tdat", "data_f2/bbobexp_f2_DIM5_i1.rdat" };
+  coco_observer_t *single_observer, *batch_observer;
+  char *single_folder, *batch_folder;
+  char single_path[COCO_PATH_MAX + 1], batch_path[COCO_PATH_MAX + 1];
+  size_t j;
+
+  single_observer = coco_observer("bbob", "result_folder: test_single_evaluation");
+  batch_observer = coco_observer("bbob", "result_folder: test_batch_evaluation");
+  single_folder = coco_strdup(coco_observer_get_result_folder(single_observer));
+  batch_folder = coco_strdup(coco_observer_get_result_folder(batch_observer));
+
+  test_coco_observer_run_random_search("bbob", single_observer);
+  test_coco_observer_run_random_search_batch("bbob", batch_observer, 7);
+  coco_observer_free(single_observer);
+  coco_observer_free(batch_observer);
+
+  for (j = 0; j < 4; j++) {
+    single_path[0] = '\0';
+    batch_path[0] = '\0';
+    coco_join_path(single_path, sizeof(single_path), single_folder, file_names[j], NULL);
+    coco_join_path(batch_path, sizeof(batch_path), batch_folder, file_names[j], NULL);
+    mu_check(test_files_equal(single_path, batch_path));
+  }
+
+  coco_free_memory(single_folder);
+  coco_free_memory(batch_folder);
+}
+
+/**
+ * Tests whether the data files written in the bbob-binary format can be converted to the same text as
+ * written in the text format.
+ */
+MU_TEST(test_coco_observer_bbob_binary_data_format) {
+
+  const char *suite_names[] = { "bbob-constrained", "bbob-mixint" };
+  const char *file_names[] = { "data_f2/bbobexp_f2_DIM5_i1.dat", "data_f2/bbobexp_f2_DIM5_i1.tdat",
+      "data_f2/bbobexp_f2_DIM5_i1.rdat" };
+  coco_observer_t *text_observer, *binary_observer;
+  char *text_folder, *binary_folder;
+  size_t i, j;
+
+  for (i = 0; i < 2; i++) {
+    text_observer = coco_observer("bbob", "result_folder: test_text_format log_discrete_as_int: 1");
+    binary_observer = coco_observer("bbob",
+        "result_folder: test_binary_format log_discrete_as_int: 1 data_format: bbob-binary");
+    text_folder = coco_strdup(coco_observer_get_result_folder(text_observer));
+    binary_folder = coco_strdup(coco_observer_get_result_folder(binary_observer));
+
+    test_coco_observer_run_random_search(suite_names[i], text_observer);
+    test_coco_observer_run_random_search(suite_names[i], binary_observer);
+    coco_observer_free(text_observer);
+    coco_observer_free(binary_observer);
+
+    mu_check(test_file_contains(binary_folder, "bbobexp_f2_i1.info", "data_format = 'bbob-binary'"));
+    for (j = 0; j < 3; j++)
+      mu_check(test_binary_file_equals(binary_folder, text_folder, file_names[j]));
+
+    coco_free_memory(text_folder);
+    coco_free_memory(binary_folder);
+  }
+}
+
+/**
+ * Tests whether a run that is written in blocks of COCO_BINARY_RESULTS_ROWS_PER_BLOCK rows while it is
+ * logged is converted to the same text as the run written in a single block.
+ */
+MU_TEST(test_coco_observer_bbob_binary_blocks) {
+
+  const char *file_names[] = { "test_binary_blocks_incremental.dat", "test_binary_blocks_single.dat",
+      "test_binary_blocks_incremental.txt", "test_binary_blocks_single.txt" };
+  const size_t number_of_rows[] = { 2 * COCO_BINARY_RESULTS_ROWS_PER_BLOCK + 88, 10 };
+  const unsigned char constraint_digits[] = { 0, 3 };
+  coco_binary_results_block_t *incremental_block, *single_block;
+  double x[3];
+  size_t run, row;
+
+  remove(file_names[0]);
+  remove(file_names[1]);
+  for (run = 0; run < 2; run++) {
+    incremental_block = coco_binary_results_block_allocate(file_names[0], 3, 1, 2, 1, -1.5);
+    single_block = coco_binary_results_block_allocate(NULL, 3, 1, 2, 1, -1.5);
+    for (row = 0; row < number_of_rows[run]; row++) {
+      x[0] = (double) (row % 7);
+      x[1] = 1.0 / (double) (row + 1);
+      x[2] = -(double) row * 1e-3;
+      coco_binary_results_block_append(incremental_block, row + 1, row / 2, (double) row, -1.0 / (double) (row + 1),
+          x, (row % 3 == 0) ? NULL : constraint_digits);
+      coco_binary_results_block_append(single_block, row + 1, row / 2, (double) row, -1.0 / (double) (row + 1),
+          x, (row % 3 == 0) ? NULL : constraint_digits);
+    }
+    mu_check(incremental_block->number_of_rows < COCO_BINARY_RESULTS_ROWS_PER_BLOCK);
+    coco_binary_results_block_close(incremental_block);
+    coco_binary_results_block_write(single_block, file_names[1]);
+    coco_binary_results_block_free(single_block);
+  }
+
+  mu_check(coco_bbob_results_to_text(file_names[0], file_names[2]) == 2);
+  mu_check(coco_bbob_results_to_text(file_names[1], file_names[3]) == 2);
+  mu_check(test_files_equal(file_names[2], file_names[3]));
+  for (run = 0; run < 4; run++)
+    remove(file_names[run]);
+}
+
+/**
+ * Tests whether the files written by the I/O thread of an observer are the same as the ones written
+ * synchronously.
+ */
+MU_TEST(test_coco_observer_async_io) {
+
+  const char *observer_names[] = { "bbob", "rw" };
+  const char *file_names[2][4] = {
+      { "bbobexp_f2_i1.info", "data_f2/bbobexp_f2_DIM5_i1.dat", "data_f2/bbobexp_f2_DIM5_i1.tdat",
+        "data_f2/bbobexp_f2_DIM5_i1.rdat" },
+      { "bbob_f002_i01_d05_rw.txt", "bbob_f002_i02_d05_rw.txt", NULL, NULL } };
+  coco_observer_t *sync_observer, *async_observer;
+  char *sync_folder, *async_folder;
+  char sync_path[COCO_PATH_MAX + 1], async_path[COCO_PATH_MAX + 1];
+  size_t i, j;
+
+  for (i = 0; i < 2; i++) {
+    sync_observer = coco_observer(observer_names[i], "result_folder: test_sync_io");
+    async_observer = coco_observer(observer_names[i],
+        "result_folder: test_async_io async_io: 1 async_io_queue_size: 2");
+    sync_folder = coco_strdup(coco_observer_get_result_folder(sync_observer));
+    async_folder = coco_strdup(coco_observer_get_result_folder(async_observer));
+
+    test_coco_observer_run_random_search("bbob", sync_observer);
+    test_coco_observer_run_random_search("bbob", async_observer);
+    coco_observer_free(sync_observer);
+    coco_observer_free(async_observer);
+
+    for (j = 0; (j < 4) && (file_names[i][j] != NULL); j++) {
+      sync_path[0] = '\0';
+      async_path[0] = '\0';
+      coco_join_path(sync_path, sizeof(sync_path), sync_folder, file_names[i][j], NULL);
+      coco_join_path(async_path, sizeof(async_path), async_folder, file_names[i][j], NULL);
+      mu_check(test_files_equal(sync_path, async_path));
+    }
+
+    coco_free_memory(sync_folder);
+    coco_free_memory(async_folder);
+  }
+}
+
 /**
  * Run all tests in this file.
  */
 MU_TEST_SUITE(test_all_coco_observer) {
   MU_RUN_TEST(test_coco_observer_targets_trigger);
   MU_RUN_TEST(test_coco_observer_evaluations_trigger);
+  MU_RUN_TEST(test_coco_observer_bbob_open_loggers);
+  MU_RUN_TEST(test_coco_observer_bbob_batch_evaluation);
+  MU_RUN_TEST(test_coco_observer_bbob_binary_data_format);
+  MU_RUN_TEST(test_coco_observer_bbob_binary_blocks);
+  MU_RUN_TEST(test_coco_observer_async_io);
 }
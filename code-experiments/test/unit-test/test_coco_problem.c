@@ -129,13 +129,481 @@ MU_TEST(test_coco_problem_get_largest_fvalues_of_interest_bbob_biobj_ext) {
   coco_suite_free(suite);
 }
 
+/**
+ * Evaluates the problems of the given suite once by calling coco_evaluate_function on each point and once
+ * by calling coco_evaluate_function_batch on all points and checks that the results are the same.
+ */
+static void test_coco_evaluate_function_batch_on_suite(const char *suite_name, const char *suite_options) {
+
+  coco_suite_t *suite_single, *suite_batch;
+  coco_problem_t *problem_single, *problem_batch;
+  coco_random_state_t *random_generator = coco_random_new(4242);
+  const size_t number_of_points = 20;
+  double *x, *y_single, *y_batch;
+  size_t dimension, number_of_objectives, i, k;
+  const double *lower, *upper;
+
+  suite_single = coco_suite(suite_name, NULL, suite_options);
+  suite_batch = coco_suite(suite_name, NULL, suite_options);
+  while ((problem_single = coco_suite_get_next_problem(suite_single, NULL)) != NULL) {
+    problem_batch = coco_suite_get_next_problem(suite_batch, NULL);
+    mu_check(problem_batch != NULL);
+
+    dimension = coco_problem_get_dimension(problem_single);
+    number_of_objectives = coco_problem_get_number_of_objectives(problem_single);
+    lower = coco_problem_get_smallest_values_of_interest(problem_single);
+    upper = coco_problem_get_largest_values_of_interest(problem_single);
+    x = coco_allocate_vector(number_of_points * dimension);
+    y_single = coco_allocate_vector(number_of_points * number_of_objectives);
+    y_batch = coco_allocate_vector(number_of_points * number_of_objectives);
+
+    for (k = 0; k < number_of_points; k++) {
+      for (i = 0; i < dimension; i++)
+        x[k * dimension + i] = lower[i] + (upper[i] - lower[i]) * coco_random_uniform(random_generator);
+    }
+    /* Points that are not evaluated */
+    x[3 * dimension] = NAN;
+    x[7 * dimension + dimension - 1] = INFINITY;
+
+    for (k = 0; k < number_of_points; k++)
+      coco_evaluate_function(problem_single, x + k * dimension, y_single + k * number_of_objectives);
+    coco_evaluate_function_batch(problem_batch, number_of_points, x, y_batch);
+
+    for (k = 0; k < number_of_points * number_of_objectives; k++) {
+      if (coco_is_nan(y_single[k]))
+        mu_check(coco_is_nan(y_batch[k]));
+      else
+        mu_check(y_single[k] == y_batch[k]);
+    }
+    mu_check(coco_problem_get_evaluations(problem_single) == coco_problem_get_evaluations(problem_batch));
+    mu_check(coco_problem_get_evaluations(problem_batch) == number_of_points - 2);
+    if (number_of_objectives == 1) {
+      mu_check(coco_problem_get_best_observed_fvalue1(problem_single)
+          == coco_problem_get_best_observed_fvalue1(problem_batch));
+    }
+
+    coco_free_memory(x);
+    coco_free_memory(y_single);
+    coco_free_memory(y_batch);
+  }
+  mu_check(coco_suite_get_next_problem(suite_batch, NULL) == NULL);
+  coco_suite_free(suite_single);
+  coco_suite_free(suite_batch);
+  coco_random_free(random_generator);
+}
+
+/**
+ * Tests whether coco_evaluate_function_batch returns the same values and counts the same number of
+ * evaluations as calling coco_evaluate_function on each of the points.
+ */
+MU_TEST(test_coco_evaluate_function_batch) {
+
+  test_coco_evaluate_function_batch_on_suite("bbob", "dimensions: 2,10 instance_indices: 1");
+  test_coco_evaluate_function_batch_on_suite("bbob-biobj", "dimensions: 5 instance_indices: 2");
+  test_coco_evaluate_function_batch_on_suite("bbob-largescale", "dimensions: 20 instance_indices: 1");
+  test_coco_evaluate_function_batch_on_suite("bbob-constrained", "dimensions: 2 instance_indices: 1");
+}
+
+#if defined(COCO_COUNT_ALLOCATIONS)
+/**
+ * Evaluates the problems of the given suite a few times and then checks that further evaluations (of
+ * single points and of batches of the same size) do not allocate any memory.
+ */
+static void test_coco_evaluate_function_no_allocation_on_suite(const char *suite_name, const char *suite_options) {
+
+  coco_suite_t *suite;
+  coco_problem_t *problem;
+  coco_random_state_t *random_generator = coco_random_new(4243);
+  const size_t number_of_points = 10;
+  double *x, *y, *cons;
+  size_t dimension, number_of_objectives, number_of_constraints, i, k, round, allocations;
+  const double *lower, *upper;
+
+  suite = coco_suite(suite_name, NULL, suite_options);
+  while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+
+    dimension = coco_problem_get_dimension(problem);
+    number_of_objectives = coco_problem_get_number_of_objectives(problem);
+    number_of_constraints = coco_problem_get_number_of_constraints(problem);
+    lower = coco_problem_get_smallest_values_of_interest(problem);
+    upper = coco_problem_get_largest_values_of_interest(problem);
+    x = coco_allocate_vector(number_of_points * dimension);
+    y = coco_allocate_vector(number_of_points * number_of_objectives);
+    cons = coco_allocate_vector(number_of_constraints + 1);
+
+    /* The first round warms up the scratch memory, the second one must not allocate anything */
+    allocations = 0;
+    for (round = 0; round < 2; round++) {
+      for (k = 0; k < number_of_points; k++) {
+        for (i = 0; i < dimension; i++)
+          x[k * dimension + i] = lower[i] + (upper[i] - lower[i]) * coco_random_uniform(random_generator);
+      }
+      if (round == 1)
+        allocations = coco_allocate_memory_counter;
+      for (k = 0; k < number_of_points; k++) {
+        coco_evaluate_function(problem, x + k * dimension, y + k * number_of_objectives);
+        if (number_of_constraints > 0)
+          coco_evaluate_constraint(problem, x + k * dimension, cons);
+      }
+      coco_evaluate_function_batch(problem, number_of_points, x, y);
+    }
+    mu_check(coco_allocate_memory_counter == allocations);
+
+    coco_free_memory(x);
+    coco_free_memory(y);
+    coco_free_memory(cons);
+  }
+  coco_suite_free(suite);
+  coco_random_free(random_generator);
+}
+
+/**
+ * Tests whether the evaluations allocate memory only when the problem is evaluated for the first time.
+ */
+MU_TEST(test_coco_evaluate_function_no_allocation) {
+
+  test_coco_evaluate_function_no_allocation_on_suite("bbob", "dimensions: 2,10 instance_indices: 1");
+  test_coco_evaluate_function_no_allocation_on_suite("bbob", "dimensions: 10 instance_indices: 1 compiled: 1");
+  test_coco_evaluate_function_no_allocation_on_suite("bbob-biobj", "dimensions: 5 instance_indices: 2");
+  test_coco_evaluate_function_no_allocation_on_suite("bbob-largescale", "dimensions: 20 instance_indices: 1");
+  test_coco_evaluate_function_no_allocation_on_suite("bbob-constrained", "dimensions: 2 instance_indices: 1");
+  test_coco_evaluate_function_no_allocation_on_suite("bbob-mixint", "dimensions: 5 instance_indices: 1");
+}
+#endif
+
+/**
+ * Evaluates the problems of the given suite and their clones alternately and checks that the results are
+ * the same and that the evaluations are merged correctly. The clone of each problem is evaluated once more
+ * after the suite has freed the problem.
+ */
+static void test_coco_problem_clone_on_suite(const char *suite_name, const char *suite_options) {
+
+  coco_suite_t *suite;
+  coco_problem_t *problem, *clone, *previous_clone = NULL;
+  coco_random_state_t *random_generator = coco_random_new(4244);
+  const size_t number_of_points = 5;
+  double *x, *y_problem, *y_clone, *cons_problem, *cons_clone;
+  size_t dimension, number_of_objectives, number_of_constraints, i, k;
+  const double *lower, *upper;
+  double best_observed_fvalue;
+
+  suite = coco_suite(suite_name, NULL, suite_options);
+  while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+
+    dimension = coco_problem_get_dimension(problem);
+    number_of_objectives = coco_problem_get_number_of_objectives(problem);
+    number_of_constraints = coco_problem_get_number_of_constraints(problem);
+    lower = coco_problem_get_smallest_values_of_interest(problem);
+    upper = coco_problem_get_largest_values_of_interest(problem);
+    x = coco_allocate_vector(dimension);
+    y_problem = coco_allocate_vector(number_of_objectives);
+    y_clone = coco_allocate_vector(number_of_objectives);
+    cons_problem = coco_allocate_vector(number_of_constraints + 1);
+    cons_clone = coco_allocate_vector(number_of_constraints + 1);
+
+    /* The previous problem has already been freed by the suite */
+    if (previous_clone != NULL) {
+      for (i = 0; i < coco_problem_get_dimension(previous_clone); i++)
+        x[i] = 0;
+      coco_evaluate_function(previous_clone, x, y_clone);
+      mu_check(coco_problem_get_evaluations(previous_clone) == 1);
+      coco_problem_free(previous_clone);
+    }
+
+    clone = coco_problem_clone(problem);
+    mu_check(coco_problem_get_evaluations(clone) == 0);
+    for (k = 0; k < number_of_points; k++) {
+      for (i = 0; i < dimension; i++)
+        x[i] = lower[i] + (upper[i] - lower[i]) * coco_random_uniform(random_generator);
+      coco_evaluate_function(problem, x, y_problem);
+      coco_evaluate_function(clone, x, y_clone);
+      for (i = 0; i < number_of_objectives; i++)
+        mu_check(y_problem[i] == y_clone[i]);
+      if (number_of_constraints > 0) {
+        coco_evaluate_constraint(clone, x, cons_clone);
+        coco_evaluate_constraint(problem, x, cons_problem);
+        for (i = 0; i < number_of_constraints; i++)
+          mu_check(cons_problem[i] == cons_clone[i]);
+      }
+    }
+
+    mu_check(coco_problem_get_evaluations(clone) == number_of_points);
+    best_observed_fvalue = coco_problem_get_best_observed_fvalue1(problem);
+    coco_problem_merge_evaluations(problem, clone);
+    mu_check(coco_problem_get_evaluations(problem) == 2 * number_of_points);
+    mu_check(coco_problem_get_evaluations(clone) == 0);
+    mu_check(coco_problem_get_best_observed_fvalue1(problem) == best_observed_fvalue);
+    if (number_of_constraints > 0) {
+      mu_check(coco_problem_get_evaluations_constraints(problem) == 2 * number_of_points);
+      mu_check(coco_problem_get_evaluations_constraints(clone) == 0);
+    }
+    previous_clone = clone;
+
+    coco_free_memory(x);
+    coco_free_memory(y_problem);
+    coco_free_memory(y_clone);
+    coco_free_memory(cons_problem);
+    coco_free_memory(cons_clone);
+  }
+  coco_suite_free(suite);
+  if (previous_clone != NULL)
+    coco_problem_free(previous_clone);
+  coco_random_free(random_generator);
+}
+
+/**
+ * Tests whether the clones of problems return the same values as the problems and whether they can outlive
+ * the problems.
+ */
+MU_TEST(test_coco_problem_clone) {
+
+  test_coco_problem_clone_on_suite("bbob", "dimensions: 2,10 instance_indices: 1");
+  test_coco_problem_clone_on_suite("bbob", "dimensions: 10 instance_indices: 1 compiled: 1");
+  test_coco_problem_clone_on_suite("bbob-biobj", "dimensions: 5 instance_indices: 2");
+  test_coco_problem_clone_on_suite("bbob-largescale", "dimensions: 20 instance_indices: 1");
+  test_coco_problem_clone_on_suite("bbob-constrained", "dimensions: 2 instance_indices: 1");
+  test_coco_problem_clone_on_suite("bbob-mixint", "dimensions: 5 instance_indices: 1");
+}
+
+#if defined(COCO_THREADS)
+/**
+ * The work of a thread evaluating a clone of a problem.
+ */
+typedef struct {
+  coco_problem_t *clone;
+  size_t number_of_points;
+  const double *x;
+  double *y;
+} test_coco_problem_clone_work_t;
+
+/**
+ * Evaluates the clone in all points of the work.
+ */
+static void test_coco_problem_clone_evaluate(test_coco_problem_clone_work_t *work) {
+  size_t k;
+  const size_t dimension = coco_problem_get_dimension(work->clone);
+  const size_t number_of_objectives = coco_problem_get_number_of_objectives(work->clone);
+
+  for (k = 0; k < work->number_of_points; k++)
+    coco_evaluate_function(work->clone, work->x + k * dimension, work->y + k * number_of_objectives);
+}
+
+#if defined(HAVE_PTHREAD)
+/**
+ * The function run by each thread evaluating a clone.
+ */
+static void *test_coco_problem_clone_thread(void *work) {
+  test_coco_problem_clone_evaluate((test_coco_problem_clone_work_t *) work);
+  return NULL;
+}
+#elif defined(HAVE_WIN_THREADS)
+/**
+ * The function run by each thread evaluating a clone.
+ */
+static DWORD WINAPI test_coco_problem_clone_thread(LPVOID work) {
+  test_coco_problem_clone_evaluate((test_coco_problem_clone_work_t *) work);
+  return 0;
+}
+#endif
+
+/**
+ * Evaluates clones of the problems of the given suite concurrently in several threads and checks that they
+ * return the same values as the problems evaluated sequentially.
+ */
+static void test_coco_problem_clone_threads_on_suite(const char *suite_name, const char *suite_options) {
+
+  coco_suite_t *suite;
+  coco_problem_t *problem;
+  coco_random_state_t *random_generator = coco_random_new(4245);
+  const size_t number_of_points = 100;
+  test_coco_problem_clone_work_t work[4];
+  double *x, *y;
+  size_t dimension, number_of_objectives, i, j, k;
+  const double *lower, *upper;
+#if defined(HAVE_PTHREAD)
+  pthread_t threads[4];
+#elif defined(HAVE_WIN_THREADS)
+  HANDLE threads[4];
+#endif
+
+  suite = coco_suite(suite_name, NULL, suite_options);
+  while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+
+    dimension = coco_problem_get_dimension(problem);
+    number_of_objectives = coco_problem_get_number_of_objectives(problem);
+    lower = coco_problem_get_smallest_values_of_interest(problem);
+    upper = coco_problem_get_largest_values_of_interest(problem);
+    x = coco_allocate_vector(number_of_points * dimension);
+    y = coco_allocate_vector(number_of_points * number_of_objectives);
+    for (k = 0; k < number_of_points; k++) {
+      for (i = 0; i < dimension; i++)
+        x[k * dimension + i] = lower[i] + (upper[i] - lower[i]) * coco_random_uniform(random_generator);
+      coco_evaluate_function(problem, x + k * dimension, y + k * number_of_objectives);
+    }
+
+    /* The clones are created and freed in this thread, but evaluated concurrently */
+    for (j = 0; j < 4; j++) {
+      work[j].clone = coco_problem_clone(problem);
+      work[j].number_of_points = number_of_points;
+      work[j].x = x;
+      work[j].y = coco_allocate_vector(number_of_points * number_of_objectives);
+    }
+#if defined(HAVE_PTHREAD)
+    for (j = 0; j < 4; j++)
+      mu_check(pthread_create(&threads[j], NULL, test_coco_problem_clone_thread, &work[j]) == 0);
+    for (j = 0; j < 4; j++)
+      pthread_join(threads[j], NULL);
+#elif defined(HAVE_WIN_THREADS)
+    for (j = 0; j < 4; j++) {
+      threads[j] = CreateThread(NULL, 0, test_coco_problem_clone_thread, &work[j], 0, NULL);
+      mu_check(threads[j] != NULL);
+    }
+    for (j = 0; j < 4; j++) {
+      WaitForSingleObject(threads[j], INFINITE);
+      CloseHandle(threads[j]);
+    }
+#endif
+
+    for (j = 0; j < 4; j++) {
+      for (k = 0; k < number_of_points * number_of_objectives; k++)
+        mu_check(work[j].y[k] == y[k]);
+      mu_check(coco_problem_get_evaluations(work[j].clone) == number_of_points);
+      coco_problem_merge_evaluations(problem, work[j].clone);
+      coco_problem_free(work[j].clone);
+      coco_free_memory(work[j].y);
+    }
+    mu_check(coco_problem_get_evaluations(problem) == 5 * number_of_points);
+
+    coco_free_memory(x);
+    coco_free_memory(y);
+  }
+  coco_suite_free(suite);
+  coco_random_free(random_generator);
+}
+
+/**
+ * Tests whether clones of problems can be evaluated concurrently in several threads.
+ */
+MU_TEST(test_coco_problem_clone_threads) {
+
+  test_coco_problem_clone_threads_on_suite("bbob", "dimensions: 2,10 instance_indices: 1");
+  test_coco_problem_clone_threads_on_suite("bbob", "dimensions: 10 instance_indices: 1 compiled: 1");
+  test_coco_problem_clone_threads_on_suite("bbob-biobj", "dimensions: 5 instance_indices: 2");
+  test_coco_problem_clone_threads_on_suite("bbob-largescale", "dimensions: 20 instance_indices: 1");
+  test_coco_problem_clone_threads_on_suite("bbob-mixint", "dimensions: 5 instance_indices: 1");
+}
+#endif
+
+/**
+ * Tests whether the fused permuted block-rotation of transform_vars_permblockdiag gives exactly the same
+ * result as the chain permutation -> block-rotation -> permutation it replaces, on random inputs.
+ */
+MU_TEST(test_transform_vars_permblockdiag) {
+
+  const size_t dimensions[] = { 20, 40, 80, 320 };
+  coco_random_state_t *random_generator = coco_random_new(7);
+  transform_vars_permblockdiag_t data;
+  double **B;
+  size_t *P1, *P2, *block_sizes, *block_size_map, *first_non_zero_map;
+  double *x, *z, *w, *y_chain, *y_fused;
+  size_t nb_blocks, k, i, j, idx_block, row, trial;
+
+  for (k = 0; k < sizeof(dimensions) / sizeof(dimensions[0]); k++) {
+    const size_t n = dimensions[k];
+    const long rseed = 10000 + (long) k;
+
+    block_sizes = coco_get_block_sizes(&nb_blocks, n, "bbob-largescale");
+    B = coco_allocate_blockmatrix(n, block_sizes, nb_blocks);
+    coco_compute_blockrotation(B, rseed + 1000000, n, block_sizes, nb_blocks);
+    P1 = coco_allocate_vector_size_t(n);
+    P2 = coco_allocate_vector_size_t(n);
+    coco_compute_truncated_uniform_swap_permutation(P1, rseed + 2000000, n, coco_get_nb_swaps(n, "bbob-largescale"),
+        coco_get_swap_range(n, "bbob-largescale"));
+    coco_compute_truncated_uniform_swap_permutation(P2, rseed + 3000000, n, coco_get_nb_swaps(n, "bbob-largescale"),
+        coco_get_swap_range(n, "bbob-largescale"));
+
+    /* The data of the fused transformation, as set up by transform_vars_permblockdiag */
+    data.dimension = n;
+    data.B = coco_copy_block_matrix_contiguous((const double * const *) B, block_sizes, nb_blocks);
+    data.P1 = P1;
+    data.P2_inverse = coco_allocate_vector_size_t(n);
+    for (i = 0; i < n; i++)
+      data.P2_inverse[P2[i]] = i;
+    data.block_sizes = block_sizes;
+    data.nb_blocks = nb_blocks;
+
+    /* The block size and the first non-zero column of each row, as in transform_vars_blockrotation */
+    block_size_map = coco_allocate_vector_size_t(n);
+    first_non_zero_map = coco_allocate_vector_size_t(n);
+    row = 0;
+    for (idx_block = 0; idx_block < nb_blocks; idx_block++) {
+      for (i = 0; i < block_sizes[idx_block]; i++) {
+        block_size_map[row + i] = block_sizes[idx_block];
+        first_non_zero_map[row + i] = row;
+      }
+      row += block_sizes[idx_block];
+    }
+
+    x = coco_allocate_vector(n);
+    z = coco_allocate_vector(n);
+    w = coco_allocate_vector(n);
+    y_chain = coco_allocate_vector(n);
+    y_fused = coco_allocate_vector(n);
+    for (trial = 0; trial < 10; trial++) {
+      for (i = 0; i < n; i++)
+        x[i] = 10 * coco_random_uniform(random_generator) - 5;
+
+      /* transform_vars_permutation(P1) */
+      for (i = 0; i < n; i++)
+        z[i] = x[P1[i]];
+      /* transform_vars_blockrotation(B) */
+      for (i = 0; i < n; i++) {
+        w[i] = 0;
+        for (j = first_non_zero_map[i]; j < first_non_zero_map[i] + block_size_map[i]; j++)
+          w[i] += B[i][j - first_non_zero_map[i]] * z[j];
+      }
+      /* transform_vars_permutation(P2) */
+      for (i = 0; i < n; i++)
+        y_chain[i] = w[P2[i]];
+
+      transform_vars_permblockdiag_apply(&data, x, z, y_fused);
+      for (i = 0; i < n; i++)
+        mu_check(y_fused[i] == y_chain[i]);
+    }
+
+    coco_free_memory(x);
+    coco_free_memory(z);
+    coco_free_memory(w);
+    coco_free_memory(y_chain);
+    coco_free_memory(y_fused);
+    coco_free_memory(block_size_map);
+    coco_free_memory(first_non_zero_map);
+    coco_free_memory(data.B);
+    coco_free_memory(data.P2_inverse);
+    coco_free_memory(P1);
+    coco_free_memory(P2);
+    coco_free_block_matrix(B, n);
+    coco_free_memory(block_sizes);
+  }
+  coco_random_free(random_generator);
+}
+
 /**
  * Run all tests in this file.
  */
 MU_TEST_SUITE(test_all_coco_problem) {
   MU_RUN_TEST(test_coco_evaluate_function);
+  MU_RUN_TEST(test_coco_evaluate_function_batch);
+#if defined(COCO_COUNT_ALLOCATIONS)
+  MU_RUN_TEST(test_coco_evaluate_function_no_allocation);
+#endif
+  MU_RUN_TEST(test_coco_problem_clone);
+#if defined(COCO_THREADS)
+  MU_RUN_TEST(test_coco_problem_clone_threads);
+#endif
   MU_RUN_TEST(test_coco_evaluate_constraint);
   MU_RUN_TEST(test_coco_is_feasible);
   MU_RUN_TEST(test_coco_problem_get_largest_fvalues_of_interest_bbob_biobj_ext);
+  MU_RUN_TEST(test_transform_vars_permblockdiag);
 }
 
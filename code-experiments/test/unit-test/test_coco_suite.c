@@ -1,6 +1,8 @@
 #include "coco.h"
 #include "minunit_c89.h"
 
+static int test_files_equal(const char *path1, const char *path2);
+
 /* Since the move from cmocka to minunit, this code should not longer work. */
 #if 0
 
@@ -79,11 +81,649 @@ MU_TEST(test_coco_suite_encode_problem_index) {
   coco_suite_free(suite);
 }
 
+/**
+ * Checks that the problems of the given suite return the same values with and without the additional
+ * suite option (up to the given relative error).
+ */
+static void test_coco_suite_option_on_suite(const char *suite_name,
+                                            const char *suite_options,
+                                            const char *additional_option,
+                                            const double precision) {
+
+  coco_suite_t *suite, *suite_compiled;
+  coco_problem_t *problem, *problem_compiled;
+  coco_random_state_t *random_generator = coco_random_new(12345);
+  char *compiled_options = coco_strdupf("%s %s", suite_options, additional_option);
+  double *x, *y, *y_compiled;
+  size_t dimension, number_of_objectives, i, k;
+  const double *lower, *upper;
+
+  suite = coco_suite(suite_name, NULL, suite_options);
+  suite_compiled = coco_suite(suite_name, NULL, compiled_options);
+  while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+    problem_compiled = coco_suite_get_next_problem(suite_compiled, NULL);
+    mu_check(problem_compiled != NULL);
+    mu_check(strcmp(coco_problem_get_id(problem), coco_problem_get_id(problem_compiled)) == 0);
+
+    dimension = coco_problem_get_dimension(problem);
+    number_of_objectives = coco_problem_get_number_of_objectives(problem);
+    lower = coco_problem_get_smallest_values_of_interest(problem);
+    upper = coco_problem_get_largest_values_of_interest(problem);
+    x = coco_allocate_vector(dimension);
+    y = coco_allocate_vector(number_of_objectives);
+    y_compiled = coco_allocate_vector(number_of_objectives);
+
+    for (k = 0; k < 10; k++) {
+      for (i = 0; i < dimension; i++)
+        x[i] = lower[i] + (upper[i] - lower[i]) * coco_random_uniform(random_generator);
+      coco_evaluate_function(problem, x, y);
+      coco_evaluate_function(problem_compiled, x, y_compiled);
+      for (i = 0; i < number_of_objectives; i++)
+        mu_check(fabs(y[i] - y_compiled[i]) <= precision * fabs(y[i]));
+    }
+    if (number_of_objectives == 1) {
+      mu_check(coco_problem_get_best_value(problem) == coco_problem_get_best_value(problem_compiled));
+    }
+
+    coco_free_memory(x);
+    coco_free_memory(y);
+    coco_free_memory(y_compiled);
+  }
+  coco_suite_free(suite);
+  coco_suite_free(suite_compiled);
+  coco_free_memory(compiled_options);
+  coco_random_free(random_generator);
+}
+
+/**
+ * Tests the "compiled" suite option.
+ */
+MU_TEST(test_coco_suite_compiled) {
+
+  test_coco_suite_option_on_suite("bbob", "dimensions: 2,10,40 instance_indices: 1,2", "compiled: 1", 1e-13);
+  test_coco_suite_option_on_suite("bbob-biobj", "dimensions: 5 instance_indices: 1", "compiled: 1", 1e-13);
+  test_coco_suite_option_on_suite("bbob-constrained", "dimensions: 2,10 instance_indices: 1", "compiled: 1",
+      1e-13);
+}
+
+/**
+ * Tests the "fast_kernels" suite option.
+ */
+MU_TEST(test_coco_suite_fast_kernels) {
+
+  test_coco_suite_option_on_suite("bbob", "dimensions: 2,10,40 instance_indices: 1,2", "fast_kernels: 1", 1e-12);
+  test_coco_suite_option_on_suite("bbob-largescale", "dimensions: 80,640 instance_indices: 1",
+      "fast_kernels: 1", 1e-12);
+  test_coco_suite_option_on_suite("bbob-constrained", "dimensions: 2,10 instance_indices: 1",
+      "fast_kernels: 1 compiled: 1", 1e-12);
+}
+
+/**
+ * Evaluates all problems of the suite in a fixed point and returns the sum of the values.
+ */
+static double test_coco_suite_instance_store_evaluate(const char *suite_name, const char *suite_options) {
+
+  coco_suite_t *suite;
+  coco_problem_t *problem;
+  double *x, y, sum = 0;
+  size_t i;
+
+  suite = coco_suite(suite_name, NULL, suite_options);
+  while ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL) {
+    x = coco_allocate_vector(coco_problem_get_dimension(problem));
+    for (i = 0; i < coco_problem_get_dimension(problem); i++)
+      x[i] = 0.5 - 0.1 * (double) (i % 11);
+    coco_evaluate_function(problem, x, &y);
+    sum += y;
+    coco_free_memory(x);
+  }
+  coco_suite_free(suite);
+  return sum;
+}
+
+/**
+ * Tests the "instance_store" suite option on a store created with coco_instance_store_create.
+ */
+MU_TEST(test_coco_suite_instance_store) {
+
+  const char *file_name = "test_instance_store.bin";
+  const char *suite_options = "dimensions: 20,40 instance_indices: 1,2";
+  char *store_options = coco_strdupf("%s instance_store: %s", suite_options, file_name);
+  double expected;
+  FILE *file;
+  coco_instance_store_t *store;
+  size_t i, number_of_gallagher_entries;
+
+  /* The suites are constructed one after another, so that the data is not taken from the instance cache */
+  expected = test_coco_suite_instance_store_evaluate("bbob-largescale", suite_options);
+  mu_check(coco_instance_store_create(file_name, "bbob-largescale", NULL, suite_options) > 0);
+  mu_check(test_coco_suite_instance_store_evaluate("bbob-largescale", store_options) == expected);
+
+  /* Corrupted data is not used */
+  file = fopen(file_name, "r+b");
+  mu_check(file != NULL);
+  fseek(file, -100, SEEK_END);
+  fputc('x', file);
+  fclose(file);
+  mu_check(test_coco_suite_instance_store_evaluate("bbob-largescale", store_options) == expected);
+  remove(file_name);
+  coco_free_memory(store_options);
+
+  /* The local optima of the Gallagher functions are stored */
+  suite_options = "function_indices: 21,22 dimensions: 10,20 instance_indices: 1,2";
+  store_options = coco_strdupf("%s instance_store: %s", suite_options, file_name);
+  expected = test_coco_suite_instance_store_evaluate("bbob", suite_options);
+  mu_check(coco_instance_store_create(file_name, "bbob", NULL, suite_options) > 0);
+  store = coco_instance_store_open(file_name);
+  mu_check(store != NULL);
+  number_of_gallagher_entries = 0;
+  for (i = 0; i < store->number_of_entries; i++) {
+    if (strcmp(store->index[i].generator, "f_gallagher_bbob_problem_allocate") == 0)
+      number_of_gallagher_entries++;
+  }
+  mu_check(number_of_gallagher_entries == 8);
+  coco_instance_store_close(store);
+  mu_check(test_coco_suite_instance_store_evaluate("bbob", store_options) == expected);
+  remove(file_name);
+  coco_free_memory(store_options);
+}
+
+/**
+ * @brief Data used by test_coco_suite_run_solver.
+ */
+typedef struct {
+  size_t *number_of_calls;  /**< @brief The number of calls for each problem index. */
+  double *best_values;      /**< @brief The best observed value for each problem index. */
+  size_t *evaluations;      /**< @brief The number of evaluations for each problem index. */
+  char **problem_names;     /**< @brief The name of the problem for each problem index. */
+  char **problem_ids;       /**< @brief The id of the problem for each problem index. */
+} test_coco_suite_run_data_t;
+
+/**
+ * A random search using the random stream of the problem index that records its results.
+ */
+static void test_coco_suite_run_solver(coco_problem_t *problem, void *solver_data) {
+  test_coco_suite_run_data_t *data = (test_coco_suite_run_data_t *) solver_data;
+  const size_t problem_index = coco_problem_get_suite_dep_index(problem);
+  const size_t dimension = coco_problem_get_dimension(problem);
+  const double *lower = coco_problem_get_smallest_values_of_interest(problem);
+  const double *upper = coco_problem_get_largest_values_of_interest(problem);
+  coco_random_stream_t *random_stream = coco_random_stream_new(1, problem_index);
+  double *x = coco_allocate_vector(dimension);
+  double *y = coco_allocate_vector(coco_problem_get_number_of_objectives(problem));
+  size_t i, k;
+
+  for (k = 0; k < 5 * dimension; k++) {
+    coco_random_stream_uniform_fill(random_stream, x, dimension);
+    for (i = 0; i < dimension; i++)
+      x[i] = lower[i] + (upper[i] - lower[i]) * x[i];
+    coco_evaluate_function(problem, x, y);
+  }
+  coco_evaluate_function_batch(problem, 1, x, y);
+
+  data->number_of_calls[problem_index]++;
+  data->best_values[problem_index] = coco_problem_get_best_observed_fvalue1(problem);
+  data->evaluations[problem_index] = coco_problem_get_evaluations(problem);
+  data->problem_names[problem_index] = coco_strdup(coco_problem_get_name(problem));
+  data->problem_ids[problem_index] = coco_strdup(coco_problem_get_id(problem));
+
+  coco_free_memory(x);
+  coco_free_memory(y);
+  coco_random_stream_free(random_stream);
+}
+
+/**
+ * Runs the solver on the suite in the given number of threads and returns the result folder of the
+ * observer (NULL if observer_name is NULL).
+ */
+static char *test_coco_suite_run_observed(coco_suite_t *suite,
+                                          const char *observer_name,
+                                          const char *observer_options,
+                                          const size_t number_of_threads,
+                                          test_coco_suite_run_data_t *data) {
+  const size_t number_of_problems = coco_suite_get_number_of_problems(suite);
+  coco_observer_t *observer = NULL;
+  char *result_folder = NULL;
+  size_t i;
+
+  data->number_of_calls = coco_allocate_vector_size_t(number_of_problems);
+  data->best_values = coco_allocate_vector(number_of_problems);
+  data->evaluations = coco_allocate_vector_size_t(number_of_problems);
+  data->problem_names = (char **) coco_allocate_memory(number_of_problems * sizeof(char *));
+  data->problem_ids = (char **) coco_allocate_memory(number_of_problems * sizeof(char *));
+  for (i = 0; i < number_of_problems; i++) {
+    data->number_of_calls[i] = 0;
+    data->problem_names[i] = NULL;
+    data->problem_ids[i] = NULL;
+  }
+
+  if (observer_name != NULL) {
+    observer = coco_observer(observer_name, observer_options);
+    result_folder = coco_strdup(coco_observer_get_result_folder(observer));
+  }
+  coco_suite_run(suite, observer, test_coco_suite_run_solver, data, number_of_threads);
+  coco_observer_free(observer);
+  return result_folder;
+}
+
+/**
+ * Frees the data of test_coco_suite_run_observed.
+ */
+static void test_coco_suite_run_data_free(test_coco_suite_run_data_t *data, const size_t number_of_problems) {
+  size_t i;
+
+  for (i = 0; i < number_of_problems; i++) {
+    if (data->problem_names[i] != NULL) {
+      coco_free_memory(data->problem_names[i]);
+      coco_free_memory(data->problem_ids[i]);
+    }
+  }
+  coco_free_memory(data->problem_names);
+  coco_free_memory(data->problem_ids);
+  coco_free_memory(data->number_of_calls);
+  coco_free_memory(data->best_values);
+  coco_free_memory(data->evaluations);
+}
+
+/**
+ * Returns 1 if each problem of the suite was solved once in both runs with the same results and 0
+ * otherwise.
+ */
+static int test_coco_suite_run_data_equal(coco_suite_t *suite,
+                                          const test_coco_suite_run_data_t *data1,
+                                          const test_coco_suite_run_data_t *data2) {
+  size_t i, function_idx, dimension_idx, instance_idx;
+
+  for (i = 0; i < coco_suite_get_number_of_problems(suite); i++) {
+    coco_suite_decode_problem_index(suite, i, &function_idx, &dimension_idx, &instance_idx);
+    if (suite->functions[function_idx] == 0 || suite->dimensions[dimension_idx] == 0
+        || suite->instances[instance_idx] == 0) {
+      if ((data1->number_of_calls[i] != 0) || (data2->number_of_calls[i] != 0))
+        return 0;
+      continue;
+    }
+    if ((data1->number_of_calls[i] != 1) || (data2->number_of_calls[i] != 1))
+      return 0;
+    if ((data1->best_values[i] != data2->best_values[i]) || (data1->evaluations[i] != data2->evaluations[i]))
+      return 0;
+    /* The solver sees the name and id of the (observed) problem */
+    if ((strstr(data1->problem_names[i], "coco_runner_guard") != NULL)
+        || (strstr(data2->problem_names[i], "coco_runner_guard") != NULL))
+      return 0;
+    if (strcmp(data1->problem_ids[i], data2->problem_ids[i]) != 0)
+      return 0;
+  }
+  return 1;
+}
+
+/**
+ * Returns the content of the file (NULL if it does not exist).
+ */
+static char *test_coco_suite_run_read_file(const char *path) {
+  FILE *file;
+  char *content;
+  long length;
+
+  file = fopen(path, "r");
+  if (file == NULL)
+    return NULL;
+  fseek(file, 0, SEEK_END);
+  length = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  content = coco_allocate_string((size_t) length + 1);
+  content[fread(content, 1, (size_t) length, file)] = '\0';
+  fclose(file);
+  return content;
+}
+
+/**
+ * @brief Records of the data logged in a result folder used by test_coco_suite_run.
+ */
+typedef struct {
+  char **records;                 /**< @brief The records. */
+  size_t number_of_records;       /**< @brief The number of records. */
+  char **data_files;              /**< @brief The data files (without extension) whose records were added. */
+  size_t number_of_data_files;    /**< @brief The number of data files. */
+} test_coco_suite_run_records_t;
+
+/**
+ * @brief The maximal number of records and data files in test_coco_suite_run_records_t.
+ */
+#define TEST_COCO_SUITE_RUN_MAX_RECORDS 4096
+
+/**
+ * Adds the record consisting of the first key_length characters of the key, the suffix, a space and the
+ * first text_length characters of the text.
+ */
+static void test_coco_suite_run_add_record(test_coco_suite_run_records_t *records,
+                                           const char *key,
+                                           const size_t key_length,
+                                           const char *suffix,
+                                           const char *text,
+                                           const size_t text_length) {
+  const size_t suffix_length = strlen(suffix);
+  char *record;
+
+  if (records->number_of_records >= TEST_COCO_SUITE_RUN_MAX_RECORDS)
+    coco_error("test_coco_suite_run_add_record(): too many records");
+  record = coco_allocate_string(key_length + suffix_length + text_length + 2);
+  memcpy(record, key, key_length);
+  memcpy(record + key_length, suffix, suffix_length);
+  record[key_length + suffix_length] = ' ';
+  memcpy(record + key_length + suffix_length + 1, text, text_length);
+  record[key_length + suffix_length + text_length + 1] = '\0';
+  records->records[records->number_of_records++] = record;
+}
+
+/**
+ * Orders the records alphabetically.
+ */
+static int test_coco_suite_run_compare_records(const void *a, const void *b) {
+  return strcmp(*(const char * const *) a, *(const char * const *) b);
+}
+
+/**
+ * Adds the records of the data file with the given extension. Each run in the data file (starting with a
+ * header line) is a record prefixed by the first key_length characters of the data file path, which do not
+ * depend on the info file the data file belongs to.
+ */
+static void test_coco_suite_run_add_data_file_records(test_coco_suite_run_records_t *records,
+                                                      const char *result_folder,
+                                                      const char *data_file_path,
+                                                      const size_t key_length,
+                                                      const char *file_extension) {
+  char path[COCO_PATH_MAX + 1] = { 0 };
+  char *relative_path, *content, *run_start, *line;
+
+  relative_path = coco_strdupf("%s%s", data_file_path, file_extension);
+  coco_join_path(path, sizeof(path), result_folder, relative_path, NULL);
+  coco_free_memory(relative_path);
+  content = test_coco_suite_run_read_file(path);
+  if (content == NULL)
+    return;
+
+  run_start = content;
+  for (line = content; line != NULL; line = strchr(line, '\n')) {
+    if (*line == '\n')
+      line++;
+    if ((*line == '%') && (line > run_start)) {
+      test_coco_suite_run_add_record(records, data_file_path, key_length, file_extension, run_start,
+          (size_t) (line - run_start));
+      run_start = line;
+    }
+  }
+  if (*run_start != '\0')
+    test_coco_suite_run_add_record(records, data_file_path, key_length, file_extension, run_start,
+        strlen(run_start));
+  coco_free_memory(content);
+}
+
+/**
+ * Adds the records of the info file written by the bbob observer and of the data files it references. The
+ * records are the instance entries and the runs in the data files, which do not depend on how the problems
+ * were grouped into files.
+ */
+static void test_coco_suite_run_add_info_file_records(test_coco_suite_run_records_t *records,
+                                                      const char *result_folder,
+                                                      const char *file_name) {
+  const char *file_extensions[] = { ".dat", ".tdat", ".rdat" };
+  char path[COCO_PATH_MAX + 1] = { 0 };
+  char *content, *line, *end, *entry, *next_entry;
+  size_t i, key_length;
+
+  coco_join_path(path, sizeof(path), result_folder, file_name, NULL);
+  content = test_coco_suite_run_read_file(path);
+  if (content == NULL)
+    return;
+
+  for (line = content; line != NULL; line = (end == NULL) ? NULL : end + 1) {
+    end = strchr(line, '\n');
+    if (end != NULL)
+      *end = '\0';
+    /* The other lines are the same for all info files */
+    entry = strstr(line, ".dat, ");
+    if ((strncmp(line, "suite", 5) == 0) || (entry == NULL) || (strstr(line, "_i") == NULL))
+      continue;
+
+    /* The data file path (without the first instance of the info file) is the key of the records */
+    *entry = '\0';
+    entry += 4;
+    key_length = (size_t) (strstr(line, "_i") - line);
+    for (i = 0; i < records->number_of_data_files; i++) {
+      if (strcmp(records->data_files[i], line) == 0)
+        break;
+    }
+    if (i == records->number_of_data_files) {
+      if (records->number_of_data_files >= TEST_COCO_SUITE_RUN_MAX_RECORDS)
+        coco_error("test_coco_suite_run_add_info_file_records(): too many data files");
+      records->data_files[records->number_of_data_files++] = coco_strdup(line);
+      for (i = 0; i < 3; i++)
+        test_coco_suite_run_add_data_file_records(records, result_folder, line, key_length,
+            file_extensions[i]);
+    }
+
+    while (entry != NULL) {
+      entry += 2;
+      next_entry = strstr(entry, ", ");
+      if (next_entry != NULL)
+        *next_entry = '\0';
+      test_coco_suite_run_add_record(records, line, key_length, "", entry, strlen(entry));
+      entry = next_entry;
+    }
+  }
+  coco_free_memory(content);
+}
+
+/**
+ * Returns 1 if the instance is one of the suite and 0 otherwise.
+ */
+static int test_coco_suite_run_has_instance(const coco_suite_t *suite, const size_t instance) {
+  size_t i;
+
+  for (i = 0; i < suite->number_of_instances; i++) {
+    if (suite->instances[i] == instance)
+      return 1;
+  }
+  return 0;
+}
+
+/**
+ * Returns the sorted records of the data logged by the bbob observer on the functions of the suite.
+ *
+ * The info files are named after an instance of the suite, followed by a number -001, -002, ... if the data
+ * files of that name were used by another logger at the same time (so the number is smaller than the
+ * number of threads).
+ */
+static test_coco_suite_run_records_t *test_coco_suite_run_bbob_records(coco_suite_t *suite,
+                                                                       const char *result_folder) {
+  test_coco_suite_run_records_t *records;
+  char path[COCO_PATH_MAX + 1];
+  char *file_name;
+  size_t i, j, number;
+
+  records = (test_coco_suite_run_records_t *) coco_allocate_memory(sizeof(*records));
+  records->records = (char **) coco_allocate_memory(TEST_COCO_SUITE_RUN_MAX_RECORDS * sizeof(char *));
+  records->data_files = (char **) coco_allocate_memory(TEST_COCO_SUITE_RUN_MAX_RECORDS * sizeof(char *));
+  records->number_of_records = 0;
+  records->number_of_data_files = 0;
+
+  for (i = 0; i < suite->number_of_functions; i++) {
+    if (suite->functions[i] == 0)
+      continue;
+    for (j = 0; j < suite->number_of_instances; j++) {
+      if (suite->instances[j] == 0)
+        continue;
+      for (number = 0; number < 10; number++) {
+        if (number == 0)
+          file_name = coco_strdupf("bbobexp_f%lu_i%lu.info", (unsigned long) suite->functions[i],
+              (unsigned long) suite->instances[j]);
+        else
+          file_name = coco_strdupf("bbobexp_f%lu_i%lu-%03lu.info", (unsigned long) suite->functions[i],
+              (unsigned long) suite->instances[j], (unsigned long) number);
+        path[0] = '\0';
+        coco_join_path(path, sizeof(path), result_folder, file_name, NULL);
+        if (coco_file_exists(path))
+          test_coco_suite_run_add_info_file_records(records, result_folder, file_name);
+        coco_free_memory(file_name);
+      }
+    }
+  }
+  qsort(records->records, records->number_of_records, sizeof(char *), test_coco_suite_run_compare_records);
+  return records;
+}
+
+/**
+ * Frees the records.
+ */
+static void test_coco_suite_run_records_free(test_coco_suite_run_records_t *records) {
+  size_t i;
+
+  for (i = 0; i < records->number_of_records; i++)
+    coco_free_memory(records->records[i]);
+  for (i = 0; i < records->number_of_data_files; i++)
+    coco_free_memory(records->data_files[i]);
+  coco_free_memory(records->records);
+  coco_free_memory(records->data_files);
+  coco_free_memory(records);
+}
+
+/**
+ * Returns 1 if the records are the same and 0 otherwise.
+ */
+static int test_coco_suite_run_records_equal(const test_coco_suite_run_records_t *records1,
+                                             const test_coco_suite_run_records_t *records2) {
+  size_t i;
+
+  if (records1->number_of_records != records2->number_of_records)
+    return 0;
+  for (i = 0; i < records1->number_of_records; i++) {
+    if (strcmp(records1->records[i], records2->records[i]) != 0)
+      return 0;
+  }
+  return 1;
+}
+
+/**
+ * Returns 1 if the info, .dat and .tdat files written by the bbob-biobj observer for the problems of the
+ * suite are the same in both result folders and 0 otherwise.
+ */
+static int test_coco_suite_run_biobj_files_equal(coco_suite_t *suite,
+                                                 const char *result_folder1,
+                                                 const char *result_folder2) {
+  const char *file_extensions[] = { ".dat", ".tdat" };
+  char path1[COCO_PATH_MAX + 1], path2[COCO_PATH_MAX + 1];
+  coco_problem_t *problem;
+  char *prefix, *file_name;
+  size_t i;
+  int result = 1;
+
+  while (result && ((problem = coco_suite_get_next_problem(suite, NULL)) != NULL)) {
+    prefix = coco_remove_from_string(problem->problem_id, "_i", "_d");
+    for (i = 0; i < 3; i++) {
+      if (i == 2)
+        file_name = coco_strdupf("%s_hyp.info", problem->problem_type);
+      else
+        file_name = coco_strdupf("%s/%s_hyp%s", problem->problem_type, prefix, file_extensions[i]);
+      path1[0] = '\0';
+      path2[0] = '\0';
+      coco_join_path(path1, sizeof(path1), result_folder1, file_name, NULL);
+      coco_join_path(path2, sizeof(path2), result_folder2, file_name, NULL);
+      coco_free_memory(file_name);
+      if (!test_files_equal(path1, path2))
+        result = 0;
+    }
+    coco_free_memory(prefix);
+  }
+  return result;
+}
+
+/**
+ * Tests whether coco_suite_run solves each problem once and logs the same data in several threads as
+ * sequentially.
+ */
+MU_TEST(test_coco_suite_run) {
+
+  coco_suite_t *suite;
+  test_coco_suite_run_data_t data_unobserved, data_sequential, data_parallel;
+  test_coco_suite_run_records_t *records_sequential, *records_parallel;
+  size_t *problem_indices;
+  char *folder_sequential, *folder_parallel;
+  char path[COCO_PATH_MAX + 1];
+  size_t number_of_problems, i, function_idx, dimension_idx, instance_idx, instance, previous_dimension = 0;
+
+  suite = coco_suite("bbob", NULL, "dimensions: 2,5,20 function_indices: 1,8,15,21 instance_indices: 1-3");
+  number_of_problems = coco_suite_get_number_of_problems(suite);
+
+  /* The problems are ordered by decreasing dimension */
+  problem_indices = coco_runner_get_problem_indices(suite, &i);
+  mu_check(i == 36);
+  for (i = 0; i < 36; i++) {
+    coco_suite_decode_problem_index(suite, problem_indices[i], &function_idx, &dimension_idx, &instance_idx);
+    if (i > 0)
+      mu_check(suite->dimensions[dimension_idx] <= previous_dimension);
+    previous_dimension = suite->dimensions[dimension_idx];
+  }
+  mu_check(previous_dimension == 2);
+  coco_free_memory(problem_indices);
+
+  /* The bbob observer logs the same data in several threads, only grouped differently into files */
+  test_coco_suite_run_observed(suite, NULL, NULL, 4, &data_unobserved);
+  folder_sequential = test_coco_suite_run_observed(suite, "bbob", "result_folder: test_suite_run_sequential", 1,
+      &data_sequential);
+  folder_parallel = test_coco_suite_run_observed(suite, "bbob", "result_folder: test_suite_run_parallel", 4,
+      &data_parallel);
+  mu_check(test_coco_suite_run_data_equal(suite, &data_unobserved, &data_sequential));
+  mu_check(test_coco_suite_run_data_equal(suite, &data_sequential, &data_parallel));
+  records_sequential = test_coco_suite_run_bbob_records(suite, folder_sequential);
+  records_parallel = test_coco_suite_run_bbob_records(suite, folder_parallel);
+  /* An info entry and the runs in the .dat, .tdat and .rdat files for each problem */
+  mu_check(records_sequential->number_of_records >= 4 * 36);
+  mu_check(test_coco_suite_run_records_equal(records_sequential, records_parallel));
+
+  /* The file names of the parallel run contain only instances of the suite */
+  for (i = 0; i < records_parallel->number_of_data_files; i++) {
+    instance = (size_t) strtoul(strstr(records_parallel->data_files[i], "_i") + 2, NULL, 10);
+    mu_check(test_coco_suite_run_has_instance(suite, instance));
+  }
+  path[0] = '\0';
+  coco_join_path(path, sizeof(path), folder_parallel, "bbobexp_f1_i4.info", NULL);
+  mu_check(!coco_file_exists(path));
+
+  test_coco_suite_run_records_free(records_sequential);
+  test_coco_suite_run_records_free(records_parallel);
+  test_coco_suite_run_data_free(&data_unobserved, number_of_problems);
+  test_coco_suite_run_data_free(&data_sequential, number_of_problems);
+  test_coco_suite_run_data_free(&data_parallel, number_of_problems);
+  coco_free_memory(folder_sequential);
+  coco_free_memory(folder_parallel);
+  coco_suite_free(suite);
+
+  /* The loggers of the bbob-biobj observer share their files, so that the problems are solved sequentially */
+  suite = coco_suite("bbob-biobj", NULL, "dimensions: 2,5 function_indices: 1,2,10 instance_indices: 1-3");
+  number_of_problems = coco_suite_get_number_of_problems(suite);
+  folder_sequential = test_coco_suite_run_observed(suite, "bbob-biobj",
+      "result_folder: test_suite_run_biobj_sequential", 1, &data_sequential);
+  folder_parallel = test_coco_suite_run_observed(suite, "bbob-biobj",
+      "result_folder: test_suite_run_biobj_parallel", 4, &data_parallel);
+  mu_check(test_coco_suite_run_data_equal(suite, &data_sequential, &data_parallel));
+  mu_check(test_coco_suite_run_biobj_files_equal(suite, folder_sequential, folder_parallel));
+
+  test_coco_suite_run_data_free(&data_sequential, number_of_problems);
+  test_coco_suite_run_data_free(&data_parallel, number_of_problems);
+  coco_free_memory(folder_sequential);
+  coco_free_memory(folder_parallel);
+  coco_suite_free(suite);
+}
+
 /**
  * Run all tests in this file.
  */
 MU_TEST_SUITE(test_all_coco_suite) {
   MU_RUN_TEST(test_coco_suite_encode_problem_index);
   MU_RUN_TEST(test_coco_suite_get_problem);
+  MU_RUN_TEST(test_coco_suite_compiled);
+  MU_RUN_TEST(test_coco_suite_fast_kernels);
+  MU_RUN_TEST(test_coco_suite_instance_store);
+  MU_RUN_TEST(test_coco_suite_run);
 }
 
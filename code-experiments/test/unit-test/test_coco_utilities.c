@@ -445,6 +445,430 @@ MU_TEST(test_coco_is_orthogonal) {
   coco_free_memory(M);
 }
 
+/**
+ * Tests the instance cache.
+ */
+MU_TEST(test_coco_instance_cache) {
+
+  double **B1, **B2;
+  const double *cached;
+  double *data;
+  size_t i, j;
+
+  /* Nothing is cached without users */
+  data = coco_allocate_vector(1);
+  coco_instance_cache_insert("test", 1, 1, 0, 0, data, sizeof(double));
+  mu_check(coco_instance_cache_acquire("test", 1, 1, 0, 0, sizeof(double)) == NULL);
+
+  coco_instance_cache_open();
+  data = coco_allocate_vector(1);
+  data[0] = 42;
+  coco_instance_cache_insert("test", 1, 1, 0, 0, data, sizeof(double));
+  mu_check(coco_instance_cache_acquire("test", 2, 1, 0, 0, sizeof(double)) == NULL);
+  mu_check(coco_instance_cache_acquire("test", 1, 1, 0, 1, sizeof(double)) == NULL);
+  cached = (const double *) coco_instance_cache_acquire("test", 1, 1, 0, 0, sizeof(double));
+  mu_check(cached != NULL);
+  mu_check(cached[0] == 42);
+  coco_instance_cache_release(cached);
+
+  /* Cached rotation matrices are the same as computed ones */
+  B1 = bbob2009_allocate_matrix(5, 5);
+  B2 = bbob2009_allocate_matrix(5, 5);
+  bbob2009_compute_rotation(B1, 12, 5);
+  bbob2009_compute_rotation(B2, 12, 5);
+  for (i = 0; i < 5; i++) {
+    for (j = 0; j < 5; j++) {
+      mu_check(B1[i][j] == B2[i][j]);
+    }
+  }
+  bbob2009_free_matrix(B1, 5);
+  bbob2009_free_matrix(B2, 5);
+
+  /* The cache is emptied when the last user is gone */
+  coco_instance_cache_close();
+  mu_check(coco_instance_cache_acquire("test", 1, 1, 0, 0, sizeof(double)) == NULL);
+}
+
+/**
+ * Tests that data of an instance store is only used if it has the size expected by the caller.
+ */
+MU_TEST(test_coco_instance_store_size) {
+
+  const char *file_name = "test_instance_store.bin";
+  const double *cached;
+  double *data;
+  char *previous_log_level;
+
+  /* A store recorded by a build in which the data of "test" consists of two values */
+  coco_instance_cache_open();
+  data = coco_allocate_vector(2);
+  data[0] = 42;
+  data[1] = 43;
+  coco_instance_cache_insert("test", 1, 1, 0, 0, data, 2 * sizeof(double));
+  mu_check(coco_instance_cache_write_store(file_name) == 1);
+  coco_instance_cache_close();
+
+  coco_instance_cache_open();
+  coco_instance_cache_open_store(file_name);
+  mu_check(coco_instance_cache.store != NULL);
+
+  cached = (const double *) coco_instance_cache_acquire("test", 1, 1, 0, 0, 2 * sizeof(double));
+  mu_check(cached != NULL);
+  mu_check((cached[0] == 42) && (cached[1] == 43));
+  coco_instance_cache_release(cached);
+  coco_instance_cache_close();
+
+  /* A build that expects a single value does not read beyond the data (the mismatch is a warning) */
+  coco_instance_cache_open();
+  coco_instance_cache_open_store(file_name);
+  previous_log_level = coco_strdup(coco_set_log_level("error"));
+  mu_check(coco_instance_cache_acquire("test", 1, 1, 0, 0, sizeof(double)) == NULL);
+  mu_check(coco_instance_cache_acquire("test", 1, 1, 0, 0, sizeof(double)) == NULL);
+  coco_set_log_level(previous_log_level);
+  coco_free_memory(previous_log_level);
+  coco_instance_cache_close();
+  remove(file_name);
+}
+
+/**
+ * Tests that bbob2009_compute_rotation returns orthogonal matrices also in large dimensions.
+ */
+MU_TEST(test_bbob2009_compute_rotation) {
+
+  const size_t dimensions[] = { 2, 40, 45, 100 };
+  double **B, *M;
+  size_t i, j, k;
+
+  for (k = 0; k < sizeof(dimensions) / sizeof(dimensions[0]); k++) {
+    B = bbob2009_allocate_matrix(dimensions[k], dimensions[k]);
+    M = coco_allocate_vector(dimensions[k] * dimensions[k]);
+    bbob2009_compute_rotation(B, 1000 + (long) k, dimensions[k]);
+    for (i = 0; i < dimensions[k]; i++) {
+      for (j = 0; j < dimensions[k]; j++) {
+        M[i * dimensions[k] + j] = B[i][j];
+      }
+    }
+    mu_check(coco_is_orthogonal(M, dimensions[k], dimensions[k]));
+    bbob2009_free_matrix(B, dimensions[k]);
+    coco_free_memory(M);
+  }
+}
+
+/**
+ * Tests that bbob2009_compute_rotation returns exactly the same entries as the legacy implementation (the
+ * values were computed with the code that was limited to 44-D).
+ */
+MU_TEST(test_bbob2009_compute_rotation_legacy) {
+
+  const struct {
+    size_t dimension;
+    long seed;
+    size_t row;
+    size_t column;
+    double value;
+  } entries[] = {
+      { 2, 1, 0, 0, 0.59400687745947689 },
+      { 2, 1, 0, 1, 0.80445996142184906 },
+      { 2, 1, 1, 0, -0.80445996142184861 },
+      { 2, 1, 1, 1, 0.59400687745947622 },
+      { 5, 10, 0, 0, 0.45440907268859471 },
+      { 5, 10, 0, 4, 0.52599324718328833 },
+      { 5, 10, 4, 0, 0.15707391937965259 },
+      { 5, 10, 2, 2, 0.47899304400490739 },
+      { 5, 10, 4, 4, -0.36688482833590952 },
+      { 5, 10, 1, 0, -0.16558417070608863 },
+      { 20, 4242, 0, 0, -0.026104439765261927 },
+      { 20, 4242, 0, 19, 0.0015204026486087983 },
+      { 20, 4242, 19, 0, 0.10859579407457827 },
+      { 20, 4242, 10, 10, -0.10321985985959567 },
+      { 20, 4242, 19, 19, -0.073536013085915258 },
+      { 20, 4242, 1, 0, 0.24867154159081525 },
+      { 40, 123457, 0, 0, 0.16502390032862599 },
+      { 40, 123457, 0, 39, 0.18651463110652261 },
+      { 40, 123457, 39, 0, 0.10675407578285716 },
+      { 40, 123457, 20, 20, -0.24654289313589045 },
+      { 40, 123457, 39, 39, 0.12489996087045696 },
+      { 40, 123457, 1, 0, 0.052619788717877841 }
+  };
+  double **B;
+  size_t k;
+
+  for (k = 0; k < sizeof(entries) / sizeof(entries[0]); k++) {
+    B = bbob2009_allocate_matrix(entries[k].dimension, entries[k].dimension);
+    bbob2009_compute_rotation(B, entries[k].seed, entries[k].dimension);
+    mu_check(B[entries[k].row][entries[k].column] == entries[k].value);
+    bbob2009_free_matrix(B, entries[k].dimension);
+  }
+}
+
+/**
+ * Tests that the bulk random number generators return the same values as the scalar ones and that the
+ * stream of the generator is unchanged.
+ */
+MU_TEST(test_coco_random_fill) {
+
+  coco_random_state_t *state1 = coco_random_new(12345);
+  coco_random_state_t *state2 = coco_random_new(12345);
+  const size_t sizes[] = { 1, 5, 594, 607, 1000, 2800 };
+  double *values = coco_allocate_vector(5000);
+  double sum_uniform = 0, sum_normal = 0;
+  size_t i, j, k;
+
+  /* Reference values computed with the scalar generator */
+  for (i = 0; i < 5000; i++)
+    sum_uniform += coco_random_uniform(state1);
+  for (i = 0; i < 5000; i++)
+    sum_normal += coco_random_normal(state1);
+  mu_check(sum_uniform == 2451.5780283204745);
+  mu_check(sum_normal == 80.804758322763433);
+  mu_check(coco_random_uniform(state1) == 0.1144481841695153);
+
+  coco_random_free(state1);
+  state1 = coco_random_new(12345);
+  for (k = 0; k < 6; k++) {
+    coco_random_uniform_fill(state2, values, sizes[k]);
+    for (i = 0; i < sizes[k]; i++)
+      mu_check(values[i] == coco_random_uniform(state1));
+    coco_random_normal_fill(state2, values, sizes[5 - k]);
+    for (i = 0; i < sizes[5 - k]; i++)
+      mu_check(values[i] == coco_random_normal(state1));
+  }
+  coco_random_uniform_fill(state2, values, 0);
+  coco_random_normal_fill(state2, values, 0);
+  j = 0;
+  for (i = 0; i < 100; i++)
+    j += (coco_random_uniform(state1) == coco_random_uniform(state2));
+  mu_check(j == 100);
+
+  coco_free_memory(values);
+  coco_random_free(state1);
+  coco_random_free(state2);
+}
+
+/**
+ * Tests the counter-based random streams, including the known-answer tests of Philox4x32-10.
+ */
+MU_TEST(test_coco_random_stream) {
+
+  const uint32_t counter1[4] = { 0, 0, 0, 0 };
+  const uint32_t key1[2] = { 0, 0 };
+  const uint32_t counter2[4] = { 0x243f6a88UL, 0x85a308d3UL, 0x13198a2eUL, 0x03707344UL };
+  const uint32_t key2[2] = { 0xa4093822UL, 0x299f31d0UL };
+  uint32_t result[4];
+  coco_random_stream_t *stream1, *stream2, *stream3;
+  double *values1 = coco_allocate_vector(1001);
+  double *values2 = coco_allocate_vector(1001);
+  size_t i, number_of_equal_values;
+
+  coco_random_philox(counter1, key1, result);
+  mu_check(result[0] == 0x6627e8d5UL && result[1] == 0xe169c58dUL);
+  mu_check(result[2] == 0xbc57ac4cUL && result[3] == 0x9b00dbd8UL);
+  coco_random_philox(counter2, key2, result);
+  mu_check(result[0] == 0xd16cfe09UL && result[1] == 0x94fdccebUL);
+  mu_check(result[2] == 0x5001e420UL && result[3] == 0x24126ea1UL);
+
+  /* Bulk generation and skipping give the same values as single values */
+  stream1 = coco_random_stream_new(42, 7);
+  stream2 = coco_random_stream_new(42, 7);
+  for (i = 0; i < 1001; i++) {
+    values1[i] = coco_random_stream_uniform(stream1);
+    mu_check(values1[i] >= 0 && values1[i] < 1);
+  }
+  coco_random_stream_skip(stream2, 3);
+  coco_random_stream_uniform_fill(stream2, values2 + 3, 998);
+  for (i = 3; i < 1001; i++)
+    mu_check(values1[i] == values2[i]);
+  coco_random_stream_normal_fill(stream1, values1, 1001);
+  for (i = 0; i < 1001; i++)
+    mu_check(values1[i] == coco_random_stream_normal(stream2));
+
+  /* Another stream gives other values */
+  stream3 = coco_random_stream_new(42, 8);
+  coco_random_stream_uniform_fill(stream3, values2, 1001);
+  coco_random_stream_free(stream1);
+  stream1 = coco_random_stream_new(42, 7);
+  coco_random_stream_uniform_fill(stream1, values1, 1001);
+  number_of_equal_values = 0;
+  for (i = 0; i < 1001; i++)
+    number_of_equal_values += (values1[i] == values2[i]);
+  mu_check(number_of_equal_values == 0);
+
+  coco_free_memory(values1);
+  coco_free_memory(values2);
+  coco_random_stream_free(stream1);
+  coco_random_stream_free(stream2);
+  coco_random_stream_free(stream3);
+}
+
+/**
+ * Tests that the number formatting of coco_writer gives the same results as printf.
+ */
+MU_TEST(test_coco_format) {
+
+  const double special_values[] = { 0.0, -0.0, 1.0, -1.0, 0.5, 1.03125, 99999.5, 9.9999999995, 9.99999999949,
+      1e-8, 1e21, 2e21, 3e21, 1e22, 1e-300, 1e300, 5e-324 };
+  const int special_ints[] = { 0, 1, -1, 9, 10, -10, 123456, INT_MAX, INT_MIN };
+  coco_random_state_t *random_generator = coco_random_new(2468);
+  char expected[256], result[256];
+  double value;
+  size_t i, length;
+  int precision, width;
+
+  for (i = 0; i < 20017; i++) {
+    width = (i % 2) ? 10 : 5;
+    precision = (i % 2) ? 9 : 4;
+    if (i < sizeof(special_values) / sizeof(double)) {
+      value = special_values[i];
+    } else {
+      value = (coco_random_uniform(random_generator) - 0.5)
+          * pow(10.0, floor(80 * coco_random_uniform(random_generator)) - 40);
+      if (i % 3 == 0)
+        value = floor(value * 1e4) / 1e4;
+    }
+    sprintf(expected, "%+*.*e", width, precision, value);
+    length = coco_format_exponential(result, value, width, precision);
+    mu_check(strcmp(result, expected) == 0);
+    mu_check(length == strlen(expected));
+  }
+  sprintf(expected, "%+*.*e", 10, 9, (double) NAN);
+  coco_format_exponential(result, NAN, 10, 9);
+  mu_check(strcmp(result, expected) == 0);
+
+  for (i = 0; i < sizeof(special_ints) / sizeof(int); i++) {
+    sprintf(expected, "%d", special_ints[i]);
+    result[coco_format_int(result, special_ints[i])] = '\0';
+    mu_check(strcmp(result, expected) == 0);
+  }
+  coco_random_free(random_generator);
+}
+
+/**
+ * Returns the number of bytes of the file that have reached the disk.
+ */
+static long test_coco_writer_file_size(const char *file_name) {
+  FILE *file = fopen(file_name, "rb");
+  long size;
+
+  if (file == NULL)
+    return -1;
+  fseek(file, 0, SEEK_END);
+  size = ftell(file);
+  fclose(file);
+  return size;
+}
+
+/**
+ * Writes lines of the given length (including the newline) with a writer that uses the given flush policy
+ * and returns the number of bytes in the file after each line in file_sizes.
+ */
+static void test_coco_writer_write_lines(const coco_writer_flush_policy_t flush_policy,
+                                         const size_t flush_lines,
+                                         const double flush_interval,
+                                         const size_t number_of_lines,
+                                         long *file_sizes,
+                                         long *final_size) {
+  const char *file_name = "test_coco_writer.txt";
+  coco_writer_t *writer;
+  size_t i;
+
+  writer = coco_writer(fopen(file_name, "w"), flush_policy, flush_lines, flush_interval, NULL);
+  for (i = 0; i < number_of_lines; i++) {
+    coco_writer_write_unsigned_long(writer, (unsigned long) (1000 + i));
+    /* Pretend that the last flush was long ago after the third line */
+    if (i == 2)
+      writer->last_flush_time -= 100;
+    coco_writer_end_line(writer);
+    file_sizes[i] = test_coco_writer_file_size(file_name);
+  }
+  coco_writer_close(writer);
+  *final_size = test_coco_writer_file_size(file_name);
+  remove(file_name);
+}
+
+/**
+ * Tests when the writer flushes its file with the different flush policies.
+ */
+MU_TEST(test_coco_writer_flush_policy) {
+
+  const long line_length = 5; /* "1000\n" */
+  long file_sizes[7], final_size;
+  size_t i;
+
+  /* After every line */
+  test_coco_writer_write_lines(COCO_WRITER_FLUSH_LINE, 0, 0, 7, file_sizes, &final_size);
+  for (i = 0; i < 7; i++)
+    mu_check(file_sizes[i] == (long) (i + 1) * line_length);
+  mu_check(final_size == 7 * line_length);
+
+  /* After every three lines */
+  test_coco_writer_write_lines(COCO_WRITER_FLUSH_LINES, 3, 0, 7, file_sizes, &final_size);
+  for (i = 0; i < 7; i++)
+    mu_check(file_sizes[i] == (long) (3 * ((i + 1) / 3)) * line_length);
+  mu_check(final_size == 7 * line_length);
+
+  /* After the third line (when the interval has passed) only */
+  test_coco_writer_write_lines(COCO_WRITER_FLUSH_INTERVAL, 0, 50, 7, file_sizes, &final_size);
+  for (i = 0; i < 7; i++)
+    mu_check(file_sizes[i] == ((i < 2) ? 0 : 3 * line_length));
+  mu_check(final_size == 7 * line_length);
+
+  /* Only when the writer is closed */
+  test_coco_writer_write_lines(COCO_WRITER_FLUSH_END, 0, 0, 7, file_sizes, &final_size);
+  for (i = 0; i < 7; i++)
+    mu_check(file_sizes[i] == 0);
+  mu_check(final_size == 7 * line_length);
+}
+
+/**
+ * Tests whether coco_writer_write_formatted writes the same text as sprintf, also for results longer than
+ * the buffer of coco_strdupf.
+ */
+MU_TEST(test_coco_writer_formatted) {
+
+  const double values[] = { 0.0, -0.0, 1.0 / 3.0, -2.5e-7, 1e300, -1e-300, 123456.789 };
+  const int precisions[] = { 0, 3, 9, 17, 600 };
+  const char *file_name = "test_coco_writer_formatted.txt";
+  char *expected, *result, *position;
+  coco_writer_t *writer;
+  FILE *file;
+  size_t i, j, length;
+
+  expected = coco_allocate_string(100000);
+  result = coco_allocate_string(100000);
+  position = expected;
+  file = fopen(file_name, "w");
+  mu_check(file != NULL);
+  writer = coco_writer(file, COCO_WRITER_FLUSH_END, 0, 0, NULL);
+  for (i = 0; i < sizeof(values) / sizeof(double); i++) {
+    for (j = 0; j < sizeof(precisions) / sizeof(int); j++) {
+      coco_writer_write_formatted(writer, "%.*e\t", precisions[j], values[i]);
+      position += sprintf(position, "%.*e\t", precisions[j], values[i]);
+    }
+    coco_writer_write_formatted(writer, "%+12.4e|%12e|%-14.3e|%.1e|%.0f|%g\n", values[i], values[i],
+        values[i], values[i], values[i], values[i]);
+    position += sprintf(position, "%+12.4e|%12e|%-14.3e|%.1e|%.0f|%g\n", values[i], values[i],
+        values[i], values[i], values[i], values[i]);
+  }
+  coco_writer_write_formatted(writer, "%e %e %e\n", (double) NAN, (double) INFINITY, (double) -INFINITY);
+  position += sprintf(position, "%e %e %e\n", (double) NAN, (double) INFINITY, (double) -INFINITY);
+  coco_writer_write_formatted(writer, "%% evaluation | %lu objective, %2lu, %d,%5d, %ld, %u, %c, %-8s|%5.2s|%s\n",
+      (unsigned long) 12, (unsigned long) 3, -42, 7, -123456789L, 4000000000U, 'x', "left", "right", "");
+  position += sprintf(position, "%% evaluation | %lu objective, %2lu, %d,%5d, %ld, %u, %c, %-8s|%5.2s|%s\n",
+      (unsigned long) 12, (unsigned long) 3, -42, 7, -123456789L, 4000000000U, 'x', "left", "right", "");
+  coco_writer_close(writer);
+
+  file = fopen(file_name, "r");
+  mu_check(file != NULL);
+  length = fread(result, 1, 100000, file);
+  fclose(file);
+  mu_check(length == strlen(expected));
+  mu_check(memcmp(result, expected, length) == 0);
+
+  remove(file_name);
+  coco_free_memory(expected);
+  coco_free_memory(result);
+}
+
 /**
  * Run all tests in this file.
  */
@@ -459,4 +883,13 @@ MU_TEST_SUITE(test_all_coco_utilities) {
   MU_RUN_TEST(test_coco_string_parse_ranges);
   MU_RUN_TEST(test_coco_create_remove_directory);
   MU_RUN_TEST(test_coco_is_orthogonal);
+  MU_RUN_TEST(test_coco_instance_cache);
+  MU_RUN_TEST(test_coco_instance_store_size);
+  MU_RUN_TEST(test_bbob2009_compute_rotation);
+  MU_RUN_TEST(test_bbob2009_compute_rotation_legacy);
+  MU_RUN_TEST(test_coco_random_fill);
+  MU_RUN_TEST(test_coco_random_stream);
+  MU_RUN_TEST(test_coco_format);
+  MU_RUN_TEST(test_coco_writer_flush_policy);
+  MU_RUN_TEST(test_coco_writer_formatted);
 }
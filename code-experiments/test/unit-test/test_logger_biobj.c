@@ -188,6 +188,195 @@ MU_TEST(test_coco_logger_biobj_feed_solution) {
   coco_suite_free(suite);
 }
 
+/**
+ * Computes the additive epsilon and IGD+ indicators of the normalized points with respect to the reference
+ * set from scratch.
+ */
+static void test_logger_biobj_compute_reference_indicators(const double *points,
+                                                           const size_t number_of_points,
+                                                           const double *reference_set,
+                                                           const size_t reference_set_size,
+                                                           double *eps,
+                                                           double *igdp) {
+  double min_eps, min_distance, value, distance, difference;
+  size_t i, k, j;
+
+  *eps = 0;
+  *igdp = 0;
+  for (i = 0; i < reference_set_size; i++) {
+    min_eps = DBL_MAX;
+    min_distance = DBL_MAX;
+    for (k = 0; k < number_of_points; k++) {
+      value = -DBL_MAX;
+      distance = 0;
+      for (j = 0; j < 2; j++) {
+        difference = points[2 * k + j] - reference_set[2 * i + j];
+        value = coco_double_max(value, difference);
+        if (difference > 0)
+          distance += difference * difference;
+      }
+      min_eps = coco_double_min(min_eps, value);
+      min_distance = coco_double_min(min_distance, sqrt(distance));
+    }
+    *eps = (i == 0) ? min_eps : coco_double_max(*eps, min_eps);
+    *igdp += min_distance / (double) reference_set_size;
+  }
+}
+
+/**
+ * Tests the incremental computation of the additive epsilon and IGD+ indicators against the default
+ * reference set (the extreme points) and a reference set read from a file.
+ */
+MU_TEST(test_logger_biobj_reference_indicators) {
+
+  const double extreme_points[4] = { 0, 1, 1, 0 };
+  const double file_points[6] = { 0.1, 0.8, 0.4, 0.4, 0.7, 0.05 };
+  const char *options[2] = { "log_nondominated: read indicator_names: hyp,eps,igdp",
+      "log_nondominated: read indicator_names: igdp,eps reference_set_folder: test_reference_set" };
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem;
+  coco_random_state_t *random_generator;
+  logger_biobj_data_t *logger;
+  logger_biobj_indicator_t *eps, *igdp;
+  const double *reference_set;
+  double points[2 * 200], y[2], expected_eps, expected_igdp;
+  char path[COCO_PATH_MAX + 1] = { 0 };
+  char *file_name;
+  size_t run, i, j;
+  FILE *file;
+
+  for (run = 0; run < 2; run++) {
+    suite = coco_suite("bbob-biobj", "instances: 1", "dimensions: 2 function_indices: 3");
+    problem = coco_suite_get_problem_by_function_dimension_instance(suite, 3, 2, 1);
+    reference_set = extreme_points;
+    if (run == 1) {
+      /* Write the reference set in the format of the archive files */
+      coco_create_directory("test_reference_set");
+      file_name = coco_strdupf("%s_reference.adat", coco_problem_get_id(problem));
+      coco_join_path(path, sizeof(path), "test_reference_set", file_name, NULL);
+      coco_free_memory(file_name);
+      file = fopen(path, "w");
+      mu_check(file != NULL);
+      fprintf(file, "%% instance = 1, name = test\n%% function evaluation | 2 objectives \n");
+      for (i = 0; i < 3; i++) {
+        fprintf(file, "%lu\t", (unsigned long) i + 1);
+        for (j = 0; j < 2; j++)
+          fprintf(file, "%.15e\t", problem->best_value[j]
+              + file_points[2 * i + j] * (problem->nadir_value[j] - problem->best_value[j]));
+        fprintf(file, "\n");
+      }
+      fclose(file);
+      reference_set = file_points;
+    }
+
+    observer = coco_observer("bbob-biobj", options[run]);
+    problem = coco_problem_add_observer(problem, observer);
+    logger = (logger_biobj_data_t *) coco_problem_transformed_get_data(problem);
+    mu_check(logger->number_of_indicators == 3 - run);
+    eps = logger->indicators[1];
+    igdp = logger->indicators[2 - 2 * run];
+    mu_check((eps->type == INDICATOR_EPS) && (igdp->type == INDICATOR_IGDP));
+    mu_check(logger->reference_set_size == 2 + run);
+
+    random_generator = coco_random_new(2 + (uint32_t) run);
+    for (i = 0; i < 200; i++) {
+      for (j = 0; j < 2; j++) {
+        points[2 * i + j] = 0.05 + 1.5 * coco_random_uniform(random_generator);
+        y[j] = problem->best_value[j] + points[2 * i + j] * (problem->nadir_value[j] - problem->best_value[j]);
+      }
+      coco_logger_biobj_feed_solution(problem, i + 1, y);
+      test_logger_biobj_compute_reference_indicators(points, i + 1, reference_set, 2 + run, &expected_eps,
+          &expected_igdp);
+      mu_check(fabs(eps->overall_value - expected_eps) < 1e-9);
+      mu_check(fabs(igdp->overall_value - expected_igdp) < 1e-9);
+    }
+
+    coco_random_free(random_generator);
+    coco_problem_free(problem);
+    coco_observer_free(observer);
+    coco_suite_free(suite);
+  }
+  coco_remove_directory("test_reference_set");
+}
+
+/**
+ * Tests the logger on a problem with three objectives constructed by stacking three bbob problems. The
+ * hypervolume updated with each new solution is compared to the hypervolume of the final archive.
+ */
+MU_TEST(test_logger_biobj_three_objectives) {
+
+  coco_suite_t *suite;
+  coco_observer_t *observer;
+  coco_problem_t *problem;
+  coco_random_state_t *random = coco_random_new(23);
+  double *smallest_values_of_interest = coco_allocate_vector_with_value(2, -5);
+  double *largest_values_of_interest = coco_allocate_vector_with_value(2, 5);
+  double x[2], y[3];
+  const double lower[3] = { 0, 0, 0 };
+  const double **points;
+  char *previous_log_level;
+  size_t i, number_of_points = 0;
+
+  logger_biobj_data_t *logger;
+  logger_biobj_indicator_t *indicator;
+  logger_biobj_avl_item_t *item;
+  avl_node_t *node, *other_node;
+
+  /* The suite is only needed for its name */
+  suite = coco_suite("bbob-biobj", "instances: 1", "dimensions: 2 function_indices: 1");
+  observer = coco_observer("bbob-biobj", "log_nondominated: none");
+
+  problem = coco_problem_stacked_allocate(coco_get_bbob_problem(1, 2, 1), coco_get_bbob_problem(2, 2, 1),
+      smallest_values_of_interest, largest_values_of_interest);
+  problem = coco_problem_stacked_allocate(problem, coco_get_bbob_problem(21, 2, 1),
+      smallest_values_of_interest, largest_values_of_interest);
+  mu_check(coco_problem_get_number_of_objectives(problem) == 3);
+  for (i = 0; i < 3; i++)
+    mu_check(problem->best_value[i] < problem->nadir_value[i]);
+  coco_problem_set_id(problem, "test-triobj_f01_i01_d02");
+  coco_problem_set_type(problem, "test-triobj");
+  problem->suite = suite;
+
+  /* The best hypervolume value of the problem is not known, which is reported as a warning */
+  previous_log_level = coco_strdup(coco_set_log_level("error"));
+  problem = coco_problem_add_observer(problem, observer);
+  coco_set_log_level(previous_log_level);
+  coco_free_memory(previous_log_level);
+
+  for (i = 0; i < 2000; i++) {
+    x[0] = -5 + 10 * coco_random_uniform(random);
+    x[1] = -5 + 10 * coco_random_uniform(random);
+    coco_evaluate_function(problem, x, y);
+  }
+
+  logger = (logger_biobj_data_t *) coco_problem_transformed_get_data(problem);
+  indicator = (logger_biobj_indicator_t *) (logger->indicators[0]);
+  mu_check(indicator->current_value > 0);
+
+  /* The archive is nondominated and its hypervolume equals the incrementally computed one */
+  points = mo_hypervolume_3d_get_points(indicator->hypervolume_3d, avl_count(logger->archive_tree));
+  for (node = logger->archive_tree->head; node != NULL; node = node->next) {
+    item = (logger_biobj_avl_item_t *) node->item;
+    for (other_node = node->next; other_node != NULL; other_node = other_node->next)
+      mu_check(mo_get_dominance(item->normalized_y, ((logger_biobj_avl_item_t *) other_node->item)->normalized_y,
+          3) == 0);
+    if (item->within_ROI)
+      points[number_of_points++] = item->normalized_y;
+  }
+  mu_check(number_of_points > 1);
+  mu_check(about_equal_value(indicator->current_value,
+      mo_hypervolume_3d_dominated(indicator->hypervolume_3d, lower, points, number_of_points)));
+
+  problem = coco_problem_remove_observer(problem, observer);
+  coco_problem_free(problem);
+  coco_observer_free(observer);
+  coco_suite_free(suite);
+  coco_random_free(random);
+  coco_free_memory(smallest_values_of_interest);
+  coco_free_memory(largest_values_of_interest);
+}
+
 /**
  * Run all tests in this file.
  */
@@ -195,4 +384,6 @@ MU_TEST_SUITE(test_all_logger_biobj) {
   MU_RUN_TEST(test_logger_biobj_evaluate);
   MU_RUN_TEST(test_logger_biobj_evaluate2);
   MU_RUN_TEST(test_coco_logger_biobj_feed_solution);
+  MU_RUN_TEST(test_logger_biobj_reference_indicators);
+  MU_RUN_TEST(test_logger_biobj_three_objectives);
 }
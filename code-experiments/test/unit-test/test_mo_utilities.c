@@ -160,6 +160,254 @@ MU_TEST(test_mo_get_distance_to_ROI) {
   mu_check(about_equal_value(mo_get_distance_to_ROI(y, 2), 0.53851648071345037));
 
   coco_free_memory(y);
+
+  y = coco_allocate_vector(3);
+  y[0] = 1.3; y[1] = 0.5; y[2] = 1.4;
+  mu_check(about_equal_value(mo_get_distance_to_ROI(y, 3), 0.5));
+
+  coco_free_memory(y);
+}
+
+/**
+ * Tests the pool allocator of the AVL trees.
+ */
+static int test_avl_pool_compare(const double *a, const double *b, void *userdata) {
+  (void) userdata; /* To silence the compiler */
+  return (*a < *b) ? -1 : ((*a > *b) ? 1 : 0);
+}
+
+MU_TEST(test_avl_pool) {
+
+  avl_pool_t *node_pool, *item_pool;
+  avl_tree_t *tree;
+  avl_node_t *node;
+  double *items[10];
+  void *block;
+  size_t i;
+
+  /* Blocks are aligned, reused after deallocation and taken from new slabs when needed */
+  item_pool = avl_pool_construct(3, 4);
+  mu_check(item_pool->block_size >= sizeof(double));
+  mu_check(item_pool->block_size % sizeof(double) == 0);
+  for (i = 0; i < 10; i++) {
+    items[i] = (double *) avl_pool_allocate(item_pool);
+    *items[i] = (double) ((7 * i) % 10);
+  }
+  for (i = 1; i < 10; i++)
+    mu_check(items[i] != items[i - 1]);
+  block = items[5];
+  avl_pool_deallocate(item_pool, block);
+  items[5] = (double *) avl_pool_allocate(item_pool);
+  mu_check(items[5] == block);
+  *items[5] = 5;
+
+  /* The nodes of a tree are allocated from a pool */
+  node_pool = avl_pool_construct(sizeof(avl_node_t), 4);
+  tree = avl_tree_construct((avl_compare_t) test_avl_pool_compare, NULL, &node_pool->allocator);
+  for (i = 0; i < 10; i++)
+    avl_item_insert(tree, items[i]);
+  mu_check(avl_count(tree) == 10);
+  for (node = tree->head, i = 0; node != NULL; node = node->next, i++)
+    mu_check(about_equal_value(*(double *) node->item, (double) i));
+  block = avl_item_search(tree, items[3]);
+  avl_item_delete(tree, items[3]);
+  avl_item_insert(tree, items[3]);
+  mu_check(avl_item_search(tree, items[3]) == block);
+  mu_check(avl_count(tree) == 10);
+
+  avl_tree_destruct(tree);
+  avl_pool_destruct(node_pool);
+  avl_pool_destruct(item_pool);
+}
+
+/**
+ * Computes the hypervolume of the three-objective points naively: the volume is summed over the slabs
+ * between the distinct values of the third objective and the area of each slab over the rectangles between
+ * the distinct values of the first objective.
+ */
+static double test_mo_hypervolume_3d_naive(const double *points, const size_t number_of_points) {
+
+  double volume = 0, z_low, z_high, x_low, x_high, y_min;
+  size_t i, j, k, l;
+
+  for (i = 0; i < number_of_points; i++) {
+    z_low = points[3 * i + 2];
+    if (z_low >= 1)
+      continue;
+    /* The slab between z_low and the next larger value of the third objective (only counted once) */
+    z_high = 1;
+    for (j = 0; j < number_of_points; j++) {
+      if ((points[3 * j + 2] == z_low) && (j < i))
+        break;
+      if ((points[3 * j + 2] > z_low) && (points[3 * j + 2] < z_high))
+        z_high = points[3 * j + 2];
+    }
+    if (j < number_of_points)
+      continue;
+    for (k = 0; k < number_of_points; k++) {
+      x_low = points[3 * k];
+      if ((x_low >= 1) || (points[3 * k + 2] > z_low))
+        continue;
+      x_high = 1;
+      for (l = 0; l < number_of_points; l++) {
+        if ((points[3 * l] == x_low) && (l < k) && (points[3 * l + 2] <= z_low))
+          break;
+        if ((points[3 * l] > x_low) && (points[3 * l] < x_high) && (points[3 * l + 2] <= z_low))
+          x_high = points[3 * l];
+      }
+      if (l < number_of_points)
+        continue;
+      y_min = 1;
+      for (l = 0; l < number_of_points; l++) {
+        if ((points[3 * l] <= x_low) && (points[3 * l + 2] <= z_low))
+          y_min = coco_double_min(y_min, points[3 * l + 1]);
+      }
+      volume += (x_high - x_low) * (1 - y_min) * (z_high - z_low);
+    }
+  }
+  return volume;
+}
+
+/**
+ * Orders the pointers to three-objective points by the third objective.
+ */
+static int test_mo_hypervolume_3d_compare(const void *a, const void *b) {
+  const double z1 = (*(const double * const *) a)[2];
+  const double z2 = (*(const double * const *) b)[2];
+  return (z1 < z2) ? -1 : ((z1 > z2) ? 1 : 0);
+}
+
+/**
+ * Tests the hypervolume computation for three objectives against a naive computation.
+ */
+MU_TEST(test_mo_hypervolume_3d) {
+
+  const size_t number_of_points = 200;
+  mo_hypervolume_3d_t *hypervolume = mo_hypervolume_3d_allocate();
+  coco_random_state_t *random = coco_random_new(3);
+  double *points = coco_allocate_vector(3 * number_of_points);
+  const double **archive = (const double **) coco_allocate_memory(number_of_points * sizeof(double *));
+  const double lower[3] = { 0, 0, 0 };
+  const double corner[3] = { 0.5, 0.5, 0.5 };
+  double incremental_value = 0, norm;
+  size_t i, j, archive_size = 0;
+
+  /* A single point and a point dominating the box of the contribution */
+  archive[0] = corner;
+  mu_check(about_equal_value(mo_hypervolume_3d_dominated(hypervolume, lower, archive, 1), 0.125));
+  mu_check(about_equal_value(mo_hypervolume_3d_contribution(hypervolume, corner, archive, 1), 0));
+  mu_check(about_equal_value(mo_hypervolume_3d_contribution(hypervolume, lower, archive, 1), 0.875));
+
+  /* Points around a spherical front (some outside the ROI and some dominated) on a coarse grid, so that
+   * there are equal values, added one by one to an archive of nondominated points */
+  for (i = 0; i < number_of_points; i++) {
+    norm = 0;
+    for (j = 0; j < 3; j++) {
+      points[3 * i + j] = coco_random_uniform(random);
+      norm += points[3 * i + j] * points[3 * i + j];
+    }
+    norm = sqrt(norm) * (0.8 + 0.4 * coco_random_uniform(random));
+    for (j = 0; j < 3; j++)
+      points[3 * i + j] = floor(points[3 * i + j] / norm * 32) / 32;
+
+    qsort((void *) archive, archive_size, sizeof(double *), test_mo_hypervolume_3d_compare);
+    incremental_value += mo_hypervolume_3d_contribution(hypervolume, points + 3 * i, archive, archive_size);
+
+    /* Update the archive */
+    for (j = 0; j < archive_size; j++) {
+      if (mo_get_dominance(points + 3 * i, archive[j], 3) < 0)
+        break;
+    }
+    if (j < archive_size)
+      continue;
+    for (j = 0; j < archive_size; j++) {
+      if (mo_get_dominance(points + 3 * i, archive[j], 3) == 1)
+        archive[j--] = archive[--archive_size];
+    }
+    archive[archive_size++] = points + 3 * i;
+  }
+
+  qsort((void *) archive, archive_size, sizeof(double *), test_mo_hypervolume_3d_compare);
+  mu_check(archive_size > 10);
+  mu_check(incremental_value > 0);
+  mu_check(about_equal_value(incremental_value, test_mo_hypervolume_3d_naive(points, number_of_points)));
+  mu_check(about_equal_value(incremental_value,
+      mo_hypervolume_3d_dominated(hypervolume, lower, archive, archive_size)));
+
+  coco_free_memory((void *) archive);
+  coco_free_memory(points);
+  coco_random_free(random);
+  mo_hypervolume_3d_free(hypervolume);
+}
+
+/**
+ * Tests the ND-tree and the hypervolume contributions computed with it against a linear archive.
+ */
+MU_TEST(test_mo_nd_tree) {
+
+  const size_t number_of_points = 3000;
+  mo_nd_tree_t *tree = mo_nd_tree_allocate(3);
+  mo_hypervolume_3d_t *hypervolume = mo_hypervolume_3d_allocate();
+  coco_random_state_t *random = coco_random_new(5);
+  double *points = coco_allocate_vector(3 * number_of_points);
+  const double **archive = (const double **) coco_allocate_memory(number_of_points * sizeof(double *));
+  const double upper[3] = { 2, 2, 2 };
+  double contribution, norm;
+  size_t i, j, k, archive_size = 0, number_of_dominated, number_removed;
+  int dominated;
+
+  for (i = 0; i < number_of_points; i++) {
+    norm = 0;
+    for (j = 0; j < 3; j++) {
+      points[3 * i + j] = coco_random_uniform(random);
+      norm += points[3 * i + j] * points[3 * i + j];
+    }
+    norm = sqrt(norm) * (0.9 + 0.2 * coco_random_uniform(random));
+    for (j = 0; j < 3; j++)
+      points[3 * i + j] = floor(points[3 * i + j] / norm * 256) / 256;
+
+    dominated = 0;
+    number_of_dominated = 0;
+    for (j = 0; j < archive_size; j++) {
+      if (mo_get_dominance(points + 3 * i, archive[j], 3) < 0)
+        dominated = 1;
+      else if (mo_get_dominance(points + 3 * i, archive[j], 3) == 1)
+        number_of_dominated++;
+    }
+    mu_check(mo_nd_tree_is_dominated(tree, points + 3 * i) == dominated);
+    if (dominated)
+      continue;
+
+    /* The contribution w.r.t. the whole archive (including the dominated points) */
+    qsort((void *) archive, archive_size, sizeof(double *), test_mo_hypervolume_3d_compare);
+    contribution = mo_hypervolume_3d_contribution(hypervolume, points + 3 * i, archive, archive_size);
+    mu_check(about_equal_value(contribution,
+        mo_hypervolume_3d_archive_contribution(hypervolume, tree, points + 3 * i)));
+
+    /* The removed points (stored as their own items) need to be exactly the dominated ones */
+    number_removed = mo_nd_tree_remove_dominated(tree, points + 3 * i);
+    mu_check(number_removed == number_of_dominated);
+    for (k = 0; k < number_removed; k++) {
+      mu_check(tree->found_items[k] == (void *) tree->found_points[k]);
+      mu_check(mo_get_dominance(points + 3 * i, tree->found_points[k], 3) == 1);
+    }
+    for (j = 0; j < archive_size; j++) {
+      if (mo_get_dominance(points + 3 * i, archive[j], 3) == 1)
+        archive[j--] = archive[--archive_size];
+    }
+    archive[archive_size++] = points + 3 * i;
+    mo_nd_tree_insert(tree, points + 3 * i, points + 3 * i);
+    mu_check(tree->number_of_points == archive_size);
+  }
+
+  mu_check(archive_size > 100);
+  mu_check(mo_nd_tree_box_search(tree, upper) == archive_size);
+
+  coco_free_memory((void *) archive);
+  coco_free_memory(points);
+  coco_random_free(random);
+  mo_hypervolume_3d_free(hypervolume);
+  mo_nd_tree_free(tree);
 }
 
 /**
@@ -171,4 +419,7 @@ MU_TEST_SUITE(test_all_mo_utilities) {
   MU_RUN_TEST(test_mo_get_dominance);
   MU_RUN_TEST(test_mo_is_within_ROI);
   MU_RUN_TEST(test_mo_get_distance_to_ROI);
+  MU_RUN_TEST(test_avl_pool);
+  MU_RUN_TEST(test_mo_hypervolume_3d);
+  MU_RUN_TEST(test_mo_nd_tree);
 }
@@ -0,0 +1,189 @@
+#! /usr/bin/env python
+# -*- coding: utf-8 -*-
+
+"""Read data files written by the bbob logger in the "bbob-binary" format.
+
+In this format, the :file:`dat`, :file:`tdat` and :file:`rdat` files
+contain the same runs as in the text format "bbob-new2", but the values
+are stored column-wise in binary form (see ``coco_binary_results.c`` in
+``code-experiments/src`` for the layout). The rows of a run can be
+split into several blocks, which the logger writes while the run is
+logged. `data_arrays` gives the rows of each run as a `numpy` array
+with the columns of the text format, which `readalign.split` reads
+without going through the text. The values are the exact doubles
+computed by the logger, not rounded to the digits of the text format.
+`read_blocks` gives the columns of each block as lists and `text_lines`
+gives the lines the logger would have written in the text format.
+
+"""
+
+from __future__ import absolute_import, division, print_function
+import math
+import struct
+import numpy
+
+MAGIC = b'COCOBDAT'
+VERSION = 2  # version 1 had no continuation blocks and is still read
+CONTINUATION = 1  # flag of a block that continues the run of the previous block
+
+_HEADER_FIELDS = ('block_size', 'number_of_rows', 'number_of_variables',
+                  'number_of_integer_variables', 'number_of_logged_variables',
+                  'number_of_constraints', 'log_discrete_as_int', 'optimal_value',
+                  'offset_f_evaluations', 'offset_g_evaluations', 'offset_fvalues',
+                  'offset_best_fvalues', 'offset_has_constraints',
+                  'offset_constraints', 'offset_x', 'flags')
+_HEADER_FORMAT = '<7Qd8Q'
+
+HEADER_LINE = ('%% f evaluations | g evaluations | best noise-free fitness - '
+               'Fopt (%13.12e) + sum g_i+ | measured fitness | best measured '
+               'fitness or single-digit g-values | x1 | x2...')
+
+
+def is_binary(file_name):
+    """return whether `file_name` is a data file in the "bbob-binary" format"""
+    with open(file_name, 'rb') as f:
+        return f.read(len(MAGIC)) == MAGIC
+
+
+def _blocks(file_name):
+    """return the contents of the binary data file and a list with the
+    header fields of each block as `dict`, including its ``'position'``
+    in the contents and whether it ``'is_continuation'`` of a run.
+    """
+    with open(file_name, 'rb') as f:
+        contents = f.read()
+    if contents[:len(MAGIC)] != MAGIC:
+        raise ValueError('%s is not a file in the bbob-binary format' % file_name)
+    version = struct.unpack_from('<Q', contents, len(MAGIC))[0]
+    if not 1 <= version <= VERSION:
+        raise ValueError('%s has version %d of the bbob-binary format, '
+                         'only versions 1 to %d are supported' % (file_name, version, VERSION))
+    header_size = struct.calcsize(_HEADER_FORMAT)
+    blocks = []
+    position = 16
+    while position < len(contents):
+        if position + header_size > len(contents):
+            raise ValueError('truncated block in %s' % file_name)
+        block = dict(zip(_HEADER_FIELDS,
+                         struct.unpack_from(_HEADER_FORMAT, contents, position)))
+        if (block['block_size'] < header_size or block['flags'] > CONTINUATION
+                or position + block['block_size'] > len(contents)):
+            raise ValueError('invalid block in %s' % file_name)
+        block['position'] = position
+        block['is_continuation'] = block['flags'] == CONTINUATION
+        blocks.append(block)
+        position += block['block_size']
+    return contents, blocks
+
+
+def _column(contents, block, key, dtype, count):
+    """return the column of the block starting at the offset `key` as
+    `numpy` array of `count` values of type `dtype`"""
+    return numpy.frombuffer(contents, dtype=dtype, count=count,
+                            offset=block['position'] + block[key])
+
+
+def data_arrays(file_name):
+    """return a list with the rows of each run in the binary data file as
+    2-D `numpy` array.
+
+    The columns are the same as in the text format "bbob-new2": the
+    numbers of function and constraint evaluations, the best function
+    value minus the optimal value, the function value, the single-digit
+    constraint values as one number (or the best function value if the
+    row has none) and the logged variables, where integer variables are
+    rounded if the run was logged with ``log_discrete_as_int``. Unlike the
+    values read from the text, the values are not rounded.
+    """
+    contents, blocks = _blocks(file_name)
+    runs = []
+    for block in blocks:
+        rows = block['number_of_rows']
+        m = block['number_of_constraints']
+        n = block['number_of_logged_variables']
+        data = numpy.empty((rows, n + 5))
+        data[:, 0] = _column(contents, block, 'offset_f_evaluations', '<u8', rows)
+        data[:, 1] = _column(contents, block, 'offset_g_evaluations', '<u8', rows)
+        best_fvalues = _column(contents, block, 'offset_best_fvalues', '<f8', rows)
+        data[:, 2] = best_fvalues - block['optimal_value']
+        data[:, 3] = _column(contents, block, 'offset_fvalues', '<f8', rows)
+        data[:, 4] = best_fvalues
+        if m > 0 and rows > 0:
+            has_constraints = _column(contents, block, 'offset_has_constraints', 'u1', rows) != 0
+            digits = _column(contents, block, 'offset_constraints', 'u1', rows * m).reshape(rows, m)
+            numbers = numpy.dot(digits.astype(float), 10.0 ** numpy.arange(m - 1, -1, -1))
+            data[has_constraints, 4] = numbers[has_constraints]
+        if n > 0:
+            data[:, 5:] = _column(contents, block, 'offset_x', '<f8', rows * n).reshape(rows, n)
+            k = min(block['number_of_integer_variables'], n)
+            if block['log_discrete_as_int'] and k > 0:
+                data[:, 5:5 + k] = numpy.floor(data[:, 5:5 + k] + 0.5)
+        if block['is_continuation'] and runs:
+            runs[-1] = numpy.vstack((runs[-1], data))
+        else:
+            runs.append(data)
+    return runs
+
+
+def read_blocks(file_name):
+    """return a list with one `dict` for each block in the binary data file.
+
+    Besides the header fields and ``'is_continuation'``, each `dict`
+    contains the columns ``'f_evaluations'``, ``'g_evaluations'``,
+    ``'fvalues'``, ``'best_fvalues'`` and ``'has_constraints'`` (one value
+    per row), ``'constraints'`` (the single-digit constraint values, one
+    list per row) and ``'x'`` (the logged variables, one list per row).
+    """
+    contents, blocks = _blocks(file_name)
+    for block in blocks:
+        rows = block['number_of_rows']
+        m = block['number_of_constraints']
+        n = block['number_of_logged_variables']
+
+        def column(dtype, key, count):
+            return _column(contents, block, key, dtype, count).tolist()
+        block['f_evaluations'] = column('<u8', 'offset_f_evaluations', rows)
+        block['g_evaluations'] = column('<u8', 'offset_g_evaluations', rows)
+        block['fvalues'] = column('<f8', 'offset_fvalues', rows)
+        block['best_fvalues'] = column('<f8', 'offset_best_fvalues', rows)
+        block['has_constraints'] = column('u1', 'offset_has_constraints', rows)
+        digits = column('u1', 'offset_constraints', rows * m)
+        block['constraints'] = [digits[i * m:(i + 1) * m] for i in range(rows)]
+        x = column('<f8', 'offset_x', rows * n)
+        block['x'] = [x[i * n:(i + 1) * n] for i in range(rows)]
+    return blocks
+
+
+def text_lines(file_name):
+    """return the lines of the binary data file in the text format "bbob-new2".
+
+    The lines are the same as written by the logger in the text format
+    (including the end-of-line characters). Blocks that continue a run
+    have no header line.
+    """
+    lines = []
+    for block in read_blocks(file_name):
+        if not block['is_continuation']:
+            lines.append(HEADER_LINE % block['optimal_value'] + '\n')
+        for i in range(block['number_of_rows']):
+            columns = ['%d' % block['f_evaluations'][i],
+                       '%d' % block['g_evaluations'][i],
+                       '%+10.9e' % (block['best_fvalues'][i] - block['optimal_value']),
+                       '%+10.9e' % block['fvalues'][i]]
+            if block['has_constraints'][i]:
+                columns.append(''.join('%d' % d for d in block['constraints'][i]))
+            else:
+                columns.append('%+10.9e' % block['best_fvalues'][i])
+            for j, value in enumerate(block['x'][i]):
+                if j < block['number_of_integer_variables'] and block['log_discrete_as_int']:
+                    columns.append('%d' % int(math.floor(value + 0.5)))
+                else:
+                    columns.append('%+5.4e' % value)
+            lines.append(' '.join(columns) + '\n')
+    return lines
+
+
+def convert(input_file_name, output_file_name):
+    """convert the binary data file to a data file in the text format"""
+    with open(output_file_name, 'w') as f:
+        f.writelines(text_lines(input_file_name))
@@ -115,5 +115,6 @@ data_format_name_to_class_mapping = {
         'bbob-old': BBOBOldDataFormat,  # probably never used
         'bbob-new': BBOBNewDataFormat,  # 2nd column has constraints evaluations
         'bbob-new2': BBOBNewDataFormat,  # 2nd column has constraints evaluations, 5th column constraints as single digits
+        'bbob-binary': BBOBNewDataFormat,  # same columns as 'bbob-new2', stored in binary form (see binarydata.py)
         'bbob-biobj': BBOBBiObjDataFormat,  # 2nd column has function evaluations
 }
@@ -23,7 +23,7 @@ import os, sys
 import numpy
 import warnings
 
-from . import genericsettings, testbedsettings, dataformatsettings
+from . import genericsettings, testbedsettings, dataformatsettings, binarydata
 
 from pdb import set_trace
 from six import string_types, advance_iterator
@@ -442,7 +442,21 @@ def split(dataFiles, idx_to_load=None, dim=None):
         with openfile(fil) as f:
             # This doesnt work with windows.
             # content = numpy.loadtxt(fil, comments='%')
-            lines = f.readlines()
+            lines = None if binarydata.is_binary(fil) else f.readlines()
+        if lines is None:  # data_format 'bbob-binary', read without parsing text
+            idx = 0
+            for data in binarydata.data_arrays(fil):
+                if dim and data.shape[1] != dim + 5:
+                    warnings.warn('Incomplete lines in data file %s' % fil)
+                    continue
+                if not len(data):
+                    continue
+                if (idx_to_load is None) or (idx_to_load and len(idx_to_load) > idx and idx_to_load[idx]):
+                    data_sets.append(data)
+                elif genericsettings.verbose:
+                        print('skipped instance...')
+                idx += 1
+            continue
 
         content = []
         idx = 0  # instance index for checking in idx_to_load
@@ -2,6 +2,7 @@
 from __future__ import absolute_import, division, print_function, unicode_literals
 
 import os
+import math
 import argparse
 
 from cocoprep.archive_load_data import get_file_name_list, parse_archive_file_name
@@ -78,8 +79,10 @@ def archive_thinning(input_path, output_path, thinning_precision, currently_nond
                         # Fill the archives with the rounded solutions values wrt the different precisions
                         f_original = [float(x) for x in line.split()[1:3]]
                         f_normalized = [(f_original[i] - ideal[i]) / normalization[i] for i in range(2)]
-                        f_normalized = [round(f_normalized[i] / thinning_precision) for i in range(2)]
-                        f_normalized = [ideal[i] + f_normalized[i] * thinning_precision for i in range(2)]
+                        # Round halves up as coco_archive_merge_thin does (round() rounds them to even)
+                        f_normalized = [math.floor(f_normalized[i] / thinning_precision + 0.5) for i in range(2)]
+                        f_normalized = [ideal[i] + f_normalized[i] * thinning_precision * normalization[i]
+                                        for i in range(2)]
                         updated = thinned_archive.add_solution(f_normalized[0], f_normalized[1], line)
                     except IndexError:
                         print('Problem in file {}, line {}, skipping line'.format(input_file, line))
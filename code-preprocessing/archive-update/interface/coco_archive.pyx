@@ -3,6 +3,7 @@
 from __future__ import absolute_import, division, print_function, unicode_literals
 import numpy as np
 cimport numpy as np
+from libc.stdlib cimport malloc, free
 
 # Must initialize numpy or risk segfaults
 np.import_array()
@@ -15,6 +16,8 @@ cdef extern from "coco.h":
     coco_archive_t *coco_archive(char *suite_name, size_t function, 
                                  size_t dimension, size_t instance)
     int coco_archive_add_solution(coco_archive_t *archive, double f1, double f2, char *text)
+    size_t coco_archive_add_solutions(coco_archive_t *archive, size_t number_of_solutions, double *f1,
+                                      double *f2, char *text, size_t *text_offsets)
     size_t coco_archive_get_number_of_solutions(coco_archive_t *archive)
     double coco_archive_get_hypervolume(coco_archive_t *archive)
     char *coco_archive_get_next_solution_text(coco_archive_t *archive)
@@ -69,6 +72,37 @@ cdef class Archive:
         if updated:
             self.up_to_date = False            
         return updated
+
+    def add_solutions(self, f1, f2, texts):
+        """Adds the solutions with objectives (f1[i], f2[i]) and texts[i] to the archive at once (faster than
+           adding them one by one). Returns the number of solutions that updated the archive.
+        """
+        cdef np.ndarray[double, ndim=1, mode='c'] _f1 = np.ascontiguousarray(f1, dtype=np.float64)
+        cdef np.ndarray[double, ndim=1, mode='c'] _f2 = np.ascontiguousarray(f2, dtype=np.float64)
+        cdef size_t number_of_solutions = len(texts)
+        cdef size_t *text_offsets
+        cdef size_t i, offset = 0
+        cdef bytes _texts
+        if len(_f1) != number_of_solutions or len(_f2) != number_of_solutions:
+            raise ValueError('f1, f2 and texts must have the same length')
+        if number_of_solutions == 0:
+            return 0
+        encoded_texts = [_bstring(text) for text in texts]
+        _texts = b'\0'.join(encoded_texts) + b'\0'
+        text_offsets = <size_t *> malloc(number_of_solutions * sizeof(size_t))
+        if text_offsets == NULL:
+            raise MemoryError()
+        try:
+            for i in range(number_of_solutions):
+                text_offsets[i] = offset
+                offset += len(encoded_texts[i]) + 1
+            updated = coco_archive_add_solutions(self.archive, number_of_solutions, &_f1[0], &_f2[0],
+                                                 _texts, text_offsets)
+        finally:
+            free(text_offsets)
+        if updated:
+            self.up_to_date = False
+        return updated
         
     def get_next_solution_text(self):
         self._tmp_text = coco_archive_get_next_solution_text(self.archive)
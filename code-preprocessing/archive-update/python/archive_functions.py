@@ -50,9 +50,11 @@ class ProblemInstanceInfo:
         """Reads the solutions from the files and feeds them to the given archive. If a file contains a single
         instance, all comments are skipped. If a file contains multiple instances, only the solutions up to the next
         instance are read. If the file contains no solutions for the given problem instance, an exception is raised.
+        The solutions of each file are added to the archive at once.
            :param archive: archive to be filled with solutions
         """
         for f_info in self.file_info:
+            f1, f2, lines = [], [], []
             f_name = f_info.get('file_name')
             single_instance = f_info.get('single_instance')
             with open(f_name, 'r') as f:
@@ -80,9 +82,13 @@ class ProblemInstanceInfo:
 
                     elif instance_found:
                         if line[0] != '%':
-                            # Solution found, feed it to the archive
+                            # Solution found, collect it for the archive
                             try:
-                                archive.add_solution(float(line.split()[1]), float(line.split()[2]), line)
+                                values = line.split()
+                                f1_value, f2_value = float(values[1]), float(values[2])
+                                f1.append(f1_value)
+                                f2.append(f2_value)
+                                lines.append(line)
                                 solution_found = True
                             except IndexError:
                                 print('Problem in file {}, line {}, skipping line'.format(f_name, line))
@@ -90,6 +96,7 @@ class ProblemInstanceInfo:
                                 continue
 
                 f.close()
+                archive.add_solutions(f1, f2, lines)
                 if not instance_found:
                     raise PreprocessingException('File \'{}\' does not contain \'instance = {}\''.format(f_name,
                                                                                                          self.instance))
@@ -210,7 +217,7 @@ class ArchiveInfo:
         function_set = set()
         for problem_instance in self.problem_instances:
             function_set.add(problem_instance.function)
-        extended_functions = range(55, 93)
+        extended_functions = range(56, 93)
         return bool(function_set.intersection(extended_functions))
 
     def get_function_string(self):
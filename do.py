@@ -30,7 +30,9 @@ from cocoutils import git_version, git_revision
 CORE_FILES = ['code-experiments/src/coco_random.c',
               'code-experiments/src/coco_suite.c',
               'code-experiments/src/coco_observer.c',
-              'code-experiments/src/coco_archive.c'
+              'code-experiments/src/coco_archive.c',
+              'code-experiments/src/coco_archive_merge.c',
+              'code-experiments/src/coco_runner.c'
              ]
 
 MATLAB_FILES = ['cocoCall.m', 'cocoEvaluateFunction.m', 'cocoObserver.m',
@@ -122,6 +124,21 @@ def test_c_example():
     run_c_example_tests()
 
 
+def benchmark_c():
+    """ Builds and runs the benchmark of the bbob-biobj logger on problems with three objectives in C """
+    build_c()
+    copy_file('code-experiments/build/c/coco.c',
+              'code-experiments/test/integration-test/coco.c')
+    expand_file('code-experiments/src/coco.h',
+                'code-experiments/test/integration-test/coco.h',
+                {'COCO_VERSION': git_version(pep440=True)})
+    make("code-experiments/test/integration-test", "benchmark_biobj_3d", verbose=_build_verbosity)
+    try:
+        run('code-experiments/test/integration-test', ['./benchmark_biobj_3d'], verbose=True)
+    except subprocess.CalledProcessError:
+        sys.exit(-1)
+
+
 def build_c_unit_tests():
     """ Builds unit tests in C """
     copy_file('code-experiments/build/c/coco.c', 'code-experiments/test/unit-test/coco.c')
@@ -923,6 +940,8 @@ Available commands for developers:
   test-c-unit             - Build and run unit tests in C
   test-c-integration      - Build and run integration tests in C
   test-c-example          - Build and run an example experiment test in C
+  benchmark-c             - Build and run the benchmark of the bbob-biobj
+                            logger on problems with three objectives
   test-java               - Build and run a test in Java
   test-python             - Build and run minimal test of Python module
   test-octave             - Build and run example experiment in Octave
@@ -991,6 +1010,7 @@ def main(args):
     elif cmd == 'test-c-unit': test_c_unit()
     elif cmd == 'test-c-integration': test_c_integration()
     elif cmd == 'test-c-example': test_c_example()
+    elif cmd == 'benchmark-c': benchmark_c()
     elif cmd == 'test-java': test_java()
     elif cmd == 'test-python': test_python()
     elif cmd == 'test-octave': test_octave()